@@ -0,0 +1,457 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "scrabble_engine.h"  // Interface publique du moteur (seule dépendance)
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+//
+// ---------------------- Analyse de positions par lots ------------------------
+//
+// Lit un flux de positions (une par ligne), calcule les meilleurs coups de chacune sur un
+// groupe de threads et écrit les résultats en JSON Lines ou dans un format binaire compact.
+//
+// Format d'entrée (champs séparés par des blancs, lignes vides et '#' ignorés) :
+//   PLATEAU RACK [SCORE [SCORE_ADVERSE]]
+// PLATEAU : toutes les cases ligne par ligne (225 avec les règles standard, '.' pour une
+// case vide), les lignes pouvant être séparées par des '/'. RACK : 1 à 7 lettres.
+//
+// Mémoire bornée : les positions transitent par un anneau de cases de taille fixe. Le
+// lecteur attend qu'une case se libère, quelle que soit la taille de l'entrée.
+//
+
+#define ANALYZE_MAX_LINE   1024
+#define ANALYZE_MAX_TOPK   255
+#define ANALYZE_MAX_THREADS 256
+#define ANALYZE_STATS_LINE  512     // Compteurs du moteur d'une position (JSON)
+
+// Format binaire : en-tête "SCAN", version, nombre de coups demandés ; puis, par position,
+// id (u64), score et score adverse (i32), statut (u8, 0 : valide), nombre de coups (u8) et,
+// par coup, mot (SCRABBLE_MAX_WORD = 22 octets), x, y, direction, lettres posées (u8),
+// score (i16) et équité (f32). Tous les entiers sont en petit-boutiste. La version 1
+// réservait 16 octets au mot (plateau 15 x 15 seulement).
+#define ANALYZE_MAGIC   "SCAN"
+#define ANALYZE_VERSION 2
+
+typedef enum { FORMAT_JSONL, FORMAT_BINARY } OutputFormat;
+
+typedef enum { SLOT_FREE, SLOT_READY, SLOT_BUSY, SLOT_DONE } SlotState;
+
+// Case de l'anneau : une ligne d'entrée, puis le résultat encodé
+typedef struct {
+    SlotState state;
+    uint64_t seq;
+    bool overflow;                 // Ligne plus longue que ANALYZE_MAX_LINE
+    char line[ANALYZE_MAX_LINE];
+    unsigned char *output;
+    size_t outputLen;
+} Slot;
+
+// État partagé entre le lecteur, les threads d'analyse et l'écriture
+typedef struct {
+    const ScrabbleEngine *engine;
+    Slot *slots;
+    int capacity;
+    size_t outputCapacity;         // Taille du tampon de sortie de chaque case
+    uint64_t nextRead;             // Prochaine position lue
+    uint64_t nextWork;             // Prochaine position confiée à un thread
+    uint64_t nextWrite;            // Prochaine position écrite (mode ordonné)
+    bool eof;
+    bool ordered;
+    bool stats;                    // Compteurs du moteur dans chaque résultat JSON (-s)
+    OutputFormat format;
+    int topK;
+    FILE *out;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;        // Diffusé à chaque changement d'état d'une case
+} Analyzer;
+
+// Contexte d'un thread d'analyse : sa propre position et ses coups
+typedef struct {
+    Analyzer *analyzer;
+    ScrabblePosition *position;
+    ScrabbleMove moves[ANALYZE_MAX_TOPK];
+} Worker;
+
+//
+// Encodage des résultats
+//
+
+// Ajoute du texte formaté au tampon de sortie (dimensionné pour ne jamais déborder)
+static void appendText(Slot *slot, size_t capacity, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf((char *)slot->output + slot->outputLen, capacity - slot->outputLen, format, args);
+    va_end(args);
+    if (n > 0)
+        slot->outputLen += ((size_t)n < capacity - slot->outputLen) ? (size_t)n : capacity - slot->outputLen - 1;
+}
+
+static void appendBytes(Slot *slot, const void *data, size_t size) {
+    memcpy(slot->output + slot->outputLen, data, size);
+    slot->outputLen += size;
+}
+
+// Entier non signé de size octets, en petit-boutiste
+static void appendLittle(Slot *slot, uint64_t value, int size) {
+    unsigned char bytes[8];
+    for (int i = 0; i < size; i++)
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    appendBytes(slot, bytes, size);
+}
+
+static void encodeJson(Slot *slot, size_t capacity, const char *rack, int score, int oppScore,
+                       const char *error, const ScrabbleMove *moves, int count, const char *stats) {
+    if (error) {
+        appendText(slot, capacity, "{\"id\":%llu,\"error\":\"%s\"}\n", (unsigned long long)slot->seq, error);
+        return;
+    }
+    appendText(slot, capacity, "{\"id\":%llu,\"rack\":\"%s\",\"score\":%d,\"opp\":%d,\"moves\":[",
+               (unsigned long long)slot->seq, rack, score, oppScore);
+    for (int i = 0; i < count; i++)
+        appendText(slot, capacity, "%s{\"word\":\"%s\",\"x\":%d,\"y\":%d,\"dir\":\"%c\",\"score\":%d,\"tiles\":%d,\"equity\":%.3f}",
+                   i > 0 ? "," : "", moves[i].word, moves[i].x, moves[i].y, moves[i].dir,
+                   moves[i].score, moves[i].tilesUsed, moves[i].equity);
+    appendText(slot, capacity, "]");
+    if (stats)
+        appendText(slot, capacity, ",\"stats\":%s", stats);
+    appendText(slot, capacity, "}\n");
+}
+
+static void encodeBinary(Slot *slot, int score, int oppScore, const char *error,
+                         const ScrabbleMove *moves, int count) {
+    appendLittle(slot, slot->seq, 8);
+    appendLittle(slot, (uint32_t)score, 4);
+    appendLittle(slot, (uint32_t)oppScore, 4);
+    appendLittle(slot, error ? 1 : 0, 1);
+    appendLittle(slot, error ? 0 : (uint64_t)count, 1);
+    for (int i = 0; !error && i < count; i++) {
+        char word[SCRABBLE_MAX_WORD] = { 0 };
+        memcpy(word, moves[i].word, strnlen(moves[i].word, sizeof(word) - 1));
+        appendBytes(slot, word, sizeof(word));
+        appendLittle(slot, (uint64_t)moves[i].x, 1);
+        appendLittle(slot, (uint64_t)moves[i].y, 1);
+        appendLittle(slot, (uint64_t)(unsigned char)moves[i].dir, 1);
+        appendLittle(slot, (uint64_t)moves[i].tilesUsed, 1);
+        appendLittle(slot, (uint16_t)moves[i].score, 2);
+        uint32_t bits;
+        memcpy(&bits, &moves[i].equity, sizeof(bits));
+        appendLittle(slot, bits, 4);
+    }
+}
+
+//
+// Analyse d'une position
+//
+
+// Charge le plateau (taille des règles du moteur, '/' ignorés) ; retourne un message
+// d'erreur ou NULL
+static const char *parseBoard(const ScrabbleEngine *engine, ScrabblePosition *position,
+                              const char *text) {
+    int size = scrabbleBoardSize(engine);
+    char cells[ANALYZE_MAX_LINE];
+    int n = 0;
+    for (const char *p = text; *p != '\0'; p++) {
+        if (*p == '/')
+            continue;
+        if (n == size * size)
+            return "plateau trop long";
+        cells[n++] = *p;
+    }
+    if (n != size * size)
+        return "plateau trop court";
+    for (int y = 0; y < size; y++) {
+        char row[ANALYZE_MAX_LINE];
+        memcpy(row, &cells[y * size], size);
+        row[size] = '\0';
+        if (scrabblePositionSetRow(position, y, row) != 0)
+            return "caractère invalide dans le plateau";
+    }
+    return NULL;
+}
+
+// Analyse la ligne de la case et encode le résultat dans son tampon de sortie
+static void analyzeSlot(Worker *worker, Slot *slot) {
+    const Analyzer *analyzer = worker->analyzer;
+    char *fields[4] = { NULL, NULL, NULL, NULL };
+    int fieldCount = 0;
+    char *save = NULL;
+    for (char *token = strtok_r(slot->line, " \t\r\n", &save); token && fieldCount < 5;
+         token = strtok_r(NULL, " \t\r\n", &save)) {
+        if (fieldCount < 4)
+            fields[fieldCount] = token;
+        fieldCount++;
+    }
+
+    const char *error = NULL;
+    int score = 0, oppScore = 0, count = 0;
+    if (slot->overflow)
+        error = "ligne trop longue";
+    else if (fieldCount < 2 || fieldCount > 4)
+        error = "attendu : PLATEAU RACK [SCORE [SCORE_ADVERSE]]";
+    else if (strlen(fields[1]) > SCRABBLE_RACK_SIZE ||
+             strspn(fields[1], "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz?") != strlen(fields[1]))
+        error = "rack invalide";
+    else
+        error = parseBoard(analyzer->engine, worker->position, fields[0]);
+    char stats[ANALYZE_STATS_LINE];
+    if (!error) {
+        score = fields[2] ? atoi(fields[2]) : 0;
+        oppScore = fields[3] ? atoi(fields[3]) : 0;
+        if (analyzer->stats)
+            scrabbleStatsReport(stats, sizeof(stats), true);   // Repart de zéro pour cette position
+        count = scrabbleGenerateMoves(worker->position, fields[1], worker->moves, analyzer->topK);
+        if (analyzer->stats)
+            scrabbleStatsReport(stats, sizeof(stats), true);
+    }
+
+    slot->outputLen = 0;
+    if (analyzer->format == FORMAT_JSONL)
+        encodeJson(slot, analyzer->outputCapacity, error ? NULL : fields[1], score, oppScore, error,
+                   worker->moves, count, analyzer->stats && !error ? stats : NULL);
+    else
+        encodeBinary(slot, score, oppScore, error, worker->moves, count);
+    if (error)
+        fprintf(stderr, "Position %llu : %s\n", (unsigned long long)slot->seq, error);
+}
+
+//
+// Anneau de positions et threads
+//
+
+// Écrit une case et la libère (verrou tenu)
+static void writeSlot(Analyzer *analyzer, Slot *slot) {
+    fwrite(slot->output, 1, slot->outputLen, analyzer->out);
+    slot->state = SLOT_FREE;
+}
+
+static void *workerMain(void *arg) {
+    Worker *worker = arg;
+    Analyzer *analyzer = worker->analyzer;
+    pthread_mutex_lock(&analyzer->lock);
+    for (;;) {
+        while (analyzer->nextWork == analyzer->nextRead && !analyzer->eof)
+            pthread_cond_wait(&analyzer->changed, &analyzer->lock);
+        if (analyzer->nextWork == analyzer->nextRead)
+            break;   // Fin de l'entrée et plus aucune position en attente
+        Slot *slot = &analyzer->slots[analyzer->nextWork % analyzer->capacity];
+        analyzer->nextWork++;
+        slot->state = SLOT_BUSY;
+        pthread_mutex_unlock(&analyzer->lock);
+
+        analyzeSlot(worker, slot);
+
+        pthread_mutex_lock(&analyzer->lock);
+        if (analyzer->ordered) {
+            // Écrit toutes les positions terminées qui suivent la dernière écrite
+            slot->state = SLOT_DONE;
+            Slot *next;
+            while ((next = &analyzer->slots[analyzer->nextWrite % analyzer->capacity])->state == SLOT_DONE &&
+                   next->seq == analyzer->nextWrite) {
+                writeSlot(analyzer, next);
+                analyzer->nextWrite++;
+            }
+        } else {
+            writeSlot(analyzer, slot);
+        }
+        pthread_cond_broadcast(&analyzer->changed);
+    }
+    pthread_mutex_unlock(&analyzer->lock);
+    return NULL;
+}
+
+// Lit les positions et les dépose dans l'anneau ; retourne le nombre de positions lues
+static uint64_t readPositions(Analyzer *analyzer, FILE *in) {
+    char buffer[ANALYZE_MAX_LINE];
+    while (fgets(buffer, sizeof(buffer), in)) {
+        bool overflow = false;
+        size_t len = strlen(buffer);
+        if (len == sizeof(buffer) - 1 && buffer[len - 1] != '\n') {
+            // Ligne trop longue : le reste est ignoré, la position sera signalée en erreur
+            overflow = true;
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n')
+                ;
+        }
+        const char *p = buffer + strspn(buffer, " \t\r\n");
+        if (!overflow && (*p == '\0' || *p == '#'))
+            continue;
+
+        pthread_mutex_lock(&analyzer->lock);
+        Slot *slot = &analyzer->slots[analyzer->nextRead % analyzer->capacity];
+        while (slot->state != SLOT_FREE)
+            pthread_cond_wait(&analyzer->changed, &analyzer->lock);
+        memcpy(slot->line, buffer, len + 1);
+        slot->overflow = overflow;
+        slot->seq = analyzer->nextRead++;
+        slot->state = SLOT_READY;
+        pthread_cond_broadcast(&analyzer->changed);
+        pthread_mutex_unlock(&analyzer->lock);
+    }
+    pthread_mutex_lock(&analyzer->lock);
+    analyzer->eof = true;
+    uint64_t total = analyzer->nextRead;
+    pthread_cond_broadcast(&analyzer->changed);
+    pthread_mutex_unlock(&analyzer->lock);
+    return total;
+}
+
+static double elapsedSeconds(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-l reliquats.bin] [-k coups] [-j threads] [-q file]\n"
+            "          [-R règles] [-f jsonl|bin] [-o sortie] [-u] [-s] [entrée|-]\n"
+            "  -R : fichier de règles (plateau, bonus, lettres), règles standard par défaut\n"
+            "  -u : écrit les résultats dans l'ordre d'achèvement (chaque résultat garde son id)\n"
+            "  -s : ajoute les compteurs du moteur à chaque résultat JSON (make STATS=1)\n",
+            prog);
+}
+
+// Fonction principale de l'analyseur par lots
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *leavesFile = NULL;
+    const char *outputFile = NULL;
+    const char *rulesFile = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int queue = 0;
+    Analyzer analyzer;
+    memset(&analyzer, 0, sizeof(analyzer));
+    analyzer.ordered = true;
+    analyzer.format = FORMAT_JSONL;
+    analyzer.topK = 10;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:l:R:k:j:q:f:o:ush")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'l': leavesFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 'k': analyzer.topK = atoi(optarg); break;
+            case 'j': threads = strtol(optarg, NULL, 10); break;
+            case 'q': queue = atoi(optarg); break;
+            case 'o': outputFile = optarg; break;
+            case 'u': analyzer.ordered = false; break;
+            case 's': analyzer.stats = true; break;
+            case 'f':
+                if (strcmp(optarg, "jsonl") == 0)
+                    analyzer.format = FORMAT_JSONL;
+                else if (strcmp(optarg, "bin") == 0)
+                    analyzer.format = FORMAT_BINARY;
+                else {
+                    usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (optind < argc - 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > ANALYZE_MAX_THREADS)
+        threads = ANALYZE_MAX_THREADS;
+    if (analyzer.topK < 1)
+        analyzer.topK = 1;
+    if (analyzer.topK > ANALYZE_MAX_TOPK)
+        analyzer.topK = ANALYZE_MAX_TOPK;
+    // Quelques positions d'avance par thread suffisent à les occuper tous
+    analyzer.capacity = queue > 0 ? queue : 4 * (int)threads;
+    if (analyzer.capacity < threads)
+        analyzer.capacity = threads;
+    char probe[ANALYZE_STATS_LINE];
+    if (analyzer.stats && scrabbleStatsReport(probe, sizeof(probe), true) < 0) {
+        fprintf(stderr, "Erreur : moteur compilé sans instrumentation (make clean && make STATS=1)\n");
+        return EXIT_FAILURE;
+    }
+
+    FILE *in = stdin;
+    if (optind == argc - 1 && strcmp(argv[optind], "-") != 0 && !(in = fopen(argv[optind], "r"))) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    analyzer.out = stdout;
+    if (outputFile && !(analyzer.out = fopen(outputFile, "wb"))) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", outputFile);
+        return EXIT_FAILURE;
+    }
+
+    ScrabbleEngine *engine = scrabbleEngineLoad(dictionaryFile, leavesFile);
+    if (!engine)
+        return EXIT_FAILURE;
+    if (rulesFile && scrabbleLoadRules(engine, rulesFile) != 0) {
+        scrabbleEngineFree(engine);
+        return EXIT_FAILURE;
+    }
+    analyzer.engine = engine;
+
+    // Anneau et tampons de sortie alloués une fois pour toutes
+    analyzer.outputCapacity = 256 + (size_t)analyzer.topK * 160 + ANALYZE_STATS_LINE;
+    analyzer.slots = calloc(analyzer.capacity, sizeof(Slot));
+    Worker *workers = calloc(threads, sizeof(Worker));
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    bool ok = analyzer.slots && workers && tids;
+    for (int i = 0; ok && i < analyzer.capacity; i++)
+        ok = (analyzer.slots[i].output = malloc(analyzer.outputCapacity)) != NULL;
+    for (long t = 0; ok && t < threads; t++) {
+        workers[t].analyzer = &analyzer;
+        ok = (workers[t].position = scrabblePositionCreate(engine)) != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return EXIT_FAILURE;
+    }
+    pthread_mutex_init(&analyzer.lock, NULL);
+    pthread_cond_init(&analyzer.changed, NULL);
+
+    if (analyzer.format == FORMAT_BINARY) {
+        fwrite(ANALYZE_MAGIC, 1, 4, analyzer.out);
+        unsigned char header[8];
+        for (int i = 0; i < 4; i++) {
+            header[i] = (unsigned char)(ANALYZE_VERSION >> (8 * i));
+            header[4 + i] = (unsigned char)((uint32_t)analyzer.topK >> (8 * i));
+        }
+        fwrite(header, 1, sizeof(header), analyzer.out);
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long t = 0; t < threads; t++)
+        pthread_create(&tids[t], NULL, workerMain, &workers[t]);
+    uint64_t total = readPositions(&analyzer, in);
+    for (long t = 0; t < threads; t++)
+        pthread_join(tids[t], NULL);
+    double seconds = elapsedSeconds(&start);
+    fprintf(stderr, "%llu positions en %.3f s (%.0f positions/s, %ld threads)\n",
+            (unsigned long long)total, seconds, seconds > 0 ? total / seconds : 0.0, threads);
+
+    int status = (fflush(analyzer.out) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    if (analyzer.out != stdout)
+        fclose(analyzer.out);
+    if (in != stdin)
+        fclose(in);
+    pthread_cond_destroy(&analyzer.changed);
+    pthread_mutex_destroy(&analyzer.lock);
+    for (int i = 0; i < analyzer.capacity; i++)
+        free(analyzer.slots[i].output);
+    for (long t = 0; t < threads; t++)
+        scrabblePositionFree(workers[t].position);
+    free(analyzer.slots);
+    free(workers);
+    free(tids);
+    scrabbleEngineFree(engine);
+    return status;
+}
@@ -0,0 +1,592 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "board.h"            // Plateau et règles (disposition des bonus)
+#include "dictionary.h"       // Chargement du dictionnaire
+#include "lexicon.h"          // Arbre lexical partagé par tous les threads
+#include "movegen.h"          // Génération de tous les coups légaux
+#include "leave.h"            // Table des valeurs de reliquat
+#include "record.h"           // Parties enregistrées et rejeu
+#include "inference.h"        // Lettres invisibles et reliquat adverse probable
+
+#include <pthread.h>
+#include <unistd.h>
+
+//
+// ---------------------- Annotation des parties enregistrées -----------------
+//
+// Rejoue chaque tour de chaque partie (.scg) et le compare au meilleur coup du moteur :
+// rang du coup joué parmi tous les coups légaux et perte d'équité. Chaque tour est une
+// tâche (partie, tour) distribuée à un groupe de threads qui partagent le même arbre
+// lexical et la même table de reliquats, en lecture seule. Les résultats sont écrits au fil
+// de l'eau en JSON Lines, dans l'ordre des parties et des tours, suivis d'un bilan par
+// partie.
+//
+// L'équité d'un coup est son score plus la valeur du reliquat conservé (score seul sans
+// table de reliquats) ; celle d'un échange est la valeur du reliquat, celle d'un passe 0.
+//
+// Avec -i, chaque coup posé est aussi vu par le joueur suivant : ses lettres invisibles sont
+// reconstituées depuis l'historique, puis le reliquat de l'auteur du coup est inféré (poids
+// exp(-beta * regret)). Le reliquat le plus probable et la probabilité donnée au vrai
+// reliquat mesurent la qualité de l'inférence.
+//
+
+#define ANNOTATE_MAX_THREADS 256
+#define ANNOTATE_MAX_PATH    1024
+#define ANNOTATE_EPSILON     1e-3f    // Écart d'équité en deçà duquel deux coups sont égaux
+
+// Tour à annoter
+typedef struct {
+    int game;
+    int turn;
+} Task;
+
+// Résultat d'un tour, encodé par le thread qui écrit
+typedef struct {
+    bool done;
+    bool legal;          // Coup joué retrouvé parmi les coups générés
+    bool hasBest;        // Au moins un coup légal
+    int rank;            // Rang du coup joué (1 : meilleur coup)
+    int moveCount;       // Nombre de coups légaux distincts
+    float playedEquity;
+    Move best;
+    bool inferred;       // Reliquat de l'auteur du coup inféré (option -i)
+    char inferredLeave[RECORD_RACK_SIZE];
+    float inferredProb;  // Probabilité du reliquat le plus probable
+    float actualProb;    // Probabilité donnée au vrai reliquat
+} TaskResult;
+
+// Bilan d'un joueur sur la partie en cours d'écriture
+typedef struct {
+    int turns;
+    int bestCount;       // Tours où le coup joué est (à égalité) le meilleur
+    double loss;         // Somme des pertes d'équité
+} PlayerSummary;
+
+typedef struct {
+    const Lexicon *lexicon;
+    const LeaveTable *leaves;
+    double inferenceBeta;          // Sévérité de l'inférence (0 : pas d'inférence)
+    GameRecord *games;
+    char **paths;
+    int gameCount;
+    Task *tasks;
+    TaskResult *results;
+    int taskCount;
+    int nextTask;                  // Prochaine tâche confiée à un thread (atomique)
+    int nextWrite;                 // Prochaine tâche écrite (verrou)
+    PlayerSummary summary[RECORD_MAX_PLAYERS];
+    FILE *out;
+    pthread_mutex_t lock;
+} Annotator;
+
+// Contexte d'un thread : plateau, coups et position rejouée qui lui sont propres
+typedef struct {
+    Annotator *annotator;
+    char **board;
+    int boardSize;
+    BonusBoard bonus;
+    MoveList list;
+    ReplayState state;
+    RackInference inference;
+} Worker;
+
+//
+// Analyse d'un tour
+//
+
+// Vrai pour la version verticale d'un coup d'une lettre déjà produit horizontalement
+static bool isMirroredSingle(char **board, int boardSize, const Move *move) {
+    if (move->tilesUsed != 1 || move->dir != 'v')
+        return false;
+    int x = move->x;
+    for (int y = move->y; move->word[y - move->y] != '\0'; y++) {
+        if (board[y][x] != ' ')
+            continue;
+        return (x > 0 && board[y][x - 1] != ' ') || (x < boardSize - 1 && board[y][x + 1] != ' ');
+    }
+    return false;
+}
+
+// Vrai si le coup pose exactement les lettres données sur les cases données
+static bool samePlacement(char **board, int boardSize, const Move *move, const int *cells,
+                          const char *letters, int count) {
+    if (move->tilesUsed != count)
+        return false;
+    int n = 0;
+    for (int i = 0; move->word[i] != '\0'; i++) {
+        int x = move->x + (move->dir == 'h' ? i : 0);
+        int y = move->y + (move->dir == 'v' ? i : 0);
+        if (board[y][x] != ' ')
+            continue;
+        if (n == count || cells[n] != y * boardSize + x || letters[n] != move->word[i])
+            return false;
+        n++;
+    }
+    return n == count;
+}
+
+// Valeur du reliquat conservé : rack moins les lettres jouées ou échangées
+static float keptLeaveValue(const LeaveTable *leaves, const char *rack, const char *used) {
+    if (!leaves)
+        return 0.0f;
+    char remaining[RECORD_RACK_SIZE];
+    strcpy(remaining, used);
+    int kept[RULESET_MAX_RACK];
+    int count = 0;
+    for (int i = 0; rack[i] != '\0' && i < RULESET_MAX_RACK; i++) {
+        char *u = strchr(remaining, rack[i]);
+        if (u) {
+            *u = '#';
+            continue;
+        }
+        int s = leaveSymbol(rack[i]);
+        if (s < 0)
+            continue;
+        if (count == LEAVE_MAX_TILES)
+            return 0.0f;   // Rack complet conservé (passe) : aucune valeur en table
+        int j = count++;
+        while (j > 0 && kept[j - 1] > s) {
+            kept[j] = kept[j - 1];
+            j--;
+        }
+        kept[j] = s;
+    }
+    return leaves->values[leaveRank(kept, count)];
+}
+
+// Rack d'un joueur au tour turn : celui d'avant son prochain tour, sinon celui d'après son dernier
+static void rackAtTurn(const GameRecord *game, int turn, int player, char rack[RECORD_RACK_SIZE]) {
+    rack[0] = '\0';
+    for (int i = turn; i < game->count; i++)
+        if (game->moves[i].player == player && game->moves[i].type != RECORD_END_RACK) {
+            strcpy(rack, game->moves[i].rackBefore);
+            return;
+        }
+    for (int i = turn - 1; i >= 0; i--)
+        if (game->moves[i].player == player && game->moves[i].type != RECORD_END_RACK) {
+            recordRackAfter(&game->moves[i], rack);
+            return;
+        }
+}
+
+// Range les lettres d'un reliquat dans l'ordre des candidats de l'inférence
+static void sortLeave(char *leave) {
+    for (int i = 1; leave[i] != '\0'; i++)
+        for (int j = i; j > 0 && leave[j - 1] > leave[j]; j--) {
+            char c = leave[j];
+            leave[j] = leave[j - 1];
+            leave[j - 1] = c;
+        }
+}
+
+/*
+ * Fonction : inferLeave
+ * ---------------------
+ * Infère le reliquat de l'auteur d'un coup posé, du point de vue du joueur suivant : lettres
+ * invisibles reconstituées depuis l'historique, puis reliquats candidats pondérés par le coup
+ * joué sur le plateau d'avant le coup (worker->board).
+ */
+static void inferLeave(Worker *worker, const GameRecord *game, int turn, TaskResult *result) {
+    const Annotator *annotator = worker->annotator;
+    const RecordMove *played = &game->moves[turn];
+    int viewer = (played->player + 1) % game->playerCount;
+    char viewerRack[RECORD_RACK_SIZE];
+    rackAtTurn(game, turn + 1, viewer, viewerRack);
+
+    // Lettres posées (minuscule : joker, '?' dans le rack) et vrai reliquat
+    char placed[RECORD_RACK_SIZE], actual[RECORD_RACK_SIZE];
+    int n = 0;
+    for (int i = 0; played->tiles[i] != '\0'; i++)
+        placed[n++] = islower((unsigned char)played->tiles[i]) ? '?' : played->tiles[i];
+    placed[n] = '\0';
+    strcpy(actual, played->rackBefore);
+    for (int i = 0; placed[i] != '\0'; i++) {
+        char *tile = strchr(actual, placed[i]);
+        if (tile)
+            memmove(tile, tile + 1, strlen(tile));
+    }
+    sortLeave(actual);
+
+    UnseenTracker tracker;
+    unseenFromHistory(&tracker, game->moves, turn + 1, viewerRack);
+    RackInference *inference = &worker->inference;
+    inferenceInit(inference, &tracker, strlen(played->rackBefore));
+    uint64_t seed = (uint64_t)turn * 1000003u + (uint64_t)(game - annotator->games) + 1;
+    int count = inferenceWeigh(inference, annotator->lexicon, worker->board, worker->boardSize,
+                               worker->bonus, annotator->leaves, placed, played->score,
+                               annotator->inferenceBeta, seed, &worker->list);
+    if (count == 0)
+        return;
+
+    // Probabilité de chaque reliquat distinct : somme des poids de ses tirages
+    double total = 0.0, best = -1.0, actualWeight = 0.0;
+    for (int c = 0; c < count; c++)
+        total += inference->weights[c];
+    for (int c = 0; c < count; c++) {
+        bool seen = false;
+        for (int p = 0; p < c && !seen; p++)
+            seen = strcmp(inference->leaves[p], inference->leaves[c]) == 0;
+        if (seen)
+            continue;
+        double weight = 0.0;
+        for (int d = c; d < count; d++)
+            if (strcmp(inference->leaves[d], inference->leaves[c]) == 0)
+                weight += inference->weights[d];
+        if (weight > best) {
+            best = weight;
+            strcpy(result->inferredLeave, inference->leaves[c]);
+        }
+        if (strcmp(inference->leaves[c], actual) == 0)
+            actualWeight = weight;
+    }
+    result->inferred = true;
+    result->inferredProb = best / total;
+    result->actualProb = actualWeight / total;
+}
+
+/*
+ * Fonction : annotateTurn
+ * -----------------------
+ * Reconstitue la position avant le tour, génère tous les coups du rack et situe le coup
+ * joué : rang, équité et meilleur coup.
+ */
+static void annotateTurn(Worker *worker, const Task *task, TaskResult *result) {
+    const Annotator *annotator = worker->annotator;
+    const GameRecord *game = &annotator->games[task->game];
+    const RecordMove *played = &game->moves[task->turn];
+    ReplayState *state = &worker->state;
+    memset(result, 0, sizeof(TaskResult));
+    if (replayTo(game, task->turn, state) != 0)
+        return;
+    int size = worker->boardSize;
+    for (int y = 0; y < size; y++)
+        memcpy(worker->board[y], &state->cells[y * size], size);
+
+    // Cases et lettres posées par le coup joué, dans l'ordre du plateau
+    int cells[RULESET_MAX_RACK];
+    char letters[RULESET_MAX_RACK];
+    int placed = 0;
+    if (played->type == RECORD_PLAY) {
+        ReplayState after = *state;
+        if (replayStep(&after, played) != 0)
+            return;
+        for (int i = 0; i < size * size && placed < RULESET_MAX_RACK; i++) {
+            if (after.cells[i] != state->cells[i]) {
+                cells[placed] = i;
+                letters[placed++] = after.cells[i];
+            }
+        }
+    }
+
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    if (annotator->leaves)
+        leavePrepareRack(annotator->leaves, played->rackBefore, rackLeaves);
+    generateMoves(annotator->lexicon, worker->board, size, worker->bonus, played->rackBefore,
+                  isBoardEmpty(worker->board, size), annotator->leaves ? rackLeaves : NULL,
+                  &worker->list);
+
+    const char *used = (played->type == RECORD_PASS) ? "" : played->tiles;
+    result->playedEquity = played->score + keptLeaveValue(annotator->leaves, played->rackBefore, used);
+    for (int i = 0; placed > 0 && i < worker->list.count; i++) {
+        const Move *move = &worker->list.moves[i];
+        if (samePlacement(worker->board, size, move, cells, letters, placed)) {
+            result->legal = true;
+            result->playedEquity = move->equity;
+            break;
+        }
+    }
+
+    int best = bestMoveIndex(&worker->list);
+    result->hasBest = best >= 0;
+    if (result->hasBest)
+        result->best = worker->list.moves[best];
+    result->rank = 1;
+    for (int i = 0; i < worker->list.count; i++) {
+        const Move *move = &worker->list.moves[i];
+        if (isMirroredSingle(worker->board, size, move))
+            continue;
+        result->moveCount++;
+        if (move->equity > result->playedEquity + ANNOTATE_EPSILON)
+            result->rank++;
+    }
+
+    if (annotator->inferenceBeta > 0.0 && placed > 0 && game->playerCount > 1)
+        inferLeave(worker, game, task->turn, result);
+}
+
+//
+// Écriture ordonnée des résultats
+//
+
+static const char *turnTypeName(int type) {
+    switch (type) {
+        case RECORD_PLAY:     return "play";
+        case RECORD_EXCHANGE: return "exchange";
+        default:              return "pass";
+    }
+}
+
+// Écrit le résultat d'une tâche et met à jour le bilan de la partie (verrou tenu)
+static void writeResult(Annotator *annotator, int index) {
+    const Task *task = &annotator->tasks[index];
+    const TaskResult *result = &annotator->results[index];
+    const GameRecord *game = &annotator->games[task->game];
+    const RecordMove *played = &game->moves[task->turn];
+    FILE *out = annotator->out;
+
+    float loss = result->hasBest ? result->best.equity - result->playedEquity : 0.0f;
+    if (loss < 0.0f)
+        loss = 0.0f;   // Échange ou passe meilleur que tout coup posé
+    fprintf(out, "{\"game\":\"%s\",\"turn\":%d,\"player\":\"%s\",\"type\":\"%s\",\"rack\":\"%s\","
+                 "\"played\":{\"tiles\":\"%s\"",
+            annotator->paths[task->game], task->turn + 1, game->names[played->player],
+            turnTypeName(played->type), played->rackBefore, played->tiles);
+    if (played->type == RECORD_PLAY)
+        fprintf(out, ",\"x\":%d,\"y\":%d,\"dir\":\"%c\",\"legal\":%s", played->x, played->y,
+                played->dir, result->legal ? "true" : "false");
+    fprintf(out, ",\"score\":%d,\"equity\":%.3f},\"rank\":%d,\"moves\":%d", played->score,
+            result->playedEquity, result->rank, result->moveCount);
+    if (result->hasBest)
+        fprintf(out, ",\"best\":{\"word\":\"%s\",\"x\":%d,\"y\":%d,\"dir\":\"%c\",\"score\":%d,"
+                     "\"equity\":%.3f}",
+                result->best.word, result->best.x, result->best.y, result->best.dir,
+                result->best.score, result->best.equity);
+    if (result->inferred)
+        fprintf(out, ",\"inferred\":{\"leave\":\"%s\",\"p\":%.3f,\"actual_p\":%.3f}",
+                result->inferredLeave, result->inferredProb, result->actualProb);
+    fprintf(out, ",\"loss\":%.3f}\n", loss);
+
+    PlayerSummary *summary = &annotator->summary[played->player];
+    summary->turns++;
+    summary->bestCount += (result->rank == 1);
+    summary->loss += loss;
+
+    // Dernier tour de la partie : bilan par joueur
+    if (index + 1 == annotator->taskCount || annotator->tasks[index + 1].game != task->game) {
+        fprintf(out, "{\"game\":\"%s\",\"summary\":[", annotator->paths[task->game]);
+        for (int p = 0; p < game->playerCount; p++) {
+            const PlayerSummary *s = &annotator->summary[p];
+            fprintf(out, "%s{\"player\":\"%s\",\"turns\":%d,\"best\":%d,\"loss\":%.3f,\"mean_loss\":%.3f}",
+                    p ? "," : "", game->names[p], s->turns, s->bestCount, s->loss,
+                    s->turns ? s->loss / s->turns : 0.0);
+        }
+        fprintf(out, "]}\n");
+        memset(annotator->summary, 0, sizeof(annotator->summary));
+    }
+}
+
+static void *workerMain(void *arg) {
+    Worker *worker = arg;
+    Annotator *annotator = worker->annotator;
+    for (;;) {
+        int index = __atomic_fetch_add(&annotator->nextTask, 1, __ATOMIC_RELAXED);
+        if (index >= annotator->taskCount)
+            break;
+        annotateTurn(worker, &annotator->tasks[index], &annotator->results[index]);
+
+        // Écrit toutes les tâches terminées qui suivent la dernière écrite
+        pthread_mutex_lock(&annotator->lock);
+        annotator->results[index].done = true;
+        while (annotator->nextWrite < annotator->taskCount &&
+               annotator->results[annotator->nextWrite].done) {
+            writeResult(annotator, annotator->nextWrite);
+            annotator->nextWrite++;
+        }
+        pthread_mutex_unlock(&annotator->lock);
+    }
+    return NULL;
+}
+
+//
+// Chargement des parties
+//
+
+// Ajoute une partie et ses tours annotables ; retourne -1 en cas d'erreur d'allocation
+static int addGame(Annotator *annotator, const char *path, int *gameCapacity, int *taskCapacity) {
+    GameRecord record;
+    if (loadGameRecord(&record, path) != 0)
+        return 0;   // Partie ignorée (message déjà affiché)
+    if (record.boardSize != currentRules->boardSize) {
+        fprintf(stderr, "%s : plateau %dx%d différent de celui des règles (-R)\n", path,
+                record.boardSize, record.boardSize);
+        freeGameRecord(&record);
+        return 0;
+    }
+    if (annotator->gameCount == *gameCapacity) {
+        int capacity = *gameCapacity ? *gameCapacity * 2 : 256;
+        GameRecord *games = realloc(annotator->games, capacity * sizeof(GameRecord));
+        char **paths = games ? realloc(annotator->paths, capacity * sizeof(char *)) : NULL;
+        if (games)
+            annotator->games = games;
+        if (paths)
+            annotator->paths = paths;
+        if (!games || !paths) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            freeGameRecord(&record);
+            return -1;
+        }
+        *gameCapacity = capacity;
+    }
+    int game = annotator->gameCount;
+    for (int turn = 0; turn < record.count; turn++) {
+        const RecordMove *move = &record.moves[turn];
+        if (move->type == RECORD_END_RACK || move->rackBefore[0] == '\0')
+            continue;
+        if (annotator->taskCount == *taskCapacity) {
+            int capacity = *taskCapacity ? *taskCapacity * 2 : 4096;
+            Task *tasks = realloc(annotator->tasks, capacity * sizeof(Task));
+            if (!tasks) {
+                fprintf(stderr, "Erreur d'allocation mémoire.\n");
+                freeGameRecord(&record);
+                return -1;
+            }
+            annotator->tasks = tasks;
+            *taskCapacity = capacity;
+        }
+        annotator->tasks[annotator->taskCount].game = game;
+        annotator->tasks[annotator->taskCount].turn = turn;
+        annotator->taskCount++;
+    }
+    annotator->games[game] = record;
+    annotator->paths[game] = strdup(path);
+    annotator->gameCount++;
+    return annotator->paths[game] ? 0 : -1;
+}
+
+static double elapsedSeconds(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-l reliquats.bin] [-R règles] [-j threads] [-o sortie]\n"
+            "          [-i beta] [partie.scg... | -]\n"
+            "  -R : fichier de règles des parties, règles standard par défaut\n"
+            "  -i : infère le reliquat de l'auteur de chaque coup posé (sévérité beta, ex. 0.5)\n"
+            "  sans partie ou avec '-' : chemins des parties lus sur l'entrée standard\n",
+            prog);
+}
+
+// Fonction principale de l'annotateur
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *leavesFile = NULL;
+    const char *outputFile = NULL;
+    const char *rulesFile = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    Annotator annotator;
+    memset(&annotator, 0, sizeof(annotator));
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:l:R:j:o:i:h")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'l': leavesFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 'j': threads = strtol(optarg, NULL, 10); break;
+            case 'o': outputFile = optarg; break;
+            case 'i': annotator.inferenceBeta = atof(optarg); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > ANNOTATE_MAX_THREADS)
+        threads = ANNOTATE_MAX_THREADS;
+    Ruleset *rules = NULL;
+    if (rulesFile && !(rules = loadRuleset(rulesFile)))
+        return EXIT_FAILURE;
+    useRuleset(rules);
+
+    // Parties : arguments, ou un chemin par ligne sur l'entrée standard
+    int gameCapacity = 0, taskCapacity = 0;
+    if (optind == argc || (optind == argc - 1 && strcmp(argv[optind], "-") == 0)) {
+        char path[ANNOTATE_MAX_PATH];
+        while (fgets(path, sizeof(path), stdin)) {
+            path[strcspn(path, "\r\n")] = '\0';
+            if (path[0] != '\0' && addGame(&annotator, path, &gameCapacity, &taskCapacity) != 0)
+                return EXIT_FAILURE;
+        }
+    } else {
+        for (int i = optind; i < argc; i++)
+            if (addGame(&annotator, argv[i], &gameCapacity, &taskCapacity) != 0)
+                return EXIT_FAILURE;
+    }
+
+    // Arbre lexical et table de reliquats : construits une fois, partagés en lecture seule
+    DictionaryEntry *dictionary = loadDictionaryHash(dictionaryFile);
+    if (!dictionary)
+        return EXIT_FAILURE;
+    Lexicon *lexicon = buildLexicon(dictionary);
+    freeDictionaryHash(dictionary);
+    if (!lexicon)
+        return EXIT_FAILURE;
+    LeaveTable *leaves = NULL;
+    if (leavesFile && !(leaves = loadLeaveTable(leavesFile)))
+        return EXIT_FAILURE;
+    annotator.lexicon = lexicon;
+    annotator.leaves = leaves;
+
+    annotator.out = stdout;
+    if (outputFile && !(annotator.out = fopen(outputFile, "w"))) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", outputFile);
+        return EXIT_FAILURE;
+    }
+
+    annotator.results = calloc(annotator.taskCount > 0 ? annotator.taskCount : 1, sizeof(TaskResult));
+    Worker *workers = calloc(threads, sizeof(Worker));
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    bool ok = annotator.results && workers && tids;
+    for (long t = 0; ok && t < threads; t++) {
+        workers[t].annotator = &annotator;
+        workers[t].boardSize = currentRules->boardSize;
+        initBonusBoard(workers[t].bonus);
+        initMoveList(&workers[t].list);
+        ok = (workers[t].board = initBoard(workers[t].boardSize)) != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return EXIT_FAILURE;
+    }
+    pthread_mutex_init(&annotator.lock, NULL);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long started = 0;
+    for (long t = 0; t < threads; t++)
+        if (pthread_create(&tids[t], NULL, workerMain, &workers[t]) == 0)
+            started++;
+    if (started == 0)
+        workerMain(&workers[0]);
+    for (long t = 0; t < started; t++)
+        pthread_join(tids[t], NULL);
+    double seconds = elapsedSeconds(&start);
+    fprintf(stderr, "%d parties, %d tours en %.3f s (%.0f tours/s, %ld threads)\n",
+            annotator.gameCount, annotator.taskCount, seconds,
+            seconds > 0 ? annotator.taskCount / seconds : 0.0, threads);
+
+    int status = (fflush(annotator.out) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    if (annotator.out != stdout)
+        fclose(annotator.out);
+    pthread_mutex_destroy(&annotator.lock);
+    for (long t = 0; t < threads; t++) {
+        freeMoveList(&workers[t].list);
+        freeBoard(workers[t].board, workers[t].boardSize);
+    }
+    for (int g = 0; g < annotator.gameCount; g++) {
+        freeGameRecord(&annotator.games[g]);
+        free(annotator.paths[g]);
+    }
+    free(annotator.games);
+    free(annotator.paths);
+    free(annotator.tasks);
+    free(annotator.results);
+    free(workers);
+    free(tids);
+    freeLeaveTable(leaves);
+    freeLexicon(lexicon);
+    freeRuleset(rules);
+    return status;
+}
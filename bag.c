@@ -0,0 +1,146 @@
+#include "bag.h"
+#include "board.h"
+
+//
+// ---------------------- Sac de lettres --------------------------------------
+//
+
+/*
+ * Fonction : nextRandom
+ * ---------------------
+ * Générateur xorshift64* : rapide, sans état global, donc utilisable par plusieurs
+ * threads tant que chacun possède son propre état.
+ *
+ * Paramètre :
+ *   state : état du générateur (ne doit jamais valoir 0).
+ *
+ * Retour :
+ *   Un entier pseudo-aléatoire sur 64 bits.
+ */
+uint64_t nextRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+ * Fonction : bagInit
+ * ------------------
+ * Remplit le sac avec la distribution des lettres des règles en vigueur.
+ *
+ * Paramètres :
+ *   bag  : le sac à initialiser.
+ *   seed : graine du générateur (une même graine donne la même suite de tirages).
+ */
+void bagInit(Bag *bag, uint64_t seed) {
+    bag->total = 0;
+    for (int i = 0; i < LEAVE_ALPHABET; i++) {
+        bag->counts[i] = currentRules->counts[i];
+        bag->total += bag->counts[i];
+    }
+    // Mélange la graine (splitmix64) pour que des graines voisines donnent des suites distinctes
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    bag->rng = z ? z : 1;
+}
+
+/*
+ * Fonction : bagDraw
+ * ------------------
+ * Tire une lettre sans remise.
+ *
+ * Retour :
+ *   La lettre tirée ('?' pour un joker), ou '\0' si le sac est vide.
+ */
+char bagDraw(Bag *bag) {
+    if (bag->total <= 0)
+        return '\0';
+    int r = (int)(nextRandom(&bag->rng) % (uint64_t)bag->total);
+    for (int i = 0; i < LEAVE_ALPHABET; i++) {
+        if (r < bag->counts[i]) {
+            bag->counts[i]--;
+            bag->total--;
+            return (i == LEAVE_BLANK) ? '?' : 'A' + i;
+        }
+        r -= bag->counts[i];
+    }
+    return '\0'; // Ne devrait jamais arriver
+}
+
+void bagReturn(Bag *bag, char letter) {
+    int s = leaveSymbol(letter);
+    if (s < 0)
+        return;
+    bag->counts[s]++;
+    bag->total++;
+}
+
+/*
+ * Fonction : bagFillRack
+ * ----------------------
+ * Complète le rack (chaîne terminée par '\0') jusqu'à la taille du chevalet des règles en
+ * vigueur, tant que le sac n'est pas vide.
+ *
+ * Retour :
+ *   Le nombre de lettres tirées.
+ */
+int bagFillRack(Bag *bag, char *rack) {
+    int rackSize = currentRules->rackSize;
+    int len = strnlen(rack, rackSize);
+    int drawn = 0;
+    while (len < rackSize && bag->total > 0) {
+        rack[len++] = bagDraw(bag);
+        drawn++;
+    }
+    rack[len] = '\0';
+    return drawn;
+}
+
+/*
+ * Fonction : countUnseenTilesWithRules
+ * ------------------------------------
+ * Compte, pour chaque symbole, les lettres que le joueur ne voit pas : celles de la
+ * distribution complète des règles qui ne sont ni sur le plateau ni sur son rack.
+ *
+ * Paramètres :
+ *   rules     : les règles (distribution des lettres).
+ *   board     : le plateau de jeu.
+ *   boardSize : taille du plateau.
+ *   rack      : le rack du joueur (terminé par '\0').
+ *   unseen    : tableau de sortie (LEAVE_ALPHABET compteurs).
+ *
+ * Retour :
+ *   Le nombre total de lettres invisibles.
+ */
+int countUnseenTilesWithRules(const Ruleset *rules, char **board, int boardSize, const char *rack,
+                              int unseen[LEAVE_ALPHABET]) {
+    int total = 0;
+    for (int i = 0; i < LEAVE_ALPHABET; i++)
+        unseen[i] = rules->counts[i];
+    for (int y = 0; y < boardSize; y++) {
+        for (int x = 0; x < boardSize; x++) {
+            char c = board[y][x];
+            int s = (c >= 'a' && c <= 'z') ? LEAVE_BLANK : leaveSymbol(c);   // Minuscule : joker
+            if (s >= 0 && unseen[s] > 0)
+                unseen[s]--;
+        }
+    }
+    for (int i = 0; rack[i] != '\0'; i++) {
+        int s = leaveSymbol(rack[i]);
+        if (s >= 0 && unseen[s] > 0)
+            unseen[s]--;
+    }
+    for (int i = 0; i < LEAVE_ALPHABET; i++)
+        total += unseen[i];
+    return total;
+}
+
+// Décompte sur la distribution des règles du processus
+int countUnseenTiles(char **board, int boardSize, const char *rack, int unseen[LEAVE_ALPHABET]) {
+    return countUnseenTilesWithRules(currentRules, board, boardSize, rack, unseen);
+}
@@ -0,0 +1,37 @@
+#ifndef BAG_H
+#define BAG_H
+
+#include "scrabble.h"
+#include "leave.h"
+#include "ruleset.h"
+
+// Sac de lettres réel (tirage sans remise), avec son propre générateur pseudo-aléatoire
+// pour que chaque partie soit reproductible et que plusieurs threads puissent jouer en parallèle.
+typedef struct {
+    int counts[LEAVE_ALPHABET];  // Lettres restantes par symbole ('A'..'Z', joker)
+    int total;                   // Nombre total de lettres restantes
+    uint64_t rng;                // État du générateur (xorshift64*)
+} Bag;
+
+// Générateur pseudo-aléatoire (xorshift64*) utilisé par le sac
+uint64_t nextRandom(uint64_t *state);
+
+// Remplit le sac selon la distribution des règles en vigueur et initialise le générateur
+void bagInit(Bag *bag, uint64_t seed);
+
+// Tire une lettre au hasard ('\0' si le sac est vide)
+char bagDraw(Bag *bag);
+
+// Remet une lettre dans le sac
+void bagReturn(Bag *bag, char letter);
+
+// Complète le rack jusqu'à la taille du chevalet ; retourne le nombre de lettres tirées
+int bagFillRack(Bag *bag, char *rack);
+
+// Compte les lettres invisibles (sac + rack adverse) : distribution - plateau - rack
+int countUnseenTiles(char **board, int boardSize, const char *rack, int unseen[LEAVE_ALPHABET]);
+// Même décompte sur la distribution de règles données
+int countUnseenTilesWithRules(const Ruleset *rules, char **board, int boardSize, const char *rack,
+                              int unseen[LEAVE_ALPHABET]);
+
+#endif  // BAG_H
@@ -0,0 +1,651 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "board.h"            // Plateau, validation et score de référence
+#include "dictionary.h"       // Chargement du dictionnaire et recherche par hachage
+#include "bestmove.h"         // Recherche exhaustive du meilleur coup
+#include "lexicon.h"          // Arbre lexical utilisé par le générateur
+#include "movegen.h"          // Génération de tous les coups légaux
+#include "leave.h"            // Table des valeurs de reliquat
+#include "bag.h"              // Lettres invisibles d'une position
+#include "endgame.h"          // Finale et pré-finale
+#ifdef BENCH_RENDER
+#include "graphics.h"         // Rendu d'une image complète (banc avec SDL)
+#endif
+
+#include <unistd.h>
+
+//
+// ---------------------- Banc d'essai du moteur ------------------------------
+//
+// Mesure chaque opération du moteur sur un corpus fixe de positions (plateau vide,
+// ouverture, milieu de partie, finale dense) : chargement du dictionnaire, recherches
+// dans la table de hachage, contraintes des mots croisés et génération des coups (noyaux
+// spécialisés, puis génériques dans les cas *_generic), latence de l'indice, validation et
+// score de référence, recherche exhaustive, finale et pré-finale (catégories finale et
+// prefinale) et, compilé avec BENCH_RENDER, rendu d'une image.
+// Le corpus suit les règles en vigueur (-R) : bench_corpus.txt pour le plateau standard,
+// bench_corpus_super.txt pour le plateau 21 x 21 de regles_super.txt. Chaque cas est
+// répété après quelques tours d'échauffement et les percentiles de la durée par opération
+// sont écrits en texte ou en JSON Lines (un objet par cas), pour être comparés d'un commit
+// à l'autre.
+//
+
+#define BENCH_MAX_POSITIONS 256
+#define BENCH_MAX_CATEGORY  16
+#define BENCH_LOOKUPS       4096    // Mots cherchés par répétition (succès et échecs)
+#define BENCH_VALIDATED     16      // Coups revalidés par position (chemin de référence)
+#define BENCH_ENDGAME_BUDGET_MS 1000.0  // Budget d'une finale (arrêt dès qu'elle est résolue)
+
+// Position du corpus
+typedef struct {
+    char category[BENCH_MAX_CATEGORY];
+    char **board;
+    BonusBoard bonusBoard;
+    char rack[8];
+    bool firstMove;
+} BenchPosition;
+
+// Données partagées par tous les cas
+typedef struct {
+    const char *dictionaryFile;
+    DictionaryEntry *dictionary;
+    Lexicon *lexicon;
+    LeaveTable *leaves;
+    int boardSize;                 // Taille du plateau des règles en vigueur (corpus compris)
+    BenchPosition positions[BENCH_MAX_POSITIONS];
+    int positionCount;
+    char (*hitWords)[16];          // Mots du dictionnaire
+    char (*missWords)[16];         // Mots absents (une lettre modifiée)
+    MoveList moves;
+    const char *category;          // Catégorie du cas en cours (NULL : toutes)
+#ifdef BENCH_RENDER
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    GlyphAtlas atlas;
+    RenderCache cache;
+#endif
+} BenchContext;
+
+// Un cas : exécute une répétition et retourne le nombre d'opérations effectuées
+typedef long (*BenchFunction)(BenchContext *ctx);
+
+// Options de mesure
+typedef struct {
+    int warmup;
+    int reps;
+    bool json;
+    const char *filter;            // Sous-chaîne du nom des cas à exécuter (NULL : tous)
+} BenchOptions;
+
+// Les cas marqués BENCH_ON_DEMAND ne tournent que si le filtre les désigne (-k)
+#define BENCH_ON_DEMAND true
+
+// Empêche le compilateur d'éliminer les résultats des cas
+static volatile long benchSink;
+
+static double nowNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+//
+// Corpus
+//
+
+// Lit le corpus ; retourne le nombre de positions, -1 en cas d'erreur
+static int loadCorpus(BenchContext *ctx, const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
+        return -1;
+    }
+    char line[1024];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), fp) && ctx->positionCount < BENCH_MAX_POSITIONS) {
+        lineNumber++;
+        char category[BENCH_MAX_CATEGORY], cells[512], rack[64];
+        int end = 0;
+        if (line[0] == '#' || sscanf(line, "%15s %511s %63s %n", category, cells, rack, &end) != 3)
+            continue;
+        BenchPosition *pos = &ctx->positions[ctx->positionCount];
+        int size = ctx->boardSize;
+        pos->board = initBoard(size);
+        if (!pos->board) {
+            fclose(fp);
+            return -1;
+        }
+        initBonusBoard(pos->bonusBoard);
+        // Les cases en trop sont comptées sans être posées : une ligne trop longue est refusée
+        int n = 0;
+        bool valid = line[end] == '\0';
+        for (const char *p = cells; *p != '\0'; p++) {
+            if (*p == '/')
+                continue;
+            char c = (*p == '.') ? ' ' : *p;   // Minuscule : joker
+            if (c != ' ' && !isalpha((unsigned char)c))
+                valid = false;
+            if (n < size * size) {
+                pos->board[n / size][n % size] = c;
+                if (c != ' ')
+                    pos->bonusBoard[n / size][n % size] = 0;
+            }
+            n++;
+        }
+        if (!valid || n != size * size || strlen(rack) > (size_t)currentRules->rackSize) {
+            fprintf(stderr, "Erreur : position invalide ligne %d de %s\n", lineNumber, filename);
+            freeBoard(pos->board, size);
+            fclose(fp);
+            return -1;
+        }
+        memcpy(pos->category, category, sizeof(category));
+        for (int i = 0; rack[i] != '\0'; i++)
+            pos->rack[i] = toupper((unsigned char)rack[i]);
+        pos->rack[strlen(rack)] = '\0';
+        pos->firstMove = isBoardEmpty(pos->board, size);
+        ctx->positionCount++;
+    }
+    fclose(fp);
+    return ctx->positionCount;
+}
+
+// Mots présents et absents, tirés du dictionnaire de façon reproductible
+static int prepareLookups(BenchContext *ctx) {
+    ctx->hitWords = malloc(BENCH_LOOKUPS * sizeof(*ctx->hitWords));
+    ctx->missWords = malloc(BENCH_LOOKUPS * sizeof(*ctx->missWords));
+    if (!ctx->hitWords || !ctx->missWords) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return -1;
+    }
+    int total = HASH_COUNT(ctx->dictionary);
+    int stride = total / BENCH_LOOKUPS > 0 ? total / BENCH_LOOKUPS : 1;
+    int n = 0, index = 0;
+    DictionaryEntry *entry, *tmp;
+    HASH_ITER(hh, ctx->dictionary, entry, tmp) {
+        if (index++ % stride != 0 || strlen(entry->word) >= 16)
+            continue;
+        strcpy(ctx->hitWords[n], entry->word);
+        // Dernière lettre décalée : mot de même longueur, presque toujours absent
+        strcpy(ctx->missWords[n], entry->word);
+        size_t len = strlen(entry->word);
+        char *last = &ctx->missWords[n][len - 1];
+        *last = (*last >= 'A' && *last <= 'Z') ? 'A' + (*last - 'A' + 7) % 26 : 'Q';
+        if (++n == BENCH_LOOKUPS)
+            break;
+    }
+    // Complète en réutilisant les premiers mots si le dictionnaire est petit
+    for (int i = n; n > 0 && i < BENCH_LOOKUPS; i++) {
+        strcpy(ctx->hitWords[i], ctx->hitWords[i % n]);
+        strcpy(ctx->missWords[i], ctx->missWords[i % n]);
+    }
+    return n > 0 ? 0 : -1;
+}
+
+static bool inCategory(const BenchContext *ctx, const BenchPosition *pos) {
+    return !ctx->category || strcmp(ctx->category, pos->category) == 0;
+}
+
+//
+// Cas mesurés
+//
+
+static long benchDictionaryLoad(BenchContext *ctx) {
+    DictionaryEntry *dictionary = loadDictionaryHash(ctx->dictionaryFile);
+    benchSink += HASH_COUNT(dictionary);
+    freeDictionaryHash(dictionary);
+    return 1;
+}
+
+static long benchLexiconBuild(BenchContext *ctx) {
+    Lexicon *lexicon = buildLexicon(ctx->dictionary);
+    benchSink += lexicon ? lexicon->count : 0;
+    freeLexicon(lexicon);
+    return 1;
+}
+
+static long benchHashHit(BenchContext *ctx) {
+    long found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++)
+        found += isValidWordHash(ctx->hitWords[i], ctx->dictionary);
+    benchSink += found;
+    return BENCH_LOOKUPS;
+}
+
+static long benchHashMiss(BenchContext *ctx) {
+    long found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++)
+        found += isValidWordHash(ctx->missWords[i], ctx->dictionary);
+    benchSink += found;
+    return BENCH_LOOKUPS;
+}
+
+// Rack vide : seules les ancres et les contraintes des mots croisés sont calculées
+static long benchCrossChecks(BenchContext *ctx) {
+    long ops = 0;
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        benchSink += generateMoves(ctx->lexicon, pos->board, ctx->boardSize, pos->bonusBoard, "",
+                                   pos->firstMove, NULL, &ctx->moves);
+        ops++;
+    }
+    return ops;
+}
+
+static long benchMoveGeneration(BenchContext *ctx) {
+    long ops = 0;
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        float rackLeaves[LEAVE_RACK_SUBSETS];
+        leavePrepareRack(ctx->leaves, pos->rack, rackLeaves);
+        benchSink += generateMoves(ctx->lexicon, pos->board, ctx->boardSize, pos->bonusBoard, pos->rack,
+                                   pos->firstMove, rackLeaves, &ctx->moves);
+        ops++;
+    }
+    return ops;
+}
+
+// Mêmes cas avec les noyaux génériques, pour mesurer le gain des noyaux spécialisés
+static long benchCrossChecksGeneric(BenchContext *ctx) {
+    selectMoveGenKernels(ctx->boardSize, true);
+    long ops = benchCrossChecks(ctx);
+    selectMoveGenKernels(ctx->boardSize, false);
+    return ops;
+}
+
+static long benchMoveGenerationGeneric(BenchContext *ctx) {
+    selectMoveGenKernels(ctx->boardSize, true);
+    long ops = benchMoveGeneration(ctx);
+    selectMoveGenKernels(ctx->boardSize, false);
+    return ops;
+}
+
+// Latence de l'indice : reliquats du rack, génération de tous les coups et choix du meilleur
+static long benchHint(BenchContext *ctx) {
+    long ops = 0;
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        float rackLeaves[LEAVE_RACK_SUBSETS];
+        leavePrepareRack(ctx->leaves, pos->rack, rackLeaves);
+        generateMoves(ctx->lexicon, pos->board, ctx->boardSize, pos->bonusBoard, pos->rack,
+                      isBoardEmpty(pos->board, ctx->boardSize), rackLeaves, &ctx->moves);
+        benchSink += bestMoveIndex(&ctx->moves);
+        ops++;
+    }
+    return ops;
+}
+
+// Chemin de référence : canPlaceWord puis validatePlacement sur les premiers coups générés
+static long benchValidation(BenchContext *ctx) {
+    long ops = 0;
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        generateMoves(ctx->lexicon, pos->board, ctx->boardSize, pos->bonusBoard, pos->rack,
+                      pos->firstMove, NULL, &ctx->moves);
+        int count = ctx->moves.count < BENCH_VALIDATED ? ctx->moves.count : BENCH_VALIDATED;
+        for (int m = 0; m < count; m++) {
+            const Move *move = &ctx->moves.moves[m];
+            if (canPlaceWord(move->word, move->x, move->y, move->dir, pos->board, ctx->boardSize, pos->rack,
+                             pos->firstMove))
+                benchSink += validatePlacement(move->word, move->x, move->y, move->dir, pos->board,
+                                               ctx->boardSize, ctx->dictionary);
+            ops++;
+        }
+    }
+    return ops;
+}
+
+static long benchScoring(BenchContext *ctx) {
+    long ops = 0;
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        benchSink += recalcTotalScore(pos->board, ctx->boardSize);
+        ops++;
+    }
+    return ops;
+}
+
+// Recherche exhaustive sur une copie du plateau (findBestMove pose le coup et l'affiche)
+static long benchFindBestMove(BenchContext *ctx) {
+    long ops = 0;
+    fflush(stdout);
+    int savedStdout = dup(STDOUT_FILENO);
+    FILE *devNull = fopen("/dev/null", "w");
+    if (devNull)
+        dup2(fileno(devNull), STDOUT_FILENO);
+    int size = ctx->boardSize;
+    char **board = initBoard(size);
+    for (int i = 0; board && i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        for (int y = 0; y < size; y++)
+            memcpy(board[y], pos->board[y], size);
+        BonusBoard bonusBoard;
+        memcpy(bonusBoard, pos->bonusBoard, sizeof(bonusBoard));
+        char rack[8];
+        memcpy(rack, pos->rack, sizeof(rack));
+        int totalPoints = 0;
+        findBestMove(board, size, ctx->dictionary, rack, &totalPoints, bonusBoard, ctx->leaves);
+        benchSink += totalPoints;
+        ops++;
+    }
+    freeBoard(board, size);
+    fflush(stdout);
+    if (savedStdout >= 0) {
+        dup2(savedStdout, STDOUT_FILENO);
+        close(savedStdout);
+    }
+    if (devNull)
+        fclose(devNull);
+    return ops;
+}
+
+// Finale des positions dont le sac est vide : le rack adverse est l'ensemble des lettres invisibles
+static long benchEndgame(BenchContext *ctx) {
+    long ops = 0;
+    TranspositionTable *tt = createTranspositionTable(ENDGAME_TT_BITS);
+    EndgameSearch search;
+    if (!tt || initEndgameSearch(&search, ctx->lexicon, ctx->boardSize, NULL, tt) != 0) {
+        freeTranspositionTable(tt);
+        return 0;
+    }
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        int unseen[LEAVE_ALPHABET];
+        int total = countUnseenTiles(pos->board, ctx->boardSize, pos->rack, unseen);
+        if (total < 1 || total > currentRules->rackSize)
+            continue;
+        char other[RULESET_MAX_RACK + 1];
+        int n = 0;
+        for (int s = 0; s < LEAVE_ALPHABET; s++)
+            for (int k = 0; k < unseen[s]; k++)
+                other[n++] = (s == LEAVE_BLANK) ? '?' : 'A' + s;
+        other[n] = '\0';
+        search.bonusBoard = pos->bonusBoard;
+        EndgameResult result;
+        solveEndgame(&search, pos->board, pos->rack, other, BENCH_ENDGAME_BUDGET_MS, &result);
+        benchSink += result.value;
+        ops++;
+    }
+    freeEndgameSearch(&search);
+    freeTranspositionTable(tt);
+    return ops;
+}
+
+// Pré-finale des positions dont le sac contient 1 à 7 lettres une fois le rack adverse
+// complété (lettres invisibles - taille du rack) ; les autres positions sont ignorées
+static long benchPreEndgame(BenchContext *ctx) {
+    long ops = 0;
+    PreEndgameOptions options;
+    defaultPreEndgameOptions(&options);
+    PreEndgameCandidate candidates[8];
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        int unseen[LEAVE_ALPHABET];
+        int bagCount = countUnseenTiles(pos->board, ctx->boardSize, pos->rack, unseen) -
+                       currentRules->rackSize;
+        if (bagCount < 1 || bagCount > PREENDGAME_MAX_BAG)
+            continue;
+        int count = solvePreEndgame(ctx->lexicon, pos->board, ctx->boardSize, pos->bonusBoard,
+                                    ctx->leaves, pos->rack, unseen, bagCount, 0, &options,
+                                    candidates, 8);
+        if (count > 0)
+            benchSink += (long)candidates[0].expectedSpread;
+        ops++;
+    }
+    return ops;
+}
+
+#ifdef BENCH_RENDER
+// Image complète (plateau, rack, saisie) composée dans la texture du cache
+static long benchRenderFrame(BenchContext *ctx) {
+    long ops = 0;
+    for (int i = 0; i < ctx->positionCount; i++) {
+        BenchPosition *pos = &ctx->positions[i];
+        if (!inCategory(ctx, pos))
+            continue;
+        SDL_SetRenderTarget(ctx->renderer, ctx->cache.frame);
+        SDL_SetRenderDrawColor(ctx->renderer, BACKGROUND_COLOR.r, BACKGROUND_COLOR.g, BACKGROUND_COLOR.b, BACKGROUND_COLOR.a);
+        SDL_RenderClear(ctx->renderer);
+        drawBoard(ctx->renderer, &ctx->cache, pos->board, pos->bonusBoard);
+        drawRack(ctx->renderer, &ctx->cache, pos->rack, 300, (WINDOW_WIDTH - 400) / 2, 10, 90, 30);
+        drawInputArea(ctx->renderer, &ctx->atlas, STATE_IDLE, "", "Cliquez pour choisir une case");
+        SDL_SetRenderTarget(ctx->renderer, NULL);
+        SDL_RenderCopy(ctx->renderer, ctx->cache.frame, NULL, NULL);
+        SDL_RenderPresent(ctx->renderer);
+        ops++;
+    }
+    return ops;
+}
+
+// Renderer logiciel sur une surface : aucune fenêtre n'est nécessaire
+static int initRender(BenchContext *ctx) {
+    if (SDL_Init(0) != 0 || TTF_Init() != 0) {
+        fprintf(stderr, "Erreur SDL_Init/TTF_Init: %s\n", SDL_GetError());
+        return -1;
+    }
+    ctx->surface = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    ctx->renderer = ctx->surface ? SDL_CreateSoftwareRenderer(ctx->surface) : NULL;
+    if (!ctx->renderer) {
+        fprintf(stderr, "Erreur SDL_CreateSoftwareRenderer: %s\n", SDL_GetError());
+        return -1;
+    }
+    static const int sizes[FONT_COUNT] = { 28, 20, 24, 12 };
+    TTF_Font *fonts[FONT_COUNT];
+    for (int f = 0; f < FONT_COUNT; f++) {
+        fonts[f] = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", sizes[f]);
+        if (!fonts[f]) {
+            fprintf(stderr, "Erreur TTF_OpenFont: %s\n", TTF_GetError());
+            return -1;
+        }
+    }
+    int status = createGlyphAtlas(ctx->renderer, fonts, &ctx->atlas);
+    for (int f = 0; f < FONT_COUNT; f++)
+        TTF_CloseFont(fonts[f]);
+    if (status != 0)
+        return -1;
+    return createRenderCache(ctx->renderer, &ctx->atlas, &ctx->cache, ctx->boardSize, WINDOW_WIDTH - 2 * BOARD_MARGIN,
+                             BOARD_HEIGHT - 2 * BOARD_MARGIN, 2);
+}
+#endif
+
+//
+// Mesure et rapport
+//
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentile par rang le plus proche sur des échantillons triés
+static double percentile(const double *sorted, int count, double p) {
+    int rank = (int)ceil(p / 100.0 * count) - 1;
+    if (rank < 0)
+        rank = 0;
+    if (rank >= count)
+        rank = count - 1;
+    return sorted[rank];
+}
+
+/*
+ * Fonction : runCase
+ * ------------------
+ * Exécute un cas : warmup répétitions ignorées, puis reps répétitions chronométrées.
+ * Chaque échantillon est la durée d'une répétition divisée par son nombre d'opérations.
+ *
+ * Paramètres :
+ *   ctx      : contexte du banc (corpus, dictionnaire...).
+ *   options  : échauffement, répétitions, format et filtre.
+ *   name     : nom du cas (stable d'un commit à l'autre).
+ *   function : le cas à mesurer.
+ *   reps     : nombre de répétitions chronométrées.
+ *   onDemand : le cas n'est exécuté que si le filtre le désigne (cas très lents).
+ */
+static void runCase(BenchContext *ctx, const BenchOptions *options, const char *name,
+                    BenchFunction function, int reps, bool onDemand) {
+    if ((options->filter || onDemand) && !(options->filter && strstr(name, options->filter)))
+        return;
+    if (reps < 1)
+        reps = 1;
+    double *samples = malloc(reps * sizeof(double));
+    if (!samples) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return;
+    }
+    long ops = 0;
+    for (int i = 0; !onDemand && i < options->warmup; i++)
+        function(ctx);
+    double sum = 0.0;
+    for (int i = 0; i < reps; i++) {
+        double start = nowNs();
+        ops = function(ctx);
+        double elapsed = nowNs() - start;
+        samples[i] = ops > 0 ? elapsed / ops : elapsed;
+        sum += samples[i];
+    }
+    qsort(samples, reps, sizeof(double), compareDoubles);
+    double p50 = percentile(samples, reps, 50), p90 = percentile(samples, reps, 90);
+    double p99 = percentile(samples, reps, 99);
+    if (options->json)
+        printf("{\"case\":\"%s\",\"ops\":%ld,\"reps\":%d,\"min_ns\":%.0f,\"p50_ns\":%.0f,"
+               "\"p90_ns\":%.0f,\"p99_ns\":%.0f,\"max_ns\":%.0f,\"mean_ns\":%.0f}\n",
+               name, ops, reps, samples[0], p50, p90, p99, samples[reps - 1], sum / reps);
+    else
+        printf("%-28s %6ld %5d %12.0f %12.0f %12.0f %12.0f %12.0f\n",
+               name, ops, reps, samples[0], p50, p90, p99, samples[reps - 1]);
+    fflush(stdout);
+    free(samples);
+}
+
+// Exécute un cas sur chaque catégorie du corpus puis sur le corpus entier
+static void runCategories(BenchContext *ctx, const BenchOptions *options, const char *prefix,
+                          BenchFunction function, int reps, bool onDemand) {
+    char name[64];
+    for (int i = 0; i < ctx->positionCount; i++) {
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++)
+            seen = strcmp(ctx->positions[j].category, ctx->positions[i].category) == 0;
+        if (seen)
+            continue;
+        ctx->category = ctx->positions[i].category;
+        snprintf(name, sizeof(name), "%s/%s", prefix, ctx->category);
+        runCase(ctx, options, name, function, reps, onDemand);
+    }
+    ctx->category = NULL;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-R règles] [-c corpus] [-l reliquats.bin]\n"
+            "          [-w échauffement] [-r répétitions] [-k filtre] [-j]\n"
+            "  -R : fichier de règles ; le corpus doit avoir la taille de plateau de ces règles\n"
+            "  -j : une ligne JSON par cas (durées par opération en nanosecondes)\n",
+            prog);
+}
+
+// Fonction principale du banc d'essai
+int main(int argc, char *argv[]) {
+    const char *corpusFile = "bench_corpus.txt";
+    const char *leavesFile = NULL;
+    const char *rulesFile = NULL;
+    BenchOptions options = { .warmup = 3, .reps = 20, .json = false, .filter = NULL };
+    static BenchContext ctx;
+    ctx.dictionaryFile = "mots_filtres.txt";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:R:c:l:w:r:k:jh")) != -1) {
+        switch (opt) {
+            case 'd': ctx.dictionaryFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 'c': corpusFile = optarg; break;
+            case 'l': leavesFile = optarg; break;
+            case 'w': options.warmup = atoi(optarg); break;
+            case 'r': options.reps = atoi(optarg); break;
+            case 'k': options.filter = optarg; break;
+            case 'j': options.json = true; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    Ruleset *rules = NULL;
+    if (rulesFile && !(rules = loadRuleset(rulesFile)))
+        return EXIT_FAILURE;
+    useRuleset(rules);
+    ctx.boardSize = currentRules->boardSize;
+
+    ctx.dictionary = loadDictionaryHash(ctx.dictionaryFile);
+    if (!ctx.dictionary || !(ctx.lexicon = buildLexicon(ctx.dictionary)))
+        return EXIT_FAILURE;
+    if (leavesFile && !(ctx.leaves = loadLeaveTable(leavesFile)))
+        return EXIT_FAILURE;
+    if (loadCorpus(&ctx, corpusFile) <= 0 || prepareLookups(&ctx) != 0)
+        return EXIT_FAILURE;
+    initMoveList(&ctx.moves);
+#ifdef BENCH_RENDER
+    if (initRender(&ctx) != 0)
+        return EXIT_FAILURE;
+#endif
+
+    if (options.json)
+        printf("{\"corpus\":\"%s\",\"rules\":\"%s\",\"board\":%d,\"kernels\":\"%s\",\"positions\":%d,"
+               "\"words\":%u,\"warmup\":%d,\"reps\":%d}\n",
+               corpusFile, currentRules->name, ctx.boardSize, moveGenKernelName(), ctx.positionCount,
+               HASH_COUNT(ctx.dictionary), options.warmup, options.reps);
+    else
+        printf("règles %s, plateau %d x %d, noyaux %s\n%-28s %6s %5s %12s %12s %12s %12s %12s\n",
+               currentRules->name, ctx.boardSize, ctx.boardSize, moveGenKernelName(), "cas (ns/op)", "ops", "reps", "min", "p50", "p90", "p99", "max");
+
+    // Les chargements sont moins répétés ; la recherche exhaustive (plusieurs secondes par
+    // position), la finale et la pré-finale ne sont mesurées qu'à la demande : -k findbestmove,
+    // -k endgame (finale et pré-finale), -k preendgame
+    int slowReps = options.reps / 4 > 0 ? options.reps / 4 : 1;
+    runCase(&ctx, &options, "dictionary_load", benchDictionaryLoad, slowReps, false);
+    runCase(&ctx, &options, "lexicon_build", benchLexiconBuild, slowReps, false);
+    runCase(&ctx, &options, "hash_hit", benchHashHit, options.reps, false);
+    runCase(&ctx, &options, "hash_miss", benchHashMiss, options.reps, false);
+    runCategories(&ctx, &options, "crosscheck", benchCrossChecks, options.reps, false);
+    runCategories(&ctx, &options, "movegen", benchMoveGeneration, options.reps, false);
+    runCategories(&ctx, &options, "crosscheck_generic", benchCrossChecksGeneric, options.reps, false);
+    runCategories(&ctx, &options, "movegen_generic", benchMoveGenerationGeneric, options.reps, false);
+    runCategories(&ctx, &options, "hint", benchHint, options.reps, false);
+    runCategories(&ctx, &options, "validate", benchValidation, options.reps, false);
+    runCategories(&ctx, &options, "score", benchScoring, options.reps, false);
+    runCategories(&ctx, &options, "findbestmove", benchFindBestMove, 1, BENCH_ON_DEMAND);
+    runCategories(&ctx, &options, "endgame", benchEndgame, 1, BENCH_ON_DEMAND);
+    runCategories(&ctx, &options, "preendgame", benchPreEndgame, 1, BENCH_ON_DEMAND);
+#ifdef BENCH_RENDER
+    runCategories(&ctx, &options, "render_frame", benchRenderFrame, options.reps, false);
+    freeRenderCache(&ctx.cache);
+    freeGlyphAtlas(&ctx.atlas);
+    SDL_DestroyRenderer(ctx.renderer);
+    SDL_FreeSurface(ctx.surface);
+    TTF_Quit();
+    SDL_Quit();
+#endif
+
+    for (int i = 0; i < ctx.positionCount; i++)
+        freeBoard(ctx.positions[i].board, ctx.boardSize);
+    free(ctx.hitWords);
+    free(ctx.missWords);
+    freeMoveList(&ctx.moves);
+    freeLeaveTable(ctx.leaves);
+    freeLexicon(ctx.lexicon);
+    freeRuleset(rules);
+    freeDictionaryHash(ctx.dictionary);
+    return EXIT_SUCCESS;
+}
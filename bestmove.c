@@ -1,5 +1,9 @@
 #include "board.h"
 #include "dictionary.h"
+#include "leave.h"
+#include "movegen.h"
+#include "stats.h"
+#include "trace.h"
 
 /*
  * Fonction : findBestMove
@@ -14,32 +18,59 @@
  *   rack        : lettres disponibles sur le chevalet du joueur.
  *   totalPoints : pointeur vers le score total du joueur (sera mis à jour si un mot est placé).
  *   bonusBoard  : tableau des bonus de points du plateau (double-mot, triple-lettre, etc.).
+ *   leaves      : table des valeurs de reliquat (NULL : seul le score compte).
  *
  * Comportement :
  *   - Parcours du dictionnaire pour tester chaque mot.
  *   - Vérification de toutes les positions du plateau pour placer le mot.
  *   - Évaluation du score pour chaque coup possible en appliquant les bonus.
- *   - Sélection du meilleur coup trouvé (le plus haut score possible).
+ *   - Classement des coups selon score + valeur du reliquat (lettres restant sur le rack).
+ *   - Sélection du meilleur coup trouvé (la plus haute équité possible).
  *   - Placement du mot si un coup valide est trouvé, mise à jour du plateau et du score.
  *   - Désactivation des bonus pour les cases utilisées.
  *
  * Remarques :
+ *   - Recherche exhaustive de référence : son coût croît avec la surface du plateau et la
+ *     taille du dictionnaire. L'indice du jeu passe par le générateur (generateMoves), dont
+ *     le coût dépend des ancres, donc des cases occupées.
  *   - Cette fonction ne prend pas en compte les échanges de lettres ou les options avancées.
  *   - Elle ne donne pas de bonus de 50 points pour un Scrabble (pose de toutes les lettres du rack).
  *   - Si aucun coup n'est trouvé, elle affiche un message d'erreur.
+ *   - Instrumentation (SCRABBLE_STATS) : le filtre canPlaceWord compte comme préfiltre,
+ *     validatePlacement comme génération, le calcul du score et la comparaison au meilleur
+ *     coup comme score.
  */
 void findBestMove(char **board, int boardSize,
     DictionaryEntry *dictionary,
     char *rack,
     int *totalPoints,
-    int bonusBoard[15][15])
+    BonusBoard bonusBoard,
+    const LeaveTable *leaves)
 {
-    int bestScore = 0;        // Meilleur score trouvé
+    int bestScore = 0;        // Score du meilleur coup trouvé
+    float bestEquity = 0.0f;  // Équité (score + reliquat) du meilleur coup
+    bool found = false;       // Indique si au moins un coup valide a été trouvé
     char bestWord[100] = "";  // Mot correspondant au meilleur coup
     int bestX = -1, bestY = -1; // Position du mot sur le plateau
     char bestDir = 'h';       // Direction du mot ('h' pour horizontal, 'v' pour vertical)
+    float bestLeave = 0.0f;   // Valeur du reliquat du meilleur coup
+
+    TRACE_BEGIN("findBestMove");
+
+    // Valeur du reliquat pour chaque sous-ensemble de lettres conservées du rack
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    leavePrepareRack(leaves, rack, rackLeaves);
+    int rackLen = strnlen(rack, RULESET_MAX_RACK);
+    int fullMask = (1 << rackLen) - 1;
+    bool firstMove = isBoardEmpty(board, boardSize);   // Premier coup : plateau vide, pas score nul
+#ifdef SCRABBLE_STATS
+    EngineStats statsBefore;
+    statsSnapshot(&statsBefore);
+    uint64_t searchStart = statsNow();
+#endif
 
     // Parcours du dictionnaire via HASH_ITER (balayage de la table de hachage)
+    TRACE_BEGIN("search");
     DictionaryEntry *entry, *tmp;
     HASH_ITER(hh, dictionary, entry, tmp) {
         const char *word = entry->word;
@@ -55,11 +86,17 @@ void findBestMove(char **board, int boardSize,
                     char dir = (d == 0) ? 'h' : 'v';
 
                     // Vérifie si le mot peut être placé à cette position
-                    if (canPlaceWord(word, x, y, dir, board, boardSize, rack, *totalPoints)) {
+                    if (canPlaceWord(word, x, y, dir, board, boardSize, rack, firstMove)) {
                         // Vérifie si les mots croisés générés sont valides
-                        if (validatePlacement(word, x, y, dir, board, boardSize, dictionary)) {
+                        STAT_TIMER_START(validateStart);
+                        bool valid = validatePlacement(word, x, y, dir, board, boardSize, dictionary);
+                        STAT_TIMER_STOP(PHASE_GENERATION, validateStart);
+                        if (valid) {
+                            STAT_TIMER_START(scoreStart);
+                            STAT_INC(STAT_MOVES);
                             int currentScore = 0;  // Score du mot testé
                             int wordMultiplier = 1; // Multiplicateur pour les bonus mots
+                            int usedMask = 0;       // Positions du rack consommées par le coup
 
                             // Calcul du score du mot en prenant en compte les bonus
                             for (int i = 0; i < len; i++) {
@@ -72,52 +109,61 @@ void findBestMove(char **board, int boardSize,
 
                                 // Vérifie si la case est vide (lettre du rack placée)
                                 if (board[yy][xx] == ' ') {
-                                    int bonus = bonusBoard[yy][xx];
-                                    int letterMult = 1;
-                                    switch (bonus) {
-                                        case 1: // Triple-mot
-                                            wordMultiplier *= 3;
-                                            break;
-                                        case 2: // Double-mot
-                                            wordMultiplier *= 2;
-                                            break;
-                                        case 3: // Triple-lettre
-                                            letterMult = 3;
-                                            break;
-                                        case 4: // Double-lettre
-                                            letterMult = 2;
-                                            break;
-                                        default:
+                                    // Marque la première position du rack portant cette lettre
+                                    for (int j = 0; j < rackLen; j++) {
+                                        if (!(usedMask & (1 << j)) && toupper(rack[j]) == toupper(word[i])) {
+                                            usedMask |= 1 << j;
                                             break;
+                                        }
                                     }
+                                    // Multiplicateurs de la case bonus (triple-mot, double-lettre...)
+                                    int bonus = bonusBoard[yy][xx];
+                                    int letterMult = bonusLetterMultiplier[bonus];
+                                    wordMultiplier *= bonusWordMultiplier[bonus];
                                     // Applique le multiplicateur de lettre
                                     currentScore += getLetterScore(toupper(word[i])) * letterMult;
                                 } else {
                                     // Ajoute directement la valeur de la lettre existante sur le plateau
-                                    currentScore += getLetterScore(board[yy][xx]);
+                                    currentScore += getTileScore(board[yy][xx]);
                                 }
                             }
 
                             // Applique le multiplicateur de mot final
                             currentScore *= wordMultiplier;
 
+                            // Équité du coup : score + valeur des lettres conservées
+                            float leave = rackLeaves[fullMask & ~usedMask];
+                            float equity = currentScore + leave;
+
                             // Vérifie si ce coup est meilleur que le précédent
-                            if (currentScore > bestScore) {
+                            if (currentScore > 0 && (!found || equity > bestEquity)) {
+                                found = true;
+                                bestEquity = equity;
+                                bestLeave = leave;
                                 bestScore = currentScore;
                                 strcpy(bestWord, word);
                                 bestX = x;
                                 bestY = y;
                                 bestDir = dir;
                             }
+                            STAT_TIMER_STOP(PHASE_SCORING, scoreStart);
                         }
                     }
                 }
             }
         }
     }
+    TRACE_END("search");
+
+#ifdef SCRABBLE_STATS
+    // Préfiltre : tout le parcours, hors validation et score déjà mesurés
+    uint64_t measured = (threadStats.phaseNs[PHASE_GENERATION] - statsBefore.phaseNs[PHASE_GENERATION]) +
+                        (threadStats.phaseNs[PHASE_SCORING] - statsBefore.phaseNs[PHASE_SCORING]);
+    threadStats.phaseNs[PHASE_PREFILTER] += statsNow() - searchStart - measured;
+#endif
 
     // Si un coup optimal a été trouvé, le placer sur le plateau
-    if (bestScore > 0) {
+    if (found) {
         placeWord(bestWord, bestX, bestY, bestDir, board, rack);
 
         // Désactive les bonus sur les cases utilisées
@@ -133,11 +179,12 @@ void findBestMove(char **board, int boardSize,
         *totalPoints += bestScore;
 
         // Affichage du coup joué par l'IA
-        printf("[Indice] Meilleur coup : %s (%c) en (%d, %d) -> %d points\n"
+        printf("[Indice] Meilleur coup : %s (%c) en (%d, %d) -> %d points (reliquat %+.1f)\n"
                "Rappel : pas de bonus 50pts si on fait un scrabble en utilisant l'indice\n",
-               bestWord, bestDir, bestX, bestY, bestScore);
+               bestWord, bestDir, bestX, bestY, bestScore, bestLeave);
     } else {
         // Aucun coup trouvé
         printf("[Indice] Aucun coup optimal trouvé...\n");
     }
+    TRACE_END("findBestMove");
 }
\ No newline at end of file
@@ -5,4 +5,5 @@ void findBestMove(char **board, int boardSize,
     DictionaryEntry *dictionary,
     char *rack,
     int *totalPoints,
-    int bonusBoard[15][15]);
\ No newline at end of file
+    BonusBoard bonusBoard,
+    const LeaveTable *leaves);
\ No newline at end of file
@@ -1,49 +1,68 @@
 #include "board.h"
 #include "dictionary.h"
+#include "stats.h"
 
 //
 // ---------------------- Fonctions pour le Scrabble --------------------------
 //
 
+// Alloue et initialise le plateau avec des espaces
+char **initBoard(int boardSize) {
+    char **board = malloc(boardSize * sizeof(char *));
+    STAT_ADD(STAT_ALLOCS, boardSize + 1);
+    if (!board) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le plateau.\n");
+        return NULL;
+    }
+    for (int i = 0; i < boardSize; i++) {
+        board[i] = malloc(boardSize * sizeof(char));
+        if (!board[i]) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            for (int j = 0; j < i; j++)
+                free(board[j]);
+            free(board);
+            return NULL;
+        }
+        memset(board[i], ' ', boardSize);
+    }
+    return board;
+}
+
+void freeBoard(char **board, int boardSize) {
+    for (int i = 0; i < boardSize; i++)
+        free(board[i]);
+    free(board);
+}
+
 /*
  * Fonction : getLetterScore
  * -------------------------
- * Retourne le score attribué à une lettre (en majuscule) selon la grille de points du Scrabble.
+ * Retourne le score attribué à une lettre (majuscule ou minuscule) par les règles en vigueur.
  *
  * Paramètre :
- *   letter : la lettre dont on veut connaître le score.
+ *   letter : la lettre dont on veut connaître le score ('?' pour un joker).
  *
  * Retour :
- *   Un entier correspondant au score de la lettre.
+ *   Un entier correspondant au score de la lettre, 0 si elle ne fait pas partie de l'alphabet.
  */
 int getLetterScore(char letter) {
-    // Convertit la lettre en majuscule
-    letter = toupper(letter);
-
-    // Utilisation de switch case pour une bonne lisibilité et performance
-    switch (letter) {
-        case 'A': case 'E': case 'I': case 'L': case 'N':
-        case 'O': case 'R': case 'S': case 'T': case 'U':
-            return 1;
-
-        case 'D': case 'G': case 'M':
-            return 2;
-
-        case 'B': case 'C': case 'P':
-            return 3;
-
-        case 'F': case 'H': case 'V':
-            return 4;
-
-        case 'J': case 'Q':
-            return 8;
-
-        case 'K': case 'W': case 'X': case 'Y': case 'Z':
-            return 10;
+    return currentRules->tileValue[(unsigned char)toupper((unsigned char)letter)];
+}
 
-        default:
-            return 0; // Retourne 0 si la lettre n'est pas valide
-    }
+/*
+ * Fonction : getTileScore
+ * -----------------------
+ * Retourne la valeur d'une lettre posée sur le plateau : un joker, posé en minuscule,
+ * rapporte la valeur du joker (aucun point dans les règles usuelles).
+ *
+ * Paramètre :
+ *   tile : la case du plateau (lettre majuscule, ou minuscule pour un joker).
+ *
+ * Retour :
+ *   Le score de la lettre, 0 pour une case vide.
+ */
+int getTileScore(char tile) {
+    return currentRules->tileValue[(unsigned char)tile];
 }
 
 
@@ -57,33 +76,20 @@ int getLetterScore(char letter) {
 /*
  * Fonction : drawRandomLetter
  * -----------------------------
- * Tire une lettre aléatoire selon la distribution classique du Scrabble.
+ * Tire une lettre aléatoire selon la distribution des règles en vigueur.
  * La distribution indique combien de fois chaque lettre doit apparaître.
  *
  * Retour :
- *   La lettre aléatoire choisie.
+ *   La lettre aléatoire choisie ('?' pour un joker).
  */
 char drawRandomLetter() {
-    // Définition de la distribution des lettres (sans jokers)
-    struct { char letter; int count; } distribution[] = {
-        {'A', 9}, {'B', 2}, {'C', 2}, {'D', 4}, {'E', 12},
-        {'F', 2}, {'G', 3}, {'H', 2}, {'I', 9}, {'J', 1},
-        {'K', 1}, {'L', 4}, {'M', 2}, {'N', 6}, {'O', 8},
-        {'P', 2}, {'Q', 1}, {'R', 6}, {'S', 4}, {'T', 6},
-        {'U', 4}, {'V', 2}, {'W', 2}, {'X', 1}, {'Y', 2},
-        {'Z', 1}
-    };
-    // Calcul du nombre total de lettres disponibles
-    int total = 0;
-    for (int i = 0; i < 26; i++)
-        total += distribution[i].count;
-    // Tire un nombre aléatoire entre 0 et total - 1
-    int r = rand() % total;
+    // Tire un nombre aléatoire entre 0 et le nombre total de lettres - 1
+    int r = rand() % currentRules->tileCount;
     // Parcours la distribution et retourne la lettre correspondante
-    for (int i = 0; i < 26; i++) {
-        if (r < distribution[i].count)
-            return distribution[i].letter;
-        r -= distribution[i].count;
+    for (int i = 0; i < LEAVE_ALPHABET; i++) {
+        if (r < currentRules->counts[i])
+            return (i == LEAVE_BLANK) ? '?' : 'A' + i;
+        r -= currentRules->counts[i];
     }
     return 'A'; // Valeur par défaut (ne devrait jamais arriver)
 }
@@ -109,7 +115,7 @@ char drawRandomLetter() {
  *  - Pour chaque lettre du mot :
  *       - Si la case est vide, le rack doit contenir la lettre.
  *       - Si la case n'est pas vide, la lettre existante doit correspondre à celle du mot.
- *  - Si c'est le premier coup (totalPoints == 0), le mot doit passer par la case centrale.
+ *  - Si c'est le premier coup, le mot doit passer par la case centrale.
  *  - Si ce n'est pas le premier coup, le mot doit intersecter au moins une lettre déjà présente.
  *
  * Paramètres :
@@ -120,19 +126,19 @@ char drawRandomLetter() {
  *   board     : le plateau actuel (tableau 2D de caractères).
  *   boardSize : la taille du plateau (nombre de colonnes/ligues).
  *   rack      : les lettres disponibles sur le chevalet.
- *   totalPoints : le score total actuel (pour savoir si c'est le premier coup).
+ *   firstMove : vrai si aucune lettre n'est encore posée (premier coup de la partie).
  *
  * Retour :
  *   true si le mot peut être placé, false sinon.
  */
 bool canPlaceWord(const char *word, int startX, int startY, char dir,
-    char **board, int boardSize, const char *rack, int totalPoints) {
+    char **board, int boardSize, const char *rack, bool firstMove) {
 bool intersects = false;           // Indique si le mot croise (ou touche) une lettre déjà présente
 bool passesThroughCenter = false;  // Indique si le mot passe par la case centrale
 int freq[26] = {0};                // Occurrences des lettres disponibles sur le rack
 
 // Remplit le tableau de fréquences avec les lettres du rack (en majuscules)
-for (int i = 0; i < 7; i++) {
+for (int i = 0; rack[i] != '\0'; i++) {
 char c = rack[i];
 if (c >= 'A' && c <= 'Z')
 freq[c - 'A']++;
@@ -212,10 +218,10 @@ if (!newLetterPlaced)
 return false;
 
 // Pour un coup ultérieur, le mot doit toucher au moins une lettre déjà présente
-if (totalPoints > 0 && !intersects)
+if (!firstMove && !intersects)
 return false;
 // Pour le premier coup, le mot doit passer par la case centrale
-if (totalPoints == 0 && !passesThroughCenter)
+if (firstMove && !passesThroughCenter)
 return false;
 
 return true;
@@ -252,7 +258,7 @@ return true;
  *   startY    : la ligne de départ.
  *   dir       : la direction ('h' ou 'v').
  *   board     : le plateau (tableau 2D de caractères).
- *   rack      : le rack de lettres (tableau de 7 caractères).
+ *   rack      : le rack de lettres (chaîne d'au plus la taille du chevalet).
  */
 void placeWord(const char *word, int startX, int startY, char dir,
                char **board, char *rack) {
@@ -269,7 +275,7 @@ void placeWord(const char *word, int startX, int startY, char dir,
         if (board[y][x] == ' ') {
             board[y][x] = toupper(word[i]);
             // Consomme la lettre du rack : remplace la lettre utilisée par une lettre aléatoire
-            for (int j = 0; j < 7; j++) {
+            for (int j = 0; rack[j] != '\0'; j++) {
                 if (toupper(rack[j]) == toupper(word[i])) {
                     rack[j] = drawRandomLetter();
                     break;
@@ -313,6 +319,7 @@ bool validatePlacement(const char *word, int startX, int startY, char dir,
 
     // Crée une copie temporaire du plateau pour simuler la pose du mot
     char **tempBoard = malloc(boardSize * sizeof(char *));
+    STAT_ADD(STAT_ALLOCS, boardSize + 1);
     if (!tempBoard)
         return false;
     
@@ -427,7 +434,7 @@ int recalcTotalScore(char **board, int boardSize) {
             int wordScore = 0;
             // Construit le mot horizontal en cours
             while (j < boardSize && board[i][j] != ' ') {
-                wordScore += getLetterScore(board[i][j]);
+                wordScore += getTileScore(board[i][j]);
                 j++;
             }
             // Si le mot comporte au moins 2 lettres, on l’ajoute
@@ -449,7 +456,7 @@ int recalcTotalScore(char **board, int boardSize) {
         int wordScore = 0;
         // Construit le mot vertical en cours
         while (i < boardSize && board[i][j] != ' ') {
-            wordScore += getLetterScore(board[i][j]);
+            wordScore += getTileScore(board[i][j]);
             i++;
         }
         // Si le mot comporte au moins 2 lettres, on l’ajoute
@@ -2,21 +2,25 @@
 #define BOARD_H
 
 #include "scrabble.h"
+#include "ruleset.h"      // Règles en vigueur : valeurs, distribution et cases bonus
 
-// Déclaration du plateau bonus (défini dans board.c)
-extern int bonusBoard[15][15];
+// Allocation et libération du plateau
+char **initBoard(int boardSize);
+void freeBoard(char **board, int boardSize);
 
 // Fonctions pour la gestion des lettres et du plateau
 int getLetterScore(char letter);
+int getTileScore(char tile);          // Valeur du joker pour un joker posé (minuscule)
 char drawRandomLetter(void);
 bool canPlaceWord(const char *word, int startX, int startY, char dir,
-                  char **board, int boardSize, const char *rack, int totalPoints);
+                  char **board, int boardSize, const char *rack, bool firstMove);
 void placeWord(const char *word, int startX, int startY, char dir,
                char **board, char *rack);
 int recalcTotalScore(char **board, int boardSize);
 bool validatePlacement(const char *word, int startX, int startY, char dir,
                        char **board, int boardSize, DictionaryEntry *dictionary);
 void findBestMove(char **board, int boardSize, DictionaryEntry *dictionary,
-                  char *rack, int *totalPoints, int bonusBoard[15][15]);
+                  char *rack, int *totalPoints, BonusBoard bonusBoard,
+                  const LeaveTable *leaves);
 
 #endif  // BOARD_H
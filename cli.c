@@ -0,0 +1,172 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "scrabble_engine.h"  // Interface publique du moteur (seule dépendance)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//
+// ---------------------- Outil en ligne de commande -------------------------
+//
+// Affiche les meilleurs coups d'un rack sur une position lue dans un fichier texte
+// (une ligne par rangée du plateau, '.' pour une case vide), sans interface graphique.
+// Avec -e, un sac de 7 lettres au plus (lettres invisibles moins le chevalet adverse) passe
+// par l'analyse de fin de partie du moteur au lieu du classement en équité.
+//
+
+#define CLI_MAX_MOVES 100
+#define CLI_ENDGAME_BUDGET_MS 20.0   // Budget par défaut de chaque finale résolue
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-l reliquats.bin] [-k coups] [-b plateau.txt]\n"
+            "          [-R règles] [-s text|json] [-e écart [-t ms]] RACK\n"
+            "  -R : fichier de règles (plateau, bonus, lettres), règles standard par défaut\n"
+            "  -e : fin de partie (sac de 0 à 7 lettres) pour l'écart actuel (joueur - adversaire)\n"
+            "  -t : budget de chaque finale résolue (%.0f ms par défaut)\n"
+            "  -s : compteurs du moteur pour ce rack (make STATS=1)\n",
+            prog, CLI_ENDGAME_BUDGET_MS);
+}
+
+// Lit un plateau d'une ligne par rangée ; retourne 0, ou -1 en cas d'erreur
+static int readBoardFile(const ScrabbleEngine *engine, ScrabblePosition *position,
+                         const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
+        return -1;
+    }
+    char line[64];
+    int y = 0;
+    int size = scrabbleBoardSize(engine);
+    while (y < size && fgets(line, sizeof(line), fp)) {
+        if (scrabblePositionSetRow(position, y, line) != 0) {
+            fprintf(stderr, "Erreur : ligne %d du plateau invalide\n", y + 1);
+            fclose(fp);
+            return -1;
+        }
+        y++;
+    }
+    fclose(fp);
+    if (y < size) {
+        fprintf(stderr, "Erreur : le plateau doit compter %d lignes\n", size);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Fonction : printEndgame
+ * -----------------------
+ * Affiche l'analyse de fin de partie du rack si le sac contient au plus 7 lettres.
+ *
+ * Retour :
+ *   1 si l'analyse a été affichée, 0 si le sac est trop plein (message sur stderr, le
+ *   classement en équité prend le relais), -1 en cas d'erreur.
+ */
+static int printEndgame(const ScrabbleEngine *engine, ScrabblePosition *position, const char *rack,
+                        int spread, double budgetMs, int topK) {
+    int bagCount = scrabbleUnseenTiles(position, rack) - scrabbleRackSize(engine);
+    ScrabbleEndgameMove moves[CLI_MAX_MOVES];
+    int count = scrabbleSolveEndgame(position, rack, spread, budgetMs, moves, topK);
+    if (count <= 0) {
+        if (count == 0)
+            fprintf(stderr, "Sac de %d lettres : pas d'analyse de fin de partie\n", bagCount);
+        return count;
+    }
+    printf(bagCount > 0 ? "Pré-finale, %d lettre(s) dans le sac :\n" : "Finale, sac vide :\n", bagCount);
+    for (int i = 0; i < count; i++) {
+        const ScrabbleMove *m = &moves[i].move;
+        if (m->word[0] == '\0')
+            printf("%3d. %-15s %22s", i + 1, "(passe)", "");
+        else
+            printf("%3d. %-15s x=%-2d y=%-2d %c  score %3d", i + 1, m->word, m->x, m->y, m->dir,
+                   m->score);
+        printf("  gain %5.1f %%  écart %+7.2f%s\n", 100.0 * moves[i].winProbability,
+               moves[i].expectedSpread, moves[i].exact ? "" : "  (estimé)");
+    }
+    return 1;
+}
+
+// Fonction principale de l'outil en ligne de commande
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *leavesFile = NULL;
+    const char *boardFile = NULL;
+    const char *rulesFile = NULL;
+    int topK = 10;
+    const char *statsFormat = NULL;
+    bool endgame = false;
+    int spread = 0;
+    double budgetMs = CLI_ENDGAME_BUDGET_MS;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:l:k:b:R:s:e:t:h")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'l': leavesFile = optarg; break;
+            case 'k': topK = atoi(optarg); break;
+            case 'b': boardFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 's': statsFormat = optarg; break;
+            case 'e': endgame = true; spread = atoi(optarg); break;
+            case 't': budgetMs = atof(optarg); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (statsFormat && strcmp(statsFormat, "text") != 0 && strcmp(statsFormat, "json") != 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (topK < 1)
+        topK = 1;
+    if (topK > CLI_MAX_MOVES)
+        topK = CLI_MAX_MOVES;
+
+    ScrabbleEngine *engine = scrabbleEngineLoad(dictionaryFile, leavesFile);
+    if (!engine)
+        return EXIT_FAILURE;
+    ScrabblePosition *position = NULL;
+    if ((rulesFile && scrabbleLoadRules(engine, rulesFile) != 0) ||
+        !(position = scrabblePositionCreate(engine)) ||
+        (boardFile && readBoardFile(engine, position, boardFile) != 0)) {
+        scrabblePositionFree(position);
+        scrabbleEngineFree(engine);
+        return EXIT_FAILURE;
+    }
+
+    // Les compteurs repartent de zéro juste avant la génération (chargement exclu)
+    char stats[512];
+    bool json = statsFormat && strcmp(statsFormat, "json") == 0;
+    if (statsFormat && scrabbleStatsReport(stats, sizeof(stats), json) < 0) {
+        fprintf(stderr, "Erreur : moteur compilé sans instrumentation (make clean && make STATS=1)\n");
+        statsFormat = NULL;
+    }
+    if (endgame) {
+        int status = printEndgame(engine, position, argv[optind], spread, budgetMs, topK);
+        if (status != 0) {
+            scrabblePositionFree(position);
+            scrabbleEngineFree(engine);
+            return (status < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+        }
+    }
+    ScrabbleMove moves[CLI_MAX_MOVES];
+    int count = scrabbleGenerateMoves(position, argv[optind], moves, topK);
+    if (count == 0)
+        printf("Aucun coup possible avec %s\n", argv[optind]);
+    for (int i = 0; i < count; i++)
+        printf("%3d. %-15s x=%-2d y=%-2d %c  score %3d  équité %7.2f\n", i + 1, moves[i].word,
+               moves[i].x, moves[i].y, moves[i].dir, moves[i].score, moves[i].equity);
+    if (statsFormat && scrabbleStatsReport(stats, sizeof(stats), json) >= 0)
+        printf(json ? "%s\n" : "[Stats] %s\n", stats);
+
+    scrabblePositionFree(position);
+    scrabbleEngineFree(engine);
+    return EXIT_SUCCESS;
+}
@@ -1,4 +1,6 @@
 #include "dictionary.h"
+#include "stats.h"
+#include "trace.h"
 
 /*
  * Fonction : loadDictionaryHash
@@ -10,18 +12,20 @@
  *   filename : chemin du fichier contenant la liste des mots du dictionnaire.
  *
  * Retour :
- *   Un pointeur vers la table de hachage contenant les mots du dictionnaire.
+ *   Un pointeur vers la table de hachage contenant les mots du dictionnaire, NULL en cas d'erreur.
  *
  * Remarque :
- *   - En cas d'échec d'ouverture du fichier, le programme affiche une erreur et quitte.
- *   - En cas d'échec d'allocation mémoire, le programme affiche une erreur et quitte.
+ *   - En cas d'échec d'ouverture du fichier ou d'allocation, une erreur est affichée et la
+ *     fonction retourne NULL (le moteur est une bibliothèque : il ne quitte jamais le programme).
  *   - Chaque mot est inséré en tant qu'entrée unique dans la table de hachage.
  */
 DictionaryEntry* loadDictionaryHash(const char *filename) {
+    TRACE_BEGIN("loadDictionary");
     FILE *fp = fopen(filename, "r");
     if (!fp) {
         fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
-        exit(EXIT_FAILURE);
+        TRACE_END("loadDictionary");
+        return NULL;
     }
 
     DictionaryEntry *dictionary = NULL;  // Table de hachage initialement vide
@@ -35,7 +39,10 @@ DictionaryEntry* loadDictionaryHash(const char *filename) {
         DictionaryEntry *entry = malloc(sizeof(DictionaryEntry));
         if (!entry) {
             fprintf(stderr, "Erreur d'allocation mémoire.\n");
-            exit(EXIT_FAILURE);
+            freeDictionaryHash(dictionary);
+            fclose(fp);
+            TRACE_END("loadDictionary");
+            return NULL;
         }
 
         // Copie le mot lu dans la structure et s'assure de la terminaison correcte
@@ -47,6 +54,7 @@ DictionaryEntry* loadDictionaryHash(const char *filename) {
     }
 
     fclose(fp);
+    TRACE_END("loadDictionary");
     return dictionary;  // Retourne le dictionnaire chargé en mémoire sous forme de table de hachage
 }
 
@@ -69,7 +77,24 @@ DictionaryEntry* loadDictionaryHash(const char *filename) {
  */
 bool isValidWordHash(const char *word, DictionaryEntry *dictionary) {
     DictionaryEntry *entry;
+    STAT_INC(STAT_DICT_PROBES);
     HASH_FIND_STR(dictionary, word, entry);  // Recherche du mot dans la table de hachage
     return entry != NULL;  // Retourne vrai si trouvé, faux sinon
 }
 
+
+/*
+ * Fonction : freeDictionaryHash
+ * -----------------------------
+ * Retire et libère chaque entrée de la table de hachage du dictionnaire.
+ *
+ * Paramètre :
+ *   dictionary : la table de hachage à libérer (peut être NULL).
+ */
+void freeDictionaryHash(DictionaryEntry *dictionary) {
+    DictionaryEntry *current, *tmp;
+    HASH_ITER(hh, dictionary, current, tmp) {
+        HASH_DEL(dictionary, current);
+        free(current);
+    }
+}
@@ -9,4 +9,7 @@ DictionaryEntry* loadDictionaryHash(const char *filename);
 // Vérifie si un mot est présent dans le dictionnaire.
 bool isValidWordHash(const char *word, DictionaryEntry *dictionary);
 
+// Libère toutes les entrées de la table de hachage.
+void freeDictionaryHash(DictionaryEntry *dictionary);
+
 #endif  // DICTIONARY_H
@@ -0,0 +1,275 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "board.h"            // Plateau et règles (disposition des bonus)
+#include "dictionary.h"       // Chargement du dictionnaire
+#include "lexicon.h"          // Arbre lexical partagé par tous les threads
+#include "duplicate.h"        // Parties en duplicate (tirage commun et top)
+#include "record.h"           // Parties enregistrées et export GCG
+
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+// ---------------------- Génération de parties en duplicate ------------------
+//
+// Joue N parties complètes en duplicate, la partie i avec la graine (première graine + i),
+// réparties entre les threads qui partagent le même arbre lexical en lecture seule. Chaque
+// partie est écrite au format des parties enregistrées (dup-<graine>.scg, un coup par top) et
+// résumée sur une ligne JSON (nombre de coups, total des tops, scrabbles, meilleur coup) pour
+// être filtrée ensuite. Une partie ne dépend que de sa graine : le nombre de threads ne
+// change ni les fichiers ni les résumés, écrits dans l'ordre des graines.
+//
+
+#define DUPGEN_MAX_THREADS 256
+#define DUPGEN_MAX_PATH    1024
+
+// Résumé d'une partie, écrit par le thread qui tient le verrou
+typedef struct {
+    bool done;
+    bool saved;          // Fichier de partie écrit
+    int rounds;
+    int topTotal;
+    int bingos;          // Tops posant tout le chevalet
+    int bestScore;       // Meilleur top de la partie
+    int redraws;         // Tirages rejetés
+} GameSummary;
+
+typedef struct {
+    const Lexicon *lexicon;
+    const char *outputDir;
+    bool gcg;                      // Export GCG à côté de chaque partie
+    uint64_t firstSeed;
+    int gameCount;
+    GameSummary *summaries;
+    int nextGame;                  // Prochaine partie confiée à un thread (atomique)
+    int nextWrite;                 // Prochain résumé écrit (verrou)
+    long roundCount;               // Coups joués par toutes les parties (verrou)
+    FILE *out;
+    pthread_mutex_t lock;
+} Generator;
+
+// Contexte d'un thread : plateau, bonus et partie qui lui sont propres
+typedef struct {
+    Generator *generator;
+    char **board;
+    int boardSize;
+    BonusBoard bonus;
+    DuplicateGame game;
+} Worker;
+
+// Écrit la partie (binaire, et GCG si demandé) ; retourne 0, ou -1 en cas d'erreur
+static int saveGame(const Generator *generator, const DuplicateGame *game, uint64_t seed) {
+    GameRecord record;
+    if (duplicateRecordGame(game, &record) != 0)
+        return -1;
+    char path[DUPGEN_MAX_PATH];
+    snprintf(path, sizeof(path), "%s/dup-%llu.scg", generator->outputDir, (unsigned long long)seed);
+    int status = saveGameRecord(&record, path);
+    if (status == 0 && generator->gcg) {
+        snprintf(path, sizeof(path), "%s/dup-%llu.gcg", generator->outputDir, (unsigned long long)seed);
+        FILE *fp = fopen(path, "w");
+        status = (fp && exportGCG(&record, fp) == 0) ? 0 : -1;
+        if (fp && fclose(fp) != 0)
+            status = -1;
+        if (status != 0)
+            fprintf(stderr, "Erreur d'écriture du fichier %s\n", path);
+    }
+    freeGameRecord(&record);
+    return status;
+}
+
+/*
+ * Fonction : playGame
+ * -------------------
+ * Joue une partie entière : à chaque coup, tirage réglementaire, top, puis top posé.
+ *
+ * Paramètres :
+ *   worker  : le contexte du thread (plateau et partie réutilisés d'une partie à l'autre).
+ *   seed    : la graine du sac.
+ *   summary : le résumé de la partie (sortie).
+ */
+static void playGame(Worker *worker, uint64_t seed, GameSummary *summary) {
+    DuplicateGame *game = &worker->game;
+    for (int y = 0; y < worker->boardSize; y++)
+        memset(worker->board[y], ' ', worker->boardSize);
+    initBonusBoard(worker->bonus);
+    freeDuplicateGame(game);
+    initDuplicateGame(game, worker->generator->lexicon, worker->board, worker->bonus, 0, seed);
+
+    memset(summary, 0, sizeof(GameSummary));
+    while (duplicateStartRound(game) == 0) {
+        const DuplicateRound *round = &game->rounds[game->roundCount];
+        summary->bingos += (round->top.tilesUsed == currentRules->rackSize);
+        if (round->top.score > summary->bestScore)
+            summary->bestScore = round->top.score;
+        summary->redraws += round->redraws;
+        duplicateEndRound(game);
+    }
+    summary->rounds = game->roundCount;
+    summary->topTotal = game->topTotal;
+    summary->saved = saveGame(worker->generator, game, seed) == 0;
+}
+
+// Écrit le résumé d'une partie (verrou tenu)
+static void writeSummary(Generator *generator, int index) {
+    const GameSummary *s = &generator->summaries[index];
+    unsigned long long seed = generator->firstSeed + index;
+    fprintf(generator->out, "{\"seed\":%llu,\"file\":\"%s/dup-%llu.scg\",\"saved\":%s,\"rounds\":%d,"
+                            "\"top\":%d,\"bingos\":%d,\"best\":%d,\"redraws\":%d}\n",
+            seed, generator->outputDir, seed, s->saved ? "true" : "false", s->rounds, s->topTotal,
+            s->bingos, s->bestScore, s->redraws);
+    generator->roundCount += s->rounds;
+}
+
+static void *workerMain(void *arg) {
+    Worker *worker = arg;
+    Generator *generator = worker->generator;
+    for (;;) {
+        int index = __atomic_fetch_add(&generator->nextGame, 1, __ATOMIC_RELAXED);
+        if (index >= generator->gameCount)
+            break;
+        playGame(worker, generator->firstSeed + index, &generator->summaries[index]);
+
+        // Écrit tous les résumés terminés qui suivent le dernier écrit
+        pthread_mutex_lock(&generator->lock);
+        generator->summaries[index].done = true;
+        while (generator->nextWrite < generator->gameCount &&
+               generator->summaries[generator->nextWrite].done) {
+            writeSummary(generator, generator->nextWrite);
+            generator->nextWrite++;
+        }
+        pthread_mutex_unlock(&generator->lock);
+    }
+    return NULL;
+}
+
+static double elapsedSeconds(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-R règles] [-n parties] [-s graine] [-j threads]\n"
+            "          [-o répertoire] [-r résumés.jsonl] [-g]\n"
+            "  -R : fichier de règles (plateau, bonus, lettres), règles standard par défaut\n"
+            "  -s : graine de la première partie (la partie i utilise la graine s + i)\n"
+            "  -o : répertoire des parties (dup-<graine>.scg), créé au besoin\n"
+            "  -r : résumés JSON Lines (sortie standard par défaut)\n"
+            "  -g : écrit aussi l'export GCG de chaque partie\n",
+            prog);
+}
+
+// Fonction principale du générateur
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *summaryFile = NULL;
+    const char *rulesFile = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    Generator generator;
+    memset(&generator, 0, sizeof(generator));
+    generator.outputDir = ".";
+    generator.gameCount = 100;
+    generator.firstSeed = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:R:n:s:j:o:r:gh")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 'n': generator.gameCount = atoi(optarg); break;
+            case 's': generator.firstSeed = strtoull(optarg, NULL, 10); break;
+            case 'j': threads = strtol(optarg, NULL, 10); break;
+            case 'o': generator.outputDir = optarg; break;
+            case 'r': summaryFile = optarg; break;
+            case 'g': generator.gcg = true; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc || generator.gameCount < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > DUPGEN_MAX_THREADS)
+        threads = DUPGEN_MAX_THREADS;
+    Ruleset *rules = NULL;
+    if (rulesFile && !(rules = loadRuleset(rulesFile)))
+        return EXIT_FAILURE;
+    useRuleset(rules);
+    if (mkdir(generator.outputDir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Erreur de création du répertoire %s\n", generator.outputDir);
+        return EXIT_FAILURE;
+    }
+
+    // Arbre lexical : construit une fois, partagé en lecture seule
+    DictionaryEntry *dictionary = loadDictionaryHash(dictionaryFile);
+    if (!dictionary)
+        return EXIT_FAILURE;
+    Lexicon *lexicon = buildLexicon(dictionary);
+    freeDictionaryHash(dictionary);
+    if (!lexicon)
+        return EXIT_FAILURE;
+    generator.lexicon = lexicon;
+
+    generator.out = stdout;
+    if (summaryFile && !(generator.out = fopen(summaryFile, "w"))) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", summaryFile);
+        return EXIT_FAILURE;
+    }
+
+    generator.summaries = calloc(generator.gameCount, sizeof(GameSummary));
+    Worker *workers = calloc(threads, sizeof(Worker));
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    bool ok = generator.summaries && workers && tids;
+    for (long t = 0; ok && t < threads; t++) {
+        workers[t].generator = &generator;
+        initMoveList(&workers[t].game.moves);
+        workers[t].boardSize = currentRules->boardSize;
+        ok = (workers[t].board = initBoard(workers[t].boardSize)) != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return EXIT_FAILURE;
+    }
+    pthread_mutex_init(&generator.lock, NULL);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long started = 0;
+    for (long t = 0; t < threads; t++)
+        if (pthread_create(&tids[t], NULL, workerMain, &workers[t]) == 0)
+            started++;
+    if (started == 0)
+        workerMain(&workers[0]);
+    for (long t = 0; t < started; t++)
+        pthread_join(tids[t], NULL);
+    double seconds = elapsedSeconds(&start);
+    fprintf(stderr, "%d parties, %ld coups en %.3f s (%.0f parties/h, %ld threads)\n",
+            generator.gameCount, generator.roundCount, seconds,
+            seconds > 0 ? generator.gameCount * 3600.0 / seconds : 0.0, threads);
+
+    int status = EXIT_SUCCESS;
+    for (int i = 0; i < generator.gameCount; i++)
+        if (!generator.summaries[i].saved)
+            status = EXIT_FAILURE;
+    if (fflush(generator.out) != 0)
+        status = EXIT_FAILURE;
+    if (generator.out != stdout)
+        fclose(generator.out);
+    pthread_mutex_destroy(&generator.lock);
+    for (long t = 0; t < threads; t++) {
+        freeDuplicateGame(&workers[t].game);
+        freeBoard(workers[t].board, workers[t].boardSize);
+    }
+    free(generator.summaries);
+    free(workers);
+    free(tids);
+    freeLexicon(lexicon);
+    freeRuleset(rules);
+    return status;
+}
@@ -0,0 +1,287 @@
+#include "duplicate.h"
+#include "trace.h"
+
+//
+// ---------------------- Partie en duplicate ---------------------------------
+//
+// Le top est exact : le générateur énumère tous les coups légaux du tirage (jokers compris)
+// avec leur score complet, et le top est le coup de score maximal. Entre deux coups de même
+// score, celui qui pose le plus de lettres est retenu, puis le premier dans l'ordre
+// alphabétique des mots et des positions, de sorte qu'une graine donne toujours la même
+// partie.
+//
+
+// Le Y et le joker complètent indifféremment les voyelles ou les consonnes
+static void countVowels(const char *rack, int *vowels, int *consonants, int *either) {
+    *vowels = *consonants = *either = 0;
+    for (int i = 0; rack[i] != '\0'; i++) {
+        char c = toupper((unsigned char)rack[i]);
+        if (c == 'Y' || c == '?')
+            (*either)++;
+        else if (strchr("AEIOU", c))
+            (*vowels)++;
+        else
+            (*consonants)++;
+    }
+}
+
+// Minimum de voyelles (et de consonnes) exigé au coup round
+static int requiredMinimum(int round) {
+    return (round < DUPLICATE_EARLY_ROUNDS) ? DUPLICATE_EARLY_MINIMUM : 1;
+}
+
+// Vrai si vowels voyelles, consonants consonnes et either lettres mixtes couvrent le minimum
+static bool coversMinimum(int vowels, int consonants, int either, int minimum) {
+    int missing = (vowels < minimum ? minimum - vowels : 0) +
+                  (consonants < minimum ? minimum - consonants : 0);
+    return missing <= either;
+}
+
+bool duplicateRackValid(const char *rack, int round) {
+    int vowels, consonants, either;
+    countVowels(rack, &vowels, &consonants, &either);
+    return coversMinimum(vowels, consonants, either, requiredMinimum(round));
+}
+
+// Vrai si un tirage complet pris dans le sac peut encore atteindre le minimum
+static bool bagCanMeetMinimum(const Bag *bag, int minimum) {
+    int vowels = 0, consonants = 0, either = 0;
+    for (int i = 0; i < LEAVE_ALPHABET; i++) {
+        char c = (i == LEAVE_BLANK) ? '?' : 'A' + i;
+        if (c == 'Y' || c == '?')
+            either += bag->counts[i];
+        else if (strchr("AEIOU", c))
+            vowels += bag->counts[i];
+        else
+            consonants += bag->counts[i];
+    }
+    int rackSize = currentRules->rackSize;
+    int drawn = bag->total < rackSize ? bag->total : rackSize;
+    return drawn >= 2 * minimum && coversMinimum(vowels, consonants, either, minimum);
+}
+
+// Remet tout le tirage dans le sac (tirage rejeté)
+static void returnRack(Bag *bag, char *rack) {
+    for (int i = 0; rack[i] != '\0'; i++)
+        bagReturn(bag, rack[i]);
+    rack[0] = '\0';
+}
+
+/*
+ * Fonction : drawRack
+ * -------------------
+ * Complète le reliquat jusqu'à la taille du chevalet. Un tirage sans le minimum de voyelles
+ * et de consonnes est remis en entier dans le sac (reliquat compris) et un nouveau tirage est
+ * fait.
+ *
+ * Paramètres :
+ *   bag     : le sac de la partie.
+ *   rack    : le reliquat en entrée, le tirage en sortie.
+ *   round   : numéro du coup (0 pour le premier).
+ *   redraws : nombre de tirages rejetés (incrémenté).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si aucun tirage réglementaire ne peut plus être formé.
+ */
+static int drawRack(Bag *bag, char *rack, int round, int *redraws) {
+    int minimum = requiredMinimum(round);
+    for (;;) {
+        bagFillRack(bag, rack);
+        if (duplicateRackValid(rack, round))
+            return 0;
+        returnRack(bag, rack);
+        if (!bagCanMeetMinimum(bag, minimum) || ++*redraws > DUPLICATE_MAX_REDRAWS)
+            return -1;
+    }
+}
+
+// Vrai si a doit être préféré à b comme top
+static bool betterTop(const Move *a, const Move *b) {
+    if (a->score != b->score)
+        return a->score > b->score;
+    if (a->tilesUsed != b->tilesUsed)
+        return a->tilesUsed > b->tilesUsed;
+    int c = strcmp(a->word, b->word);
+    if (c != 0)
+        return c < 0;
+    if (a->y != b->y)
+        return a->y < b->y;
+    if (a->x != b->x)
+        return a->x < b->x;
+    return a->dir < b->dir;
+}
+
+void initDuplicateGame(DuplicateGame *game, const Lexicon *lexicon, char **board,
+                       BonusBoard bonusBoard, int playerCount, uint64_t seed) {
+    memset(game, 0, sizeof(*game));
+    game->lexicon = lexicon;
+    game->board = board;
+    game->boardSize = currentRules->boardSize;
+    game->bonusBoard = bonusBoard;
+    game->playerCount = playerCount < DUPLICATE_MAX_PLAYERS ? playerCount : DUPLICATE_MAX_PLAYERS;
+    bagInit(&game->bag, seed);
+    initMoveList(&game->moves);
+}
+
+void freeDuplicateGame(DuplicateGame *game) {
+    freeMoveList(&game->moves);
+}
+
+/*
+ * Fonction : duplicateStartRound
+ * ------------------------------
+ * Tire le coup suivant et calcule son top. Un tirage sans aucun coup légal est rejeté comme
+ * un tirage sans le minimum de voyelles et de consonnes, tant que le sac permet d'en changer.
+ *
+ * Paramètres :
+ *   game : la partie (le coup précédent doit être terminé).
+ *
+ * Retour :
+ *   0 si un tirage attend les propositions, -1 si la partie est terminée.
+ */
+int duplicateStartRound(DuplicateGame *game) {
+    if (game->over || game->inRound)
+        return game->over ? -1 : 0;
+    if (game->roundCount == DUPLICATE_MAX_ROUNDS) {
+        game->over = true;
+        return -1;
+    }
+    TRACE_BEGIN("duplicateStartRound");
+    DuplicateRound *round = &game->rounds[game->roundCount];
+    memset(round, 0, sizeof(*round));
+    bool firstMove = isBoardEmpty(game->board, game->boardSize);
+    for (;;) {
+        if (drawRack(&game->bag, game->rack, game->roundCount, &round->redraws) != 0)
+            break;
+        generateMoves(game->lexicon, game->board, game->boardSize, game->bonusBoard, game->rack, firstMove,
+                      NULL, &game->moves);
+        if (game->moves.count > 0) {
+            game->inRound = true;
+            break;
+        }
+        // Aucun coup : inutile de retirer si le sac ne contient plus d'autres lettres
+        if (game->bag.total == 0 || ++round->redraws > DUPLICATE_MAX_REDRAWS)
+            break;
+        returnRack(&game->bag, game->rack);
+    }
+    if (!game->inRound) {
+        game->over = true;
+        TRACE_END("duplicateStartRound");
+        return -1;
+    }
+
+    int best = 0;
+    for (int i = 1; i < game->moves.count; i++)
+        if (betterTop(&game->moves.moves[i], &game->moves.moves[best]))
+            best = i;
+    strcpy(round->rack, game->rack);
+    round->moveCount = game->moves.count;
+    round->top = game->moves.moves[best];
+    TRACE_END("duplicateStartRound");
+    return 0;
+}
+
+const Move *duplicateFindMove(const DuplicateGame *game, const char *word, int x, int y, char dir) {
+    return game->inRound ? findMove(&game->moves, word, x, y, dir) : NULL;
+}
+
+void duplicateSubmit(DuplicateGame *game, int player, const Move *move) {
+    if (!game->inRound || player < 0 || player >= game->playerCount)
+        return;
+    DuplicateRound *round = &game->rounds[game->roundCount];
+    round->submitted[player] = (move != NULL);
+    if (move)
+        round->submissions[player] = *move;
+}
+
+/*
+ * Fonction : duplicateEndRound
+ * ----------------------------
+ * Termine le coup en cours : chaque joueur marque les points de sa proposition, le top est
+ * posé sur le plateau (ses cases perdent leur bonus) et ses lettres quittent le tirage.
+ */
+void duplicateEndRound(DuplicateGame *game) {
+    if (!game->inRound)
+        return;
+    DuplicateRound *round = &game->rounds[game->roundCount];
+    for (int p = 0; p < game->playerCount; p++)
+        if (round->submitted[p])
+            game->scores[p] += round->submissions[p].score;
+    game->topTotal += round->top.score;
+
+    const Move *top = &round->top;
+    recordMoveTiles(game->board, top, round->tiles);
+    for (int i = 0; top->word[i] != '\0'; i++) {
+        int x = top->x + (top->dir == 'h' ? i : 0);
+        int y = top->y + (top->dir == 'v' ? i : 0);
+        game->bonusBoard[y][x] = 0;
+    }
+    applyMove(game->board, top, game->rack);
+    game->roundCount++;
+    game->inRound = false;
+}
+
+/*
+ * Fonction : duplicateRecordGame
+ * ------------------------------
+ * Enregistre la partie au format des parties enregistrées : un coup par top, joué par un
+ * joueur unique nommé « Top ». Les lettres tirées après un coup sont celles du tirage suivant
+ * qui ne viennent pas du reliquat ; un tirage rejeté n'est pas enregistré, mais le rack de
+ * chaque coup est toujours celui qui a été proposé aux joueurs.
+ *
+ * Paramètres :
+ *   game   : la partie (les coups terminés seulement sont enregistrés).
+ *   record : la partie enregistrée (initialisée par la fonction).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'erreur.
+ */
+int duplicateRecordGame(const DuplicateGame *game, GameRecord *record) {
+    if (initGameRecord(record, 1, game->boardSize) != 0)
+        return -1;
+    snprintf(record->names[0], RECORD_NAME_SIZE, "Top");
+    for (int r = 0; r < game->roundCount; r++) {
+        const DuplicateRound *round = &game->rounds[r];
+        char drawn[RECORD_RACK_SIZE] = "";
+        if (r + 1 < game->roundCount)
+            recordDrawnTiles(round->rack, round->tiles, game->rounds[r + 1].rack, drawn);
+        if (recordPlay(record, 0, round->rack, round->top.x, round->top.y, round->top.dir,
+                       round->tiles, round->top.score, drawn) != 0) {
+            freeGameRecord(record);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Coordonnées d'un coup : rangée puis colonne à l'horizontale (8H), l'inverse à la verticale
+static void formatPosition(const Move *move, char out[16]) {
+    if (move->dir == 'h')
+        snprintf(out, 16, "%d%c", move->y + 1, 'A' + move->x);
+    else
+        snprintf(out, 16, "%c%d", 'A' + move->x, move->y + 1);
+}
+
+void printDuplicateRound(const DuplicateGame *game, int round) {
+    if (round < 0 || round >= game->roundCount)
+        return;
+    const DuplicateRound *r = &game->rounds[round];
+    char position[16];
+    formatPosition(&r->top, position);
+    printf("[Duplicate] Coup %d, tirage %s", round + 1, r->rack);
+    if (r->redraws > 0)
+        printf(" (%d tirage%s rejeté%s)", r->redraws, r->redraws > 1 ? "s" : "",
+               r->redraws > 1 ? "s" : "");
+    printf(" : top %s %s, %d points parmi %d coups\n", r->top.word, position, r->top.score,
+           r->moveCount);
+    for (int p = 0; p < game->playerCount; p++) {
+        if (!r->submitted[p]) {
+            printf("  joueur %d : aucune proposition, 0 (%+d)\n", p + 1, -r->top.score);
+            continue;
+        }
+        const Move *m = &r->submissions[p];
+        formatPosition(m, position);
+        printf("  joueur %d : %s %s, %d (%+d)\n", p + 1, m->word, position, m->score,
+               m->score - r->top.score);
+    }
+}
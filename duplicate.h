@@ -0,0 +1,87 @@
+#ifndef DUPLICATE_H
+#define DUPLICATE_H
+
+#include "scrabble.h"
+#include "lexicon.h"
+#include "movegen.h"
+#include "bag.h"
+#include "record.h"
+#include "ruleset.h"
+
+//
+// Partie en duplicate
+//
+// Tous les joueurs cherchent, à chaque coup, la meilleure solution avec le même tirage sur le
+// même plateau. Le tirage est complété depuis le sac et doit compter assez de voyelles et de
+// consonnes (DUPLICATE_EARLY_MINIMUM de chaque jusqu'au coup DUPLICATE_EARLY_ROUNDS, une
+// ensuite ; le Y et le joker comptent pour l'une ou l'autre) : sinon il est remis en entier
+// dans le sac et retiré. Le top (le coup de score maximal, mots croisés et prime du scrabble
+// comprise) est ensuite posé sur le plateau, et chaque joueur marque les points de sa propre
+// proposition. La partie s'arrête quand le sac et le reliquat ne permettent plus de former
+// un tirage réglementaire, ou qu'aucun tirage n'offre de coup.
+//
+
+#define DUPLICATE_MAX_PLAYERS   16
+#define DUPLICATE_MAX_ROUNDS    128   // Le sac de 204 lettres du 21 x 21 dépasse 50 coups
+#define DUPLICATE_EARLY_ROUNDS  15    // Coups soumis au minimum renforcé
+#define DUPLICATE_EARLY_MINIMUM 2     // Voyelles et consonnes exigées pendant ces coups
+#define DUPLICATE_MAX_REDRAWS   100   // Tirages rejetés au-delà desquels la partie s'arrête
+
+// Un coup de la partie : le tirage, le top et la proposition de chaque joueur
+typedef struct {
+    char rack[RULESET_MAX_RACK + 1];               // Tirage commun
+    int redraws;                                   // Tirages rejetés avant celui-ci
+    int moveCount;                                 // Coups légaux du tirage
+    Move top;                                      // Coup posé sur le plateau
+    char tiles[RULESET_MAX_RACK + 1];              // Lettres posées par le top (ordre du mot)
+    bool submitted[DUPLICATE_MAX_PLAYERS];         // Le joueur a-t-il proposé un coup valide ?
+    Move submissions[DUPLICATE_MAX_PLAYERS];       // Proposition de chaque joueur
+} DuplicateRound;
+
+typedef struct {
+    const Lexicon *lexicon;
+    char **board;                                  // Plateau partagé (fourni par l'appelant)
+    int boardSize;                                 // Taille du plateau des règles en vigueur
+    int (*bonusBoard)[BOARD_MAX_SIZE];             // Bonus restants, consommés par les tops
+    Bag bag;
+    int playerCount;
+    int scores[DUPLICATE_MAX_PLAYERS];
+    int topTotal;                                  // Somme des tops : le score maximal
+    char rack[RULESET_MAX_RACK + 1];               // Tirage du coup en cours
+    DuplicateRound rounds[DUPLICATE_MAX_ROUNDS];   // rounds[roundCount] : coup en cours
+    int roundCount;                                // Coups terminés
+    bool inRound;                                  // Un tirage attend les propositions
+    bool over;
+    MoveList moves;                                // Coups légaux du tirage en cours
+} DuplicateGame;
+
+// Prépare une partie sur le plateau et les bonus de l'appelant (plateau vide au départ), avec
+// les règles en vigueur
+void initDuplicateGame(DuplicateGame *game, const Lexicon *lexicon, char **board,
+                       BonusBoard bonusBoard, int playerCount, uint64_t seed);
+void freeDuplicateGame(DuplicateGame *game);
+
+// Vrai si le tirage compte le minimum de voyelles et de consonnes exigé au coup round (0..)
+bool duplicateRackValid(const char *rack, int round);
+
+// Tire le coup suivant et calcule son top ; retourne 0, ou -1 si la partie est terminée
+int duplicateStartRound(DuplicateGame *game);
+
+// Coup légal du tirage en cours correspondant au mot posé (meilleur score si le mot peut
+// être formé de plusieurs façons, avec ou sans joker) ; NULL s'il n'existe pas
+const Move *duplicateFindMove(const DuplicateGame *game, const char *word, int x, int y, char dir);
+
+// Proposition d'un joueur pour le coup en cours (NULL : aucune, 0 point)
+void duplicateSubmit(DuplicateGame *game, int player, const Move *move);
+
+// Pose le top, ajoute les points des propositions et termine le coup
+void duplicateEndRound(DuplicateGame *game);
+
+// Enregistre les coups terminés (tirage, lettres posées et score de chaque top) comme une
+// partie d'un seul joueur, « Top » ; retourne 0, ou -1 en cas d'erreur d'allocation
+int duplicateRecordGame(const DuplicateGame *game, GameRecord *record);
+
+// Affiche un coup terminé : tirage, top, et proposition de chaque joueur comparée au top
+void printDuplicateRound(const DuplicateGame *game, int round);
+
+#endif  // DUPLICATE_H
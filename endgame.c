@@ -0,0 +1,863 @@
+#include "endgame.h"
+#include "board.h"
+#include "bag.h"
+#include "trace.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+//
+// ---------------------- Finale et pré-finale -------------------------------
+//
+// Finale : le sac est vide, le rack adverse est donc connu (les lettres invisibles).
+// La recherche est un negamax alpha-bêta sur l'écart final, par approfondissement
+// itératif dans un budget de temps. Les positions sont identifiées par une clé de Zobrist
+// (plateau, racks des deux joueurs, passes consécutives) et mémorisées dans une table de
+// transposition partagée par tous les threads, sans verrou : chaque entrée stocke
+// clé ^ données à côté des données, une écriture concurrente déchirée est donc rejetée.
+//
+// Pré-finale : le sac contient 1 à 7 lettres. Pour chaque coup candidat, tous les tirages
+// distincts (multiensembles pondérés par leur probabilité hypergéométrique) sont examinés.
+// Si le coup vide le sac, le rack adverse devient connu et la finale est résolue. Sinon, le
+// tirage du joueur et les lettres restées dans le sac sont énumérés ensemble : le rack
+// adverse est alors connu dans chaque branche, l'adversaire y cherche sa meilleure réponse,
+// et chaque réponse qui vide le sac mène à une finale résolue à son tour. Seules les
+// réponses qui laissent des lettres dans le sac sont évaluées statiquement.
+//
+
+#define BOUND_EXACT 0
+#define BOUND_LOWER 1
+#define BOUND_UPPER 2
+#define TT_EXACT_BIT (1ULL << 26)
+
+static uint64_t zobristBoard[BOARD_MAX_SIZE * BOARD_MAX_SIZE][52];   // 26 lettres, puis 26 jokers posés
+static uint64_t zobristRack[2][LEAVE_ALPHABET][8];
+static uint64_t zobristPasses[2];
+static pthread_once_t zobristOnce = PTHREAD_ONCE_INIT;
+
+// Tire une fois pour toutes les clés de Zobrist (graine fixe : clés identiques à chaque exécution)
+static void initZobrist(void) {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int c = 0; c < BOARD_MAX_SIZE * BOARD_MAX_SIZE; c++)
+        for (int l = 0; l < 52; l++)
+            zobristBoard[c][l] = nextRandom(&state);
+    for (int p = 0; p < 2; p++)
+        for (int s = 0; s < LEAVE_ALPHABET; s++)
+            for (int n = 0; n < 8; n++)
+                zobristRack[p][s][n] = (n == 0) ? 0 : nextRandom(&state);
+    zobristPasses[0] = 0;
+    zobristPasses[1] = nextRandom(&state);
+}
+
+/*
+ * Fonction : createTranspositionTable
+ * -----------------------------------
+ * Alloue une table de transposition de 2^bits entrées, partageable entre threads.
+ *
+ * Retour :
+ *   La table, ou NULL en cas d'échec d'allocation.
+ */
+TranspositionTable *createTranspositionTable(int bits) {
+    pthread_once(&zobristOnce, initZobrist);
+    TranspositionTable *tt = malloc(sizeof(TranspositionTable));
+    if (!tt) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return NULL;
+    }
+    tt->entries = calloc((size_t)1 << bits, sizeof(TTEntry));
+    if (!tt->entries) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        free(tt);
+        return NULL;
+    }
+    tt->mask = ((uint64_t)1 << bits) - 1;
+    return tt;
+}
+
+void freeTranspositionTable(TranspositionTable *tt) {
+    if (!tt)
+        return;
+    free(tt->entries);
+    free(tt);
+}
+
+// Lecture d'une entrée : les deux mots sont lus séparément, la clé valide leur cohérence
+static bool ttProbe(const TranspositionTable *tt, uint64_t key, uint64_t *data) {
+    TTEntry *entry = &tt->entries[key & tt->mask];
+    uint64_t d = __atomic_load_n(&entry->data, __ATOMIC_RELAXED);
+    uint64_t c = __atomic_load_n(&entry->check, __ATOMIC_RELAXED);
+    if ((c ^ d) != key)
+        return false;
+    *data = d;
+    return true;
+}
+
+// Données : valeur (16 bits), profondeur (8), borne (2), exactitude (1), signature du coup (32)
+static void ttStore(TranspositionTable *tt, uint64_t key, int value, int depth, int bound,
+                    bool exact, uint32_t moveSig) {
+    uint64_t data = (uint64_t)(uint16_t)(value + 32768) | ((uint64_t)depth << 16) |
+                    ((uint64_t)bound << 24) | (exact ? TT_EXACT_BIT : 0) |
+                    ((uint64_t)moveSig << 32);
+    TTEntry *entry = &tt->entries[key & tt->mask];
+    __atomic_store_n(&entry->check, key ^ data, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->data, data, __ATOMIC_RELAXED);
+}
+
+// Somme des valeurs des lettres d'un rack
+static int rackSum(const Ruleset *rules, const char *rack) {
+    int sum = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        sum += rules->tileValue[(unsigned char)rack[i]];
+    return sum;
+}
+
+// Indice de Zobrist d'une lettre posée (un joker, en minuscule, a ses propres clés)
+static inline int tileKey(char c) {
+    return (c >= 'a') ? 26 + (c - 'a') : c - 'A';
+}
+
+// Clé de Zobrist des deux racks (multiensembles : l'ordre des lettres n'importe pas)
+static uint64_t rackKey(const char *toMove, const char *other) {
+    int counts[2][LEAVE_ALPHABET] = { { 0 } };
+    for (int i = 0; toMove[i] != '\0'; i++)
+        counts[0][leaveSymbol(toMove[i])]++;
+    for (int i = 0; other[i] != '\0'; i++)
+        counts[1][leaveSymbol(other[i])]++;
+    uint64_t key = 0;
+    for (int p = 0; p < 2; p++)
+        for (int s = 0; s < LEAVE_ALPHABET; s++)
+            key ^= zobristRack[p][s][counts[p][s]];
+    return key;
+}
+
+// Signature d'un coup (FNV-1a sur la position et le mot) pour l'ordre des coups
+static uint32_t moveSignature(const Move *move) {
+    uint32_t h = 2166136261u;
+    h = (h ^ (uint32_t)move->x) * 16777619u;
+    h = (h ^ (uint32_t)move->y) * 16777619u;
+    h = (h ^ (uint32_t)move->dir) * 16777619u;
+    for (const char *p = move->word; *p != '\0'; p++)
+        h = (h ^ (uint8_t)*p) * 16777619u;
+    return h ? h : 1;
+}
+
+static int compareMoveScores(const void *a, const void *b) {
+    const Move *ma = a, *mb = b;
+    return mb->score - ma->score;
+}
+
+static int compareMoveEquities(const void *a, const void *b) {
+    const Move *ma = a, *mb = b;
+    if (ma->equity != mb->equity)
+        return (ma->equity < mb->equity) ? 1 : -1;
+    return mb->score - ma->score;
+}
+
+// Pose les lettres du coup sur le plateau de travail ; retourne le nombre de cases remplies
+static int placeTiles(char **board, int boardSize, const Move *move, int *cells, uint64_t *key) {
+    int n = 0;
+    int len = strlen(move->word);
+    for (int i = 0; i < len; i++) {
+        int x = move->x + (move->dir == 'h' ? i : 0);
+        int y = move->y + (move->dir == 'h' ? 0 : i);
+        if (board[y][x] != ' ')
+            continue;
+        board[y][x] = move->word[i];
+        cells[n++] = y * boardSize + x;
+        *key ^= zobristBoard[y * boardSize + x][tileKey(move->word[i])];
+    }
+    return n;
+}
+
+static void liftTiles(char **board, int boardSize, const int *cells, int n) {
+    for (int i = 0; i < n; i++)
+        board[cells[i] / boardSize][cells[i] % boardSize] = ' ';
+}
+
+// Rack restant après le coup (positions de usedMask retirées)
+static void removeUsed(const char *rack, int usedMask, char *out) {
+    int j = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        if (!(usedMask & (1 << i)))
+            out[j++] = rack[i];
+    out[j] = '\0';
+}
+
+static double elapsedMs(const struct timespec *from, const struct timespec *to) {
+    return (to->tv_sec - from->tv_sec) * 1e3 + (to->tv_nsec - from->tv_nsec) / 1e6;
+}
+
+static bool timeUp(EndgameSearch *search) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return elapsedMs(&search->deadline, &now) >= 0.0;
+}
+
+/*
+ * Fonction : initEndgameSearch
+ * ----------------------------
+ * Prépare le contexte de recherche d'un thread : plateau de travail et listes de coups.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+int initEndgameSearch(EndgameSearch *search, const Lexicon *lexicon, int boardSize,
+                      BonusBoard bonusBoard, TranspositionTable *tt) {
+    pthread_once(&zobristOnce, initZobrist);
+    search->lexicon = lexicon;
+    search->rules = currentRules;
+    search->boardSize = boardSize;
+    search->bonusBoard = bonusBoard;
+    search->tt = tt;
+    search->nodes = 0;
+    for (int i = 0; i <= ENDGAME_MAX_PLY; i++)
+        initMoveList(&search->lists[i]);
+    search->board = initBoard(boardSize);
+    return search->board ? 0 : -1;
+}
+
+void freeEndgameSearch(EndgameSearch *search) {
+    for (int i = 0; i <= ENDGAME_MAX_PLY; i++)
+        freeMoveList(&search->lists[i]);
+    freeBoard(search->board, search->boardSize);
+    search->board = NULL;
+}
+
+// Évaluation à l'horizon : le meilleur gain immédiat du joueur au trait
+static int horizonValue(EndgameSearch *search, const char *toMove, const char *other) {
+    MoveList *list = &search->lists[ENDGAME_MAX_PLY];
+    generateMovesWithRules(search->rules, search->lexicon, search->board, search->boardSize,
+                           search->bonusBoard, toMove, false, NULL, list);
+    int rackLen = strlen(toMove);
+    int best = -rackSum(search->rules, toMove);
+    for (int i = 0; i < list->count; i++) {
+        const Move *m = &list->moves[i];
+        int value = m->score + (m->tilesUsed == rackLen ? 2 * rackSum(search->rules, other) : 0);
+        if (value > best)
+            best = value;
+    }
+    return best;
+}
+
+/*
+ * Fonction : negamax
+ * ------------------
+ * Recherche alpha-bêta. La valeur est l'écart de points que le joueur au trait réalisera
+ * d'ici la fin de la partie. Finir son rack rapporte deux fois la valeur du rack adverse ;
+ * deux passes consécutives terminent la partie, chacun perdant la valeur de son rack.
+ */
+static int negamax(EndgameSearch *search, const char *toMove, const char *other, int passes,
+                   int depth, int ply, int alpha, int beta, uint64_t boardKey,
+                   Move *rootMove, bool *rootPass) {
+    search->nodes++;
+    if (passes >= 2)
+        return rackSum(search->rules, other) - rackSum(search->rules, toMove);
+    if (depth == 0 || ply >= ENDGAME_MAX_PLY) {
+        search->horizon = true;
+        return horizonValue(search, toMove, other);
+    }
+    if (ply > 0 && timeUp(search)) {
+        search->timedOut = true;
+        return 0;
+    }
+
+    uint64_t key = boardKey ^ rackKey(toMove, other) ^ zobristPasses[passes];
+    uint32_t ttMove = 0;
+    uint64_t data;
+    if (ttProbe(search->tt, key, &data)) {
+        int value = (int)(data & 0xFFFF) - 32768;
+        int storedDepth = (int)((data >> 16) & 0xFF);
+        int bound = (int)((data >> 24) & 3);
+        bool exact = (data & TT_EXACT_BIT) != 0;
+        ttMove = (uint32_t)(data >> 32);
+        if (ply > 0 && (storedDepth >= depth || exact)) {
+            if (bound == BOUND_LOWER && value > alpha)
+                alpha = value;
+            else if (bound == BOUND_UPPER && value < beta)
+                beta = value;
+            if (bound == BOUND_EXACT || alpha >= beta) {
+                search->horizon |= !exact;
+                return value;
+            }
+        }
+    }
+
+    MoveList *list = &search->lists[ply];
+    generateMovesWithRules(search->rules, search->lexicon, search->board, search->boardSize,
+                           search->bonusBoard, toMove, false, NULL, list);
+    qsort(list->moves, list->count, sizeof(Move), compareMoveScores);
+    for (int i = 1; ttMove && i < list->count; i++) {
+        if (moveSignature(&list->moves[i]) == ttMove) {
+            Move tmp = list->moves[0];
+            list->moves[0] = list->moves[i];
+            list->moves[i] = tmp;
+            break;
+        }
+    }
+
+    int alphaOrig = alpha;
+    int best = INT32_MIN;
+    uint32_t bestSig = 0;
+    int otherSum = rackSum(search->rules, other);
+    bool parentHorizon = search->horizon;
+    search->horizon = false;
+
+    // Les coups, puis la passe (indice list->count)
+    for (int i = 0; i <= list->count; i++) {
+        int value;
+        if (i < list->count) {
+            const Move *m = &list->moves[i];
+            char after[8];
+            int cells[7];
+            uint64_t childKey = boardKey;
+            removeUsed(toMove, m->usedMask, after);
+            if (after[0] == '\0') {
+                value = m->score + 2 * otherSum;
+            } else {
+                int n = placeTiles(search->board, search->boardSize, m, cells, &childKey);
+                value = m->score - negamax(search, other, after, 0, depth - 1, ply + 1,
+                                           m->score - beta, m->score - alpha, childKey,
+                                           NULL, NULL);
+                liftTiles(search->board, search->boardSize, cells, n);
+            }
+        } else {
+            value = -negamax(search, other, toMove, passes + 1, depth - 1, ply + 1,
+                             -beta, -alpha, boardKey, NULL, NULL);
+        }
+        if (search->timedOut)
+            return 0;
+        if (value > best) {
+            best = value;
+            bestSig = (i < list->count) ? moveSignature(&list->moves[i]) : 0;
+            if (rootMove) {
+                *rootPass = (i == list->count);
+                if (!*rootPass)
+                    *rootMove = list->moves[i];
+            }
+        }
+        if (best > alpha)
+            alpha = best;
+        if (alpha >= beta)
+            break;
+    }
+
+    bool exact = !search->horizon;
+    search->horizon |= parentHorizon;
+    int bound = (best <= alphaOrig) ? BOUND_UPPER : (best >= beta) ? BOUND_LOWER : BOUND_EXACT;
+    ttStore(search->tt, key, best, depth, bound, exact, bestSig);
+    return best;
+}
+
+/*
+ * Fonction : solveEndgame
+ * -----------------------
+ * Résout une finale (sac vide) par approfondissement itératif : chaque itération terminée
+ * dans le budget remplace le résultat précédent, et la recherche s'arrête dès qu'une
+ * itération atteint la fin de partie dans toutes les variantes.
+ *
+ * Paramètres :
+ *   search     : contexte du thread (initEndgameSearch).
+ *   board      : le plateau (copié : il n'est pas modifié).
+ *   rackToMove : rack du joueur au trait.
+ *   rackOther  : rack de l'adversaire.
+ *   budgetMs   : budget de temps ; la première itération est toujours terminée.
+ *   result     : résultat de la dernière itération terminée.
+ */
+void solveEndgame(EndgameSearch *search, char **board, const char *rackToMove,
+                  const char *rackOther, double budgetMs, EndgameResult *result) {
+    TRACE_BEGIN("solveEndgame");
+    int size = search->boardSize;
+    uint64_t boardKey = 0;
+    for (int y = 0; y < size; y++) {
+        memcpy(search->board[y], board[y], size);
+        for (int x = 0; x < size; x++) {
+            char c = board[y][x];
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+                boardKey ^= zobristBoard[y * size + x][tileKey(c)];
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &search->deadline);
+    long long ns = search->deadline.tv_nsec + (long long)(budgetMs * 1e6);
+    search->deadline.tv_sec += ns / 1000000000LL;
+    search->deadline.tv_nsec = ns % 1000000000LL;
+
+    memset(result, 0, sizeof(EndgameResult));
+    result->pass = true;
+    uint64_t startNodes = search->nodes;
+    for (int depth = 1; depth <= ENDGAME_MAX_PLY; depth++) {
+        Move move;
+        bool pass = true;
+        search->timedOut = false;
+        search->horizon = false;
+        TRACE_BEGIN("iteration");
+        int value = negamax(search, rackToMove, rackOther, 0, depth, 0, -32000, 32000,
+                            boardKey, &move, &pass);
+        TRACE_END("iteration");
+        if (search->timedOut)
+            break;
+        result->value = value;
+        result->depth = depth;
+        result->pass = pass;
+        if (!pass)
+            result->best = move;
+        result->exact = !search->horizon;
+        if (result->exact)
+            break;
+    }
+    result->nodes = search->nodes - startNodes;
+    TRACE_END("solveEndgame");
+}
+
+//
+// ---------------------- Pré-finale --------------------------------------------
+//
+
+// Un tirage à examiner pour un coup candidat
+typedef struct {
+    int candidate;
+    char drawn[8];       // Lettres tirées après le coup
+    char bag[8];         // Lettres restées dans le sac (vide si le coup vide le sac)
+    double weight;       // Probabilité du tirage
+    bool solve;          // Le coup vide le sac : la finale est résolue
+    bool estimated;      // La réponse adverse retenue laisse le sac non vide (évaluation statique)
+    double spread;       // Écart final (ou estimé) de la branche
+    double win;          // Gain (1), nul (0,5) ou défaite (0) ; probabilité pour les statiques
+    bool exact;
+} PreEndgameJob;
+
+// Données partagées par les threads de la pré-finale
+typedef struct {
+    const Lexicon *lexicon;
+    const Ruleset *rules;
+    char **board;
+    int boardSize;
+    int (*bonusBoard)[BOARD_MAX_SIZE];
+    const LeaveTable *leaves;
+    const char *rack;
+    const int *unseen;
+    int spread;
+    const PreEndgameCandidate *candidates;
+    const float *rackLeaves;
+    PreEndgameJob *jobs;
+    int jobCount;
+    int nextJob;          // Prochain tirage à traiter (incrément atomique)
+    TranspositionTable *tt;
+    double budgetMs;
+    int replies;
+} PreEndgameShared;
+
+// Liste dynamique de tirages
+typedef struct {
+    PreEndgameJob *jobs;
+    int count;
+    int capacity;
+} JobList;
+
+static PreEndgameJob *pushJob(JobList *list) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 256;
+        PreEndgameJob *jobs = realloc(list->jobs, capacity * sizeof(PreEndgameJob));
+        if (!jobs) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            return NULL;
+        }
+        list->jobs = jobs;
+        list->capacity = capacity;
+    }
+    PreEndgameJob *job = &list->jobs[list->count++];
+    memset(job, 0, sizeof(PreEndgameJob));
+    return job;
+}
+
+// Multiensemble de lettres tirées et sa probabilité
+typedef struct {
+    char letters[8];
+    double weight;
+} Draw;
+
+typedef struct {
+    Draw *draws;
+    int count;
+    int capacity;
+} DrawList;
+
+static double binomialD(int n, int k) {
+    if (k < 0 || k > n)
+        return 0.0;
+    double result = 1.0;
+    for (int i = 1; i <= k; i++)
+        result = result * (n - k + i) / i;
+    return result;
+}
+
+// Énumère les multiensembles de lettres tirables, avec leur nombre de façons d'être tirés
+static bool enumerateDraws(DrawList *list, const int *unseen, int symbol, int remaining,
+                           char *drawn, int drawnLen, double ways, double total) {
+    if (remaining == 0) {
+        if (list->count == list->capacity) {
+            int capacity = list->capacity ? list->capacity * 2 : 64;
+            Draw *draws = realloc(list->draws, capacity * sizeof(Draw));
+            if (!draws) {
+                fprintf(stderr, "Erreur d'allocation mémoire.\n");
+                return false;
+            }
+            list->draws = draws;
+            list->capacity = capacity;
+        }
+        Draw *draw = &list->draws[list->count++];
+        memcpy(draw->letters, drawn, drawnLen);
+        draw->letters[drawnLen] = '\0';
+        draw->weight = ways / total;
+        return true;
+    }
+    if (symbol >= LEAVE_ALPHABET)
+        return true;
+    char letter = (symbol == LEAVE_BLANK) ? '?' : 'A' + symbol;
+    for (int k = 0; k <= unseen[symbol] && k <= remaining; k++) {
+        for (int i = 0; i < k; i++)
+            drawn[drawnLen + i] = letter;
+        if (!enumerateDraws(list, unseen, symbol + 1, remaining - k, drawn, drawnLen + k,
+                            ways * binomialD(unseen[symbol], k), total))
+            return false;
+    }
+    return true;
+}
+
+// Tous les tirages de k lettres parmi counts (total lettres), dans list (vidée)
+static bool listDraws(DrawList *list, const int *counts, int total, int k) {
+    char drawn[8];
+    list->count = 0;
+    return enumerateDraws(list, counts, 0, k, drawn, 0, 1.0, binomialD(total, k));
+}
+
+// Retire les lettres d'un tirage d'un décompte par symbole
+static void removeDrawn(int *counts, const char *letters) {
+    for (int i = 0; letters[i] != '\0'; i++)
+        counts[leaveSymbol(letters[i])]--;
+}
+
+// Rack adverse : les lettres invisibles qui ne sont ni tirées par le joueur, ni dans le sac
+static void opponentRack(const int *unseen, const PreEndgameJob *job, char *out) {
+    int counts[LEAVE_ALPHABET];
+    memcpy(counts, unseen, sizeof(counts));
+    removeDrawn(counts, job->drawn);
+    removeDrawn(counts, job->bag);
+    int n = 0;
+    for (int s = 0; s < LEAVE_ALPHABET; s++)
+        for (int k = 0; k < counts[s] && n < 7; k++)
+            out[n++] = (s == LEAVE_BLANK) ? '?' : 'A' + s;
+    out[n] = '\0';
+}
+
+static double staticWin(double spread) {
+    return 1.0 / (1.0 + exp(-spread / PREENDGAME_SPREAD_SCALE));
+}
+
+/*
+ * Fonction : searchReplies
+ * ------------------------
+ * Branche d'un coup qui ne vide pas le sac : le rack adverse et le sac restant sont fixés
+ * par le tirage. L'adversaire choisit, parmi ses meilleures réponses en équité (et la passe),
+ * celle qui minimise notre écart. Une réponse qui vide le sac donne une finale à information
+ * complète, résolue avec une part du budget de la branche ; les autres sont évaluées
+ * statiquement (score, reliquats des deux joueurs).
+ */
+static void searchReplies(PreEndgameShared *shared, EndgameSearch *search, char **work,
+                          MoveList *replies, const char *mine, PreEndgameJob *job) {
+    char opponent[8];
+    opponentRack(shared->unseen, job, opponent);
+    float opponentLeaves[LEAVE_RACK_SUBSETS];
+    leavePrepareRack(shared->leaves, opponent, opponentLeaves);
+    generateMovesWithRules(shared->rules, shared->lexicon, work, shared->boardSize,
+                           shared->bonusBoard, opponent, false, opponentLeaves, replies);
+    qsort(replies->moves, replies->count, sizeof(Move), compareMoveEquities);
+    int examined = replies->count;
+    if (shared->replies > 0 && shared->replies < examined)
+        examined = shared->replies;
+    int bagLen = strlen(job->bag);
+    int solves = 0;
+    for (int i = 0; i < examined; i++)
+        solves += replies->moves[i].tilesUsed >= bagLen;
+    double budgetMs = shared->budgetMs / (solves > 0 ? solves : 1);
+
+    // La passe adverse laisse le sac en l'état
+    double base = shared->spread + shared->candidates[job->candidate].move.score;
+    double ownLeave = shared->rackLeaves[job->candidate];
+    job->spread = base + ownLeave;
+    job->estimated = true;
+    job->exact = false;
+    for (int i = 0; i < examined; i++) {
+        const Move *reply = &replies->moves[i];
+        double value;
+        bool solved = reply->tilesUsed >= bagLen;
+        bool exact = false;
+        if (solved) {
+            // L'adversaire vide le sac : il complète son rack avec les lettres restantes
+            char after[16];
+            int cells[7];
+            uint64_t key = 0;
+            removeUsed(opponent, reply->usedMask, after);
+            strcat(after, job->bag);
+            int n = placeTiles(work, shared->boardSize, reply, cells, &key);
+            EndgameResult result;
+            solveEndgame(search, work, mine, after, budgetMs, &result);
+            liftTiles(work, shared->boardSize, cells, n);
+            value = base - reply->score + result.value;
+            exact = result.exact;
+        } else {
+            value = base + ownLeave - reply->equity;
+        }
+        if (value < job->spread) {
+            job->spread = value;
+            job->estimated = !solved;
+            job->exact = exact;
+        }
+    }
+    job->win = job->estimated ? staticWin(job->spread)
+                              : (job->spread > 0) ? 1.0 : (job->spread == 0) ? 0.5 : 0.0;
+}
+
+// Traite un tirage : pose le coup, complète le rack et résout la finale (ou cherche la réponse)
+static void runJob(PreEndgameShared *shared, EndgameSearch *search, char **work,
+                   MoveList *replies, PreEndgameJob *job) {
+    const Move *move = &shared->candidates[job->candidate].move;
+    double base = shared->spread + move->score;
+    for (int y = 0; y < shared->boardSize; y++)
+        memcpy(work[y], shared->board[y], shared->boardSize);
+    char mine[16];
+    strcpy(mine, shared->rack);
+    applyMove(work, move, mine);
+    strcat(mine, job->drawn);
+    if (!job->solve) {
+        searchReplies(shared, search, work, replies, mine, job);
+        return;
+    }
+
+    // L'adversaire tient toutes les lettres invisibles qui n'ont pas été tirées
+    char opponent[8];
+    opponentRack(shared->unseen, job, opponent);
+    if (mine[0] == '\0') {
+        // Le coup a vidé le rack et le sac : la partie est finie
+        job->spread = base + 2 * rackSum(shared->rules, opponent);
+        job->exact = true;
+    } else {
+        EndgameResult result;
+        solveEndgame(search, work, opponent, mine, shared->budgetMs, &result);
+        job->spread = base - result.value;
+        job->exact = result.exact;
+    }
+    job->win = (job->spread > 0) ? 1.0 : (job->spread == 0) ? 0.5 : 0.0;
+}
+
+static void *preEndgameWorker(void *arg) {
+    PreEndgameShared *shared = arg;
+    traceSetThreadName("preEndgame");
+    EndgameSearch search;
+    char **work = initBoard(shared->boardSize);
+    if (!work || initEndgameSearch(&search, shared->lexicon, shared->boardSize,
+                                   shared->bonusBoard, shared->tt) != 0) {
+        freeBoard(work, shared->boardSize);
+        return NULL;
+    }
+    search.rules = shared->rules;
+    MoveList replies;
+    initMoveList(&replies);
+    for (;;) {
+        int j = __atomic_fetch_add(&shared->nextJob, 1, __ATOMIC_RELAXED);
+        if (j >= shared->jobCount)
+            break;
+        runJob(shared, &search, work, &replies, &shared->jobs[j]);
+    }
+    freeMoveList(&replies);
+    freeEndgameSearch(&search);
+    freeBoard(work, shared->boardSize);
+    return NULL;
+}
+
+void defaultPreEndgameOptions(PreEndgameOptions *options) {
+    options->candidates = 8;
+    options->threads = 0;
+    options->branchBudgetMs = 20.0;
+    options->ttBits = ENDGAME_TT_BITS;
+    options->replies = 4;
+    options->rules = NULL;
+}
+
+static int compareCandidates(const void *a, const void *b) {
+    const PreEndgameCandidate *ca = a, *cb = b;
+    if (ca->winProbability != cb->winProbability)
+        return (ca->winProbability < cb->winProbability) ? 1 : -1;
+    if (ca->expectedSpread != cb->expectedSpread)
+        return (ca->expectedSpread < cb->expectedSpread) ? 1 : -1;
+    return 0;
+}
+
+/*
+ * Fonction : solvePreEndgame
+ * --------------------------
+ * Mode pré-finale (1 à 7 lettres dans le sac). Les meilleurs coups en équité sont retenus ;
+ * pour chacun, tous les tirages distincts des lettres invisibles sont énumérés avec leur
+ * probabilité hypergéométrique. Un coup qui vide le sac donne une finale à information
+ * complète, résolue dans le budget de temps de la branche. Un coup qui ne le vide pas est
+ * examiné pour chaque couple (tirage, lettres restées dans le sac) : la réponse adverse
+ * est cherchée sur le rack adverse de la branche (searchReplies), les finales qu'elle
+ * ouvre se partageant le budget de la branche. Les threads se répartissent les branches
+ * et partagent la table de transposition.
+ *
+ * Remarque :
+ *   - Le nombre de branches d'un coup qui ne vide pas le sac croît vite avec la taille du
+ *     sac (quelques centaines pour 2 lettres, plusieurs milliers dès 4) : le temps total est
+ *     de l'ordre de branches x branchBudgetMs / threads.
+ *
+ * Paramètres :
+ *   lexicon    : le lexique.
+ *   board      : le plateau (non modifié).
+ *   boardSize  : taille du plateau.
+ *   bonusBoard : les cases bonus.
+ *   leaves     : table des reliquats (choix des candidats, branches statiques ; peut être NULL).
+ *   rack       : le rack du joueur.
+ *   unseen     : lettres invisibles (sac + rack adverse).
+ *   bagCount   : nombre de lettres dans le sac (1..7).
+ *   spread     : écart actuel (score du joueur - score adverse).
+ *   options    : options de l'analyse.
+ *   out        : candidats analysés, triés par probabilité de gain décroissante.
+ *   maxOut     : capacité de out.
+ *
+ * Retour :
+ *   Le nombre de candidats analysés, ou -1 en cas d'erreur.
+ */
+int solvePreEndgame(const Lexicon *lexicon, char **board, int boardSize, BonusBoard bonusBoard,
+                    const LeaveTable *leaves, const char *rack, const int unseen[LEAVE_ALPHABET],
+                    int bagCount, int spread, const PreEndgameOptions *options,
+                    PreEndgameCandidate *out, int maxOut) {
+    int unseenTotal = 0;
+    for (int s = 0; s < LEAVE_ALPHABET; s++)
+        unseenTotal += unseen[s];
+    if (bagCount < 1 || bagCount > PREENDGAME_MAX_BAG || unseenTotal - bagCount < 1 ||
+        unseenTotal - bagCount > 7) {
+        fprintf(stderr, "Erreur : la pré-finale demande 1 à 7 lettres dans le sac "
+                        "(sac : %d, lettres invisibles : %d).\n", bagCount, unseenTotal);
+        return -1;
+    }
+
+    TRACE_BEGIN("solvePreEndgame");
+    const Ruleset *rules = options->rules ? options->rules : currentRules;
+
+    // Coups candidats : les meilleurs en équité
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    leavePrepareRack(leaves, rack, rackLeaves);
+    MoveList list;
+    initMoveList(&list);
+    generateMovesWithRules(rules, lexicon, board, boardSize, bonusBoard, rack,
+                           isBoardEmpty(board, boardSize), rackLeaves, &list);
+    qsort(list.moves, list.count, sizeof(Move), compareMoveEquities);
+    int wanted = (options->candidates < maxOut) ? options->candidates : maxOut;
+    int count = 0;
+    int fullMask = (1 << strlen(rack)) - 1;
+    float candidateLeaves[LEAVE_RACK_SUBSETS];
+    for (int i = 0; i < list.count && count < wanted; i++) {
+        // Les coups d'une seule lettre sont générés deux fois (une par direction)
+        bool duplicate = false;
+        for (int j = 0; j < count && !duplicate; j++)
+            duplicate = out[j].move.score == list.moves[i].score &&
+                        out[j].move.usedMask == list.moves[i].usedMask &&
+                        list.moves[i].tilesUsed == 1;
+        if (duplicate)
+            continue;
+        memset(&out[count], 0, sizeof(PreEndgameCandidate));
+        out[count].move = list.moves[i];
+        candidateLeaves[count] = rackLeaves[fullMask & ~list.moves[i].usedMask];
+        count++;
+    }
+    freeMoveList(&list);
+
+    // Tirages de chaque candidat : si le coup ne vide pas le sac, le tirage du joueur puis
+    // les lettres restées dans le sac (le reste forme le rack adverse)
+    JobList jobs = { NULL, 0, 0 };
+    DrawList draws = { NULL, 0, 0 }, bags = { NULL, 0, 0 };
+    bool ok = true;
+    for (int c = 0; c < count && ok; c++) {
+        int drawCount = out[c].move.tilesUsed;
+        if (drawCount >= bagCount) {
+            ok = listDraws(&draws, unseen, unseenTotal, bagCount);
+            for (int d = 0; ok && d < draws.count; d++) {
+                PreEndgameJob *job = pushJob(&jobs);
+                ok = job != NULL;
+                if (ok) {
+                    job->candidate = c;
+                    strcpy(job->drawn, draws.draws[d].letters);
+                    job->weight = draws.draws[d].weight;
+                    job->solve = true;
+                }
+            }
+            continue;
+        }
+        ok = listDraws(&draws, unseen, unseenTotal, drawCount);
+        for (int d = 0; ok && d < draws.count; d++) {
+            int rest[LEAVE_ALPHABET];
+            memcpy(rest, unseen, sizeof(rest));
+            removeDrawn(rest, draws.draws[d].letters);
+            ok = listDraws(&bags, rest, unseenTotal - drawCount, bagCount - drawCount);
+            for (int b = 0; ok && b < bags.count; b++) {
+                PreEndgameJob *job = pushJob(&jobs);
+                ok = job != NULL;
+                if (ok) {
+                    job->candidate = c;
+                    strcpy(job->drawn, draws.draws[d].letters);
+                    strcpy(job->bag, bags.draws[b].letters);
+                    job->weight = draws.draws[d].weight * bags.draws[b].weight;
+                }
+            }
+        }
+    }
+    free(draws.draws);
+    free(bags.draws);
+
+    TranspositionTable *tt = ok ? createTranspositionTable(options->ttBits) : NULL;
+    if (!tt) {
+        free(jobs.jobs);
+        TRACE_END("solvePreEndgame");
+        return -1;
+    }
+
+    PreEndgameShared shared = {
+        .lexicon = lexicon, .rules = rules, .board = board, .boardSize = boardSize, .bonusBoard = bonusBoard,
+        .leaves = leaves, .rack = rack, .unseen = unseen, .spread = spread, .candidates = out,
+        .rackLeaves = candidateLeaves, .jobs = jobs.jobs, .jobCount = jobs.count,
+        .nextJob = 0, .tt = tt, .budgetMs = options->branchBudgetMs,
+        .replies = options->replies
+    };
+    int threads = options->threads > 0 ? options->threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1)
+        threads = 1;
+    if (threads > jobs.count)
+        threads = jobs.count > 0 ? jobs.count : 1;
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    int started = 0;
+    for (int t = 0; tids && t < threads; t++)
+        if (pthread_create(&tids[t], NULL, preEndgameWorker, &shared) == 0)
+            started++;
+    if (started == 0)
+        preEndgameWorker(&shared);
+    for (int t = 0; t < started; t++)
+        pthread_join(tids[t], NULL);
+    free(tids);
+
+    // Agrégation par candidat
+    for (int j = 0; j < jobs.count; j++) {
+        const PreEndgameJob *job = &jobs.jobs[j];
+        PreEndgameCandidate *c = &out[job->candidate];
+        c->draws++;
+        c->staticDraws += job->estimated;
+        c->exactDraws += job->exact;
+        c->winProbability += job->weight * job->win;
+        c->expectedSpread += job->weight * job->spread;
+    }
+    qsort(out, count, sizeof(PreEndgameCandidate), compareCandidates);
+
+    freeTranspositionTable(tt);
+    free(jobs.jobs);
+    TRACE_END("solvePreEndgame");
+    return count;
+}
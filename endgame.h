@@ -0,0 +1,94 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "scrabble.h"
+#include "leave.h"
+#include "lexicon.h"
+#include "movegen.h"
+
+// Profondeur maximale de la recherche (demi-coups)
+#define ENDGAME_MAX_PLY   24
+// Taille par défaut de la table de transposition (2^bits entrées)
+#define ENDGAME_TT_BITS   20
+// Nombre maximal de lettres dans le sac pour le mode pré-finale
+#define PREENDGAME_MAX_BAG 7
+// Échelle (points) de la probabilité de gain logistique des branches évaluées statiquement :
+// 1 / (1 + exp(-écart / échelle)), soit environ 3 chances sur 4 pour 13 points d'avance
+#define PREENDGAME_SPREAD_SCALE 12.0
+
+// Table de transposition partagée sans verrou (chaque entrée : clé ^ données, données)
+typedef struct {
+    uint64_t check;
+    uint64_t data;
+} TTEntry;
+
+typedef struct {
+    TTEntry *entries;
+    uint64_t mask;
+} TranspositionTable;
+
+TranspositionTable *createTranspositionTable(int bits);
+void freeTranspositionTable(TranspositionTable *tt);
+
+// Résultat d'une recherche de finale (sac vide, racks connus)
+typedef struct {
+    int value;        // Écart final (points) du point de vue du joueur au trait
+    int depth;        // Profondeur de la dernière itération terminée
+    bool exact;       // Vrai si la fin de partie a été atteinte dans toutes les variantes
+    bool pass;        // Le meilleur coup est de passer
+    Move best;        // Meilleur coup (si pass est faux)
+    uint64_t nodes;
+} EndgameResult;
+
+// Contexte de recherche d'un thread (plateau de travail et listes de coups par demi-coup)
+typedef struct {
+    const Lexicon *lexicon;
+    const Ruleset *rules;   // Règles du jeu (currentRules à l'initialisation)
+    int boardSize;
+    int (*bonusBoard)[BOARD_MAX_SIZE];
+    TranspositionTable *tt;
+    char **board;
+    MoveList lists[ENDGAME_MAX_PLY + 1];
+    struct timespec deadline;
+    bool timedOut;
+    bool horizon;     // Une feuille a été évaluée avant la fin de partie
+    uint64_t nodes;
+} EndgameSearch;
+
+int initEndgameSearch(EndgameSearch *search, const Lexicon *lexicon, int boardSize,
+                      BonusBoard bonusBoard, TranspositionTable *tt);
+void freeEndgameSearch(EndgameSearch *search);
+
+// Résout la finale par approfondissement itératif dans le budget de temps donné
+void solveEndgame(EndgameSearch *search, char **board, const char *rackToMove,
+                  const char *rackOther, double budgetMs, EndgameResult *result);
+
+// Options du mode pré-finale (1 à 7 lettres dans le sac)
+typedef struct {
+    int candidates;         // Nombre de coups candidats examinés (les meilleurs en équité)
+    int threads;            // Nombre de threads (0 : nombre de processeurs)
+    double branchBudgetMs;  // Budget de temps de chaque finale résolue
+    int ttBits;             // Taille de la table de transposition partagée
+    int replies;            // Réponses adverses examinées si le coup ne vide pas le sac (0 : toutes)
+    const Ruleset *rules;   // Règles du jeu (NULL : currentRules)
+} PreEndgameOptions;
+
+// Évaluation d'un coup candidat sur tous les tirages possibles
+typedef struct {
+    Move move;
+    int draws;              // Nombre de branches examinées (tirage, et sac restant si non vidé)
+    int staticDraws;        // Branches dont la réponse adverse retenue laisse le sac non vide
+    int exactDraws;         // Branches dont la finale retenue est résolue jusqu'au bout
+    double winProbability;
+    double expectedSpread;
+} PreEndgameCandidate;
+
+void defaultPreEndgameOptions(PreEndgameOptions *options);
+
+// Analyse les meilleurs coups du rack ; retourne le nombre de candidats (triés), -1 si erreur
+int solvePreEndgame(const Lexicon *lexicon, char **board, int boardSize, BonusBoard bonusBoard,
+                    const LeaveTable *leaves, const char *rack, const int unseen[LEAVE_ALPHABET],
+                    int bagCount, int spread, const PreEndgameOptions *options,
+                    PreEndgameCandidate *out, int maxOut);
+
+#endif  // ENDGAME_H
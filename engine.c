@@ -0,0 +1,483 @@
+#include "board.h"            // Plateau ; règles standard et chargement d'un fichier de règles
+#include "dictionary.h"       // Chargement du dictionnaire
+#include "lexicon.h"          // Arbre lexical utilisé par le générateur
+#include "movegen.h"          // Génération de tous les coups légaux
+#include "leave.h"            // Table des valeurs de reliquat
+#include "bag.h"              // Décompte des lettres invisibles
+#include "endgame.h"          // Finale et pré-finale
+#include "stats.h"            // Compteurs d'instrumentation (SCRABBLE_STATS)
+#include "trace.h"            // Traces chronologiques (SCRABBLE_TRACE)
+#include "scrabble_engine.h"  // Interface publique (sans SDL)
+
+_Static_assert(SCRABBLE_MAX_WORD == MOVE_MAX_WORD, "ScrabbleMove.word doit recevoir tout mot généré");
+_Static_assert(SCRABBLE_MAX_BOARD_SIZE == BOARD_MAX_SIZE, "Taille maximale du plateau incohérente");
+
+//
+// ---------------------- Interface publique du moteur ------------------------
+//
+// Enveloppe les modules internes derrière des pointeurs opaques. Le plateau et les bonus
+// ne vivent que dans la position : deux positions sont indépendantes et peuvent être
+// analysées en parallèle avec le même moteur. Les règles appartiennent au moteur et sont
+// passées explicitement au générateur : rien ne passe par les règles globales du processus
+// (currentRules), que les outils internes restent libres de choisir.
+//
+
+struct ScrabbleEngine {
+    Lexicon *lexicon;
+    LeaveTable *leaves;     // NULL : équité = score
+    Ruleset *rules;         // NULL : règles standard
+    int positions;          // Positions créées et pas encore libérées (accès atomiques)
+};
+
+struct ScrabblePosition {
+    const ScrabbleEngine *engine;
+    const Ruleset *rules;   // Règles du moteur à la création
+    char **board;
+    int boardSize;
+    BonusBoard bonusBoard;
+    MoveList moves;         // Tampon de génération réutilisé d'un appel à l'autre
+};
+
+static const Ruleset *engineRules(const ScrabbleEngine *engine) {
+    return engine->rules ? engine->rules : &standardRuleset;
+}
+
+/*
+ * Fonction : scrabbleEngineLoad
+ * -----------------------------
+ * Charge le dictionnaire, construit l'arbre lexical (la table de hachage est libérée
+ * aussitôt) et, si demandé, la table des valeurs de reliquat.
+ *
+ * Paramètres :
+ *   dictionaryPath : fichier de mots, un par ligne.
+ *   leavesPath     : table de reliquats au format de loadLeaveTable, ou NULL.
+ *
+ * Retour :
+ *   Le moteur, ou NULL en cas d'erreur (message sur stderr).
+ */
+ScrabbleEngine *scrabbleEngineLoad(const char *dictionaryPath, const char *leavesPath) {
+    ScrabbleEngine *engine = calloc(1, sizeof(ScrabbleEngine));
+    if (!engine) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le moteur.\n");
+        return NULL;
+    }
+    DictionaryEntry *dictionary = loadDictionaryHash(dictionaryPath);
+    if (!dictionary) {
+        free(engine);
+        return NULL;
+    }
+    engine->lexicon = buildLexicon(dictionary);
+    freeDictionaryHash(dictionary);
+    if (!engine->lexicon || (leavesPath && !(engine->leaves = loadLeaveTable(leavesPath)))) {
+        scrabbleEngineFree(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void scrabbleEngineFree(ScrabbleEngine *engine) {
+    if (!engine)
+        return;
+    freeLexicon(engine->lexicon);
+    freeLeaveTable(engine->leaves);
+    freeRuleset(engine->rules);
+    free(engine);
+}
+
+bool scrabbleIsWord(const ScrabbleEngine *engine, const char *word) {
+    char upper[SCRABBLE_MAX_WORD];
+    size_t len = strlen(word);
+    if (len == 0 || len >= sizeof(upper))
+        return false;
+    for (size_t i = 0; i <= len; i++)
+        upper[i] = toupper((unsigned char)word[i]);
+    return lexiconContains(engine->lexicon, upper);
+}
+
+int scrabbleLetterScore(const ScrabbleEngine *engine, char letter) {
+    return engineRules(engine)->tileValue[(unsigned char)toupper((unsigned char)letter)];
+}
+
+int scrabbleLetterCount(const ScrabbleEngine *engine, char letter) {
+    int s = leaveSymbol(letter);
+    return (s >= 0) ? engineRules(engine)->counts[s] : 0;
+}
+
+int scrabbleBoardSize(const ScrabbleEngine *engine) {
+    return engineRules(engine)->boardSize;
+}
+
+int scrabbleRackSize(const ScrabbleEngine *engine) {
+    return engineRules(engine)->rackSize;
+}
+
+/*
+ * Fonction : scrabbleLoadRules
+ * ----------------------------
+ * Charge un fichier de règles (format de ruleset.h) et en fait les règles du moteur, à la
+ * place des précédentes qui sont libérées. Les positions lisent les règles de leur moteur :
+ * le changement est refusé tant qu'une position du moteur existe.
+ *
+ * Paramètres :
+ *   engine : le moteur.
+ *   path   : le fichier de règles, ou NULL pour revenir aux règles standard.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'erreur (les règles du moteur sont inchangées).
+ */
+int scrabbleLoadRules(ScrabbleEngine *engine, const char *path) {
+    int positions = __atomic_load_n(&engine->positions, __ATOMIC_ACQUIRE);
+    if (positions > 0) {
+        fprintf(stderr, "Erreur : règles inchangées, le moteur a encore %d position(s).\n", positions);
+        return -1;
+    }
+    Ruleset *rules = NULL;
+    if (path && !(rules = loadRuleset(path)))
+        return -1;
+    freeRuleset(engine->rules);
+    engine->rules = rules;
+    return 0;
+}
+
+ScrabblePosition *scrabblePositionCreate(const ScrabbleEngine *engine) {
+    ScrabblePosition *position = calloc(1, sizeof(ScrabblePosition));
+    if (!position) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la position.\n");
+        return NULL;
+    }
+    position->engine = engine;
+    position->rules = engineRules(engine);
+    position->boardSize = position->rules->boardSize;
+    position->board = initBoard(position->boardSize);
+    if (!position->board) {
+        free(position);
+        return NULL;
+    }
+    memcpy(position->bonusBoard, position->rules->premium, sizeof(BonusBoard));
+    initMoveList(&position->moves);
+    // Seul champ du moteur modifié après son chargement (le moteur alloué n'est pas constant)
+    __atomic_fetch_add(&((ScrabbleEngine *)engine)->positions, 1, __ATOMIC_RELEASE);
+    return position;
+}
+
+void scrabblePositionFree(ScrabblePosition *position) {
+    if (!position)
+        return;
+    __atomic_fetch_sub(&((ScrabbleEngine *)position->engine)->positions, 1, __ATOMIC_RELEASE);
+    freeBoard(position->board, position->boardSize);
+    freeMoveList(&position->moves);
+    free(position);
+}
+
+// Vide le plateau et remet toutes les cases bonus
+void scrabblePositionClear(ScrabblePosition *position) {
+    for (int y = 0; y < position->boardSize; y++)
+        memset(position->board[y], ' ', position->boardSize);
+    memcpy(position->bonusBoard, position->rules->premium, sizeof(BonusBoard));
+}
+
+/*
+ * Fonction : scrabblePositionSetRow
+ * ---------------------------------
+ * Remplace le contenu d'une ligne du plateau. Une case occupée n'a plus de bonus, une
+ * case vide retrouve celui de la disposition des règles de la position.
+ *
+ * Paramètres :
+ *   position : la position.
+ *   y        : la ligne (0 .. taille du plateau - 1).
+ *   letters  : au moins une ligne de caractères : lettres A-Z, a-z pour un joker posé, '.' ou
+ *              ' ' pour une case vide.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si la ligne ou un caractère est invalide (la ligne est alors inchangée).
+ */
+int scrabblePositionSetRow(ScrabblePosition *position, int y, const char *letters) {
+    int size = position->boardSize;
+    if (y < 0 || y >= size)
+        return -1;
+    char row[BOARD_MAX_SIZE];
+    for (int x = 0; x < size; x++) {
+        char c = letters[x];
+        if (c == '.' || c == ' ')
+            row[x] = ' ';
+        else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+            row[x] = c;
+        else
+            return -1;   // Y compris la fin de chaîne d'une ligne trop courte
+    }
+    for (int x = 0; x < size; x++) {
+        position->board[y][x] = row[x];
+        position->bonusBoard[y][x] = (row[x] == ' ') ? position->rules->premium[y][x] : 0;
+    }
+    return 0;
+}
+
+char scrabblePositionGet(const ScrabblePosition *position, int x, int y) {
+    if (x < 0 || y < 0 || x >= position->boardSize || y >= position->boardSize)
+        return '\0';
+    return position->board[y][x];
+}
+
+// Vrai pour la version verticale d'un coup d'une lettre déjà produit horizontalement
+static bool isMirroredSingle(char **board, int boardSize, const Move *move) {
+    if (move->tilesUsed != 1 || move->dir != 'v')
+        return false;
+    int x = move->x;
+    for (int y = move->y; move->word[y - move->y] != '\0'; y++) {
+        if (board[y][x] != ' ')
+            continue;
+        return (x > 0 && board[y][x - 1] != ' ') ||
+               (x < boardSize - 1 && board[y][x + 1] != ' ');
+    }
+    return false;
+}
+
+// Copie un coup du générateur dans le format public
+static void copyMove(ScrabbleMove *dst, const Move *move) {
+    memcpy(dst->word, move->word, sizeof(dst->word));
+    dst->x = move->x;
+    dst->y = move->y;
+    dst->dir = move->dir;
+    dst->score = move->score;
+    dst->tilesUsed = move->tilesUsed;
+    dst->equity = move->equity;
+}
+
+// Ordre de classement : équité décroissante, puis score décroissant
+static bool rankedBefore(const Move *a, const ScrabbleMove *b) {
+    return a->equity > b->equity || (a->equity == b->equity && a->score > b->score);
+}
+
+/*
+ * Fonction : scrabbleGenerateMoves
+ * --------------------------------
+ * Génère tous les coups légaux du rack et ne garde que les maxOut meilleurs, par insertion
+ * dans le tableau de sortie trié (les coups moins bons que le dernier retenu sont écartés
+ * sans être copiés).
+ *
+ * Paramètres :
+ *   position : la position (son tampon de coups est réutilisé).
+ *   rack     : les lettres du rack (au plus 7).
+ *   out      : tableau de sortie d'au moins maxOut coups.
+ *   maxOut   : nombre de coups demandés.
+ *
+ * Retour :
+ *   Le nombre de coups écrits dans out (0 si aucun coup n'est possible).
+ */
+int scrabbleGenerateMoves(ScrabblePosition *position, const char *rack,
+                          ScrabbleMove *out, int maxOut) {
+    char upperRack[SCRABBLE_RACK_SIZE + 1];
+    int rackLen = 0;
+    for (; rackLen < SCRABBLE_RACK_SIZE && rack[rackLen] != '\0'; rackLen++)
+        upperRack[rackLen] = toupper((unsigned char)rack[rackLen]);
+    upperRack[rackLen] = '\0';
+
+    const ScrabbleEngine *engine = position->engine;
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    TRACE_BEGIN("scrabbleGenerateMoves");
+    TRACE_BEGIN("leaves");
+    STAT_TIMER_START(scoringStart);
+    leavePrepareRack(engine->leaves, upperRack, rackLeaves);
+    STAT_TIMER_STOP(PHASE_SCORING, scoringStart);
+    TRACE_END("leaves");
+    generateMovesWithRules(position->rules, engine->lexicon, position->board, position->boardSize,
+                           position->bonusBoard, upperRack,
+                           isBoardEmpty(position->board, position->boardSize), rackLeaves,
+                           &position->moves);
+
+    TRACE_BEGIN("rank");
+    STAT_TIMER_START(rankingStart);
+    int count = 0;
+    for (int i = 0; i < position->moves.count && maxOut > 0; i++) {
+        const Move *move = &position->moves.moves[i];
+        if (count == maxOut && !rankedBefore(move, &out[count - 1]))
+            continue;
+        if (isMirroredSingle(position->board, position->boardSize, move))
+            continue;
+        int j = (count < maxOut) ? count++ : count - 1;
+        while (j > 0 && rankedBefore(move, &out[j - 1])) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        copyMove(&out[j], move);
+    }
+    STAT_TIMER_STOP(PHASE_RANKING, rankingStart);
+    TRACE_END("rank");
+    TRACE_END("scrabbleGenerateMoves");
+    return count;
+}
+
+/*
+ * Fonction : scrabblePlayMove
+ * ---------------------------
+ * Pose les lettres du coup sur les cases vides et consomme leurs bonus. Le coup n'est pas
+ * revalidé contre le dictionnaire : seule sa compatibilité avec le plateau est vérifiée.
+ *
+ * Paramètres :
+ *   position : la position.
+ *   move     : le coup à jouer.
+ *
+ * Retour :
+ *   Le nombre de lettres posées, ou -1 si le coup sort du plateau ou contredit une lettre posée.
+ */
+int scrabblePlayMove(ScrabblePosition *position, const ScrabbleMove *move) {
+    int len = strnlen(move->word, SCRABBLE_MAX_WORD);
+    int dx = (move->dir == 'h') ? 1 : 0, dy = 1 - dx;
+    if (len == 0 || move->x < 0 || move->y < 0 ||
+        move->x + dx * (len - 1) >= position->boardSize || move->y + dy * (len - 1) >= position->boardSize)
+        return -1;
+    for (int i = 0; i < len; i++) {
+        char current = position->board[move->y + dy * i][move->x + dx * i];
+        char letter = toupper((unsigned char)move->word[i]);
+        if (letter < 'A' || letter > 'Z' || (current != ' ' && toupper((unsigned char)current) != letter))
+            return -1;
+    }
+    int placed = 0;
+    for (int i = 0; i < len; i++) {
+        int x = move->x + dx * i, y = move->y + dy * i;
+        if (position->board[y][x] == ' ') {
+            position->board[y][x] = move->word[i];   // Minuscule : joker
+            position->bonusBoard[y][x] = 0;
+            placed++;
+        }
+    }
+    return placed;
+}
+
+// Met le rack en majuscules ; retourne sa longueur, ou -1 s'il contient un caractère invalide
+static int upperRack(const char *rack, char out[SCRABBLE_RACK_SIZE + 1]) {
+    int len = 0;
+    for (; len < SCRABBLE_RACK_SIZE && rack[len] != '\0'; len++) {
+        out[len] = toupper((unsigned char)rack[len]);
+        if (leaveSymbol(out[len]) < 0)
+            return -1;
+    }
+    out[len] = '\0';
+    return (rack[len] == '\0') ? len : -1;
+}
+
+int scrabbleUnseenTiles(const ScrabblePosition *position, const char *rack) {
+    char upper[SCRABBLE_RACK_SIZE + 1];
+    int unseen[LEAVE_ALPHABET];
+    if (upperRack(rack, upper) < 0)
+        return -1;
+    return countUnseenTilesWithRules(position->rules, position->board, position->boardSize, upper,
+                                     unseen);
+}
+
+// Finale à sac vide : l'adversaire tient toutes les lettres invisibles
+static int solveEmptyBag(ScrabblePosition *position, const char *rack, const int *unseen,
+                         int spread, double budgetMs, ScrabbleEndgameMove *out) {
+    char other[SCRABBLE_RACK_SIZE + 1];
+    int n = 0;
+    for (int s = 0; s < LEAVE_ALPHABET; s++)
+        for (int k = 0; k < unseen[s]; k++)
+            other[n++] = (s == LEAVE_BLANK) ? '?' : 'A' + s;
+    other[n] = '\0';
+
+    EndgameSearch search;
+    TranspositionTable *tt = createTranspositionTable(ENDGAME_TT_BITS);
+    if (!tt || initEndgameSearch(&search, position->engine->lexicon, position->boardSize,
+                                 position->bonusBoard, tt) != 0) {
+        if (tt)
+            freeEndgameSearch(&search);
+        freeTranspositionTable(tt);
+        return -1;
+    }
+    search.rules = position->rules;
+    EndgameResult result;
+    solveEndgame(&search, position->board, rack, other, budgetMs, &result);
+    freeEndgameSearch(&search);
+    freeTranspositionTable(tt);
+
+    memset(out, 0, sizeof(ScrabbleEndgameMove));
+    if (!result.pass)
+        copyMove(&out->move, &result.best);
+    out->expectedSpread = spread + result.value;
+    out->winProbability = (out->expectedSpread > 0) ? 1.0 : (out->expectedSpread == 0) ? 0.5 : 0.0;
+    out->exact = result.exact;
+    return 1;
+}
+
+/*
+ * Fonction : scrabbleSolveEndgame
+ * -------------------------------
+ * Analyse de fin de partie. Les lettres invisibles qui ne tiennent pas sur le chevalet
+ * adverse sont dans le sac : sac vide, la finale est à information complète et résolue par
+ * approfondissement itératif (solveEndgame) ; de 1 à PREENDGAME_MAX_BAG lettres dans le sac,
+ * les meilleurs coups sont évalués sur tous les tirages (solvePreEndgame, tous processeurs).
+ *
+ * Paramètres :
+ *   position : la position (non modifiée).
+ *   rack     : les lettres du rack (au plus 7, '?' : joker).
+ *   spread   : écart actuel (score du joueur - score adverse).
+ *   budgetMs : budget de temps de chaque finale résolue.
+ *   out      : coups analysés, triés par probabilité de gain décroissante.
+ *   maxOut   : capacité de out.
+ *
+ * Retour :
+ *   Le nombre de coups écrits dans out, 0 si le sac contient plus de PREENDGAME_MAX_BAG lettres
+ *   ou si l'adversaire n'a plus de lettre, -1 en cas d'erreur (message sur stderr).
+ */
+int scrabbleSolveEndgame(ScrabblePosition *position, const char *rack, int spread,
+                         double budgetMs, ScrabbleEndgameMove *out, int maxOut) {
+    char upper[SCRABBLE_RACK_SIZE + 1];
+    if (upperRack(rack, upper) < 0) {
+        fprintf(stderr, "Erreur : rack %s invalide.\n", rack);
+        return -1;
+    }
+    int unseen[LEAVE_ALPHABET];
+    int total = countUnseenTilesWithRules(position->rules, position->board, position->boardSize,
+                                          upper, unseen);
+    int bagCount = total - position->rules->rackSize;
+    if (total == 0 || upper[0] == '\0' || bagCount > PREENDGAME_MAX_BAG || maxOut < 1)
+        return 0;
+    if (bagCount <= 0)
+        return solveEmptyBag(position, upper, unseen, spread, budgetMs, out);
+
+    PreEndgameOptions options;
+    defaultPreEndgameOptions(&options);
+    options.branchBudgetMs = budgetMs;
+    options.rules = position->rules;
+    PreEndgameCandidate *candidates = malloc(maxOut * sizeof(PreEndgameCandidate));
+    if (!candidates) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la pré-finale.\n");
+        return -1;
+    }
+    int count = solvePreEndgame(position->engine->lexicon, position->board, position->boardSize,
+                                position->bonusBoard, position->engine->leaves, upper, unseen,
+                                bagCount, spread, &options, candidates, maxOut);
+    for (int i = 0; i < count; i++) {
+        copyMove(&out[i].move, &candidates[i].move);
+        out[i].winProbability = candidates[i].winProbability;
+        out[i].expectedSpread = candidates[i].expectedSpread;
+        out[i].exact = candidates[i].exactDraws == candidates[i].draws;
+    }
+    free(candidates);
+    return count;
+}
+
+/*
+ * Fonction : scrabbleStatsReport
+ * ------------------------------
+ * Écrit sur une ligne les compteurs d'instrumentation du thread appelant accumulés depuis son
+ * appel précédent (le premier appel couvre tout ce que le thread a fait jusque-là).
+ *
+ * Paramètres :
+ *   buffer : tampon de sortie.
+ *   size   : taille du tampon.
+ *   json   : vrai pour un objet JSON, faux pour "nom=valeur ...".
+ *
+ * Retour :
+ *   La longueur écrite, ou -1 si la bibliothèque est compilée sans SCRABBLE_STATS.
+ */
+int scrabbleStatsReport(char *buffer, size_t size, bool json) {
+    static _Thread_local EngineStats lastReport;
+    if (!STATS_ENABLED)
+        return -1;
+    EngineStats now, delta;
+    statsSnapshot(&now);
+    statsDelta(&lastReport, &now, &delta);
+    lastReport = now;
+    return statsFormat(&delta, json, buffer, size);
+}
@@ -0,0 +1,314 @@
+#include "exchange.h"
+#include "bag.h"
+#include "board.h"
+#include "trace.h"
+
+//
+// ---------------------- Analyse des échanges --------------------------------
+//
+// Échanger en conservant le reliquat K rapporte 0 point : son équité est la valeur du
+// reliquat K, comme pour un coup joué. La table a cependant été apprise avec des tirages
+// dans un sac « moyen » ; on la corrige par l'écart entre la valeur attendue du rack K + D
+// quand D est tiré dans les lettres réellement invisibles et quand il est tiré dans la
+// distribution complète. La valeur d'un rack de LEAVE_MAX_TILES + 1 lettres est la moyenne
+// des valeurs de ses sous-reliquats de LEAVE_MAX_TILES lettres.
+//
+
+// Coefficient binomial C(n, k) (petites valeurs)
+static double binomialD(int n, int k) {
+    if (k < 0 || k > n)
+        return 0.0;
+    double result = 1.0;
+    for (int i = 1; i <= k; i++)
+        result = result * (n - k + i) / i;
+    return result;
+}
+
+// Valeur d'un rack trié : reliquat direct jusqu'à LEAVE_MAX_TILES lettres, moyenne des
+// sous-reliquats au-delà
+static float rackValue(const LeaveTable *table, const int *sorted, int count) {
+    if (count <= LEAVE_MAX_TILES)
+        return table->values[leaveRank(sorted, count)];
+    int ranks[LEAVE_MAX_TILES + 1];
+    leaveSubRanks(sorted, count, ranks);
+    float sum = 0.0f;
+    for (int i = 0; i < count; i++)
+        sum += table->values[ranks[i]];
+    return sum / count;
+}
+
+// Fusionne deux listes triées de symboles
+static int mergeSorted(const int *a, int na, const int *b, int nb, int *out) {
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb)
+        out[k++] = (a[i] <= b[j]) ? a[i++] : b[j++];
+    while (i < na)
+        out[k++] = a[i++];
+    while (j < nb)
+        out[k++] = b[j++];
+    return k;
+}
+
+// Nombre de tirages distincts (multiensembles) de chaque taille dans les lettres invisibles
+static void countDistinctDraws(const int unseen[LEAVE_ALPHABET], double distinct[RULESET_MAX_RACK + 1]) {
+    for (int m = 0; m <= RULESET_MAX_RACK; m++)
+        distinct[m] = (m == 0) ? 1.0 : 0.0;
+    for (int s = 0; s < LEAVE_ALPHABET; s++) {
+        for (int m = RULESET_MAX_RACK; m >= 1; m--)
+            for (int d = 1; d <= unseen[s] && d <= m; d++)
+                distinct[m] += distinct[m - d];
+    }
+}
+
+// Contexte de l'énumération exacte des tirages
+typedef struct {
+    const LeaveTable *table;
+    const int *unseen;
+    const int *kept;
+    int keptCount;
+    int draw[RULESET_MAX_RACK];
+    double weighted;     // Somme des valeurs pondérées par le nombre de façons de tirer
+} DrawEnumeration;
+
+// Énumère les tirages distincts (symbole par symbole) et accumule leurs valeurs pondérées
+static void enumerateDraws(DrawEnumeration *e, int symbol, int remaining, int drawn, double ways) {
+    if (remaining == 0) {
+        int rack[RULESET_MAX_RACK];
+        int n = mergeSorted(e->kept, e->keptCount, e->draw, drawn, rack);
+        e->weighted += ways * rackValue(e->table, rack, n);
+        return;
+    }
+    if (symbol >= LEAVE_ALPHABET)
+        return;
+    // d lettres du symbole courant : C(unseen, d) façons de les tirer
+    for (int d = 0; d <= remaining && d <= e->unseen[symbol]; d++) {
+        for (int i = 0; i < d; i++)
+            e->draw[drawn + i] = symbol;
+        enumerateDraws(e, symbol + 1, remaining - d, drawn + d, ways * binomialD(e->unseen[symbol], d));
+    }
+}
+
+/*
+ * Fonction : expectedRackValue
+ * ----------------------------
+ * Espérance de la valeur du rack K + D, D étant un tirage de m lettres sans remise.
+ * Exacte (loi hypergéométrique multivariée) si le nombre de tirages distincts reste
+ * raisonnable, estimée par échantillonnage sinon.
+ */
+static float expectedRackValue(const LeaveTable *table, const int *kept, int keptCount,
+                               const int unseen[LEAVE_ALPHABET], int unseenTotal, int m,
+                               bool exact, uint64_t *rng) {
+    if (m == 0 || unseenTotal < m)
+        return rackValue(table, kept, keptCount);
+
+    if (exact) {
+        DrawEnumeration e = { table, unseen, kept, keptCount, {0}, 0.0 };
+        enumerateDraws(&e, 0, m, 0, 1.0);
+        return (float)(e.weighted / binomialD(unseenTotal, m));
+    }
+
+    double sum = 0.0;
+    for (int sample = 0; sample < EXCHANGE_SAMPLES; sample++) {
+        int counts[LEAVE_ALPHABET];
+        memcpy(counts, unseen, sizeof(counts));
+        int total = unseenTotal;
+        int draw[RULESET_MAX_RACK];
+        for (int i = 0; i < m; i++) {
+            int r = (int)(nextRandom(rng) % (uint64_t)total);
+            int s = 0;
+            while (r >= counts[s])
+                r -= counts[s++];
+            counts[s]--;
+            total--;
+            // Insertion triée
+            int j = i;
+            while (j > 0 && draw[j - 1] > s) {
+                draw[j] = draw[j - 1];
+                j--;
+            }
+            draw[j] = s;
+        }
+        int rack[RULESET_MAX_RACK];
+        int n = mergeSorted(kept, keptCount, draw, m, rack);
+        sum += rackValue(table, rack, n);
+    }
+    return (float)(sum / EXCHANGE_SAMPLES);
+}
+
+// Distribution complète des lettres privée du reliquat conservé (sac « moyen »)
+static int standardPool(const int *kept, int keptCount, int pool[LEAVE_ALPHABET]) {
+    int total = 0;
+    for (int s = 0; s < LEAVE_ALPHABET; s++)
+        pool[s] = currentRules->counts[s];
+    for (int i = 0; i < keptCount; i++)
+        if (pool[kept[i]] > 0)
+            pool[kept[i]]--;
+    for (int s = 0; s < LEAVE_ALPHABET; s++)
+        total += pool[s];
+    return total;
+}
+
+/*
+ * Fonction : analyzeExchanges
+ * ---------------------------
+ * Évalue chacun des sous-ensembles non vides du rack à échanger (127 pour un rack de 7 lettres)
+ * et compare la meilleure option au meilleur coup jouable.
+ *
+ * Paramètres :
+ *   table      : table des reliquats (NULL : toutes les valeurs sont nulles).
+ *   rack       : lettres du rack (au plus RULESET_MAX_RACK).
+ *   unseen     : lettres invisibles par symbole (voir countUnseenTiles).
+ *   bagCount   : nombre de lettres dans le sac (l'échange exige au moins un chevalet de lettres).
+ *   playEquity : équité du meilleur coup jouable.
+ *   hasPlay    : faux si aucun coup n'est jouable.
+ *   seed       : graine de l'échantillonnage.
+ *   out        : résultat de l'analyse.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si un caractère du rack n'est ni une lettre ni un joker ('?') :
+ *   l'analyse est alors vide (aucune option, best à -1, pas de conseil d'échange).
+ *
+ * Remarque :
+ *   - Les options dont le reliquat conservé est identique (lettres en double) ne sont
+ *     évaluées qu'une fois.
+ */
+int analyzeExchanges(const LeaveTable *table, const char *rack, const int unseen[LEAVE_ALPHABET],
+                     int bagCount, float playEquity, bool hasPlay, uint64_t seed,
+                     ExchangeAnalysis *out) {
+    out->count = 0;
+    out->best = -1;
+    out->playEquity = playEquity;
+    out->hasPlay = hasPlay;
+    out->canExchange = bagCount >= currentRules->rackSize;
+    out->recommendExchange = false;
+
+    int symbols[RULESET_MAX_RACK];
+    int rackLen = 0;
+    for (int i = 0; i < RULESET_MAX_RACK && rack[i] != '\0'; i++) {
+        int s = leaveSymbol(rack[i]);
+        if (s < 0)
+            return -1;
+        symbols[rackLen++] = s;
+    }
+
+    TRACE_BEGIN("analyzeExchanges");
+
+    int unseenTotal = 0;
+    for (int s = 0; s < LEAVE_ALPHABET; s++)
+        unseenTotal += unseen[s];
+    int fullPool[LEAVE_ALPHABET];
+    standardPool(NULL, 0, fullPool);
+    double distinct[RULESET_MAX_RACK + 1], distinctFull[RULESET_MAX_RACK + 1];
+    countDistinctDraws(unseen, distinct);
+    countDistinctDraws(fullPool, distinctFull);
+
+    uint64_t rng = seed ? seed : 1;
+    int cachedRank[EXCHANGE_MAX_OPTIONS];
+    float cachedValue[EXCHANGE_MAX_OPTIONS];
+    int cached = 0;
+
+    int fullMask = (1 << rackLen) - 1;
+    for (int keepMask = 0; keepMask < fullMask; keepMask++) {
+        // Reliquat conservé, trié
+        int kept[RULESET_MAX_RACK];
+        int keptCount = 0;
+        for (int i = 0; i < rackLen; i++) {
+            if (!(keepMask & (1 << i)))
+                continue;
+            int j = keptCount++;
+            while (j > 0 && kept[j - 1] > symbols[i]) {
+                kept[j] = kept[j - 1];
+                j--;
+            }
+            kept[j] = symbols[i];
+        }
+        int m = rackLen - keptCount;
+        int rank = leaveRank(kept, keptCount);
+
+        ExchangeOption *option = &out->options[out->count++];
+        option->keepMask = keepMask;
+        option->exchanged = m;
+        option->leave = table ? table->values[rank] : 0.0f;
+        option->exact = distinct[m] <= EXCHANGE_EXACT_LIMIT && distinctFull[m] <= EXCHANGE_EXACT_LIMIT;
+
+        // Réutilise l'espérance d'un reliquat identique déjà évalué
+        int c = 0;
+        while (c < cached && cachedRank[c] != rank)
+            c++;
+        if (c == cached) {
+            cachedRank[c] = rank;
+            cachedValue[c] = 0.0f;
+            if (table) {
+                int pool[LEAVE_ALPHABET];
+                int poolTotal = standardPool(kept, keptCount, pool);
+                cachedValue[c] = expectedRackValue(table, kept, keptCount, unseen, unseenTotal, m,
+                                                   distinct[m] <= EXCHANGE_EXACT_LIMIT, &rng) -
+                                 expectedRackValue(table, kept, keptCount, pool, poolTotal, m,
+                                                   distinctFull[m] <= EXCHANGE_EXACT_LIMIT, &rng);
+            }
+            cached++;
+        }
+        option->drawAdjust = cachedValue[c];
+        option->equity = option->leave + option->drawAdjust;
+
+        if (out->best < 0 || option->equity > out->options[out->best].equity)
+            out->best = out->count - 1;
+    }
+
+    out->recommendExchange = out->canExchange && out->best >= 0 &&
+                             (!hasPlay || out->options[out->best].equity > playEquity);
+    TRACE_END("analyzeExchanges");
+    return 0;
+}
+
+// Ordre décroissant d'équité (pour l'affichage)
+static int compareOptions(const void *a, const void *b) {
+    float ea = ((const ExchangeOption *)a)->equity;
+    float eb = ((const ExchangeOption *)b)->equity;
+    return (ea < eb) - (ea > eb);
+}
+
+/*
+ * Fonction : printExchangeAnalysis
+ * --------------------------------
+ * Affiche les cinq meilleures options d'échange distinctes et la recommandation finale.
+ */
+void printExchangeAnalysis(const ExchangeAnalysis *analysis, const char *rack) {
+    ExchangeOption sorted[EXCHANGE_MAX_OPTIONS];
+    memcpy(sorted, analysis->options, analysis->count * sizeof(ExchangeOption));
+    qsort(sorted, analysis->count, sizeof(ExchangeOption), compareOptions);
+
+    printf("[Echange] Rack %s :\n", rack);
+    char shown[5][RULESET_MAX_RACK + 1];
+    int nShown = 0;
+    for (int i = 0; i < analysis->count && nShown < 5; i++) {
+        char kept[RULESET_MAX_RACK + 1], given[RULESET_MAX_RACK + 1];
+        int nk = 0, ng = 0;
+        for (int j = 0; rack[j] != '\0' && j < RULESET_MAX_RACK; j++) {
+            if (sorted[i].keepMask & (1 << j))
+                kept[nk++] = rack[j];
+            else
+                given[ng++] = rack[j];
+        }
+        kept[nk] = '\0';
+        given[ng] = '\0';
+        // Les lettres en double donnent plusieurs options identiques : une seule est affichée
+        bool duplicate = false;
+        for (int j = 0; j < nShown; j++)
+            duplicate |= strcmp(shown[j], kept) == 0;
+        if (duplicate)
+            continue;
+        strcpy(shown[nShown++], kept);
+        printf("  échanger %-7s garder %-7s reliquat %+6.1f  sac %+5.1f  équité %+6.1f (%s)\n",
+               given, nk ? kept : "-", sorted[i].leave, sorted[i].drawAdjust, sorted[i].equity,
+               sorted[i].exact ? "exacte" : "échantillonnée");
+    }
+    if (!analysis->canExchange)
+        printf("  Moins de %d lettres dans le sac : échange impossible.\n", currentRules->rackSize);
+    else if (analysis->recommendExchange)
+        printf("  Conseil : échanger (%+.1f contre %+.1f pour le meilleur coup).\n",
+               analysis->options[analysis->best].equity, analysis->playEquity);
+    else
+        printf("  Conseil : jouer (%+.1f contre %+.1f pour le meilleur échange).\n",
+               analysis->playEquity, analysis->options[analysis->best].equity);
+}
@@ -0,0 +1,43 @@
+#ifndef EXCHANGE_H
+#define EXCHANGE_H
+
+#include "scrabble.h"
+#include "leave.h"
+#include "ruleset.h"
+
+// Au-delà de ce nombre de tirages distincts, l'espérance est estimée par échantillonnage
+#define EXCHANGE_EXACT_LIMIT 512
+#define EXCHANGE_SAMPLES     128
+#define EXCHANGE_MAX_OPTIONS ((1 << RULESET_MAX_RACK) - 1)   // Sous-ensembles non vides du rack
+
+// Une façon d'échanger : les positions conservées et la valeur attendue du rack obtenu
+typedef struct {
+    int keepMask;      // Positions du rack conservées (bit i : rack[i])
+    int exchanged;     // Nombre de lettres remises dans le sac
+    float leave;       // Valeur statique du reliquat conservé
+    float drawAdjust;  // Correction due au contenu réel du sac (tirage favorable ou non)
+    float equity;      // leave + drawAdjust
+    bool exact;        // Espérances exactes (hypergéométriques) ou échantillonnées
+} ExchangeOption;
+
+// Résultat de l'analyse : toutes les options d'échange comparées au meilleur coup
+typedef struct {
+    ExchangeOption options[EXCHANGE_MAX_OPTIONS];
+    int count;
+    int best;                // Indice de la meilleure option d'échange
+    float playEquity;        // Équité du meilleur coup joué (score + reliquat)
+    bool hasPlay;            // Un coup est-il jouable ?
+    bool canExchange;        // Le sac contient-il au moins un chevalet de lettres ?
+    bool recommendExchange;  // L'échange vaut-il mieux que le meilleur coup ?
+} ExchangeAnalysis;
+
+// Analyse tous les sous-ensembles non vides du rack à échanger ; retourne 0, ou -1 (analyse
+// vide) si le rack contient un caractère qui n'est ni une lettre ni un joker
+int analyzeExchanges(const LeaveTable *table, const char *rack, const int unseen[LEAVE_ALPHABET],
+                      int bagCount, float playEquity, bool hasPlay, uint64_t seed,
+                      ExchangeAnalysis *out);
+
+// Affiche les meilleures options et la recommandation
+void printExchangeAnalysis(const ExchangeAnalysis *analysis, const char *rack);
+
+#endif  // EXCHANGE_H
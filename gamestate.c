@@ -0,0 +1,283 @@
+#include "gamestate.h"
+#include "board.h"
+#include "trace.h"
+
+//
+// ---------------------- Partie à plusieurs joueurs --------------------------
+//
+
+// Entrées réservées dans l'historique pour les ajustements de fin de partie (le joueur qui
+// termine reçoit chaque rack adverse, que son propriétaire perd)
+#define GAME_END_ENTRIES (2 * (GAME_MAX_PLAYERS - 1))
+
+int initGameState(GameState *state, int playerCount, int botCount, uint64_t seed) {
+    memset(state, 0, sizeof(*state));
+    if (playerCount < GAME_MIN_PLAYERS || playerCount > GAME_MAX_PLAYERS || botCount < 0 ||
+        botCount > playerCount) {
+        fprintf(stderr, "Erreur : partie de %d joueurs dont %d robots non prise en charge.\n",
+                playerCount, botCount);
+        return -1;
+    }
+    state->boardSize = currentRules->boardSize;
+    memset(state->board, ' ', sizeof(state->board));
+    initBonusBoard(state->bonusBoard);
+    bagInit(&state->bag, seed);
+    state->playerCount = playerCount;
+    for (int p = 0; p < playerCount; p++) {
+        GamePlayer *player = &state->players[p];
+        player->bot = (p >= playerCount - botCount);
+        snprintf(player->name, sizeof(player->name), "%s %d", player->bot ? "Robot" : "Joueur", p + 1);
+        bagFillRack(&state->bag, player->rack);
+    }
+    return 0;
+}
+
+void gameBoardRows(GameState *state, char *rows[BOARD_MAX_SIZE]) {
+    for (int y = 0; y < BOARD_MAX_SIZE; y++)
+        rows[y] = state->board[y];
+}
+
+bool gameFirstMove(const GameState *state) {
+    for (int y = 0; y < state->boardSize; y++)
+        for (int x = 0; x < state->boardSize; x++)
+            if (state->board[y][x] != ' ')
+                return false;
+    return true;
+}
+
+// Valeur des lettres restant sur un rack (pénalité de fin de partie)
+static int rackValue(const char *rack) {
+    int total = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        total += getLetterScore(rack[i]);
+    return total;
+}
+
+// Copie au plus 7 lettres dans un champ de l'historique (déjà mis à zéro)
+static void copyTiles(char dst[RECORD_RACK_SIZE], const char *src) {
+    for (int i = 0; i < RECORD_RACK_SIZE - 1 && src[i] != '\0'; i++)
+        dst[i] = src[i];
+}
+
+// Ajoute une entrée vide à l'historique (la place est vérifiée par l'appelant)
+static RecordMove *pushHistory(GameState *state, int player, RecordMoveType type) {
+    RecordMove *entry = &state->history[state->historyCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->type = type;
+    entry->player = player;
+    entry->dir = 'h';
+    return entry;
+}
+
+// Vrai si un tour peut encore être joué sans entamer la réserve de fin de partie
+static bool haveRoom(const GameState *state) {
+    return state->historyCount < GAME_MAX_HISTORY - GAME_END_ENTRIES;
+}
+
+// Fin de partie : chaque joueur perd la valeur de son rack ; si winner >= 0, ce joueur a vidé
+// son rack et reçoit en plus la valeur de chaque rack adverse
+static void endGame(GameState *state, int winner) {
+    for (int p = 0; p < state->playerCount; p++) {
+        GamePlayer *player = &state->players[p];
+        int value = rackValue(player->rack);
+        if (p == winner || value == 0)
+            continue;
+        RecordMove *entry;
+        if (winner >= 0) {
+            state->players[winner].score += value;
+            entry = pushHistory(state, winner, RECORD_END_RACK);
+            entry->score = value;
+            copyTiles(entry->tiles, player->rack);
+        }
+        player->score -= value;
+        entry = pushHistory(state, p, RECORD_END_RACK);
+        entry->score = -value;
+        copyTiles(entry->tiles, player->rack);
+        copyTiles(entry->rackBefore, player->rack);
+    }
+    state->over = true;
+}
+
+/*
+ * Fonction : finishTurn
+ * ---------------------
+ * Termine le tour du joueur au trait : compte les tours sans points, détecte la fin de la
+ * partie et passe la main au joueur suivant.
+ *
+ * Paramètres :
+ *   state  : la partie.
+ *   points : les points du tour (0 pour une passe ou un échange).
+ */
+static void finishTurn(GameState *state, int points) {
+    GamePlayer *player = &state->players[state->current];
+    state->turn++;
+    state->scoreless = (points > 0) ? 0 : state->scoreless + 1;
+    if (player->rack[0] == '\0')
+        endGame(state, state->current);
+    else if (state->scoreless >= GAME_SCORELESS_ROUNDS * state->playerCount || !haveRoom(state))
+        endGame(state, -1);
+    else
+        state->current = (state->current + 1) % state->playerCount;
+}
+
+int gamePlayMove(GameState *state, const Move *move) {
+    if (state->over || !haveRoom(state) || move->tilesUsed <= 0)
+        return -1;
+    TRACE_BEGIN("gamePlayMove");
+    GamePlayer *player = &state->players[state->current];
+    char *rows[BOARD_MAX_SIZE];
+    gameBoardRows(state, rows);
+    RecordMove *entry = pushHistory(state, state->current, RECORD_PLAY);
+    entry->x = move->x;
+    entry->y = move->y;
+    entry->dir = move->dir;
+    entry->score = move->score;
+    recordMoveTiles(rows, move, entry->tiles);
+    copyTiles(entry->rackBefore, player->rack);
+
+    for (int i = 0; move->word[i] != '\0'; i++) {
+        int x = move->x + (move->dir == 'h' ? i : 0);
+        int y = move->y + (move->dir == 'v' ? i : 0);
+        state->bonusBoard[y][x] = 0;   // Les bonus ne servent qu'une fois
+    }
+    applyMove(rows, move, player->rack);
+    int kept = strlen(player->rack);
+    bagFillRack(&state->bag, player->rack);
+    copyTiles(entry->drawn, player->rack + kept);
+    player->score += move->score;
+    finishTurn(state, move->score);
+    TRACE_END("gamePlayMove");
+    return 0;
+}
+
+/*
+ * Fonction : gameExchange
+ * -----------------------
+ * Échange des lettres du joueur au trait : les nouvelles lettres sont tirées avant que les
+ * anciennes ne retournent dans le sac. L'échange exige un sac d'au moins un chevalet de lettres.
+ *
+ * Paramètres :
+ *   state   : la partie.
+ *   letters : les lettres remises dans le sac ('?' pour un joker).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si l'échange est refusé.
+ */
+int gameExchange(GameState *state, const char *letters) {
+    GamePlayer *player = &state->players[state->current];
+    int count = strlen(letters);
+    if (state->over || !haveRoom(state) || count == 0 || count > RULESET_MAX_RACK ||
+        state->bag.total < currentRules->rackSize)
+        return -1;
+    // Retire les lettres échangées du rack (chacune doit y figurer)
+    char rack[RULESET_MAX_RACK + 1];
+    strcpy(rack, player->rack);
+    for (int i = 0; i < count; i++) {
+        char *tile = strchr(rack, letters[i]);
+        if (!tile)
+            return -1;
+        memmove(tile, tile + 1, strlen(tile));
+    }
+    RecordMove *entry = pushHistory(state, state->current, RECORD_EXCHANGE);
+    copyTiles(entry->tiles, letters);
+    copyTiles(entry->rackBefore, player->rack);
+    int kept = strlen(rack);
+    bagFillRack(&state->bag, rack);
+    copyTiles(entry->drawn, rack + kept);
+    for (int i = 0; i < count; i++)
+        bagReturn(&state->bag, letters[i]);
+    strcpy(player->rack, rack);
+    player->exchanges++;
+    finishTurn(state, 0);
+    return 0;
+}
+
+int gamePass(GameState *state) {
+    if (state->over || !haveRoom(state))
+        return -1;
+    GamePlayer *player = &state->players[state->current];
+    copyTiles(pushHistory(state, state->current, RECORD_PASS)->rackBefore, player->rack);
+    player->passes++;
+    finishTurn(state, 0);
+    return 0;
+}
+
+int gameApplyAction(GameState *state, const GameAction *action) {
+    switch (action->type) {
+        case RECORD_PLAY:     return gamePlayMove(state, &action->move);
+        case RECORD_EXCHANGE: return gameExchange(state, action->exchanged);
+        case RECORD_PASS:     return gamePass(state);
+        default:              return -1;
+    }
+}
+
+/*
+ * Fonction : gameChooseAction
+ * ---------------------------
+ * Choisit le tour du moteur pour le joueur au trait, sans modifier la partie : le coup de
+ * meilleure équité (score + valeur du reliquat), sinon l'échange du rack entier si le sac le
+ * permet, sinon une passe.
+ *
+ * Paramètres :
+ *   state   : la partie (lue seulement).
+ *   lexicon : arbre lexical du dictionnaire.
+ *   leaves  : table des valeurs de reliquat (NULL : seul le score compte).
+ *   moves   : liste de coups réutilisée.
+ *   action  : la décision (sortie).
+ */
+void gameChooseAction(const GameState *state, const Lexicon *lexicon, const LeaveTable *leaves,
+                      MoveList *moves, GameAction *action) {
+    TRACE_BEGIN("gameChooseAction");
+    memset(action, 0, sizeof(*action));
+    const char *rack = state->players[state->current].rack;
+    // Le générateur ne modifie ni le plateau ni les bonus
+    char *rows[BOARD_MAX_SIZE];
+    for (int y = 0; y < BOARD_MAX_SIZE; y++)
+        rows[y] = (char *)state->board[y];
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    leavePrepareRack(leaves, rack, rackLeaves);
+    generateMoves(lexicon, rows, state->boardSize, (int (*)[BOARD_MAX_SIZE])state->bonusBoard, rack,
+                  gameFirstMove(state), rackLeaves, moves);
+    int best = bestMoveIndex(moves);
+    if (best >= 0) {
+        action->type = RECORD_PLAY;
+        action->move = moves->moves[best];
+    } else if (state->bag.total >= currentRules->rackSize) {
+        action->type = RECORD_EXCHANGE;
+        strcpy(action->exchanged, rack);
+    } else {
+        action->type = RECORD_PASS;
+    }
+    TRACE_END("gameChooseAction");
+}
+
+int gameStateRecord(const GameState *state, GameRecord *record) {
+    if (initGameRecord(record, state->playerCount, state->boardSize) != 0)
+        return -1;
+    for (int p = 0; p < state->playerCount; p++)
+        snprintf(record->names[p], RECORD_NAME_SIZE, "%s", state->players[p].name);
+    for (int i = 0; i < state->historyCount; i++) {
+        const RecordMove *m = &state->history[i];
+        int status;
+        switch (m->type) {
+            case RECORD_PLAY:
+                status = recordPlay(record, m->player, m->rackBefore, m->x, m->y, m->dir, m->tiles,
+                                    m->score, m->drawn);
+                break;
+            case RECORD_EXCHANGE:
+                status = recordExchange(record, m->player, m->rackBefore, m->tiles, m->drawn);
+                break;
+            case RECORD_PASS:
+                status = recordPass(record, m->player, m->rackBefore);
+                break;
+            default:
+                status = recordEndRack(record, m->player, m->tiles, m->score);
+                break;
+        }
+        if (status != 0) {
+            freeGameRecord(record);
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "scrabble.h"
+#include "lexicon.h"
+#include "movegen.h"
+#include "bag.h"
+#include "leave.h"
+#include "record.h"
+#include "ruleset.h"
+
+//
+// Partie à plusieurs joueurs
+//
+// L'état complet d'une partie classique de 2 à 4 joueurs : plateau, bonus restants, sac
+// commun, rack et score de chaque joueur, joueur au trait et historique des tours. Il ne
+// contient aucun pointeur : une simple copie (affectation ou memcpy) donne une partie
+// indépendante, que la recherche ou la simulation peuvent jouer sans toucher à l'original.
+// Les fonctions du moteur qui attendent un plateau char ** le reçoivent par gameBoardRows.
+//
+// La partie s'arrête quand un joueur vide son rack alors que le sac est vide (il reçoit la
+// valeur des racks adverses, que chacun perd), ou après GAME_SCORELESS_ROUNDS tours de table
+// consécutifs sans points (passes, échanges ou coups nuls : chacun perd la valeur de son rack).
+//
+
+#define GAME_MIN_PLAYERS      2
+#define GAME_MAX_PLAYERS      RECORD_MAX_PLAYERS
+#define GAME_MAX_HISTORY      256   // Tours et ajustements de fin de partie enregistrés
+#define GAME_SCORELESS_ROUNDS 3     // Tours de table sans points avant la fin de la partie
+
+typedef struct {
+    char name[RECORD_NAME_SIZE];
+    bool bot;                             // Joué par le moteur
+    char rack[RULESET_MAX_RACK + 1];
+    int score;
+    int passes;                           // Tours passés
+    int exchanges;                        // Échanges
+} GamePlayer;
+
+typedef struct {
+    int boardSize;                                 // Taille du plateau des règles en vigueur
+    char board[BOARD_MAX_SIZE][BOARD_MAX_SIZE];    // ' ' : case vide, minuscule : joker posé
+    BonusBoard bonusBoard;                         // Bonus restants, consommés par les coups
+    Bag bag;                                       // Sac commun
+    int playerCount;
+    GamePlayer players[GAME_MAX_PLAYERS];
+    int current;                                   // Joueur au trait
+    int turn;                                      // Tours joués (coups, échanges et passes)
+    int scoreless;                                 // Tours consécutifs sans points
+    bool over;
+    int historyCount;
+    RecordMove history[GAME_MAX_HISTORY];          // Tours joués, au format des parties enregistrées
+} GameState;
+
+// Décision d'un joueur pour son tour
+typedef struct {
+    RecordMoveType type;                  // RECORD_PLAY, RECORD_EXCHANGE ou RECORD_PASS
+    Move move;                            // Coup joué (RECORD_PLAY)
+    char exchanged[RULESET_MAX_RACK + 1]; // Lettres remises dans le sac (RECORD_EXCHANGE)
+} GameAction;
+
+// Nouvelle partie avec les règles en vigueur : plateau vide, sac mélangé par la graine et racks
+// tirés dans l'ordre des joueurs ; les botCount derniers joueurs sont joués par le moteur.
+// Retourne 0, ou -1 si le nombre de joueurs est invalide.
+int initGameState(GameState *state, int playerCount, int botCount, uint64_t seed);
+
+// Lignes du plateau de la partie, pour les fonctions qui attendent un char ** (à refaire après
+// chaque copie de l'état : elles pointent dans celui-ci)
+void gameBoardRows(GameState *state, char *rows[BOARD_MAX_SIZE]);
+
+// Vrai tant qu'aucune lettre n'est posée (le premier coup doit passer par le centre)
+bool gameFirstMove(const GameState *state);
+
+// Tour du joueur au trait ; chacune retourne 0, ou -1 si l'action est refusée (partie
+// terminée, lettres absentes du rack, sac trop petit pour un échange, historique plein).
+// Le coup doit venir du générateur pour la position et le rack en cours.
+int gamePlayMove(GameState *state, const Move *move);
+int gameExchange(GameState *state, const char *letters);
+int gamePass(GameState *state);
+int gameApplyAction(GameState *state, const GameAction *action);
+
+// Décision du moteur pour le joueur au trait : coup de meilleure équité, sinon échange du rack
+// entier si le sac le permet, sinon passe. Ne modifie pas l'état (utilisable sur une copie
+// depuis un autre thread).
+void gameChooseAction(const GameState *state, const Lexicon *lexicon, const LeaveTable *leaves,
+                      MoveList *moves, GameAction *action);
+
+// Enregistre l'historique comme une partie (noms des joueurs compris) ; retourne 0, ou -1 en
+// cas d'erreur d'allocation
+int gameStateRecord(const GameState *state, GameRecord *record);
+
+#endif  // GAMESTATE_H
@@ -1,289 +1,649 @@
 #include "graphics.h"
+#include "board.h"
+#include "trace.h"
 
 // Définition des couleurs (initialisation des variables globales)
 SDL_Color BACKGROUND_COLOR = {255, 255, 255, 255};
 SDL_Color GRID_COLOR       = {255, 255, 255, 255};
 SDL_Color TEXT_COLOR       = {80, 80, 80, 255};
 SDL_Color INPUT_BG_COLOR   = {200, 200, 200, 255};
+SDL_Color SELECTION_COLOR  = {255, 255, 255, 110};
+
+//
+// ---------------------- Atlas de glyphes -----------------------------------
+//
+
+/*
+ * Fonction : createGlyphAtlas
+ * ---------------------------
+ * Rastérise une seule fois tous les caractères imprimables de chaque police et les range
+ * par étagères dans une surface unique, envoyée ensuite en une seule texture. Le rendu
+ * d'un texte se réduit alors à des copies de rectangles source, sans aucune surface ni
+ * texture créée pendant les images.
+ *
+ * Paramètres :
+ *   renderer : le renderer SDL.
+ *   fonts    : les polices, indexées par FontId.
+ *   atlas    : l'atlas à remplir.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'erreur.
+ */
+int createGlyphAtlas(SDL_Renderer *renderer, TTF_Font *fonts[FONT_COUNT], GlyphAtlas *atlas) {
+    TRACE_BEGIN("createGlyphAtlas");
+    SDL_Surface *glyphSurfaces[FONT_COUNT][ATLAS_GLYPHS];
+    memset(glyphSurfaces, 0, sizeof(glyphSurfaces));
+    atlas->texture = NULL;
+
+    // Premier passage : rastérisation et placement par étagères, après le bloc blanc
+    // réservé dans le coin supérieur gauche pour les aplats de couleur
+    int penX = ATLAS_WHITE_SIZE + 1, penY = 0, shelfHeight = ATLAS_WHITE_SIZE;
+    for (int f = 0; f < FONT_COUNT; f++) {
+        atlas->lineHeight[f] = TTF_FontHeight(fonts[f]);
+        for (int c = 0; c < ATLAS_GLYPHS; c++) {
+            Glyph *glyph = &atlas->glyphs[f][c];
+            int minX, maxX, minY, maxY, advance = 0;
+            TTF_GlyphMetrics(fonts[f], (Uint16)(ATLAS_FIRST_CHAR + c), &minX, &maxX, &minY, &maxY, &advance);
+            glyph->advance = advance;
+            glyph->rect = (SDL_Rect){ 0, 0, 0, 0 };
+            SDL_Surface *surface = TTF_RenderGlyph_Blended(fonts[f], (Uint16)(ATLAS_FIRST_CHAR + c), TEXT_COLOR);
+            if (!surface)
+                continue; // L'espace, par exemple, n'a pas de pixels
+            if (penX + surface->w > ATLAS_WIDTH) {
+                penX = 0;
+                penY += shelfHeight + 1;
+                shelfHeight = 0;
+            }
+            glyph->rect = (SDL_Rect){ penX, penY, surface->w, surface->h };
+            penX += surface->w + 1;
+            if (surface->h > shelfHeight)
+                shelfHeight = surface->h;
+            glyphSurfaces[f][c] = surface;
+        }
+    }
+
+    // Second passage : copie des glyphes dans la surface de l'atlas (alpha compris)
+    int status = -1;
+    atlas->width = ATLAS_WIDTH;
+    atlas->height = penY + shelfHeight + 1;
+    // Centre du bloc blanc, en coordonnées de texture normalisées
+    atlas->white.x = (ATLAS_WHITE_SIZE / 2.0f) / atlas->width;
+    atlas->white.y = (ATLAS_WHITE_SIZE / 2.0f) / atlas->height;
+    SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(0, atlas->width, atlas->height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (sheet) {
+        SDL_FillRect(sheet, NULL, 0);
+        SDL_Rect whiteRect = { 0, 0, ATLAS_WHITE_SIZE, ATLAS_WHITE_SIZE };
+        SDL_FillRect(sheet, &whiteRect, 0xFFFFFFFFu); // Blanc opaque quel que soit l'ordre des canaux
+        for (int f = 0; f < FONT_COUNT; f++) {
+            for (int c = 0; c < ATLAS_GLYPHS; c++) {
+                if (!glyphSurfaces[f][c])
+                    continue;
+                SDL_Rect dst = atlas->glyphs[f][c].rect;
+                SDL_SetSurfaceBlendMode(glyphSurfaces[f][c], SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(glyphSurfaces[f][c], NULL, sheet, &dst);
+            }
+        }
+        atlas->texture = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_FreeSurface(sheet);
+    }
+    if (atlas->texture) {
+        SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+        status = 0;
+    } else {
+        fprintf(stderr, "Erreur lors de la création de l'atlas de glyphes : %s\n", SDL_GetError());
+    }
+
+    for (int f = 0; f < FONT_COUNT; f++)
+        for (int c = 0; c < ATLAS_GLYPHS; c++)
+            SDL_FreeSurface(glyphSurfaces[f][c]);
+    TRACE_END("createGlyphAtlas");
+    return status;
+}
+
+void freeGlyphAtlas(GlyphAtlas *atlas) {
+    if (atlas->texture)
+        SDL_DestroyTexture(atlas->texture);
+    atlas->texture = NULL;
+}
+
+// Glyphe d'un caractère (les caractères hors atlas sont affichés comme des espaces)
+static const Glyph *atlasGlyph(const GlyphAtlas *atlas, FontId font, char ch) {
+    unsigned char c = (unsigned char)ch;
+    if (c < ATLAS_FIRST_CHAR || c > ATLAS_LAST_CHAR)
+        c = ' ';
+    return &atlas->glyphs[font][c - ATLAS_FIRST_CHAR];
+}
+
+/*
+ * Fonction : measureText
+ * ----------------------
+ * Calcule la taille en pixels d'un texte affiché avec l'atlas.
+ *
+ * Paramètres :
+ *   atlas : l'atlas de glyphes.
+ *   font  : la police.
+ *   text  : le texte (ASCII).
+ *   w, h  : largeur et hauteur en sortie.
+ */
+void measureText(const GlyphAtlas *atlas, FontId font, const char *text, int *w, int *h) {
+    int width = 0;
+    for (const char *p = text; *p != '\0'; p++)
+        width += atlasGlyph(atlas, font, *p)->advance;
+    *w = width;
+    *h = atlas->lineHeight[font];
+}
+
+/*
+ * Fonction : drawText
+ * -------------------
+ * Affiche un texte glyphe par glyphe, par copie de rectangles de l'atlas.
+ *
+ * Paramètres :
+ *   renderer : le renderer SDL.
+ *   atlas    : l'atlas de glyphes.
+ *   font     : la police.
+ *   text     : le texte (ASCII).
+ *   x, y     : coin supérieur gauche du texte.
+ */
+void drawText(SDL_Renderer *renderer, const GlyphAtlas *atlas, FontId font,
+              const char *text, int x, int y) {
+    TRACE_BEGIN("drawText");
+    for (const char *p = text; *p != '\0'; p++) {
+        const Glyph *glyph = atlasGlyph(atlas, font, *p);
+        if (glyph->rect.w > 0) {
+            SDL_Rect dst = { x, y, glyph->rect.w, glyph->rect.h };
+            SDL_RenderCopy(renderer, atlas->texture, &glyph->rect, &dst);
+        }
+        x += glyph->advance;
+    }
+    TRACE_END("drawText");
+}
+
+//
+// ---------------------- Lots de géométrie ----------------------------------
+//
+
+void initGeometryBatch(GeometryBatch *batch) {
+    memset(batch, 0, sizeof(GeometryBatch));
+}
+
+// Vide le lot sans libérer ses tampons, réutilisés par la construction suivante
+void clearGeometryBatch(GeometryBatch *batch) {
+    batch->vertexCount = 0;
+    batch->indexCount = 0;
+    batch->failed = false;
+}
+
+void freeGeometryBatch(GeometryBatch *batch) {
+    free(batch->vertices);
+    free(batch->indices);
+    initGeometryBatch(batch);
+}
+
+// Garantit la place de vertices sommets et indices indices supplémentaires (croissance par doublement)
+static bool batchReserve(GeometryBatch *batch, int vertices, int indices) {
+    if (batch->failed)
+        return false;
+    if (batch->vertexCount + vertices > batch->vertexCapacity) {
+        int capacity = batch->vertexCapacity > 0 ? batch->vertexCapacity : 256;
+        while (capacity < batch->vertexCount + vertices)
+            capacity *= 2;
+        SDL_Vertex *grown = realloc(batch->vertices, (size_t)capacity * sizeof(SDL_Vertex));
+        if (!grown) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour les sommets du lot de géométrie\n");
+            batch->failed = true;
+            return false;
+        }
+        batch->vertices = grown;
+        batch->vertexCapacity = capacity;
+    }
+    if (batch->indexCount + indices > batch->indexCapacity) {
+        int capacity = batch->indexCapacity > 0 ? batch->indexCapacity : 384;
+        while (capacity < batch->indexCount + indices)
+            capacity *= 2;
+        int *grown = realloc(batch->indices, (size_t)capacity * sizeof(int));
+        if (!grown) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour les indices du lot de géométrie\n");
+            batch->failed = true;
+            return false;
+        }
+        batch->indices = grown;
+        batch->indexCapacity = capacity;
+    }
+    return true;
+}
+
+// Ajoute un quadrilatère (deux triangles) : dst en pixels, uv en coordonnées de texture normalisées
+static void batchQuad(GeometryBatch *batch, SDL_FRect dst, SDL_FRect uv, SDL_Color color) {
+    if (!batchReserve(batch, 4, 6))
+        return;
+    float x0 = dst.x, y0 = dst.y, x1 = dst.x + dst.w, y1 = dst.y + dst.h;
+    float u0 = uv.x, v0 = uv.y, u1 = uv.x + uv.w, v1 = uv.y + uv.h;
+    SDL_Vertex *v = batch->vertices + batch->vertexCount;
+    v[0] = (SDL_Vertex){ { x0, y0 }, color, { u0, v0 } };
+    v[1] = (SDL_Vertex){ { x1, y0 }, color, { u1, v0 } };
+    v[2] = (SDL_Vertex){ { x1, y1 }, color, { u1, v1 } };
+    v[3] = (SDL_Vertex){ { x0, y1 }, color, { u0, v1 } };
+    int base = batch->vertexCount;
+    int *index = batch->indices + batch->indexCount;
+    index[0] = base;     index[1] = base + 1; index[2] = base + 2;
+    index[3] = base;     index[4] = base + 2; index[5] = base + 3;
+    batch->vertexCount += 4;
+    batch->indexCount += 6;
+}
+
+/*
+ * Fonction : batchFillRect
+ * ------------------------
+ * Ajoute un rectangle plein au lot. Ses sommets échantillonnent le bloc blanc de l'atlas,
+ * si bien que la couleur des sommets donne directement la couleur du rectangle.
+ *
+ * Paramètres :
+ *   batch : le lot de géométrie.
+ *   atlas : l'atlas de glyphes (coordonnées du bloc blanc).
+ *   rect  : le rectangle en pixels.
+ *   color : la couleur (l'alpha est mélangé au rendu).
+ */
+void batchFillRect(GeometryBatch *batch, const GlyphAtlas *atlas, SDL_Rect rect, SDL_Color color) {
+    SDL_FRect dst = { (float)rect.x, (float)rect.y, (float)rect.w, (float)rect.h };
+    SDL_FRect uv = { atlas->white.x, atlas->white.y, 0.0f, 0.0f };
+    batchQuad(batch, dst, uv, color);
+}
+
+// Ajoute un glyphe de l'atlas dont le coin supérieur gauche est en (x, y)
+static void batchGlyph(GeometryBatch *batch, const GlyphAtlas *atlas, const Glyph *glyph, int x, int y) {
+    if (glyph->rect.w <= 0)
+        return;
+    SDL_FRect dst = { (float)x, (float)y, (float)glyph->rect.w, (float)glyph->rect.h };
+    SDL_FRect uv = { (float)glyph->rect.x / atlas->width, (float)glyph->rect.y / atlas->height,
+                     (float)glyph->rect.w / atlas->width, (float)glyph->rect.h / atlas->height };
+    SDL_Color white = { 255, 255, 255, 255 }; // Les glyphes sont déjà rastérisés en TEXT_COLOR
+    batchQuad(batch, dst, uv, white);
+}
+
+/*
+ * Fonction : batchText
+ * --------------------
+ * Ajoute un texte au lot, un quadrilatère texturé par glyphe.
+ *
+ * Paramètres :
+ *   batch : le lot de géométrie.
+ *   atlas : l'atlas de glyphes.
+ *   font  : la police.
+ *   text  : le texte (ASCII).
+ *   x, y  : coin supérieur gauche du texte.
+ */
+void batchText(GeometryBatch *batch, const GlyphAtlas *atlas, FontId font,
+               const char *text, int x, int y) {
+    for (const char *p = text; *p != '\0'; p++) {
+        const Glyph *glyph = atlasGlyph(atlas, font, *p);
+        batchGlyph(batch, atlas, glyph, x, y);
+        x += glyph->advance;
+    }
+}
+
+/*
+ * Fonction : drawGeometryBatch
+ * ----------------------------
+ * Soumet tout le lot en un seul appel à SDL_RenderGeometry, texturé par l'atlas.
+ *
+ * Paramètres :
+ *   renderer : le renderer SDL.
+ *   atlas    : l'atlas de glyphes (unique texture du lot).
+ *   batch    : le lot à dessiner.
+ */
+void drawGeometryBatch(SDL_Renderer *renderer, const GlyphAtlas *atlas, const GeometryBatch *batch) {
+    if (batch->indexCount == 0)
+        return;
+    TRACE_BEGIN("drawGeometryBatch");
+    if (SDL_RenderGeometry(renderer, atlas->texture, batch->vertices, batch->vertexCount,
+                           batch->indices, batch->indexCount) != 0)
+        fprintf(stderr, "Erreur SDL_RenderGeometry: %s\n", SDL_GetError());
+    TRACE_END("drawGeometryBatch");
+}
 
 //
 // ---------------------- Fonctions de rendu graphique ------------------------
 //
 
 /*
- * Fonction : drawGrid
+ * Fonction : batchGrid
  * --------------------
- * Dessine la grille du plateau sur l'écran.
+ * Ajoute la grille du plateau au lot : un rectangle de l'épaisseur demandée par ligne.
  *
  * Paramètres :
- *   renderer         : le renderer SDL utilisé pour dessiner.
+ *   batch            : le lot de géométrie.
+ *   atlas            : l'atlas de glyphes (bloc blanc).
  *   boardSize        : la taille du plateau (nombre de cases par ligne/colonne).
  *   boardDrawWidth   : largeur en pixels de la zone de dessin du plateau.
  *   boardDrawHeight  : hauteur en pixels de la zone de dessin du plateau.
+ *   gridThickness    : épaisseur des lignes de la grille.
+ *   originX, originY : coin supérieur gauche du plateau dans la cible de rendu.
  */
-void drawGrid(SDL_Renderer *renderer, int boardSize, int boardDrawWidth, int boardDrawHeight) {
-    // Efface l'écran avec la couleur de fond
-    SDL_SetRenderDrawColor(renderer, BACKGROUND_COLOR.r, BACKGROUND_COLOR.g, BACKGROUND_COLOR.b, BACKGROUND_COLOR.a);
-    SDL_RenderClear(renderer);
-    
+void batchGrid(GeometryBatch *batch, const GlyphAtlas *atlas, int boardSize, int boardDrawWidth,
+               int boardDrawHeight, int gridThickness, int originX, int originY) {
     // Calcule la taille d'une case
     float cellWidth = (float)boardDrawWidth / boardSize;
     float cellHeight = (float)boardDrawHeight / boardSize;
     
-    // Dessine les lignes verticales
+    // Lignes verticales
     for (int i = 0; i <= boardSize; i++) {
-        int x = BOARD_MARGIN + (int)(i * cellWidth);
-        SDL_RenderDrawLine(renderer, x, BOARD_MARGIN, x, BOARD_MARGIN + boardDrawHeight);
+        SDL_Rect line = { originX + (int)(i * cellWidth), originY, gridThickness, boardDrawHeight + 1 };
+        batchFillRect(batch, atlas, line, GRID_COLOR);
     }
-    // Dessine les lignes horizontales
+    // Lignes horizontales
     for (int j = 0; j <= boardSize; j++) {
-        int y = BOARD_MARGIN + (int)(j * cellHeight);
-        SDL_RenderDrawLine(renderer, BOARD_MARGIN, y, BOARD_MARGIN + boardDrawWidth, y);
+        SDL_Rect line = { originX, originY + (int)(j * cellHeight), boardDrawWidth + 1, gridThickness };
+        batchFillRect(batch, atlas, line, GRID_COLOR);
+    }
+}
+
+// Ajoute une lettre centrée dans la case (x, y, w, h) et sa valeur dans le coin inférieur droit
+static void batchTile(GeometryBatch *batch, const GlyphAtlas *atlas, char letter, int value,
+                      int x, int y, int w, int h, FontId letterFont) {
+    const Glyph *glyph = atlasGlyph(atlas, letterFont, letter);
+    batchGlyph(batch, atlas, glyph, x + (w - glyph->rect.w) / 2, y + (h - glyph->rect.h) / 2);
+
+    char valueText[4];
+    snprintf(valueText, sizeof(valueText), "%d", value);
+    int valueW, valueH;
+    measureText(atlas, FONT_VALUE, valueText, &valueW, &valueH);
+    batchText(batch, atlas, FONT_VALUE, valueText, x + w - valueW - 2, y + h - valueH - 2);
+}
+
+// Couleur d'une case vide selon son bonus (la case centrale est dorée)
+static SDL_Color premiumColor(int bonus, bool center) {
+    if (center)
+        return (SDL_Color){ 255, 215, 0, 255 };   // Jaune doré pour la case centrale
+    switch (bonus) {
+        case BONUS_QUADRUPLE_WORD:   return (SDL_Color){ 128, 0, 32, 255 };     // Bordeaux
+        case BONUS_QUADRUPLE_LETTER: return (SDL_Color){ 0, 0, 128, 255 };      // Bleu marine
+        case BONUS_TRIPLE_WORD:      return (SDL_Color){ 200, 39, 34, 255 };    // Rouge
+        case BONUS_DOUBLE_WORD:      return (SDL_Color){ 255, 165, 0, 255 };    // Orange
+        case BONUS_TRIPLE_LETTER:    return (SDL_Color){ 0, 0, 255, 255 };      // Bleu
+        case BONUS_DOUBLE_LETTER:    return (SDL_Color){ 173, 216, 230, 255 };  // Bleu clair
+        default:                     return (SDL_Color){ 34, 139, 34, 255 };    // Vert pour les autres cases
     }
 }
 
+//
+// ---------------------- Cache de rendu -------------------------------------
+//
+
 /*
- * Fonction : drawBoard
- * --------------------
- * Dessine le plateau de jeu, y compris les cases, les bonus et les lettres placées.
+ * Fonction : createRenderCache
+ * ----------------------------
+ * Alloue l'image de la fenêtre (texture cible) et prépare les lots de géométrie du plateau
+ * et du rack. La géométrie du plateau est construite à la première image, puis seulement
+ * quand le plateau, les bonus ou les surbrillances changent.
  *
  * Paramètres :
- *   renderer         : le renderer SDL.
- *   boardFont        : police utilisée pour afficher les lettres.
- *   valueFont        : police utilisée pour afficher la valeur des lettres.
- *   board            : le plateau de jeu (tableau 2D de caractères).
+ *   renderer         : le renderer SDL (doit accepter les textures cibles).
+ *   atlas            : atlas de glyphes (unique texture des lots).
+ *   cache            : le cache à initialiser.
  *   boardSize        : taille du plateau.
  *   boardDrawWidth   : largeur de la zone de dessin du plateau.
  *   boardDrawHeight  : hauteur de la zone de dessin du plateau.
  *   gridThickness    : épaisseur des lignes de la grille.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'erreur.
  */
-void drawBoard(SDL_Renderer *renderer, TTF_Font *boardFont, TTF_Font *valueFont,
-               char **board, int boardSize, int boardDrawWidth, int boardDrawHeight, int gridThickness) {
-    float cellWidth = (float)boardDrawWidth / boardSize;
-    float cellHeight = (float)boardDrawHeight / boardSize;
-    
-    // Définition d'un tableau bonus (standard Scrabble) pour colorer certaines cases
-    int bonusBoard[15][15] = {
-        {1, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 1},
-        {0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 2, 0},
-        {0, 0, 2, 0, 0, 0, 4, 0, 4, 0, 0, 0, 2, 0, 0},
-        {4, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 4},
-        {0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0},
-        {0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0},
-        {0, 0, 4, 0, 0, 0, 4, 0, 4, 0, 0, 0, 4, 0, 0},
-        {1, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0, 4, 0, 0, 1},
-        {0, 0, 4, 0, 0, 0, 4, 0, 4, 0, 0, 0, 4, 0, 0},
-        {0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0},
-        {0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0},
-        {4, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 4},
-        {0, 0, 2, 0, 0, 0, 4, 0, 4, 0, 0, 0, 2, 0, 0},
-        {0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 2, 0},
-        {1, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 1}
-    };
-    
-    // Parcours toutes les cases du plateau
-    for (int y = 0; y < boardSize; y++) {
-        for (int x = 0; x < boardSize; x++) {
-            // Détermine le rectangle correspondant à la case
-            SDL_Rect cellRect = {
-                BOARD_MARGIN + (int)(x * cellWidth),
-                BOARD_MARGIN + (int)(y * cellHeight),
-                (int)cellWidth,
-                (int)cellHeight
-            };
-            // Colorie la case en fonction des bonus ou si c'est la case centrale
-            if (x == boardSize/2 && y == boardSize/2)
-                SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255); // Jaune doré pour la case centrale
-            else if (bonusBoard[y][x] == 1)
-                SDL_SetRenderDrawColor(renderer, 200, 39, 34, 255);  // Rouge pour certains bonus
-            else if (bonusBoard[y][x] == 2)
-                SDL_SetRenderDrawColor(renderer, 255, 165, 0, 255);  // Orange
-            else if (bonusBoard[y][x] == 3)
-                SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);    // Bleu
-            else if (bonusBoard[y][x] == 4)
-                SDL_SetRenderDrawColor(renderer, 173, 216, 230, 255); // Bleu clair
-            else
-                SDL_SetRenderDrawColor(renderer, 34, 139, 34, 255);   // Vert pour les autres cases
-            SDL_RenderFillRect(renderer, &cellRect);
-            
-            // Si une lettre est placée sur cette case, dessine un overlay beige (pour mettre en évidence la lettre)
-            if (board[y][x] != ' ') {
-                int overlayWidth = (int)round(cellWidth * 0.8);
-                int overlayHeight = (int)round(cellHeight * 0.8);
-                int offsetX = (int)round((cellWidth - overlayWidth) / 2.0);
-                int offsetY = (int)round((cellHeight - overlayHeight) / 2.0);
-                SDL_Rect overlayRect = {
-                    BOARD_MARGIN + (int)(x * cellWidth) + offsetX,
-                    BOARD_MARGIN + (int)(y * cellHeight) + offsetY,
-                    overlayWidth,
-                    overlayHeight
-                };
-                SDL_SetRenderDrawColor(renderer, 245, 245, 220, 255); // Beige clair
-                SDL_RenderFillRect(renderer, &overlayRect);
-            }
+int createRenderCache(SDL_Renderer *renderer, const GlyphAtlas *atlas, RenderCache *cache,
+                      int boardSize, int boardDrawWidth, int boardDrawHeight, int gridThickness) {
+    memset(cache, 0, sizeof(RenderCache));
+    initGeometryBatch(&cache->board);
+    initGeometryBatch(&cache->rack);
+    initGeometryBatch(&cache->overlay);
+    cache->atlas = atlas;
+    cache->boardSize = boardSize;
+    cache->boardDrawWidth = boardDrawWidth;
+    cache->boardDrawHeight = boardDrawHeight;
+    cache->gridThickness = gridThickness;
+
+    cache->frame = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                     WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!cache->frame) {
+        fprintf(stderr, "Erreur SDL_CreateTexture: %s\n", SDL_GetError());
+        return -1;
+    }
+    // L'image complète est opaque : elle remplace l'écran sans mélange
+    SDL_SetTextureBlendMode(cache->frame, SDL_BLENDMODE_NONE);
+    return 0;
+}
+
+void freeRenderCache(RenderCache *cache) {
+    if (cache->frame)
+        SDL_DestroyTexture(cache->frame);
+    cache->frame = NULL;
+    freeGeometryBatch(&cache->board);
+    freeGeometryBatch(&cache->rack);
+    freeGeometryBatch(&cache->overlay);
+}
+
+/*
+ * Fonction : drawDebugOverlay
+ * ---------------------------
+ * Affiche un panneau semi-transparent dans le coin supérieur gauche, un champ "nom=valeur"
+ * par ligne (le texte est coupé aux espaces). Dessiné directement à l'écran, par-dessus
+ * l'image du cache, qu'il ne modifie pas.
+ *
+ * Paramètres :
+ *   renderer : le renderer SDL.
+ *   cache    : le cache de rendu (atlas et lot de géométrie de la surcouche).
+ *   text     : les champs à afficher, séparés par des espaces.
+ */
+void drawDebugOverlay(SDL_Renderer *renderer, RenderCache *cache, const char *text) {
+    TRACE_BEGIN("drawDebugOverlay");
+    const GlyphAtlas *atlas = cache->atlas;
+    GeometryBatch *batch = &cache->overlay;
+    char lines[DEBUG_OVERLAY_LINES][64];
+    int lineCount = 0, width = 0;
+    for (const char *p = text; *p != '\0' && lineCount < DEBUG_OVERLAY_LINES; ) {
+        size_t len = strcspn(p, " ");
+        if (len > 0) {
+            snprintf(lines[lineCount], sizeof(lines[lineCount]), "%.*s", (int)len, p);
+            int w, h;
+            measureText(atlas, FONT_VALUE, lines[lineCount], &w, &h);
+            if (w > width)
+                width = w;
+            lineCount++;
         }
+        p += len + (p[len] == ' ');
     }
-    
-    // Dessine la grille par-dessus le plateau
-    SDL_SetRenderDrawColor(renderer, GRID_COLOR.r, GRID_COLOR.g, GRID_COLOR.b, GRID_COLOR.a);
-    for (int i = 0; i <= boardSize; i++) {
-        int x = BOARD_MARGIN + (int)(i * cellWidth);
-        for (int offset = 0; offset < gridThickness; offset++)
-            SDL_RenderDrawLine(renderer, x + offset, BOARD_MARGIN, x + offset, BOARD_MARGIN + boardDrawHeight);
+    int lineHeight = atlas->lineHeight[FONT_VALUE];
+    clearGeometryBatch(batch);
+    SDL_Rect panel = { 8, 8, width + 12, lineCount * lineHeight + 12 };
+    batchFillRect(batch, atlas, panel, (SDL_Color){ 255, 255, 255, 220 });
+    for (int i = 0; i < lineCount; i++)
+        batchText(batch, atlas, FONT_VALUE, lines[i], panel.x + 6, panel.y + 6 + i * lineHeight);
+    drawGeometryBatch(renderer, atlas, batch);
+    TRACE_END("drawDebugOverlay");
+}
+
+// Force la reconstruction de la géométrie du plateau à la prochaine image
+void invalidateRenderCache(RenderCache *cache) {
+    cache->boardValid = false;
+}
+
+/*
+ * Fonction : setCellOverlay
+ * -------------------------
+ * Colore une case du plateau par-dessus son fond et sa tuile (aperçu d'un coup, carte de
+ * chaleur...). La géométrie n'est reconstruite que si la couleur change réellement.
+ *
+ * Paramètres :
+ *   cache : le cache de rendu.
+ *   x, y  : la case.
+ *   color : la couleur de surbrillance (alpha nul : aucune).
+ */
+void setCellOverlay(RenderCache *cache, int x, int y, SDL_Color color) {
+    if (x < 0 || y < 0 || x >= cache->boardSize || y >= cache->boardSize)
+        return;
+    if (memcmp(&cache->overlays[y][x], &color, sizeof(SDL_Color)) != 0) {
+        cache->overlays[y][x] = color;
+        cache->boardValid = false;
     }
-    for (int j = 0; j <= boardSize; j++) {
-        int y = BOARD_MARGIN + (int)(j * cellHeight);
-        for (int offset = 0; offset < gridThickness; offset++)
-            SDL_RenderDrawLine(renderer, BOARD_MARGIN, y + offset, BOARD_MARGIN + boardDrawWidth, y + offset);
+}
+
+void clearCellOverlays(RenderCache *cache) {
+    static const SDL_Color none[BOARD_MAX_SIZE][BOARD_MAX_SIZE];
+    if (memcmp(cache->overlays, none, sizeof(none)) != 0) {
+        memset(cache->overlays, 0, sizeof(cache->overlays));
+        cache->boardValid = false;
     }
-    
-    // Dessine les lettres et leurs valeurs sur chaque case où une lettre est présente
+}
+
+// Vrai si le plateau ou les bonus diffèrent de ceux décrits par la géométrie en cache
+static bool boardChanged(const RenderCache *cache, char **board, BonusBoard bonusBoard) {
+    for (int y = 0; y < cache->boardSize; y++)
+        if (memcmp(cache->boardLetters[y], board[y], cache->boardSize) != 0)
+            return true;
+    return memcmp(cache->bonusLayout, bonusBoard, sizeof(cache->bonusLayout)) != 0;
+}
+
+// Construit la géométrie du plateau, dans l'ordre de dessin : cases, tuiles, surbrillances,
+// grille, puis lettres et valeurs
+static void buildBoardGeometry(RenderCache *cache, char **board, BonusBoard bonusBoard) {
+    TRACE_BEGIN("buildBoardGeometry");
+    const GlyphAtlas *atlas = cache->atlas;
+    GeometryBatch *batch = &cache->board;
+    int boardSize = cache->boardSize;
+    float cellWidth = (float)cache->boardDrawWidth / boardSize;
+    float cellHeight = (float)cache->boardDrawHeight / boardSize;
+    int cellW = (int)cellWidth, cellH = (int)cellHeight;
+    // Tuile : un overlay beige de 80 % au centre de la case
+    int overlayW = (int)round(cellW * 0.8);
+    int overlayH = (int)round(cellH * 0.8);
+    int overlayX = (int)round((cellW - overlayW) / 2.0);
+    int overlayY = (int)round((cellH - overlayH) / 2.0);
+    SDL_Color tileColor = { 245, 245, 220, 255 }; // Beige clair
+    clearGeometryBatch(batch);
+
     for (int y = 0; y < boardSize; y++) {
         for (int x = 0; x < boardSize; x++) {
-            char letter = board[y][x];
-            if (letter != ' ') {
-                // Prépare la chaîne contenant la lettre
-                char text[2] = { letter, '\0' };
-                SDL_Surface *textSurface = TTF_RenderUTF8_Blended(boardFont, text, TEXT_COLOR);
-                if (textSurface) {
-                    SDL_Texture *textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                    int textW, textH;
-                    SDL_QueryTexture(textTexture, NULL, NULL, &textW, &textH);
-                    int posX = BOARD_MARGIN + (int)(x * cellWidth + (cellWidth - textW) / 2);
-                    int posY = BOARD_MARGIN + (int)(y * cellHeight + (cellHeight - textH) / 2);
-                    SDL_Rect dstRect = { posX, posY, textW, textH };
-                    SDL_RenderCopy(renderer, textTexture, NULL, &dstRect);
-                    SDL_DestroyTexture(textTexture);
-                    SDL_FreeSurface(textSurface);
-                }
-                // Prépare la chaîne affichant la valeur de la lettre
-                char valueText[4];
-                sprintf(valueText, "%d", getLetterScore(letter));
-                SDL_Surface *valueSurface = TTF_RenderUTF8_Blended(valueFont, valueText, TEXT_COLOR);
-                if (valueSurface) {
-                    SDL_Texture *valueTexture = SDL_CreateTextureFromSurface(renderer, valueSurface);
-                    int valueW, valueH;
-                    SDL_QueryTexture(valueTexture, NULL, NULL, &valueW, &valueH);
-                    int valuePosX = BOARD_MARGIN + (int)(x * cellWidth) + (int)cellWidth - valueW - 2;
-                    int valuePosY = BOARD_MARGIN + (int)(y * cellHeight) + (int)cellHeight - valueH - 2;
-                    SDL_Rect valueRect = { valuePosX, valuePosY, valueW, valueH };
-                    SDL_RenderCopy(renderer, valueTexture, NULL, &valueRect);
-                    SDL_DestroyTexture(valueTexture);
-                    SDL_FreeSurface(valueSurface);
-                }
+            SDL_Rect cellRect = { BOARD_MARGIN + (int)(x * cellWidth), BOARD_MARGIN + (int)(y * cellHeight),
+                                  cellW, cellH };
+            bool center = (x == boardSize / 2 && y == boardSize / 2);
+            batchFillRect(batch, atlas, cellRect, premiumColor(bonusBoard[y][x], center));
+            char letter = toupper((unsigned char)board[y][x]);
+            if (letter >= 'A' && letter <= 'Z') {
+                SDL_Rect tileRect = { cellRect.x + overlayX, cellRect.y + overlayY, overlayW, overlayH };
+                batchFillRect(batch, atlas, tileRect, tileColor);
             }
+            if (cache->overlays[y][x].a > 0)
+                batchFillRect(batch, atlas, cellRect, cache->overlays[y][x]);
+        }
+    }
+    batchGrid(batch, atlas, boardSize, cache->boardDrawWidth, cache->boardDrawHeight,
+              cache->gridThickness, BOARD_MARGIN, BOARD_MARGIN);
+    for (int y = 0; y < boardSize; y++) {
+        for (int x = 0; x < boardSize; x++) {
+            char letter = toupper((unsigned char)board[y][x]);
+            if (letter >= 'A' && letter <= 'Z')   // Un joker posé (minuscule) vaut la valeur du joker
+                batchTile(batch, atlas, letter, getTileScore(board[y][x]),
+                          BOARD_MARGIN + (int)(x * cellWidth), BOARD_MARGIN + (int)(y * cellHeight),
+                          cellW, cellH, FONT_BOARD);
         }
     }
+
+    for (int y = 0; y < boardSize; y++)
+        memcpy(cache->boardLetters[y], board[y], boardSize);
+    memcpy(cache->bonusLayout, bonusBoard, sizeof(cache->bonusLayout));
+    cache->boardValid = !batch->failed;
+    TRACE_END("buildBoardGeometry");
+}
+
+/*
+ * Fonction : drawBoard
+ * --------------------
+ * Dessine le plateau de jeu (cases bonus, grille, tuiles, surbrillances et lettres) en un
+ * seul appel à SDL_RenderGeometry. La géométrie n'est reconstruite que si le plateau, les
+ * bonus ou les surbrillances ont changé depuis la dernière image.
+ *
+ * Paramètres :
+ *   renderer         : le renderer SDL.
+ *   cache            : le cache de rendu (géométrie du plateau).
+ *   board            : le plateau de jeu (tableau 2D de caractères).
+ *   bonusBoard       : les cases bonus restantes.
+ */
+void drawBoard(SDL_Renderer *renderer, RenderCache *cache, char **board, BonusBoard bonusBoard) {
+    TRACE_BEGIN("drawBoard");
+    if (!cache->boardValid || boardChanged(cache, board, bonusBoard))
+        buildBoardGeometry(cache, board, bonusBoard);
+    drawGeometryBatch(renderer, cache->atlas, &cache->board);
+    TRACE_END("drawBoard");
 }
 
 /*
  * Fonction : drawRack
  * ---------------------
- * Dessine la zone du chevalet (rack) et le bouton "Echanger" dans la zone dédiée en bas de la fenêtre.
+ * Dessine la zone du chevalet (rack) et le bouton "Echanger" dans la zone dédiée en bas de la fenêtre,
+ * en un seul appel à SDL_RenderGeometry.
  *
  * Paramètres :
  *   renderer       : le renderer SDL.
- *   rackFont       : police utilisée pour afficher les lettres du rack.
- *   valueFont      : police pour afficher la valeur des lettres sur le rack.
- *   rack           : le tableau contenant les lettres du rack.
+ *   cache          : cache de rendu (lot du rack et atlas).
+ *   rack           : les lettres du rack (chaîne, au plus la taille du chevalet).
  *   rackAreaWidth  : largeur de la zone du rack.
- *   SCRABBLE_RACK_HEIGHT    : hauteur de la zone du rack.
- *   startXRack     : position en X de départ pour le rack.py
+ *   startXRack     : position en X de départ pour le rack.
  *   buttonMargin   : marge entre le rack et le bouton.
  *   buttonWidth    : largeur du bouton "Echanger".
  *   buttonHeight   : hauteur du bouton "Echanger".
- *   inputFont      : police utilisée pour le texte du bouton.
  */
-void drawRack(SDL_Renderer *renderer, TTF_Font *rackFont, TTF_Font *valueFont,
-              char *rack, int rackAreaWidth,
-              int startXRack, int buttonMargin, int buttonWidth, int buttonHeight,
-              TTF_Font *inputFont) {
-    // Dessine le rectangle de fond pour le rack
+void drawRack(SDL_Renderer *renderer, RenderCache *cache,
+              const char *rack, int rackAreaWidth,
+              int startXRack, int buttonMargin, int buttonWidth, int buttonHeight) {
+    TRACE_BEGIN("drawRack");
+    const GlyphAtlas *atlas = cache->atlas;
+    GeometryBatch *batch = &cache->rack;
+    clearGeometryBatch(batch);
+
+    // Rectangle de fond pour le rack
     SDL_Rect rackRect = { startXRack, BOARD_HEIGHT, rackAreaWidth, SCRABBLE_RACK_HEIGHT };
-    SDL_SetRenderDrawColor(renderer, 220, 220, 220, 255); // Gris clair
-    SDL_RenderFillRect(renderer, &rackRect);
+    batchFillRect(batch, atlas, rackRect, (SDL_Color){ 220, 220, 220, 255 }); // Gris clair
     
-    // Pour chaque jeton du rack, dessine une case beige avec la lettre et sa valeur
-    for (int i = 0; i < 7; i++) {
-        float currentCellWidth = rackAreaWidth / 7.0;
-        int tileWidth = (int)round(currentCellWidth * 0.8);
-        int tileHeight = (int)round(SCRABBLE_RACK_HEIGHT * 0.8);
-        int tileOffsetX = (int)round((currentCellWidth - tileWidth) / 2.0);
-        int tileOffsetY = (int)round((SCRABBLE_RACK_HEIGHT - tileHeight) / 2.0);
+    // Pour chaque jeton du rack (taille du chevalet des règles) : case beige, lettre et valeur ;
+    // les cases au-delà des lettres restantes (fin de partie) restent vierges
+    int rackSize = currentRules->rackSize;
+    int rackLen = strnlen(rack, rackSize);
+    float currentCellWidth = (float)rackAreaWidth / rackSize;
+    int tileW = (int)round(currentCellWidth * 0.8);
+    int tileH = (int)round(SCRABBLE_RACK_HEIGHT * 0.8);
+    int tileOffsetX = (int)round((currentCellWidth - tileW) / 2.0);
+    int tileOffsetY = (int)round((SCRABBLE_RACK_HEIGHT - tileH) / 2.0);
+    for (int i = 0; i < rackSize; i++) {
         int cellX = startXRack + (int)(i * currentCellWidth);
-        int cellY = BOARD_HEIGHT;
-        SDL_Rect tileRect = { cellX + tileOffsetX, cellY + tileOffsetY, tileWidth, tileHeight };
-        SDL_SetRenderDrawColor(renderer, 245, 245, 220, 255); // Beige clair
-        SDL_RenderFillRect(renderer, &tileRect);
-        // Dessine la lettre du jeton
-        char letter[2] = { rack[i], '\0' };
-        SDL_Surface *rackSurface = TTF_RenderUTF8_Blended(rackFont, letter, TEXT_COLOR);
-        if (rackSurface) {
-            SDL_Texture *rackTexture = SDL_CreateTextureFromSurface(renderer, rackSurface);
-            int rackW, rackH;
-            SDL_QueryTexture(rackTexture, NULL, NULL, &rackW, &rackH);
-            int drawX = cellX + tileOffsetX + (tileWidth - rackW) / 2;
-            int drawY = cellY + tileOffsetY + (tileHeight - rackH) / 2;
-            SDL_Rect dstRect = { drawX, drawY, rackW, rackH };
-            SDL_RenderCopy(renderer, rackTexture, NULL, &dstRect);
-            SDL_DestroyTexture(rackTexture);
-            SDL_FreeSurface(rackSurface);
-        }
-        // Dessine la valeur de la lettre dans le coin inférieur droit du jeton
-        char valueText[4];
-        sprintf(valueText, "%d", getLetterScore(rack[i]));
-        SDL_Surface *valueSurface = TTF_RenderUTF8_Blended(valueFont, valueText, TEXT_COLOR);
-        if (valueSurface) {
-            SDL_Texture *valueTexture = SDL_CreateTextureFromSurface(renderer, valueSurface);
-            int valueW, valueH;
-            SDL_QueryTexture(valueTexture, NULL, NULL, &valueW, &valueH);
-            int valuePosX = cellX + tileOffsetX + tileWidth - valueW - 2;
-            int valuePosY = cellY + tileOffsetY + tileHeight - valueH - 2;
-            SDL_Rect valueRect = { valuePosX, valuePosY, valueW, valueH };
-            SDL_RenderCopy(renderer, valueTexture, NULL, &valueRect);
-            SDL_DestroyTexture(valueTexture);
-            SDL_FreeSurface(valueSurface);
-        }
+        SDL_Rect tileRect = { cellX + tileOffsetX, BOARD_HEIGHT + tileOffsetY, tileW, tileH };
+        batchFillRect(batch, atlas, tileRect, (SDL_Color){ 245, 245, 220, 255 }); // Beige clair
+        char letter = (i < rackLen) ? toupper((unsigned char)rack[i]) : '\0';
+        if (letter >= 'A' && letter <= 'Z')   // Un joker ('?') reste une case vierge
+            batchTile(batch, atlas, letter, getLetterScore(letter), tileRect.x, tileRect.y, tileW, tileH,
+                      FONT_RACK);
     }
-    // Dessine le bouton "Echanger" à côté du rack
+    // Bouton "Echanger" à côté du rack
     int buttonX = startXRack + rackAreaWidth + buttonMargin;
     int buttonY = BOARD_HEIGHT + (SCRABBLE_RACK_HEIGHT - buttonHeight) / 2;
     SDL_Rect buttonRect = { buttonX, buttonY, buttonWidth, buttonHeight };
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Rouge pour le bouton
-    SDL_RenderFillRect(renderer, &buttonRect);
-    SDL_Surface *btnSurface = TTF_RenderUTF8_Blended(inputFont, "Echanger", TEXT_COLOR);
-    if (btnSurface) {
-        SDL_Texture *btnTexture = SDL_CreateTextureFromSurface(renderer, btnSurface);
-        int btnW, btnH;
-        SDL_QueryTexture(btnTexture, NULL, NULL, &btnW, &btnH);
-        int btnTextX = buttonX + (buttonWidth - btnW) / 2;
-        int btnTextY = buttonY + (buttonHeight - btnH) / 2;
-        SDL_Rect btnRect = { btnTextX, btnTextY, btnW, btnH };
-        SDL_RenderCopy(renderer, btnTexture, NULL, &btnRect);
-        SDL_DestroyTexture(btnTexture);
-        SDL_FreeSurface(btnSurface);
-    }
+    batchFillRect(batch, atlas, buttonRect, (SDL_Color){ 255, 0, 0, 255 }); // Rouge pour le bouton
+    int btnW, btnH;
+    measureText(atlas, FONT_INPUT, "Echanger", &btnW, &btnH);
+    batchText(batch, atlas, FONT_INPUT, "Echanger",
+              buttonX + (buttonWidth - btnW) / 2, buttonY + (buttonHeight - btnH) / 2);
     // === Ajout du bouton "Meilleur Coup" ===
     int bestMoveButtonX = buttonX + buttonWidth + 10; // 10px d'écart à droite de "Echanger"
     int bestMoveButtonY = buttonY;
     int bestMoveButtonWidth = 120;  // Largeur fixe (modifiable)
     int bestMoveButtonHeight = buttonHeight; // Même hauteur que "Echanger"
     SDL_Rect bestMoveRect = { bestMoveButtonX, bestMoveButtonY, bestMoveButtonWidth, bestMoveButtonHeight };
-    SDL_SetRenderDrawColor(renderer, 0, 128, 0, 255); // Vert
-    SDL_RenderFillRect(renderer, &bestMoveRect);
-
-    SDL_Surface *bestSurface = TTF_RenderUTF8_Blended(inputFont, "Indice", TEXT_COLOR);
-    if (bestSurface) {
-        SDL_Texture *bestTexture = SDL_CreateTextureFromSurface(renderer, bestSurface);
-        int bmW, bmH;
-        SDL_QueryTexture(bestTexture, NULL, NULL, &bmW, &bmH);
-        int bmTextX = bestMoveButtonX + (bestMoveButtonWidth - bmW) / 2;
-        int bmTextY = bestMoveButtonY + (bestMoveButtonHeight - bmH) / 2;
-        SDL_Rect bmRect = { bmTextX, bmTextY, bmW, bmH };
-        SDL_RenderCopy(renderer, bestTexture, NULL, &bmRect);
-        SDL_DestroyTexture(bestTexture);
-        SDL_FreeSurface(bestSurface);
-    }
+    batchFillRect(batch, atlas, bestMoveRect, (SDL_Color){ 0, 128, 0, 255 }); // Vert
+    int bmW, bmH;
+    measureText(atlas, FONT_INPUT, "Indice", &bmW, &bmH);
+    batchText(batch, atlas, FONT_INPUT, "Indice",
+              bestMoveButtonX + (bestMoveButtonWidth - bmW) / 2, bestMoveButtonY + (bestMoveButtonHeight - bmH) / 2);
+
+    drawGeometryBatch(renderer, atlas, batch);
+    TRACE_END("drawRack");
 }
 
 /*
@@ -293,36 +653,29 @@ void drawRack(SDL_Renderer *renderer, TTF_Font *rackFont, TTF_Font *valueFont,
  *
  * Paramètres :
  *   renderer     : le renderer SDL.
- *   inputFont    : police utilisée pour le texte d'invite.
+ *   atlas        : atlas de glyphes utilisé pour le texte d'invite.
  *   currentState : l'état de saisie actuel (STATE_IDLE, STATE_INPUT_TEXT, STATE_INPUT_DIRECTION).
  *   inputBuffer  : le texte actuellement saisi par l'utilisateur.
+ *   idlePrompt   : l'invite hors saisie (joueur au trait, premier coup, tour d'un robot...).
  */
-void drawInputArea(SDL_Renderer *renderer, TTF_Font *inputFont, InputState currentState, char *inputBuffer, int totalPoints) {
+void drawInputArea(SDL_Renderer *renderer, const GlyphAtlas *atlas, InputState currentState, char *inputBuffer,
+                   const char *idlePrompt) {
+    TRACE_BEGIN("drawInputArea");
   SDL_Rect inputRect = { 0, BOARD_HEIGHT + SCRABBLE_RACK_HEIGHT, WINDOW_WIDTH, INPUT_AREA_HEIGHT };
   SDL_SetRenderDrawColor(renderer, INPUT_BG_COLOR.r, INPUT_BG_COLOR.g, INPUT_BG_COLOR.b, INPUT_BG_COLOR.a);
   SDL_RenderFillRect(renderer, &inputRect);
-    char displayText[100];
+    char displayText[128];
     if (currentState == STATE_IDLE) {
-        if (totalPoints == 0)
-            snprintf(displayText, sizeof(displayText), "Cliquez pour choisir une case (1er mot doit passer par le milieu)");
-        else
-            snprintf(displayText, sizeof(displayText), "Cliquez pour choisir une case");
+        snprintf(displayText, sizeof(displayText), "%s", idlePrompt);
     } else if (currentState == STATE_INPUT_TEXT) {
         snprintf(displayText, sizeof(displayText), "Entrez un mot: %s", inputBuffer);
     } else if (currentState == STATE_INPUT_DIRECTION) {
         snprintf(displayText, sizeof(displayText), "Entrez la direction du mot (h/v): ");
     }
-    // Rend le texte de l'invite dans la zone de saisie
-    SDL_Surface *promptSurface = TTF_RenderUTF8_Blended(inputFont, displayText, TEXT_COLOR);
-    if (promptSurface) {
-        SDL_Texture *promptTexture = SDL_CreateTextureFromSurface(renderer, promptSurface);
-        int textW, textH;
-        SDL_QueryTexture(promptTexture, NULL, NULL, &textW, &textH);
-        int posX = 10;
-        int posY = BOARD_HEIGHT + SCRABBLE_RACK_HEIGHT + (INPUT_AREA_HEIGHT - textH) / 2;
-        SDL_Rect dstRect = { posX, posY, textW, textH };
-        SDL_RenderCopy(renderer, promptTexture, NULL, &dstRect);
-        SDL_DestroyTexture(promptTexture);
-        SDL_FreeSurface(promptSurface);
-    }
-}
\ No newline at end of file
+    // Affiche le texte de l'invite dans la zone de saisie
+    int textW, textH;
+    measureText(atlas, FONT_INPUT, displayText, &textW, &textH);
+    drawText(renderer, atlas, FONT_INPUT, displayText, 10,
+             BOARD_HEIGHT + SCRABBLE_RACK_HEIGHT + (INPUT_AREA_HEIGHT - textH) / 2);
+    TRACE_END("drawInputArea");
+}
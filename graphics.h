@@ -3,20 +3,148 @@
 
 #include "scrabble.h"
 
+// Inclusion des bibliothèques SDL et TTF (réservées à l'interface graphique)
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+// Définition des constantes
+#define WINDOW_WIDTH      800
+#define WINDOW_HEIGHT     900
+
+#define BOARD_HEIGHT      800                        // Hauteur de la zone du plateau
+#define SCRABBLE_RACK_HEIGHT       50
+#define INPUT_AREA_HEIGHT (WINDOW_HEIGHT - BOARD_HEIGHT - SCRABBLE_RACK_HEIGHT)
+#define BOARD_MARGIN      50
+
+// Énumération pour l'état de saisie
+typedef enum {
+    STATE_IDLE,
+    STATE_INPUT_TEXT,
+    STATE_INPUT_DIRECTION
+} InputState;
+
+// Atlas de glyphes et cache de rendu (définis plus bas)
+typedef struct GlyphAtlas GlyphAtlas;
+typedef struct RenderCache RenderCache;
+
 // Définition des couleurs utilisées pour l'affichage
 extern SDL_Color BACKGROUND_COLOR;
 extern SDL_Color GRID_COLOR;
 extern SDL_Color TEXT_COLOR;
 extern SDL_Color INPUT_BG_COLOR;
+extern SDL_Color SELECTION_COLOR;   // Surbrillance semi-transparente de la case sélectionnée
+
+// Polices rastérisées dans l'atlas de glyphes
+typedef enum {
+    FONT_BOARD,
+    FONT_RACK,
+    FONT_INPUT,
+    FONT_VALUE,
+    FONT_COUNT
+} FontId;
+
+// Caractères présents dans l'atlas : ASCII imprimable (lettres, chiffres des valeurs, invites)
+#define ATLAS_FIRST_CHAR 32
+#define ATLAS_LAST_CHAR  126
+#define ATLAS_GLYPHS     (ATLAS_LAST_CHAR - ATLAS_FIRST_CHAR + 1)
+#define ATLAS_WIDTH      1024
+// Bloc blanc opaque réservé dans l'atlas : les aplats de couleur s'y échantillonnent, ce qui
+// permet de dessiner rectangles et glyphes dans un même lot de géométrie
+#define ATLAS_WHITE_SIZE 4
+
+// Position d'un glyphe dans la texture de l'atlas et avance horizontale
+typedef struct {
+    SDL_Rect rect;
+    int advance;
+} Glyph;
+
+// Atlas de glyphes : tous les caractères de toutes les polices dans une seule texture,
+// rastérisés une fois au démarrage puis copiés par rectangles source à chaque image.
+struct GlyphAtlas {
+    SDL_Texture *texture;
+    Glyph glyphs[FONT_COUNT][ATLAS_GLYPHS];
+    int lineHeight[FONT_COUNT];
+    int width, height;           // Taille de la texture (normalisation des coordonnées)
+    SDL_FPoint white;            // Coordonnées normalisées d'un texel blanc opaque
+};
+
+// Création et libération de l'atlas
+int createGlyphAtlas(SDL_Renderer *renderer, TTF_Font *fonts[FONT_COUNT], GlyphAtlas *atlas);
+void freeGlyphAtlas(GlyphAtlas *atlas);
 
+// Mesure et affichage d'un texte à partir de l'atlas
+void measureText(const GlyphAtlas *atlas, FontId font, const char *text, int *w, int *h);
+void drawText(SDL_Renderer *renderer, const GlyphAtlas *atlas, FontId font,
+              const char *text, int x, int y);
+
+// Lot de géométrie : triangles texturés par l'atlas, soumis en un seul appel à
+// SDL_RenderGeometry. Les tampons ne grandissent que si nécessaire et sont réutilisés.
+typedef struct {
+    SDL_Vertex *vertices;
+    int *indices;
+    int vertexCount, indexCount;
+    int vertexCapacity, indexCapacity;
+    bool failed;                 // Une allocation a échoué depuis le dernier vidage
+} GeometryBatch;
+
+void initGeometryBatch(GeometryBatch *batch);
+void clearGeometryBatch(GeometryBatch *batch);
+void freeGeometryBatch(GeometryBatch *batch);
+
+// Ajout d'aplats et de texte au lot (un échec d'allocation positionne batch->failed)
+void batchFillRect(GeometryBatch *batch, const GlyphAtlas *atlas, SDL_Rect rect, SDL_Color color);
+void batchText(GeometryBatch *batch, const GlyphAtlas *atlas, FontId font,
+               const char *text, int x, int y);
+void batchGrid(GeometryBatch *batch, const GlyphAtlas *atlas, int boardSize, int boardDrawWidth,
+               int boardDrawHeight, int gridThickness, int originX, int originY);
+
+// Soumet tout le lot en un appel (une seule texture : l'atlas)
+void drawGeometryBatch(SDL_Renderer *renderer, const GlyphAtlas *atlas, const GeometryBatch *batch);
+
+// Zones de la fenêtre à recomposer (drapeaux combinables)
+#define DIRTY_BOARD 0x1u   // Plateau et scores
+#define DIRTY_RACK  0x2u   // Rack et boutons
+#define DIRTY_INPUT 0x4u   // Zone de saisie
+#define DIRTY_ALL   (DIRTY_BOARD | DIRTY_RACK | DIRTY_INPUT)
+
+// Attente maximale d'un événement dans la boucle principale (ms)
+#define EVENT_WAIT_MS 1000
+
+// Cache de rendu : l'image de la fenêtre et la géométrie du plateau (cases bonus, grille,
+// tuiles, surbrillances et lettres), reconstruite seulement quand son contenu change.
+struct RenderCache {
+    SDL_Texture *frame;          // Image complète de la fenêtre, recomposée zone par zone
+    GeometryBatch board;         // Plateau complet, dessiné en un appel
+    GeometryBatch rack;          // Rack et boutons, reconstruits à chaque recomposition
+    GeometryBatch overlay;       // Surcouche de débogage (hors de l'image du cache)
+    bool boardValid;
+    char boardLetters[BOARD_MAX_SIZE][BOARD_MAX_SIZE];   // Contenu du plateau décrit par la géométrie
+    BonusBoard bonusLayout;                              // Disposition des bonus décrite par la géométrie
+    SDL_Color overlays[BOARD_MAX_SIZE][BOARD_MAX_SIZE];  // Surbrillance par case (alpha nul : aucune)
+    const GlyphAtlas *atlas;
+    int boardSize, boardDrawWidth, boardDrawHeight, gridThickness;
+};
+
+// Création, invalidation et libération du cache
+int createRenderCache(SDL_Renderer *renderer, const GlyphAtlas *atlas, RenderCache *cache,
+                      int boardSize, int boardDrawWidth, int boardDrawHeight, int gridThickness);
+void invalidateRenderCache(RenderCache *cache);
+void freeRenderCache(RenderCache *cache);
+
+// Surbrillances du plateau (aperçu d'un coup, carte de chaleur, case sélectionnée)
+void setCellOverlay(RenderCache *cache, int x, int y, SDL_Color color);
+void clearCellOverlays(RenderCache *cache);
 
 // Fonctions d'affichage SDL
-void drawGrid(SDL_Renderer *renderer, int boardSize, int boardDrawWidth, int boardDrawHeight);
-void drawBoard(SDL_Renderer *renderer, TTF_Font *boardFont, TTF_Font *valueFont,
-               char **board, int boardSize, int boardDrawWidth, int boardDrawHeight, int gridThickness);
-void drawRack(SDL_Renderer *renderer, TTF_Font *rackFont, TTF_Font *valueFont,
-              char *rack, int rackAreaWidth, int startXRack, int buttonMargin,
-              int buttonWidth, int buttonHeight, TTF_Font *inputFont);
-void drawInputArea(SDL_Renderer *renderer, TTF_Font *inputFont, InputState currentState, char *inputBuffer, int totalPoints);
+void drawBoard(SDL_Renderer *renderer, RenderCache *cache, char **board, BonusBoard bonusBoard);
+void drawRack(SDL_Renderer *renderer, RenderCache *cache,
+              const char *rack, int rackAreaWidth, int startXRack, int buttonMargin,
+              int buttonWidth, int buttonHeight);
+void drawInputArea(SDL_Renderer *renderer, const GlyphAtlas *atlas, InputState currentState, char *inputBuffer,
+                   const char *idlePrompt);
+
+// Panneau de débogage (compteurs du dernier indice), une ligne par champ "nom=valeur"
+#define DEBUG_OVERLAY_LINES 16
+void drawDebugOverlay(SDL_Renderer *renderer, RenderCache *cache, const char *text);
 
 #endif  // GRAPHICS_H
@@ -0,0 +1,381 @@
+#include "inference.h"
+#include "bag.h"
+#include "board.h"
+#include "trace.h"
+
+//
+// ---------------------- Lettres invisibles et racks adverses ----------------
+//
+// Les racks adverses sont tirés sans remise dans les lettres invisibles. La table d'alias
+// est construite une seule fois sur le multiensemble complet ; pour tirer sans remise,
+// un symbole proposé s est accepté avec la probabilité restants[s] / initiaux[s]
+// (amincissement), ce qui donne exactement une loi proportionnelle aux lettres restantes
+// sans jamais reconstruire la table ni allouer de mémoire.
+//
+
+// Nombre de propositions refusées avant de repasser à un parcours linéaire
+#define SAMPLER_MAX_REJECTIONS 64
+
+// Retire une lettre du multiensemble (si elle y figure encore) ; une minuscule est un joker posé
+static void removeLetter(UnseenTracker *tracker, char letter) {
+    int s = (letter >= 'a' && letter <= 'z') ? LEAVE_BLANK : leaveSymbol(letter);
+    if (s >= 0 && tracker->counts[s] > 0) {
+        tracker->counts[s]--;
+        tracker->total--;
+    }
+}
+
+/*
+ * Fonction : unseenInit
+ * ---------------------
+ * Initialise les lettres invisibles en début de partie : la distribution complète moins
+ * le rack de départ du joueur.
+ *
+ * Paramètres :
+ *   tracker : le suivi à initialiser.
+ *   rack    : le rack de départ du joueur (terminé par '\0').
+ */
+void unseenInit(UnseenTracker *tracker, const char *rack) {
+    tracker->total = 0;
+    for (int i = 0; i < LEAVE_ALPHABET; i++) {
+        tracker->counts[i] = currentRules->counts[i];
+        tracker->total += tracker->counts[i];
+    }
+    for (int i = 0; rack && rack[i] != '\0'; i++)
+        removeLetter(tracker, rack[i]);
+}
+
+/*
+ * Fonction : unseenRecordPlay
+ * ---------------------------
+ * Met à jour les lettres invisibles après un coup de l'historique. Les lettres posées par
+ * l'adversaire deviennent visibles sur le plateau ; celles posées par le joueur l'étaient
+ * déjà (elles venaient de son rack), seules ses nouvelles lettres tirées sont retirées.
+ *
+ * Paramètres :
+ *   tracker : le suivi des lettres invisibles.
+ *   mine    : vrai si le coup est celui du joueur.
+ *   placed  : lettres posées depuis le rack (peut être NULL).
+ *   drawn   : lettres tirées par le joueur après son coup (ignoré pour l'adversaire).
+ */
+void unseenRecordPlay(UnseenTracker *tracker, bool mine, const char *placed, const char *drawn) {
+    const char *visible = mine ? drawn : placed;
+    for (int i = 0; visible && visible[i] != '\0'; i++)
+        removeLetter(tracker, visible[i]);
+}
+
+void unseenRecordExchange(UnseenTracker *tracker, const char *returned, const char *drawn) {
+    for (int i = 0; returned && returned[i] != '\0'; i++) {
+        int s = leaveSymbol(returned[i]);
+        if (s >= 0) {
+            tracker->counts[s]++;
+            tracker->total++;
+        }
+    }
+    for (int i = 0; drawn && drawn[i] != '\0'; i++)
+        removeLetter(tracker, drawn[i]);
+}
+
+/*
+ * Fonction : unseenFromHistory
+ * ----------------------------
+ * Reconstitue les lettres invisibles d'un joueur à partir de l'historique d'une partie
+ * (coups d'un GameRecord ou historique d'un GameState) : la distribution complète, moins son
+ * rack actuel, moins toutes les lettres posées sur le plateau. Ses échanges et tirages sont
+ * résumés par son rack actuel.
+ *
+ * Paramètres :
+ *   tracker : le suivi à initialiser.
+ *   moves   : les tours joués, dans l'ordre (coups, échanges, passes, fins de partie).
+ *   count   : nombre de tours à prendre en compte.
+ *   rack    : son rack après ces tours (terminé par '\0').
+ */
+void unseenFromHistory(UnseenTracker *tracker, const RecordMove *moves, int count, const char *rack) {
+    unseenInit(tracker, rack);
+    for (int i = 0; i < count; i++)
+        if (moves[i].type == RECORD_PLAY)
+            unseenRecordPlay(tracker, false, moves[i].tiles, NULL);
+}
+
+/*
+ * Fonction : buildAlias
+ * ---------------------
+ * Construit une table d'alias (méthode de Vose) pour des poids positifs : on tire une
+ * case i uniformément, puis on garde i avec la probabilité prob[i], sinon alias[i].
+ *
+ * Paramètres :
+ *   weights : poids des n entrées (la somme doit être strictement positive).
+ *   n       : nombre d'entrées (au plus INFERENCE_CANDIDATES).
+ *   prob    : tableau de sortie des probabilités de conservation.
+ *   alias   : tableau de sortie des alias.
+ */
+static void buildAlias(const double *weights, int n, float *prob, int *alias) {
+    double scaled[INFERENCE_CANDIDATES];
+    int small[INFERENCE_CANDIDATES], large[INFERENCE_CANDIDATES];
+    int nSmall = 0, nLarge = 0;
+    double sum = 0.0;
+    for (int i = 0; i < n; i++)
+        sum += weights[i];
+    for (int i = 0; i < n; i++) {
+        scaled[i] = weights[i] * n / sum;
+        alias[i] = i;
+        if (scaled[i] < 1.0)
+            small[nSmall++] = i;
+        else
+            large[nLarge++] = i;
+    }
+    while (nSmall > 0 && nLarge > 0) {
+        int s = small[--nSmall];
+        int l = large[nLarge - 1];
+        prob[s] = (float)scaled[s];
+        alias[s] = l;
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            nLarge--;
+            small[nSmall++] = l;
+        }
+    }
+    // Restes dus aux arrondis : ces cases se gardent toujours
+    while (nLarge > 0)
+        prob[large[--nLarge]] = 1.0f;
+    while (nSmall > 0)
+        prob[small[--nSmall]] = 1.0f;
+}
+
+// Tire une case d'une table d'alias avec un seul nombre aléatoire de 64 bits
+static inline int aliasPick(const float *prob, const int *alias, int n, uint64_t r) {
+    int i = (int)(((r >> 32) * (uint64_t)n) >> 32);
+    float u = (float)(r & 0xFFFFFFFFu) * (1.0f / 4294967296.0f);
+    return (u < prob[i]) ? i : alias[i];
+}
+
+/*
+ * Fonction : samplerInit
+ * ----------------------
+ * Construit la table d'alias d'un multiensemble de lettres.
+ *
+ * Paramètres :
+ *   sampler : l'échantillonneur à initialiser.
+ *   counts  : nombre de lettres par symbole.
+ */
+void samplerInit(TileSampler *sampler, const int counts[LEAVE_ALPHABET]) {
+    double weights[LEAVE_ALPHABET];
+    int alias[LEAVE_ALPHABET];
+    sampler->total = 0;
+    for (int i = 0; i < LEAVE_ALPHABET; i++) {
+        sampler->counts[i] = counts[i];
+        sampler->total += counts[i];
+        weights[i] = counts[i];
+    }
+    if (sampler->total == 0) {
+        memset(sampler->prob, 0, sizeof(sampler->prob));
+        memset(sampler->alias, 0, sizeof(sampler->alias));
+        return;
+    }
+    buildAlias(weights, LEAVE_ALPHABET, sampler->prob, alias);
+    for (int i = 0; i < LEAVE_ALPHABET; i++)
+        sampler->alias[i] = (uint8_t)alias[i];
+}
+
+/*
+ * Fonction : samplerDraw
+ * ----------------------
+ * Tire un symbole sans remise. La proposition vient de la table d'alias du multiensemble
+ * complet, puis elle est acceptée avec la probabilité remaining[s] / counts[s].
+ *
+ * Paramètres :
+ *   sampler        : l'échantillonneur (non modifié : partageable entre threads).
+ *   rng            : état du générateur du thread appelant.
+ *   remaining      : lettres encore disponibles (décrémenté du symbole tiré).
+ *   remainingTotal : nombre de lettres disponibles (décrémenté).
+ *
+ * Retour :
+ *   Le symbole tiré, ou -1 s'il ne reste aucune lettre.
+ */
+int samplerDraw(const TileSampler *sampler, uint64_t *rng, int remaining[LEAVE_ALPHABET],
+                int *remainingTotal) {
+    if (*remainingTotal <= 0)
+        return -1;
+    int s = -1;
+    for (int attempt = 0; attempt < SAMPLER_MAX_REJECTIONS && s < 0; attempt++) {
+        uint64_t r = nextRandom(rng);
+        int i = (int)(((r >> 32) * (uint64_t)LEAVE_ALPHABET) >> 32);
+        float u = (float)(r & 0xFFFFFFFFu) * (1.0f / 4294967296.0f);
+        int proposal = (u < sampler->prob[i]) ? i : sampler->alias[i];
+        // Une case de poids nul peut garder prob = 1 à cause des arrondis : elle est refusée
+        if (sampler->counts[proposal] == 0)
+            continue;
+        if (remaining[proposal] == sampler->counts[proposal] ||
+            (int)(nextRandom(rng) % (uint64_t)sampler->counts[proposal]) < remaining[proposal])
+            s = proposal;
+    }
+    if (s < 0) {
+        // Multiensemble presque épuisé : parcours linéaire des lettres restantes
+        int r = (int)(nextRandom(rng) % (uint64_t)*remainingTotal);
+        for (s = 0; s < LEAVE_ALPHABET - 1 && r >= remaining[s]; s++)
+            r -= remaining[s];
+    }
+    remaining[s]--;
+    (*remainingTotal)--;
+    return s;
+}
+
+// Lettre du rack correspondant à un symbole
+static char symbolLetter(int s) {
+    return (s == LEAVE_BLANK) ? '?' : (char)('A' + s);
+}
+
+/*
+ * Fonction : inferenceInit
+ * ------------------------
+ * Prépare le tirage de racks adverses sans information : chaque rack est tiré
+ * uniformément (sans remise) dans les lettres invisibles.
+ *
+ * Paramètres :
+ *   inference : l'état d'inférence à initialiser.
+ *   tracker   : les lettres invisibles du point de vue du joueur.
+ *   rackSize  : taille du rack adverse (7, ou moins en fin de partie).
+ */
+void inferenceInit(RackInference *inference, const UnseenTracker *tracker, int rackSize) {
+    samplerInit(&inference->pool, tracker->counts);
+    inference->count = 0;
+    inference->rackSize = (rackSize < tracker->total) ? rackSize : tracker->total;
+}
+
+/*
+ * Fonction : inferenceWeigh
+ * -------------------------
+ * Inférence bayésienne à partir du dernier coup adverse. L'adversaire avait en main les
+ * lettres posées plus un reliquat L, toujours dans son rack. Pour des reliquats L tirés
+ * selon la loi a priori (les lettres invisibles), on génère tous les coups du rack
+ * « posées + L » sur le plateau d'avant le coup : si un coup valait bien mieux que celui
+ * joué, ce reliquat est peu probable. Chaque candidat reçoit le poids exp(-beta * regret),
+ * où regret = meilleure équité - (score joué + valeur de L).
+ *
+ * Paramètres :
+ *   inference   : état initialisé par inferenceInit (après avoir retiré les lettres posées).
+ *   lexicon     : lexique pour la génération des coups.
+ *   boardBefore : le plateau avant le coup adverse.
+ *   boardSize   : taille du plateau.
+ *   bonusBoard  : les cases bonus.
+ *   leaves      : table des reliquats (NULL : reliquats nuls).
+ *   placed      : lettres posées par l'adversaire.
+ *   playScore   : score du coup adverse.
+ *   beta        : sévérité de la pondération (0 : aucune).
+ *   seed        : graine du tirage des candidats.
+ *   scratch     : liste de coups réutilisée pour la génération.
+ *
+ * Retour :
+ *   Le nombre de reliquats candidats retenus, 0 si la pondération ne s'applique pas.
+ */
+int inferenceWeigh(RackInference *inference, const Lexicon *lexicon, char **boardBefore,
+                   int boardSize, BonusBoard bonusBoard, const LeaveTable *leaves,
+                   const char *placed, int playScore, double beta, uint64_t seed,
+                   MoveList *scratch) {
+    inference->count = 0;
+    int placedLen = strnlen(placed, RULESET_MAX_RACK);
+    int keepSize = currentRules->rackSize - placedLen;
+    if (keepSize > inference->rackSize)
+        keepSize = inference->rackSize;
+    if (keepSize <= 0 || placedLen == 0)
+        return 0;
+    TRACE_BEGIN("inferenceWeigh");
+
+    bool firstMove = isBoardEmpty(boardBefore, boardSize);
+    int keptMask = ((1 << (placedLen + keepSize)) - 1) & ~((1 << placedLen) - 1);
+    uint64_t rng = seed ? seed : 1;
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    double weights[INFERENCE_CANDIDATES];
+    double sum = 0.0;
+
+    for (int c = 0; c < INFERENCE_CANDIDATES; c++) {
+        // Tire un reliquat candidat et le range par ordre alphabétique
+        int remaining[LEAVE_ALPHABET];
+        int remainingTotal = inference->pool.total;
+        memcpy(remaining, inference->pool.counts, sizeof(remaining));
+        char *leave = inference->leaves[c];
+        int n = 0;
+        for (int i = 0; i < keepSize; i++) {
+            char letter = symbolLetter(samplerDraw(&inference->pool, &rng, remaining, &remainingTotal));
+            int j = n++;
+            while (j > 0 && leave[j - 1] > letter) {
+                leave[j] = leave[j - 1];
+                j--;
+            }
+            leave[j] = letter;
+        }
+        leave[n] = '\0';
+
+        // Un reliquat déjà évalué reprend son poids sans relancer la génération
+        int same = -1;
+        for (int p = 0; p < c && same < 0; p++)
+            if (strcmp(inference->leaves[p], leave) == 0)
+                same = p;
+        if (same >= 0) {
+            weights[c] = weights[same];
+        } else {
+            char rack[8];
+            memcpy(rack, placed, placedLen);
+            memcpy(rack + placedLen, leave, n + 1);
+            leavePrepareRack(leaves, rack, rackLeaves);
+            generateMoves(lexicon, boardBefore, boardSize, bonusBoard, rack, firstMove,
+                          rackLeaves, scratch);
+            int best = bestMoveIndex(scratch);
+            float played = playScore + rackLeaves[keptMask];
+            float regret = (best >= 0) ? scratch->moves[best].equity - played : 0.0f;
+            weights[c] = exp(-beta * (regret > 0.0f ? regret : 0.0f));
+        }
+        inference->weights[c] = (float)weights[c];
+        sum += weights[c];
+    }
+
+    // Tous les candidats sont invraisemblables : on revient au tirage uniforme
+    if (sum <= 1e-300) {
+        TRACE_END("inferenceWeigh");
+        return 0;
+    }
+    buildAlias(weights, INFERENCE_CANDIDATES, inference->prob, inference->alias);
+    inference->count = INFERENCE_CANDIDATES;
+    TRACE_END("inferenceWeigh");
+    return inference->count;
+}
+
+/*
+ * Fonction : inferenceSampleRack
+ * ------------------------------
+ * Tire un rack adverse : un reliquat candidat selon son poids (s'il y en a), complété par
+ * des lettres tirées sans remise dans le reste des lettres invisibles. Aucune allocation :
+ * l'état du tirage tient sur la pile, plusieurs threads peuvent partager l'inférence.
+ *
+ * Paramètres :
+ *   inference : l'état d'inférence.
+ *   rng       : état du générateur du thread appelant.
+ *   rack      : rack de sortie (terminé par '\0').
+ *
+ * Retour :
+ *   Le nombre de lettres du rack.
+ */
+int inferenceSampleRack(const RackInference *inference, uint64_t *rng, char rack[8]) {
+    int remaining[LEAVE_ALPHABET];
+    int remainingTotal = inference->pool.total;
+    memcpy(remaining, inference->pool.counts, sizeof(remaining));
+    int n = 0;
+
+    if (inference->count > 0) {
+        int c = aliasPick(inference->prob, inference->alias, inference->count, nextRandom(rng));
+        for (const char *p = inference->leaves[c]; *p != '\0'; p++) {
+            int s = leaveSymbol(*p);
+            remaining[s]--;
+            remainingTotal--;
+            rack[n++] = *p;
+        }
+    }
+    while (n < inference->rackSize) {
+        int s = samplerDraw(&inference->pool, rng, remaining, &remainingTotal);
+        if (s < 0)
+            break;
+        rack[n++] = symbolLetter(s);
+    }
+    rack[n] = '\0';
+    return n;
+}
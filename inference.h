@@ -0,0 +1,70 @@
+#ifndef INFERENCE_H
+#define INFERENCE_H
+
+#include "scrabble.h"
+#include "leave.h"
+#include "lexicon.h"
+#include "movegen.h"
+#include "record.h"
+
+// Nombre de reliquats candidats évalués pour l'inférence bayésienne
+#define INFERENCE_CANDIDATES 256
+
+// Lettres invisibles pour un joueur, tenues à jour au fil de l'historique des coups
+typedef struct {
+    int counts[LEAVE_ALPHABET];
+    int total;
+} UnseenTracker;
+
+// Démarre une partie : distribution complète moins le rack de départ du joueur
+void unseenInit(UnseenTracker *tracker, const char *rack);
+
+// Coup de l'historique : lettres posées par l'adversaire (minuscule : joker), ou lettres tirées
+// par le joueur
+void unseenRecordPlay(UnseenTracker *tracker, bool mine, const char *placed, const char *drawn);
+
+// Échange du joueur : les lettres rendues redeviennent invisibles, les lettres tirées non
+void unseenRecordExchange(UnseenTracker *tracker, const char *returned, const char *drawn);
+
+// Lettres invisibles d'un joueur après les count premiers tours d'un historique (coups d'un
+// GameRecord ou d'un GameState), connaissant son rack après ces tours
+void unseenFromHistory(UnseenTracker *tracker, const RecordMove *moves, int count, const char *rack);
+
+// Table d'alias (méthode de Walker/Vose) sur un multiensemble de lettres : tirage en O(1)
+typedef struct {
+    float prob[LEAVE_ALPHABET];
+    uint8_t alias[LEAVE_ALPHABET];
+    int counts[LEAVE_ALPHABET];  // Multiensemble sur lequel la table a été construite
+    int total;
+} TileSampler;
+
+void samplerInit(TileSampler *sampler, const int counts[LEAVE_ALPHABET]);
+
+// Tire un symbole sans remise parmi remaining (sous-multiensemble de sampler->counts)
+int samplerDraw(const TileSampler *sampler, uint64_t *rng, int remaining[LEAVE_ALPHABET],
+                int *remainingTotal);
+
+// Rack adverse probable : reliquats candidats pondérés, complétés par un tirage uniforme
+typedef struct {
+    TileSampler pool;                          // Lettres invisibles
+    char leaves[INFERENCE_CANDIDATES][8];      // Reliquats candidats (après le dernier coup)
+    float prob[INFERENCE_CANDIDATES];          // Table d'alias sur les poids des candidats
+    int alias[INFERENCE_CANDIDATES];
+    float weights[INFERENCE_CANDIDATES];
+    int count;                                 // 0 : pas de pondération, tirage uniforme
+    int rackSize;                              // Taille du rack adverse
+} RackInference;
+
+// Sans information sur l'adversaire : racks tirés uniformément dans les lettres invisibles
+void inferenceInit(RackInference *inference, const UnseenTracker *tracker, int rackSize);
+
+// Repondère les racks avec le dernier coup adverse (poids exp(-beta * regret))
+int inferenceWeigh(RackInference *inference, const Lexicon *lexicon, char **boardBefore,
+                   int boardSize, BonusBoard bonusBoard, const LeaveTable *leaves,
+                   const char *placed, int playScore, double beta, uint64_t seed,
+                   MoveList *scratch);
+
+// Tire un rack adverse (sans allocation) ; retourne sa taille
+int inferenceSampleRack(const RackInference *inference, uint64_t *rng, char rack[8]);
+
+#endif  // INFERENCE_H
@@ -0,0 +1,270 @@
+#include "leave.h"
+#include "trace.h"
+
+//
+// ---------------------- Valeurs de reliquat (leave) --------------------------
+//
+
+// Identifiant du format binaire de la table
+static const char LEAVE_MAGIC[4] = { 'S', 'C', 'L', 'V' };
+#define LEAVE_VERSION 1
+
+// rankTerm[i][c] = C(c + i - 1, i) : contribution du i-ème symbole (1-based) au rang
+static int rankTerm[LEAVE_MAX_TILES + 1][LEAVE_ALPHABET];
+// sizeOffset[k] = nombre de multiensembles de taille < k
+static int sizeOffset[LEAVE_MAX_TILES + 2];
+static bool ranksReady = false;
+
+// Coefficient binomial C(n, k) pour de petites valeurs
+static int binomial(int n, int k) {
+    if (k < 0 || k > n)
+        return 0;
+    long long result = 1;
+    for (int i = 1; i <= k; i++)
+        result = result * (n - k + i) / i;
+    return (int)result;
+}
+
+// Précalcule les tables du rang combinatoire (idempotent)
+static void initLeaveRanks(void) {
+    if (ranksReady)
+        return;
+    for (int i = 1; i <= LEAVE_MAX_TILES; i++)
+        for (int c = 0; c < LEAVE_ALPHABET; c++)
+            rankTerm[i][c] = binomial(c + i - 1, i);
+    sizeOffset[0] = 0;
+    for (int k = 0; k <= LEAVE_MAX_TILES; k++)
+        sizeOffset[k + 1] = sizeOffset[k] + binomial(LEAVE_ALPHABET + k - 1, k);
+    ranksReady = true;
+}
+
+/*
+ * Fonction : leaveSymbol
+ * ----------------------
+ * Convertit une lettre du rack en symbole de l'alphabet des reliquats.
+ *
+ * Paramètre :
+ *   letter : la lettre ('A'..'Z', minuscules acceptées) ou '?' pour un joker.
+ *
+ * Retour :
+ *   Le symbole (0..25 pour les lettres, LEAVE_BLANK pour le joker), -1 sinon.
+ */
+int leaveSymbol(char letter) {
+    if (letter == '?')
+        return LEAVE_BLANK;
+    letter = toupper(letter);
+    if (letter >= 'A' && letter <= 'Z')
+        return letter - 'A';
+    return -1;
+}
+
+/*
+ * Fonction : leaveRank
+ * --------------------
+ * Calcule le rang combinatoire parfait d'un multiensemble de symboles.
+ * Les multiensembles sont rangés par taille, puis dans le système combinatoire :
+ * le multiensemble trié c1 <= c2 <= ... <= ck devient la suite strictement croissante
+ * ci + (i - 1), dont le rang vaut la somme des C(ci + i - 1, i).
+ *
+ * Paramètres :
+ *   symbols : symboles triés par ordre croissant.
+ *   count   : nombre de symboles (0..LEAVE_MAX_TILES).
+ *
+ * Retour :
+ *   Un indice dans [0, LEAVE_TABLE_SIZE), sans trou ni collision.
+ */
+int leaveRank(const int *symbols, int count) {
+    initLeaveRanks();
+    int rank = sizeOffset[count];
+    for (int i = 0; i < count; i++)
+        rank += rankTerm[i + 1][symbols[i]];
+    return rank;
+}
+
+/*
+ * Fonction : leaveSubRanks
+ * ------------------------
+ * Calcule en une passe le rang de chacun des sous-multiensembles obtenus en retirant
+ * un symbole : retirer le symbole i décale d'un cran le terme des symboles suivants.
+ * Avec des sommes préfixes et suffixes, les count rangs coûtent O(count) au total.
+ *
+ * Paramètres :
+ *   symbols : symboles triés par ordre croissant (count <= LEAVE_MAX_TILES + 1).
+ *   count   : nombre de symboles.
+ *   ranks   : tableau de sortie de count rangs (ranks[i] : sans le symbole i).
+ */
+void leaveSubRanks(const int *symbols, int count, int *ranks) {
+    initLeaveRanks();
+    int suffix[LEAVE_MAX_TILES + 2];
+    suffix[count] = 0;
+    for (int j = count - 1; j >= 1; j--)
+        suffix[j] = suffix[j + 1] + rankTerm[j][symbols[j]];
+    int prefix = 0;
+    for (int i = 0; i < count; i++) {
+        ranks[i] = sizeOffset[count - 1] + prefix + (i + 1 < count ? suffix[i + 1] : 0);
+        if (i < LEAVE_MAX_TILES)
+            prefix += rankTerm[i + 1][symbols[i]];
+    }
+}
+
+/*
+ * Fonction : createLeaveTable
+ * ---------------------------
+ * Alloue une table de reliquats dont toutes les valeurs sont nulles.
+ *
+ * Retour :
+ *   La table allouée, ou NULL en cas d'échec d'allocation.
+ */
+LeaveTable *createLeaveTable(void) {
+    initLeaveRanks();
+    LeaveTable *table = malloc(sizeof(LeaveTable));
+    if (!table) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return NULL;
+    }
+    table->size = LEAVE_TABLE_SIZE;
+    table->values = calloc(LEAVE_TABLE_SIZE, sizeof(float));
+    if (!table->values) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        free(table);
+        return NULL;
+    }
+    return table;
+}
+
+/*
+ * Fonction : loadLeaveTable
+ * -------------------------
+ * Charge une table de reliquats depuis un fichier binaire.
+ * Format : "SCLV", version (uint32), nombre de valeurs (uint32), puis les valeurs (float32).
+ *
+ * Paramètre :
+ *   filename : chemin du fichier binaire.
+ *
+ * Retour :
+ *   La table chargée, ou NULL si le fichier est absent ou invalide.
+ */
+LeaveTable *loadLeaveTable(const char *filename) {
+    TRACE_BEGIN("loadLeaves");
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
+        TRACE_END("loadLeaves");
+        return NULL;
+    }
+
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic) ||
+        memcmp(magic, LEAVE_MAGIC, sizeof(magic)) != 0 ||
+        fread(&version, sizeof(version), 1, fp) != 1 || version != LEAVE_VERSION ||
+        fread(&count, sizeof(count), 1, fp) != 1 || count != LEAVE_TABLE_SIZE) {
+        fprintf(stderr, "Fichier de reliquats invalide : %s\n", filename);
+        fclose(fp);
+        TRACE_END("loadLeaves");
+        return NULL;
+    }
+
+    LeaveTable *table = createLeaveTable();
+    if (!table) {
+        fclose(fp);
+        TRACE_END("loadLeaves");
+        return NULL;
+    }
+    if (fread(table->values, sizeof(float), count, fp) != count) {
+        fprintf(stderr, "Fichier de reliquats tronqué : %s\n", filename);
+        freeLeaveTable(table);
+        fclose(fp);
+        TRACE_END("loadLeaves");
+        return NULL;
+    }
+
+    fclose(fp);
+    TRACE_END("loadLeaves");
+    return table;
+}
+
+/*
+ * Fonction : saveLeaveTable
+ * -------------------------
+ * Écrit la table de reliquats dans le format binaire lu par loadLeaveTable.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'erreur d'écriture.
+ */
+int saveLeaveTable(const LeaveTable *table, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
+        return -1;
+    }
+    uint32_t version = LEAVE_VERSION, count = (uint32_t)table->size;
+    bool ok = fwrite(LEAVE_MAGIC, 1, sizeof(LEAVE_MAGIC), fp) == sizeof(LEAVE_MAGIC) &&
+              fwrite(&version, sizeof(version), 1, fp) == 1 &&
+              fwrite(&count, sizeof(count), 1, fp) == 1 &&
+              fwrite(table->values, sizeof(float), count, fp) == count;
+    if (fclose(fp) != 0)
+        ok = false;
+    if (!ok) {
+        fprintf(stderr, "Erreur d'écriture du fichier %s\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+void freeLeaveTable(LeaveTable *table) {
+    if (!table)
+        return;
+    free(table->values);
+    free(table);
+}
+
+/*
+ * Fonction : leavePrepareRack
+ * ---------------------------
+ * Précalcule la valeur du reliquat pour les 128 sous-ensembles de positions du rack.
+ * Le bit i du masque indique que la lettre rack[i] est conservée. Pendant la génération,
+ * l'évaluation d'un coup se réduit alors à leaves[masqueConservé] : un seul accès mémoire.
+ *
+ * Paramètres :
+ *   table  : table des reliquats (NULL : toutes les valeurs sont nulles).
+ *   rack   : lettres du rack (au plus 7, terminé par '\0').
+ *   leaves : tableau de sortie de LEAVE_RACK_SUBSETS valeurs.
+ *
+ * Remarque :
+ *   - Les masques de plus de LEAVE_MAX_TILES lettres (aucune lettre posée) valent 0.
+ */
+void leavePrepareRack(const LeaveTable *table, const char *rack, float leaves[LEAVE_RACK_SUBSETS]) {
+    int symbols[7];
+    int rackLen = 0;
+    for (int i = 0; i < 7 && rack[i] != '\0'; i++)
+        symbols[rackLen++] = leaveSymbol(rack[i]);
+
+    for (int mask = 0; mask < LEAVE_RACK_SUBSETS; mask++) {
+        leaves[mask] = 0.0f;
+        if (!table)
+            continue;
+
+        // Rassemble et trie (insertion) les symboles conservés
+        int kept[7];
+        int count = 0;
+        bool valid = true;
+        for (int i = 0; i < rackLen; i++) {
+            if (!(mask & (1 << i)))
+                continue;
+            int s = symbols[i];
+            if (s < 0) {
+                valid = false;
+                break;
+            }
+            int j = count++;
+            while (j > 0 && kept[j - 1] > s) {
+                kept[j] = kept[j - 1];
+                j--;
+            }
+            kept[j] = s;
+        }
+        if (valid && count <= LEAVE_MAX_TILES)
+            leaves[mask] = table->values[leaveRank(kept, count)];
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef LEAVE_H
+#define LEAVE_H
+
+#include "scrabble.h"
+
+// Alphabet des reliquats : 'A'..'Z' puis le joker '?'
+#define LEAVE_ALPHABET    27
+#define LEAVE_BLANK       26
+// Taille maximale d'un reliquat (un coup pose au moins une lettre du rack de 7)
+#define LEAVE_MAX_TILES   6
+// Nombre de sous-multiensembles de 0 à 6 lettres sur 27 symboles : C(33, 6)
+#define LEAVE_TABLE_SIZE  1107568
+// Nombre de sous-ensembles de positions d'un rack de 7 lettres
+#define LEAVE_RACK_SUBSETS 128
+
+// Table des valeurs de reliquat, indexée par le rang combinatoire du multiensemble
+struct LeaveTable {
+    float *values;   // LEAVE_TABLE_SIZE valeurs (en points)
+    int size;
+};
+
+// Conversion lettre -> symbole (0..26), -1 si le caractère n'est pas une lettre du jeu
+int leaveSymbol(char letter);
+
+// Rang d'un multiensemble de symboles triés par ordre croissant (count <= LEAVE_MAX_TILES)
+int leaveRank(const int *symbols, int count);
+
+// Rangs des count sous-multiensembles obtenus en retirant chacun des symboles (triés)
+void leaveSubRanks(const int *symbols, int count, int *ranks);
+
+// Création, chargement, sauvegarde et libération d'une table
+LeaveTable *createLeaveTable(void);
+LeaveTable *loadLeaveTable(const char *filename);
+int saveLeaveTable(const LeaveTable *table, const char *filename);
+void freeLeaveTable(LeaveTable *table);
+
+// Valeur du reliquat pour chaque sous-ensemble de positions conservées du rack
+void leavePrepareRack(const LeaveTable *table, const char *rack, float leaves[LEAVE_RACK_SUBSETS]);
+
+#endif  // LEAVE_H
@@ -0,0 +1,217 @@
+#include "lexicon.h"
+#include "stats.h"
+#include "trace.h"
+
+//
+// ---------------------- Arbre lexical (trie compact) ------------------------
+//
+
+static int compareWords(const void *a, const void *b) {
+    return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
+
+/*
+ * Fonction : buildLexicon
+ * -----------------------
+ * Construit un arbre lexical compact à partir du dictionnaire chargé en table de hachage.
+ * Les mots sont mis en majuscules, triés, puis l'arbre est construit en largeur :
+ * les fils de chaque nœud sont ainsi alloués de façon contiguë.
+ *
+ * Paramètres :
+ *   dictionary : la table de hachage contenant les mots du dictionnaire.
+ *
+ * Retour :
+ *   Un pointeur vers le lexique, ou NULL en cas d'échec d'allocation.
+ *
+ * Remarque :
+ *   - Les mots contenant d'autres caractères que A-Z (accents, tirets...) sont ignorés.
+ */
+Lexicon *buildLexicon(DictionaryEntry *dictionary) {
+    TRACE_BEGIN("buildLexicon");
+    int total = HASH_COUNT(dictionary);
+    char **words = malloc((total + 1) * sizeof(char *));
+    char *storage = malloc((size_t)total * sizeof(dictionary->word) + 1);
+    Lexicon *lexicon = calloc(1, sizeof(Lexicon));
+    int capacity = 1024;
+    int *rangeStart = malloc(capacity * sizeof(int));
+    int *rangeEnd = malloc(capacity * sizeof(int));
+    int *depth = malloc(capacity * sizeof(int));
+    if (lexicon)
+        lexicon->nodes = malloc(capacity * sizeof(LexiconNode));
+    if (!words || !storage || !lexicon || !lexicon->nodes || !rangeStart || !rangeEnd || !depth) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        goto fail;
+    }
+
+    // Copie les mots valides en majuscules
+    int n = 0;
+    char *next = storage;
+    DictionaryEntry *entry, *tmp;
+    HASH_ITER(hh, dictionary, entry, tmp) {
+        int len = 0;
+        bool valid = entry->word[0] != '\0';
+        for (; entry->word[len] != '\0'; len++) {
+            char c = toupper((unsigned char)entry->word[len]);
+            if (c < 'A' || c > 'Z') {
+                valid = false;
+                break;
+            }
+            next[len] = c;
+        }
+        if (!valid)
+            continue;
+        next[len] = '\0';
+        words[n++] = next;
+        next += len + 1;
+    }
+    qsort(words, n, sizeof(char *), compareWords);
+
+    // Supprime les doublons (mots présents en minuscules et en majuscules)
+    int unique = 0;
+    for (int i = 0; i < n; i++)
+        if (unique == 0 || strcmp(words[unique - 1], words[i]) != 0)
+            words[unique++] = words[i];
+    n = unique;
+    lexicon->wordCount = n;
+
+    // Construction en largeur : chaque nœud couvre la plage de mots partageant son préfixe
+    lexicon->count = 1;
+    rangeStart[0] = 0;
+    rangeEnd[0] = n;
+    depth[0] = 0;
+    for (int i = 0; i < lexicon->count; i++) {
+        int j = rangeStart[i], end = rangeEnd[i], d = depth[i];
+        uint32_t mask = 0;
+
+        // Le mot égal au préfixe (s'il existe) est le premier de la plage triée
+        if (j < end && words[j][d] == '\0') {
+            mask |= LEXICON_TERMINAL;
+            j++;
+        }
+
+        lexicon->nodes[i].firstChild = (uint32_t)lexicon->count;
+        while (j < end) {
+            char letter = words[j][d];
+            int k = j;
+            while (k < end && words[k][d] == letter)
+                k++;
+
+            if (lexicon->count == capacity) {
+                capacity *= 2;
+                LexiconNode *nodes = realloc(lexicon->nodes, capacity * sizeof(LexiconNode));
+                int *s = realloc(rangeStart, capacity * sizeof(int));
+                if (s) rangeStart = s;
+                int *e = realloc(rangeEnd, capacity * sizeof(int));
+                if (e) rangeEnd = e;
+                int *dd = realloc(depth, capacity * sizeof(int));
+                if (dd) depth = dd;
+                if (nodes) lexicon->nodes = nodes;
+                if (!nodes || !s || !e || !dd) {
+                    fprintf(stderr, "Erreur d'allocation mémoire.\n");
+                    goto fail;
+                }
+            }
+            int child = lexicon->count++;
+            rangeStart[child] = j;
+            rangeEnd[child] = k;
+            depth[child] = d + 1;
+            mask |= 1u << (letter - 'A');
+            j = k;
+        }
+        lexicon->nodes[i].mask = mask;
+    }
+
+    // Ajuste la mémoire au nombre réel de nœuds
+    LexiconNode *shrunk = realloc(lexicon->nodes, lexicon->count * sizeof(LexiconNode));
+    if (shrunk)
+        lexicon->nodes = shrunk;
+
+    free(words);
+    free(storage);
+    free(rangeStart);
+    free(rangeEnd);
+    free(depth);
+    TRACE_END("buildLexicon");
+    return lexicon;
+
+fail:
+    free(words);
+    free(storage);
+    free(rangeStart);
+    free(rangeEnd);
+    free(depth);
+    freeLexicon(lexicon);
+    TRACE_END("buildLexicon");
+    return NULL;
+}
+
+void freeLexicon(Lexicon *lexicon) {
+    if (!lexicon)
+        return;
+    free(lexicon->nodes);
+    free(lexicon);
+}
+
+/*
+ * Fonction : lexiconContains
+ * --------------------------
+ * Vérifie si un mot (majuscules ou minuscules) appartient au lexique.
+ *
+ * Retour :
+ *   true si le mot est présent, false sinon.
+ */
+bool lexiconContains(const Lexicon *lexicon, const char *word) {
+    int node = 0;
+    STAT_INC(STAT_DICT_PROBES);
+    for (int i = 0; word[i] != '\0'; i++) {
+        char c = toupper((unsigned char)word[i]);
+        if (c < 'A' || c > 'Z')
+            return false;
+        node = lexiconChild(lexicon, node, c - 'A');
+        if (node < 0)
+            return false;
+    }
+    return (lexicon->nodes[node].mask & LEXICON_TERMINAL) != 0;
+}
+
+/*
+ * Fonction : lexiconContainsSorted
+ * --------------------------------
+ * Vérifie un lot de mots triés. Chaque mot reprend le chemin du mot précédent à partir de
+ * leur plus long préfixe commun : les nœuds partagés par des mots voisins ne sont parcourus
+ * qu'une fois, et le parcours de l'arbre progresse dans l'ordre des nœuds.
+ *
+ * Paramètres :
+ *   lexicon : le lexique.
+ *   words   : les mots, en majuscules, triés par ordre croissant (strcmp).
+ *   count   : le nombre de mots.
+ *   found   : reçoit, pour chaque mot, sa présence dans le lexique.
+ */
+void lexiconContainsSorted(const Lexicon *lexicon, const char *const *words, int count,
+                           bool *found) {
+    int path[LEXICON_MAX_DEPTH + 1];   // path[i] : nœud atteint après i lettres du mot précédent
+    const char *prev = "";
+    int depth = 0;                     // Nombre de lettres du mot précédent présentes dans path
+    path[0] = 0;
+    STAT_ADD(STAT_DICT_PROBES, count);
+    for (int w = 0; w < count; w++) {
+        const char *word = words[w];
+        int i = 0;
+        while (i < depth && prev[i] == word[i])
+            i++;
+        int node = path[i];
+        for (; word[i] != '\0'; i++) {
+            if (word[i] < 'A' || word[i] > 'Z' || i == LEXICON_MAX_DEPTH) {
+                node = -1;
+                break;
+            }
+            node = lexiconChild(lexicon, node, word[i] - 'A');
+            if (node < 0)
+                break;
+            path[i + 1] = node;
+        }
+        found[w] = node >= 0 && (lexicon->nodes[node].mask & LEXICON_TERMINAL) != 0;
+        depth = i;
+        prev = word;
+    }
+}
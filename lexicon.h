@@ -0,0 +1,50 @@
+#ifndef LEXICON_H
+#define LEXICON_H
+
+#include "scrabble.h"
+
+// Bit indiquant qu'un nœud termine un mot (les bits 0..25 codent les fils 'A'..'Z')
+#define LEXICON_TERMINAL (1u << 26)
+#define LEXICON_LETTERS  ((1u << 26) - 1)
+
+// Longueur maximale d'un mot vérifié par lot (lexiconContainsSorted)
+#define LEXICON_MAX_DEPTH 64
+
+// Nœud de l'arbre lexical : les fils d'un nœud sont contigus et rangés par lettre,
+// le fils de la lettre l se trouve donc à firstChild + popcount(mask & ((1 << l) - 1)).
+typedef struct {
+    uint32_t firstChild;
+    uint32_t mask;
+} LexiconNode;
+
+// Arbre lexical compact construit à partir du dictionnaire (racine : nœud 0)
+typedef struct {
+    LexiconNode *nodes;
+    int count;
+    int wordCount;
+} Lexicon;
+
+// Construit l'arbre à partir de la table de hachage (mots A-Z uniquement)
+Lexicon *buildLexicon(DictionaryEntry *dictionary);
+void freeLexicon(Lexicon *lexicon);
+
+// Vérifie si un mot appartient au lexique
+bool lexiconContains(const Lexicon *lexicon, const char *word);
+
+// Vérifie un lot de mots en majuscules triés par ordre croissant (un seul parcours de l'arbre)
+void lexiconContainsSorted(const Lexicon *lexicon, const char *const *words, int count,
+                           bool *found);
+
+/*
+ * Fils d'un nœud pour la lettre l (0..25), ou -1 s'il n'existe pas.
+ * Définie ici pour être intégrée dans les boucles du générateur de coups.
+ */
+static inline int lexiconChild(const Lexicon *lexicon, int node, int letter) {
+    uint32_t mask = lexicon->nodes[node].mask;
+    uint32_t bit = 1u << letter;
+    if (!(mask & bit))
+        return -1;
+    return (int)(lexicon->nodes[node].firstChild + __builtin_popcount(mask & (bit - 1)));
+}
+
+#endif  // LEXICON_H
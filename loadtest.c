@@ -0,0 +1,329 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "server.h"           // Protocole : trames, opérations et statuts
+
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+//
+// ---------------------- Charge en rafale sur le serveur ---------------------
+//
+// Vérifie qu'un client qui envoie ses requêtes à la suite sans lire les réponses obtient
+// toutes ses réponses : des trames BATCH de taille maximale remplies de STATE, puis des
+// milliers de STATE isolés, bien au-delà de ce que le serveur garde en attente avant de
+// cesser de lire. Les réponses sont lues pendant l'envoi ; l'outil échoue si plus rien
+// n'avance pendant le délai donné (serveur bloqué) ou si une réponse manque ou est fausse.
+//
+
+#define LOADTEST_DEFAULT_SOCKET  "scrabble.sock"
+#define LOADTEST_STATE_SIZE      (21 + SERVER_BOARD_SIZE * SERVER_BOARD_SIZE)
+#define LOADTEST_BATCH_ITEM      7   // Longueur (u16), opération, partie (u32)
+#define LOADTEST_BATCH_ITEMS     ((SERVER_MAX_FRAME - 7) / LOADTEST_BATCH_ITEM)
+#define LOADTEST_SINGLE_FRAME    13  // Longueur, identifiant, opération, partie
+
+typedef struct {
+    unsigned char *data;
+    size_t len;
+    size_t capacity;
+} Buffer;
+
+static double nowSeconds(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void putLittle(unsigned char *p, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++)
+        p[i] = (unsigned char)(value >> (8 * i));
+}
+
+static uint32_t getLittle(const unsigned char *p, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++)
+        value |= (uint32_t)p[i] << (8 * i);
+    return value;
+}
+
+static int reserve(Buffer *b, size_t extra) {
+    if (b->len + extra <= b->capacity)
+        return 0;
+    size_t capacity = b->capacity ? b->capacity : 65536;
+    while (capacity < b->len + extra)
+        capacity *= 2;
+    unsigned char *data = realloc(b->data, capacity);
+    if (!data) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return -1;
+    }
+    b->data = data;
+    b->capacity = capacity;
+    return 0;
+}
+
+// Connexion à la socket, réessayée tant que le serveur charge son dictionnaire
+static int connectServer(const char *path, double timeout) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Erreur : chemin de socket trop long : %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    double deadline = nowSeconds() + timeout;
+    for (;;) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            perror("socket");
+            return -1;
+        }
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+            return fd;
+        close(fd);
+        if (nowSeconds() > deadline) {
+            fprintf(stderr, "Erreur de connexion à %s : %s\n", path, strerror(errno));
+            return -1;
+        }
+        struct timespec pause = { 0, 50 * 1000 * 1000 };
+        nanosleep(&pause, NULL);
+    }
+}
+
+// Ouvre une partie (échange bloquant) ; retourne son numéro ou -1
+static long openGame(int fd) {
+    unsigned char frame[SERVER_REQUEST_HEADER];
+    putLittle(frame, SERVER_REQUEST_HEADER - 4, 4);
+    putLittle(frame + 4, 0, 4);
+    frame[8] = SERVER_NEW_GAME;
+    if (write(fd, frame, sizeof(frame)) != (ssize_t)sizeof(frame)) {
+        perror("write");
+        return -1;
+    }
+    unsigned char response[SERVER_RESPONSE_HEADER + 4];
+    size_t got = 0;
+    while (got < sizeof(response)) {
+        ssize_t n = read(fd, response + got, sizeof(response) - got);
+        if (n <= 0) {
+            fprintf(stderr, "Erreur : connexion fermée pendant NEW_GAME\n");
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    if (getLittle(response, 4) != SERVER_RESPONSE_HEADER || response[9] != SERVER_OK) {
+        fprintf(stderr, "Erreur : NEW_GAME refusé (statut %d)\n", response[9]);
+        return -1;
+    }
+    return (long)getLittle(response + SERVER_RESPONSE_HEADER, 4);
+}
+
+// Prépare toutes les requêtes : batches trames BATCH (identifiants 1..), puis singles STATE
+static int buildRequests(Buffer *out, uint32_t game, int batches, int singles) {
+    size_t batchFrame = 4 + 7 + (size_t)LOADTEST_BATCH_ITEMS * LOADTEST_BATCH_ITEM;
+    if (reserve(out, batches * batchFrame + (size_t)singles * LOADTEST_SINGLE_FRAME) != 0)
+        return -1;
+    uint32_t id = 1;
+    for (int b = 0; b < batches; b++, id++) {
+        unsigned char *p = out->data + out->len;
+        putLittle(p, (uint32_t)(batchFrame - 4), 4);
+        putLittle(p + 4, id, 4);
+        p[8] = SERVER_BATCH;
+        putLittle(p + 9, LOADTEST_BATCH_ITEMS, 2);
+        p += 11;
+        for (int i = 0; i < LOADTEST_BATCH_ITEMS; i++, p += LOADTEST_BATCH_ITEM) {
+            putLittle(p, 5, 2);
+            p[2] = SERVER_STATE;
+            putLittle(p + 3, game, 4);
+        }
+        out->len += batchFrame;
+    }
+    for (int i = 0; i < singles; i++, id++) {
+        unsigned char *p = out->data + out->len;
+        putLittle(p, LOADTEST_SINGLE_FRAME - 4, 4);
+        putLittle(p + 4, id, 4);
+        p[8] = SERVER_STATE;
+        putLittle(p + 9, game, 4);
+        out->len += LOADTEST_SINGLE_FRAME;
+    }
+    return 0;
+}
+
+// Vérifie une réponse : les requêtes étant toutes immédiates, elles reviennent dans l'ordre
+static bool checkResponse(const unsigned char *frame, size_t len, uint32_t expectedId, int batches) {
+    uint32_t id = getLittle(frame + 4, 4);
+    const unsigned char *data = frame + SERVER_RESPONSE_HEADER;
+    size_t dataLen = len - SERVER_RESPONSE_HEADER;
+    if (id != expectedId || frame[9] != SERVER_OK) {
+        fprintf(stderr, "Réponse %u inattendue (attendue : %u, statut %d)\n", id, expectedId,
+                frame[9]);
+        return false;
+    }
+    if (id > (uint32_t)batches) {
+        if (frame[8] != SERVER_STATE || dataLen != LOADTEST_STATE_SIZE) {
+            fprintf(stderr, "Réponse STATE %u mal formée (%zu octets)\n", id, dataLen);
+            return false;
+        }
+        return true;
+    }
+    if (frame[8] != SERVER_BATCH || dataLen < 2 || getLittle(data, 2) != LOADTEST_BATCH_ITEMS) {
+        fprintf(stderr, "Réponse BATCH %u mal formée\n", id);
+        return false;
+    }
+    size_t k = 2;
+    for (int i = 0; i < LOADTEST_BATCH_ITEMS; i++) {
+        if (k + 3 > dataLen || getLittle(data + k, 2) != 1 + LOADTEST_STATE_SIZE ||
+            data[k + 2] != SERVER_OK) {
+            fprintf(stderr, "Réponse BATCH %u : élément %d mal formé\n", id, i);
+            return false;
+        }
+        k += 2 + 1 + LOADTEST_STATE_SIZE;
+    }
+    if (k != dataLen) {
+        fprintf(stderr, "Réponse BATCH %u : %zu octets en trop\n", id, dataLen - k);
+        return false;
+    }
+    return true;
+}
+
+// Envoie toutes les requêtes sans attendre et lit les réponses au fil de l'eau
+static int runLoad(int fd, const Buffer *requests, int batches, int singles, double timeout) {
+    Buffer in = { 0 };
+    size_t sent = 0;
+    size_t received = 0;
+    uint32_t expectedId = 1;
+    uint32_t lastId = (uint32_t)(batches + singles);
+    double start = nowSeconds();
+    double progress = start;
+    int status = 0;
+
+    while (expectedId <= lastId) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN | (sent < requests->len ? POLLOUT : 0) };
+        if (poll(&pfd, 1, 100) < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("poll");
+            status = -1;
+            break;
+        }
+        if (pfd.revents & POLLOUT) {
+            ssize_t n = send(fd, requests->data + sent, requests->len - sent, MSG_DONTWAIT);
+            if (n > 0) {
+                sent += (size_t)n;
+                progress = nowSeconds();
+            } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                perror("send");
+                status = -1;
+                break;
+            }
+        }
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (reserve(&in, 65536) != 0) {
+                status = -1;
+                break;
+            }
+            ssize_t n = recv(fd, in.data + in.len, in.capacity - in.len, MSG_DONTWAIT);
+            if (n == 0) {
+                fprintf(stderr, "Erreur : connexion fermée par le serveur\n");
+                status = -1;
+                break;
+            }
+            if (n > 0) {
+                in.len += (size_t)n;
+                received += (size_t)n;
+                progress = nowSeconds();
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                perror("recv");
+                status = -1;
+                break;
+            }
+        }
+
+        // Réponses complètes
+        size_t used = 0;
+        while (status == 0 && in.len - used >= 4) {
+            size_t len = getLittle(in.data + used, 4);
+            if (len < SERVER_RESPONSE_HEADER - 4) {
+                fprintf(stderr, "Erreur : trame de réponse trop courte\n");
+                status = -1;
+            } else if (in.len - used >= 4 + len) {
+                if (!checkResponse(in.data + used, 4 + len, expectedId++, batches))
+                    status = -1;
+                used += 4 + len;
+            } else {
+                break;
+            }
+        }
+        memmove(in.data, in.data + used, in.len - used);
+        in.len -= used;
+        if (status != 0)
+            break;
+
+        if (nowSeconds() - progress > timeout) {
+            fprintf(stderr, "Erreur : plus rien ne bouge depuis %.0f s (%zu / %zu octets envoyés, "
+                    "%u / %u réponses)\n", timeout, sent, requests->len, expectedId - 1, lastId);
+            status = -1;
+            break;
+        }
+    }
+    if (status == 0) {
+        double elapsed = nowSeconds() - start;
+        printf("%d trames BATCH (%d requêtes chacune) et %d requêtes isolées : %u réponses, "
+               "%.1f Mo reçus en %.2f s\n", batches, LOADTEST_BATCH_ITEMS, singles, lastId,
+               received / 1e6, elapsed);
+    }
+    free(in.data);
+    return status;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-s socket] [-b trames] [-n requêtes] [-t délai]\n"
+            "  -s : chemin de la socket Unix du serveur (défaut : %s)\n"
+            "  -b : trames BATCH de taille maximale envoyées à la suite (défaut : 16)\n"
+            "  -n : requêtes STATE isolées envoyées ensuite (défaut : 20000)\n"
+            "  -t : secondes sans progrès avant de conclure au blocage (défaut : 10)\n",
+            prog, LOADTEST_DEFAULT_SOCKET);
+}
+
+// Fonction principale de l'outil de charge
+int main(int argc, char *argv[]) {
+    const char *socketPath = LOADTEST_DEFAULT_SOCKET;
+    int batches = 16;
+    int singles = 20000;
+    double timeout = 10.0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:b:n:t:h")) != -1) {
+        switch (opt) {
+            case 's': socketPath = optarg; break;
+            case 'b': batches = atoi(optarg); break;
+            case 'n': singles = atoi(optarg); break;
+            case 't': timeout = atof(optarg); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (batches < 0 || singles < 0 || batches + singles < 1 || timeout <= 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int fd = connectServer(socketPath, timeout);
+    if (fd < 0)
+        return EXIT_FAILURE;
+    long game = openGame(fd);
+    Buffer requests = { 0 };
+    int status = -1;
+    if (game >= 0 && buildRequests(&requests, (uint32_t)game, batches, singles) == 0)
+        status = runLoad(fd, &requests, batches, singles, timeout);
+    free(requests.data);
+    close(fd);
+    return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
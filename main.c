@@ -3,65 +3,272 @@
 #include "board.h"            // Inclusion des fonctions de gestion du plateau de jeu
 #include "graphics.h"         // Inclusion des fonctions de rendu graphique
 #include "utils.h"            // Inclusion des fonctions utilitaires (initialisation, nettoyage, etc.)
-#include "bestmove.h"         // Inclusion des fonctions de recherche du meilleur coup
+#include "leave.h"            // Inclusion de la table des valeurs de reliquat
+#include "lexicon.h"          // Inclusion de l'arbre lexical du générateur de coups
+#include "movegen.h"          // Inclusion du générateur de coups
+#include "bag.h"              // Inclusion du décompte des lettres invisibles
+#include "exchange.h"         // Inclusion de l'analyse des échanges
+#include "stats.h"            // Inclusion des compteurs d'instrumentation (SCRABBLE_STATS)
+#include "trace.h"            // Inclusion des traces chronologiques (SCRABBLE_TRACE)
+#include "record.h"           // Inclusion de l'enregistrement de la partie
+#include "duplicate.h"        // Inclusion du mode duplicate (tirage commun et top)
+#include "gamestate.h"        // Inclusion de l'état de la partie à plusieurs joueurs
 
-// Fonction principale du programme
+#include <pthread.h>
+
+// Fichiers de la partie enregistrée, écrits à la fermeture de la fenêtre
+#define GAME_RECORD_FILE "partie.scg"
+#define GAME_GCG_FILE    "partie.gcg"
+
+// Tour d'un robot : la décision est calculée par un thread sur une copie de la partie, puis
+// jouée par l'interface à la réception de doneEvent
+typedef struct {
+    pthread_t thread;
+    bool running;                 // Un thread calcule la décision
+    GameState state;              // Copie de la partie au début du tour
+    const Lexicon *lexicon;
+    const LeaveTable *leaves;
+    MoveList moves;               // Liste de coups propre au thread
+    GameAction action;            // Décision du robot
+    Uint32 doneEvent;             // Événement SDL envoyé à la fin du calcul ((Uint32)-1 : aucun)
+} BotTurn;
+
+static void *botMain(void *arg) {
+    BotTurn *bot = arg;
+    traceSetThreadName("robot");
+    gameChooseAction(&bot->state, bot->lexicon, bot->leaves, &bot->moves, &bot->action);
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = bot->doneEvent;
+    SDL_PushEvent(&event);
+    return NULL;
+}
+
+// Lance le tour du robot au trait ; retourne false si la décision a été calculée sur place
+// (pas de thread), auquel cas elle est déjà dans bot->action
+static bool startBotTurn(BotTurn *bot, const GameState *game) {
+    bot->state = *game;
+    if (bot->doneEvent != (Uint32)-1 && pthread_create(&bot->thread, NULL, botMain, bot) == 0) {
+        bot->running = true;
+        return true;
+    }
+    gameChooseAction(&bot->state, bot->lexicon, bot->leaves, &bot->moves, &bot->action);
+    return false;
+}
+
+// Joueur dont le rack est affiché : le joueur au trait s'il est humain, sinon le dernier humain
+// à avoir joué (-1 si tous les joueurs sont des robots)
+static int shownPlayer(const GameState *game) {
+    for (int i = 0; i < game->playerCount; i++) {
+        int p = (game->current - i + game->playerCount) % game->playerCount;
+        if (!game->players[p].bot)
+            return p;
+    }
+    return -1;
+}
+
+/*
+ * Fonction : playTurn
+ * -------------------
+ * Joue le tour du joueur au trait (coup, échange ou passe) et l'annonce ; en fin de partie,
+ * affiche les scores finaux.
+ *
+ * Paramètres :
+ *   game          : la partie.
+ *   action        : la décision du joueur.
+ *   lastWordScore : points du dernier coup (sortie).
+ */
+static void playTurn(GameState *game, const GameAction *action, int *lastWordScore) {
+    const GamePlayer *player = &game->players[game->current];
+    if (gameApplyAction(game, action) != 0) {
+        fprintf(stderr, "Tour refusé pour %s\n", player->name);
+        return;
+    }
+    const Move *move = &action->move;
+    switch (action->type) {
+        case RECORD_PLAY:
+            *lastWordScore = move->score;
+            printf("[Partie] %s : %s (%c) en (%d, %d) -> %d points\n", player->name, move->word,
+                   move->dir, move->x, move->y, move->score);
+            break;
+        case RECORD_EXCHANGE:
+            *lastWordScore = 0;
+            printf("[Partie] %s échange %zu lettres\n", player->name, strlen(action->exchanged));
+            break;
+        default:
+            *lastWordScore = 0;
+            printf("[Partie] %s passe\n", player->name);
+            break;
+    }
+    if (game->over) {
+        printf("[Partie] Fin de la partie après %d tours :", game->turn);
+        for (int p = 0; p < game->playerCount; p++)
+            printf("%s %s %d", p > 0 ? "," : "", game->players[p].name, game->players[p].score);
+        printf("\n");
+    }
+}
+
+/*
+ * Fonction : findTypedMove
+ * ------------------------
+ * Cherche le coup correspondant au mot saisi parmi les coups légaux : ceux du tirage en
+ * duplicate, sinon ceux du rack du joueur au trait (un joker est utilisé si le rack n'a pas la
+ * lettre). Le générateur vérifie les mots croisés, le premier coup et calcule le score complet.
+ *
+ * Paramètres :
+ *   duplicate : la partie en duplicate, ou NULL.
+ *   game      : la partie classique (hors duplicate).
+ *   lexicon   : arbre lexical du dictionnaire.
+ *   board     : le plateau.
+ *   moves     : liste de coups réutilisée.
+ *   word      : le mot saisi (lettres du plateau comprises).
+ *   x, y      : la case de la première lettre.
+ *   dir       : 'h', 'v', ou '\0' pour une seule lettre (le sens du mot qu'elle forme).
+ *
+ * Retour :
+ *   Le coup (valable jusqu'à la prochaine génération), ou NULL s'il n'est pas légal.
+ */
+static const Move *findTypedMove(const DuplicateGame *duplicate, GameState *game, const Lexicon *lexicon,
+                                 char **board, MoveList *moves, const char *word, int x, int y, char dir) {
+    if (dir == '\0') {
+        const Move *move = findTypedMove(duplicate, game, lexicon, board, moves, word, x, y, 'h');
+        return move ? move : findTypedMove(duplicate, game, lexicon, board, moves, word, x, y, 'v');
+    }
+    if (duplicate)
+        return duplicateFindMove(duplicate, word, x, y, dir);
+    generateMoves(lexicon, board, game->boardSize, game->bonusBoard, game->players[game->current].rack,
+                  gameFirstMove(game), NULL, moves);
+    return findMove(moves, word, x, y, dir);
+}
+
+/*
+ * Fonction : finishDuplicateRound
+ * -------------------------------
+ * Termine le coup en duplicate : la proposition du joueur (NULL s'il n'en a pas) est comparée
+ * au top, le top est posé sur le plateau et le tirage suivant remplace le rack affiché.
+ *
+ * Paramètres :
+ *   game          : la partie en duplicate.
+ *   submission    : le coup proposé par le joueur, ou NULL.
+ *   rack          : le rack affiché (complété par des '\0').
+ *   lastWordScore : points de la proposition (sortie).
+ *   totalPoints   : total du joueur (sortie).
+ */
+static void finishDuplicateRound(DuplicateGame *game, const Move *submission, char rack[RULESET_MAX_RACK + 1],
+                                 int *lastWordScore, int *totalPoints) {
+    duplicateSubmit(game, 0, submission);
+    duplicateEndRound(game);
+    printDuplicateRound(game, game->roundCount - 1);
+    *lastWordScore = submission ? game->rounds[game->roundCount - 1].submissions[0].score : 0;
+    *totalPoints = game->scores[0];
+    memset(rack, '\0', RULESET_MAX_RACK + 1);
+    if (duplicateStartRound(game) == 0)
+        strcpy(rack, game->rack);
+    else
+        printf("[Duplicate] Fin de la partie : %d points pour un top de %d (%.1f %%)\n",
+               game->scores[0], game->topTotal,
+               game->topTotal > 0 ? 100.0 * game->scores[0] / game->topTotal : 0.0);
+}
+
+// Fonction principale du programme (--duplicate : partie en duplicate, --regles FICHIER :
+// règles chargées depuis un fichier au lieu des règles standard, --joueurs N : partie de 2 à 4
+// joueurs, --robots N : les N derniers joueurs sont joués par le moteur)
 int main(int argc, char* argv[]) {
-    (void)argc;   // Ignorer argc pour éviter les avertissements
-    (void)argv;   // Ignorer argv pour éviter les avertissements
+    bool duplicateMode = false;
+    int playerCount = 2, botCount = 1;
+    Ruleset *rules = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--duplicate") == 0) {
+            duplicateMode = true;
+        } else if (strcmp(argv[i], "--regles") == 0 && i + 1 < argc) {
+            freeRuleset(rules);
+            if (!(rules = loadRuleset(argv[++i])))
+                return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "--joueurs") == 0 && i + 1 < argc) {
+            playerCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--robots") == 0 && i + 1 < argc) {
+            botCount = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage : %s [--duplicate] [--regles fichier] [--joueurs 2-4] [--robots nombre]\n",
+                    argv[0]);
+            freeRuleset(rules);
+            return EXIT_FAILURE;
+        }
+    }
+    // Règles de la partie (plateau, bonus, lettres), en vigueur avant toute allocation
+    useRuleset(rules);
+    traceSetThreadName("ui");
     
-    // Initialisation de la graine pour les nombres aléatoires
-    srand(time(NULL));
+    // Partie : plateau, bonus, sac commun et racks des joueurs (en duplicate, seuls le plateau et
+    // les bonus servent, le tirage venant du sac de la partie en duplicate)
+    GameState game;
+    if (initGameState(&game, playerCount, botCount, (uint64_t)time(NULL)) != 0) {
+        freeRuleset(rules);
+        return EXIT_FAILURE;
+    }
+    // Taille du plateau des règles en vigueur (15x15 pour le Scrabble standard)
+    int boardSize = game.boardSize;
+    // Lignes du plateau de la partie, pour les fonctions qui attendent un char **
+    char *boardRows[BOARD_MAX_SIZE];
+    gameBoardRows(&game, boardRows);
+    char **board = boardRows;
+    // Cases bonus restantes de la partie : copie de la disposition des règles, consommée au fil des coups
+    int (*bonusBoard)[BOARD_MAX_SIZE] = game.bonusBoard;
     
     // Chargement du dictionnaire depuis le fichier "mots_filtres.txt"
     DictionaryEntry *dictionaryHash = loadDictionaryHash("mots_filtres.txt");
     if (!dictionaryHash) {
         fprintf(stderr, "Erreur lors du chargement du dictionnaire.\n");
+        useRuleset(NULL);
+        freeRuleset(rules);
         return EXIT_FAILURE;
     }
     
-    // Définition de la taille du plateau (15x15 pour le Scrabble standard)
-    int boardSize = 15;
-    // Allocation et initialisation du plateau (chaque case est initialisée avec un espace)
-    char **board = initBoard(boardSize);
-    if (!board)
+    // Arbre lexical utilisé par le générateur de coups (coups saisis, indice, robots, échanges)
+    Lexicon *lexicon = buildLexicon(dictionaryHash);
+    if (!lexicon) {
+        freeDictionaryHash(dictionaryHash);
+        useRuleset(NULL);
+        freeRuleset(rules);
         return EXIT_FAILURE;
+    }
+    MoveList moveList;
+    initMoveList(&moveList);
     
-    // Déclaration locale d'un tableau bonus (15x15) pour les multiplicateurs de points
-    // Ce tableau définit les bonus appliqués à certaines cases du plateau.
-    int bonusBoard[15][15] = {
-        {1, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 1},
-        {0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 2, 0},
-        {0, 0, 2, 0, 0, 0, 4, 0, 4, 0, 0, 0, 2, 0, 0},
-        {4, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 4},
-        {0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0},
-        {0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0},
-        {0, 0, 4, 0, 0, 0, 4, 0, 4, 0, 0, 0, 4, 0, 0},
-        {1, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0, 4, 0, 0, 1},
-        {0, 0, 4, 0, 0, 0, 4, 0, 4, 0, 0, 0, 4, 0, 0},
-        {0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0},
-        {0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0},
-        {4, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 4},
-        {0, 0, 2, 0, 0, 0, 4, 0, 4, 0, 0, 0, 2, 0, 0},
-        {0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 2, 0},
-        {1, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 1}
-    };
-    
-    // Initialisation du score total du joueur
-    int totalPoints = 0;
+    // Chargement (facultatif) de la table des valeurs de reliquat utilisée par l'indice et les robots
+    LeaveTable *leaveTable = loadLeaveTable("leaves.bin");
+    if (!leaveTable)
+        fprintf(stderr, "Indice : pas de table de reliquats, classement au score seul.\n");
     
     // Initialisation des ressources SDL, TTF, fenêtre, renderer, et polices via utils
     Resources res;
     if (initResources(&res) != 0) {
-        freeBoard(board, boardSize);
+        freeLeaveTable(leaveTable);
+        freeLexicon(lexicon);
+        freeDictionaryHash(dictionaryHash);
+        useRuleset(NULL);
+        freeRuleset(rules);
         return EXIT_FAILURE;
     }
     
-    // Initialisation du rack du joueur (chevalet) avec 7 lettres aléatoires
-    char rack[8];
-    for (int i = 0; i < 7; i++)
-        rack[i] = drawRandomLetter();
-    rack[7] = '\0';  // Terminaison de la chaîne
+    // Robots : un thread par tour, qui signale la fin de son calcul par un événement SDL
+    BotTurn bot;
+    memset(&bot, 0, sizeof(bot));
+    bot.lexicon = lexicon;
+    bot.leaves = leaveTable;
+    bot.doneEvent = SDL_RegisterEvents(1);
+    initMoveList(&bot.moves);
+    
+    // Mode duplicate : tirage commun depuis le sac, top calculé à chaque coup et posé sur le plateau
+    int rackSize = currentRules->rackSize;
+    char duplicateRack[RULESET_MAX_RACK + 1] = "";
+    int totalPoints = 0;   // Total du joueur en duplicate
+    DuplicateGame duplicate;
+    if (duplicateMode) {
+        initDuplicateGame(&duplicate, lexicon, board, bonusBoard, 1, (uint64_t)time(NULL));
+        if (duplicateStartRound(&duplicate) == 0)
+            strcpy(duplicateRack, duplicate.rack);
+    }
     
     // Déclaration des variables de gestion de la saisie utilisateur
     InputState currentState = STATE_IDLE;   // État initial (aucune saisie en cours)
@@ -79,32 +286,92 @@ int main(int argc, char* argv[]) {
     
     // Configuration de la zone du rack et du bouton "Echanger"
     int rackAreaWidth = 300; // Largeur de la zone dédiée au chevalet
-    // Création d'une surface pour le texte "Echanger"
-    SDL_Surface *btnSurface = TTF_RenderUTF8_Blended(res.inputFont, "Echanger", TEXT_COLOR);
+    // Mesure du texte "Echanger" à partir de l'atlas de glyphes
     int btnW, btnH;
-    // Création d'une texture temporaire pour obtenir la taille du texte
-    SDL_Texture *tempTex = SDL_CreateTextureFromSurface(res.renderer, btnSurface);
-    SDL_QueryTexture(tempTex, NULL, NULL, &btnW, &btnH);
-    SDL_DestroyTexture(tempTex);
-    SDL_FreeSurface(btnSurface);
+    measureText(&res.atlas, FONT_INPUT, "Echanger", &btnW, &btnH);
     int buttonWidth = btnW + 10;   // Largeur du bouton "Echanger" avec une marge
     int buttonHeight = btnH + 4;     // Hauteur du bouton "Echanger" avec une marge
     int buttonMargin = 10;           // Espace entre le rack et le bouton
     int totalRackWidth = rackAreaWidth + buttonMargin + buttonWidth; // Largeur totale de la zone du rack et du bouton
     int startXRack = (WINDOW_WIDTH - totalRackWidth) / 2;  // Position X de départ du rack dans la fenêtre
     
-    // Boucle principale du programme
+    // Cache de rendu : image de la fenêtre et géométrie du plateau
+    RenderCache renderCache;
+    if (createRenderCache(res.renderer, &res.atlas, &renderCache, boardSize, boardDrawWidth,
+                          boardDrawHeight, gridThickness) != 0) {
+        freeLeaveTable(leaveTable);
+        freeMoveList(&moveList);
+        freeMoveList(&bot.moves);
+        freeLexicon(lexicon);
+        if (duplicateMode)
+            freeDuplicateGame(&duplicate);
+        cleanup(&res, dictionaryHash);
+        useRuleset(NULL);
+        freeRuleset(rules);
+        return EXIT_FAILURE;
+    }
+    
+    // Boucle principale du programme : elle dort dans SDL_WaitEventTimeout tant que rien ne
+    // se passe, et ne recompose que les zones marquées comme modifiées.
     bool quit = false;
+    unsigned dirty = DIRTY_ALL;   // Zones de l'image à recomposer
+    bool present = true;          // L'image doit être (ré)affichée à l'écran
+    bool showStats = false;       // Panneau des compteurs du dernier indice (F3)
+    char statsText[512] = "aucun indice";
     SDL_Event e;
     while (!quit) {
-        // Traitement des événements SDL
-        while (SDL_PollEvent(&e)) {
+        // Tour d'un robot : lancé dès que la main lui revient, joué à la fin de son calcul
+        if (!duplicateMode && !game.over && game.players[game.current].bot && !bot.running) {
+            if (!startBotTurn(&bot, &game))
+                playTurn(&game, &bot.action, &lastWordScore);
+            dirty = DIRTY_ALL;
+        }
+        // Traitement des événements SDL : attente du premier, puis ceux déjà en file
+        for (bool haveEvent = SDL_WaitEventTimeout(&e, EVENT_WAIT_MS) != 0; haveEvent;
+             haveEvent = SDL_PollEvent(&e) != 0) {
+            TRACE_BEGIN("event");
+            int submitDir = -1;   // Sens du mot saisi à jouer ('\0' : une seule lettre), -1 : aucun
             // Si l'utilisateur ferme la fenêtre
             if (e.type == SDL_QUIT)
                 quit = true;
+            // Fin du calcul d'un robot : sa décision est jouée sur la partie
+            if (e.type == bot.doneEvent && bot.running) {
+                pthread_join(bot.thread, NULL);
+                bot.running = false;
+                playTurn(&game, &bot.action, &lastWordScore);
+                dirty = DIRTY_ALL;
+            }
+            // Le contenu des textures cibles a été perdu (changement de pilote, redimensionnement...)
+            if (e.type == SDL_RENDER_TARGETS_RESET) {
+                invalidateRenderCache(&renderCache);
+                dirty = DIRTY_ALL;
+            }
+            // La fenêtre a été découverte : l'image composée est simplement réaffichée
+            if (e.type == SDL_WINDOWEVENT && (e.window.event == SDL_WINDOWEVENT_EXPOSED ||
+                                              e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED))
+                present = true;
+            // F3 : affiche ou masque les compteurs du moteur (compilé avec SCRABBLE_STATS)
+            if (STATS_ENABLED && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3) {
+                showStats = !showStats;
+                present = true;
+            }
+            // F4 : écrit la trace chronologique sans quitter (compilé avec SCRABBLE_TRACE)
+            if (TRACE_ENABLED && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F4) {
+                int count = traceWrite(NULL);
+                if (count >= 0)
+                    printf("[Trace] %d événements écrits\n", count);
+            }
             
-            // Gestion de l'état STATE_IDLE (aucune saisie en cours)
-            if (currentState == STATE_IDLE) {
+            // Gestion de l'état STATE_IDLE (aucune saisie en cours), pendant le tour d'un humain
+            bool humanTurn = duplicateMode || (!game.over && !game.players[game.current].bot);
+            if (currentState == STATE_IDLE && humanTurn) {
+                char *rack = duplicateMode ? duplicateRack : game.players[game.current].rack;
+                // P : le joueur au trait passe son tour (pas de passe en duplicate)
+                if (!duplicateMode && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_p) {
+                    GameAction action = { .type = RECORD_PASS };
+                    playTurn(&game, &action, &lastWordScore);
+                    dirty = DIRTY_ALL;
+                }
                 if (e.type == SDL_MOUSEBUTTONDOWN) {
                     int mouseX = e.button.x;
                     int mouseY = e.button.y;
@@ -117,18 +384,48 @@ int main(int argc, char* argv[]) {
                         inputBuffer[0] = '\0'; // Réinitialisation du buffer de saisie
                         inputLength = 0;
                         SDL_StartTextInput(); // Démarrage de la saisie de texte
+                        // Surbrillance de la case de départ pendant la saisie
+                        setCellOverlay(&renderCache, selectedCellX, selectedCellY, SELECTION_COLOR);
+                        dirty |= DIRTY_INPUT | DIRTY_BOARD;
                     }
                     // Sinon, si le clic se situe dans la zone du rack
                     else if (mouseY >= BOARD_HEIGHT && mouseY < (BOARD_HEIGHT + SCRABBLE_RACK_HEIGHT)) {
                         int buttonX = startXRack + rackAreaWidth + buttonMargin; // Coordonnée X du bouton "Echanger"
                         int buttonY = BOARD_HEIGHT + (SCRABBLE_RACK_HEIGHT - buttonHeight) / 2; // Coordonnée Y du bouton
-                        // Si le clic se fait sur le bouton "Echanger"
-                        if (mouseX >= buttonX && mouseX < buttonX + buttonWidth &&
+                        // Si le clic se fait sur le bouton "Echanger" (pas d'échange en duplicate)
+                        if (!duplicateMode && mouseX >= buttonX && mouseX < buttonX + buttonWidth &&
                             mouseY >= buttonY && mouseY < buttonY + buttonHeight) {
-                            // Rafraîchit le rack en attribuant 7 nouvelles lettres
-                            for (int i = 0; i < 7; i++)
-                                rack[i] = drawRandomLetter();
-                            rack[7] = '\0'; // Terminaison de la chaîne
+                            if (game.bag.total < rackSize) {
+                                printf("[Echange] Impossible : moins de %d lettres dans le sac\n", rackSize);
+                            } else {
+                                // Compare toutes les façons d'échanger au meilleur coup jouable
+                                int unseen[LEAVE_ALPHABET];
+                                int unseenTotal = countUnseenTiles(board, boardSize, rack, unseen);
+                                float rackLeaves[LEAVE_RACK_SUBSETS];
+                                leavePrepareRack(leaveTable, rack, rackLeaves);
+                                generateMoves(lexicon, board, boardSize, bonusBoard, rack, gameFirstMove(&game),
+                                              rackLeaves, &moveList);
+                                int best = bestMoveIndex(&moveList);
+                                ExchangeAnalysis analysis;
+                                if (analyzeExchanges(leaveTable, rack, unseen, unseenTotal,
+                                                     best >= 0 ? moveList.moves[best].equity : 0.0f, best >= 0,
+                                                     (uint64_t)time(NULL), &analysis) != 0 ||
+                                    analysis.best < 0) {
+                                    printf("[Echange] Rack %s invalide : échange impossible\n", rack);
+                                } else {
+                                    printExchangeAnalysis(&analysis, rack);
+                                    // Remet dans le sac les lettres que la meilleure option n'a pas conservées
+                                    int keepMask = analysis.options[analysis.best].keepMask;
+                                    GameAction action = { .type = RECORD_EXCHANGE };
+                                    int exchangedCount = 0;
+                                    for (int i = 0; rack[i] != '\0'; i++)
+                                        if (!(keepMask & (1 << i)))
+                                            action.exchanged[exchangedCount++] = rack[i];
+                                    if (exchangedCount > 0)
+                                        playTurn(&game, &action, &lastWordScore);
+                                    dirty = DIRTY_ALL;
+                                }
+                            }
                         }
                         // Gestion du clic sur le bouton "Indice" (bouton "Meilleur Coup")
                         int bestMoveButtonX = buttonX + buttonWidth + 10; // Position X du bouton "Indice"
@@ -137,9 +434,33 @@ int main(int argc, char* argv[]) {
                         int bestMoveButtonHeight = buttonHeight;          // Hauteur du bouton "Indice"
                         // Si le clic se fait sur le bouton "Indice"
                         if (mouseX >= bestMoveButtonX && mouseX < bestMoveButtonX + bestMoveButtonWidth &&
-                            mouseY >= bestMoveButtonY && mouseY < bestMoveButtonY + bestMoveButtonHeight) {
-                            // Appel de la fonction qui trouve et place le meilleur coup
-                            findBestMove(board, boardSize, dictionaryHash, rack, &totalPoints, bonusBoard);
+                            mouseY >= bestMoveButtonY && mouseY < bestMoveButtonY + bestMoveButtonHeight &&
+                            duplicateMode) {
+                            // En duplicate, l'indice révèle le top : le joueur ne marque rien à ce coup
+                            finishDuplicateRound(&duplicate, NULL, duplicateRack, &lastWordScore, &totalPoints);
+                            dirty = DIRTY_ALL;
+                        } else if (mouseX >= bestMoveButtonX && mouseX < bestMoveButtonX + bestMoveButtonWidth &&
+                                   mouseY >= bestMoveButtonY && mouseY < bestMoveButtonY + bestMoveButtonHeight) {
+                            // Trouve et joue le meilleur coup du joueur au trait (décision du moteur)
+                            EngineStats statsBefore, statsAfter, hintStats;
+                            statsSnapshot(&statsBefore);
+                            GameAction action;
+                            gameChooseAction(&game, lexicon, leaveTable, &moveList, &action);
+                            if (action.type == RECORD_PLAY) {
+                                printf("[Indice] Meilleur coup : %s (%c) en (%d, %d) -> %d points (reliquat %+.1f)\n",
+                                       action.move.word, action.move.dir, action.move.x, action.move.y,
+                                       action.move.score, action.move.equity - action.move.score);
+                                playTurn(&game, &action, &lastWordScore);
+                            } else {
+                                printf("[Indice] Aucun coup trouvé...\n");
+                            }
+                            statsSnapshot(&statsAfter);
+                            if (STATS_ENABLED) {
+                                statsDelta(&statsBefore, &statsAfter, &hintStats);
+                                statsFormat(&hintStats, false, statsText, sizeof(statsText));
+                                printf("[Stats] %s\n", statsText);
+                            }
+                            dirty = DIRTY_ALL;
                         }
                     }
                 }
@@ -154,51 +475,24 @@ int main(int argc, char* argv[]) {
                         // Conversion de toutes les lettres saisies en majuscules
                         for (size_t i = 0; i < strlen(inputBuffer); i++)
                             inputBuffer[i] = toupper(inputBuffer[i]);
+                        dirty |= DIRTY_INPUT;
                     }
                 } else if (e.type == SDL_KEYDOWN) {
                     // Gestion de la touche BACKSPACE
                     if (e.key.keysym.sym == SDLK_BACKSPACE && inputLength > 0) {
                         inputBuffer[inputLength - 1] = '\0';
                         inputLength--;
+                        dirty |= DIRTY_INPUT;
                     }
                     // Si l'utilisateur valide la saisie avec la touche RETURN
                     else if (e.key.keysym.sym == SDLK_RETURN) {
                         SDL_StopTextInput(); // Arrêt de la saisie de texte
+                        dirty = DIRTY_ALL;   // Changement d'état et, peut-être, lettres posées
                         if (inputLength == 0) {
                             currentState = STATE_IDLE;
-                        } else if (!isValidWordHash(inputBuffer, dictionaryHash)) {
-                            // Message d'erreur si le mot n'est pas présent dans le dictionnaire
-                            fprintf(stderr, "Mot invalide: %s\n", inputBuffer);
-                            inputBuffer[0] = '\0';
-                            inputLength = 0;
-                            currentState = STATE_IDLE;
                         } else if (inputLength == 1) {
-                            // Si le mot saisi est d'une seule lettre, on suppose l'orientation horizontale
-                            if (canPlaceWord(inputBuffer, selectedCellX, selectedCellY, 'h', board, boardSize, rack, totalPoints)) {
-                                int letterMultiplier = 1, wordMultiplier = 1;
-                                if (board[selectedCellY][selectedCellX] == ' ') {
-                                    int bonus = bonusBoard[selectedCellY][selectedCellX];
-                                    // Application des bonus sur la case sélectionnée
-                                    switch(bonus) {
-                                        case 1: wordMultiplier *= 3; break;
-                                        case 2: wordMultiplier *= 2; break;
-                                        case 3: letterMultiplier = 3; break;
-                                        case 4: letterMultiplier = 2; break;
-                                        default: break;
-                                    }
-                                }
-                                int score = getLetterScore(inputBuffer[0]) * letterMultiplier;
-                                score *= wordMultiplier;
-                                if (validatePlacement(inputBuffer, selectedCellX, selectedCellY, 'h', board, boardSize, dictionaryHash)) {
-                                    lastWordScore = score;
-                                    placeWord(inputBuffer, selectedCellX, selectedCellY, 'h', board, rack);
-                                    bonusBoard[selectedCellY][selectedCellX] = 0;
-                                    totalPoints = recalcTotalScore(board, boardSize);
-                                } else {
-                                    fprintf(stderr, "Placement invalide: un mot croisé n'existe pas\n");
-                                }
-                            }
-                            currentState = STATE_IDLE;
+                            // Une seule lettre : le sens est celui du mot qu'elle forme
+                            submitDir = '\0';
                         } else {
                             // Pour un mot de plusieurs lettres, passage à la sélection de l'orientation
                             currentState = STATE_INPUT_DIRECTION;
@@ -206,6 +500,7 @@ int main(int argc, char* argv[]) {
                     } else if (e.key.keysym.sym == SDLK_ESCAPE) {
                         SDL_StopTextInput();
                         currentState = STATE_IDLE;
+                        dirty |= DIRTY_INPUT | DIRTY_BOARD;
                     }
                 }
             }
@@ -214,212 +509,153 @@ int main(int argc, char* argv[]) {
                 if (e.type == SDL_KEYDOWN) {
                     char dir = tolower((char)e.key.keysym.sym);
                     if (dir == 'h' || dir == 'v') {
-                        if (canPlaceWord(inputBuffer, selectedCellX, selectedCellY, dir, board, boardSize, rack, totalPoints)) {
-                            if (!validatePlacement(inputBuffer, selectedCellX, selectedCellY, dir, board, boardSize, dictionaryHash)) {
-                                fprintf(stderr, "Placement invalide: un mot croisé n'existe pas\n");
-                                currentState = STATE_IDLE;
-                            } else {
-                                int score = 0;
-                                int wordMultiplier = 1;
-                                int len = strlen(inputBuffer);
-                                int tilesUsed = 0;
-                                // Calcul du score du mot principal, en tenant compte des bonus sur les cases vides
-                                for (int i = 0; i < len; i++) {
-                                    int x = selectedCellX, y = selectedCellY;
-                                    if (dir == 'h')
-                                        x += i;
-                                    else
-                                        y += i;
-                                    int letterMultiplier = 1;
-                                    if (board[y][x] == ' ') {
-                                        tilesUsed++;
-                                        int bonus = bonusBoard[y][x];
-                                        switch(bonus) {
-                                            case 1: wordMultiplier *= 3; break;
-                                            case 2: wordMultiplier *= 2; break;
-                                            case 3: letterMultiplier = 3; break;
-                                            case 4: letterMultiplier = 2; break;
-                                            default: break;
-                                        }
-                                    }
-                                    score += getLetterScore(toupper(inputBuffer[i])) * letterMultiplier;
-                                }
-                                score *= wordMultiplier;
-                                if (tilesUsed == 7)
-                                    score += 50;
-                                // Calcul du score des mots perpendiculaires formés par les lettres nouvellement posées
-                                int perpendicularScore = 0;
-                                for (int i = 0; i < len; i++) {
-                                    int x = selectedCellX, y = selectedCellY;
-                                    if (dir == 'h')
-                                        x += i;
-                                    else
-                                        y += i;
-                                    if (board[y][x] == ' ') {
-                                        int perpWordMultiplier = 1;
-                                        int perpScore = 0;
-                                        if (dir == 'h') {
-                                            int startRow = y;
-                                            while (startRow > 0 && board[startRow - 1][x] != ' ')
-                                                startRow--;
-                                            int endRow = y;
-                                            while (endRow < boardSize - 1 && board[endRow + 1][x] != ' ')
-                                                endRow++;
-                                            if (endRow - startRow + 1 > 1) {
-                                                for (int r = startRow; r <= endRow; r++) {
-                                                    if (r == y) {
-                                                        int letterMult = 1;
-                                                        int bonus = bonusBoard[y][x];
-                                                        if (bonus == 3)
-                                                            letterMult = 3;
-                                                        else if (bonus == 4)
-                                                            letterMult = 2;
-                                                        if (bonus == 1)
-                                                            perpWordMultiplier *= 3;
-                                                        else if (bonus == 2)
-                                                            perpWordMultiplier *= 2;
-                                                        perpScore += getLetterScore(toupper(inputBuffer[i])) * letterMult;
-                                                    } else {
-                                                        perpScore += getLetterScore(toupper(board[r][x]));
-                                                    }
-                                                }
-                                                perpendicularScore += perpScore * perpWordMultiplier;
-                                            }
-                                        } else {
-                                            int startCol = x;
-                                            while (startCol > 0 && board[y][startCol - 1] != ' ')
-                                                startCol--;
-                                            int endCol = x;
-                                            while (endCol < boardSize - 1 && board[y][endCol + 1] != ' ')
-                                                endCol++;
-                                            if (endCol - startCol + 1 > 1) {
-                                                int perpWordMultiplier = 1;
-                                                int perpScore = 0;
-                                                for (int c = startCol; c <= endCol; c++) {
-                                                    if (c == x) {
-                                                        int letterMult = 1;
-                                                        int bonus = bonusBoard[y][x];
-                                                        if (bonus == 3)
-                                                            letterMult = 3;
-                                                        else if (bonus == 4)
-                                                            letterMult = 2;
-                                                        if (bonus == 1)
-                                                            perpWordMultiplier *= 3;
-                                                        else if (bonus == 2)
-                                                            perpWordMultiplier *= 2;
-                                                        perpScore += getLetterScore(toupper(inputBuffer[i])) * letterMult;
-                                                    } else {
-                                                        perpScore += getLetterScore(toupper(board[y][c]));
-                                                    }
-                                                }
-                                                perpendicularScore += perpScore * perpWordMultiplier;
-                                            }
-                                        }
-                                    }
-                                }
-                                score += perpendicularScore;
-                                lastWordScore = score;
-                                totalPoints += score;
-                                placeWord(inputBuffer, selectedCellX, selectedCellY, dir, board, rack);
-                                // Réinitialisation des bonus sur les cases utilisées
-                                for (int i = 0; i < len; i++) {
-                                    int x = selectedCellX, y = selectedCellY;
-                                    if (dir == 'h')
-                                        x += i;
-                                    else
-                                        y += i;
-                                    bonusBoard[y][x] = 0;
-                                }
-                            }
-                        }
-                        currentState = STATE_IDLE;
+                        submitDir = dir;
+                        dirty = DIRTY_ALL;
                     } else if (e.key.keysym.sym == SDLK_ESCAPE) {
                         currentState = STATE_IDLE;
+                        dirty |= DIRTY_INPUT | DIRTY_BOARD;
                     }
                 }
             }
+            // Mot saisi et orienté : il doit figurer parmi les coups légaux du joueur (le
+            // générateur vérifie les mots croisés, le premier coup et calcule le score)
+            if (submitDir >= 0) {
+                const Move *move = findTypedMove(duplicateMode ? &duplicate : NULL, &game, lexicon, board,
+                                                 &moveList, inputBuffer, selectedCellX, selectedCellY,
+                                                 (char)submitDir);
+                if (!move) {
+                    fprintf(stderr, "%s invalide: %s\n",
+                            isValidWordHash(inputBuffer, dictionaryHash) ? "Coup" : "Mot", inputBuffer);
+                } else if (duplicateMode) {
+                    finishDuplicateRound(&duplicate, move, duplicateRack, &lastWordScore, &totalPoints);
+                } else {
+                    GameAction action = { .type = RECORD_PLAY, .move = *move };
+                    playTurn(&game, &action, &lastWordScore);
+                }
+                inputBuffer[0] = '\0';
+                inputLength = 0;
+                currentState = STATE_IDLE;
+            }
+            TRACE_END("event");
         }
         
-        // Appel des fonctions de rendu graphique
-        drawGrid(res.renderer, boardSize, boardDrawWidth, boardDrawHeight);
-        drawBoard(res.renderer, res.boardFont, res.valueFont, board, boardSize, boardDrawWidth, boardDrawHeight, gridThickness);
-        drawRack(res.renderer, res.rackFont, res.valueFont, rack, rackAreaWidth, startXRack, buttonMargin, buttonWidth, buttonHeight, res.inputFont);
-        drawInputArea(res.renderer, res.inputFont, currentState, inputBuffer, totalPoints);
-        
-        // Affichage du score du dernier mot dans le coin supérieur droit
-        {
-            char scoreText[50];
-            snprintf(scoreText, sizeof(scoreText), "Points: %d", lastWordScore);
-            SDL_Surface *scoreSurface = TTF_RenderUTF8_Blended(res.boardFont, scoreText, TEXT_COLOR);
-            if (scoreSurface) {
-                SDL_Texture *scoreTexture = SDL_CreateTextureFromSurface(res.renderer, scoreSurface);
+        // Hors saisie, aucune case n'est en surbrillance (sans effet si aucune ne l'était)
+        if (currentState == STATE_IDLE)
+            clearCellOverlays(&renderCache);
+        // Recomposition des seules zones modifiées dans l'image persistante du cache
+        if (dirty) {
+            TRACE_BEGIN("compose");
+            SDL_SetRenderTarget(res.renderer, renderCache.frame);
+            if (dirty & DIRTY_BOARD) {
+                SDL_Rect area = { 0, 0, WINDOW_WIDTH, BOARD_HEIGHT };
+                SDL_RenderSetClipRect(res.renderer, &area);
+                SDL_SetRenderDrawColor(res.renderer, BACKGROUND_COLOR.r, BACKGROUND_COLOR.g, BACKGROUND_COLOR.b, BACKGROUND_COLOR.a);
+                SDL_RenderFillRect(res.renderer, &area);
+                drawBoard(res.renderer, &renderCache, board, bonusBoard);
+                
+                // Affichage du score du dernier mot dans le coin supérieur droit (en duplicate :
+                // la proposition du joueur et le top du coup précédent)
+                char scoreText[160];
                 int textW, textH;
-                SDL_QueryTexture(scoreTexture, NULL, NULL, &textW, &textH);
-                int posX = WINDOW_WIDTH - textW - 10;
-                int posY = 10;
-                SDL_Rect scoreRect = { posX, posY, textW, textH };
-                SDL_RenderCopy(res.renderer, scoreTexture, NULL, &scoreRect);
-                SDL_DestroyTexture(scoreTexture);
-                SDL_FreeSurface(scoreSurface);
+                if (duplicateMode && duplicate.roundCount > 0) {
+                    const DuplicateRound *last = &duplicate.rounds[duplicate.roundCount - 1];
+                    snprintf(scoreText, sizeof(scoreText), "Coup %d: %d / top %s %d", duplicate.roundCount,
+                             lastWordScore, last->top.word, last->top.score);
+                } else {
+                    snprintf(scoreText, sizeof(scoreText), "Points: %d", lastWordScore);
+                }
+                measureText(&res.atlas, FONT_BOARD, scoreText, &textW, &textH);
+                drawText(res.renderer, &res.atlas, FONT_BOARD, scoreText, WINDOW_WIDTH - textW - 10, 10);
+                // Affichage des scores dans le coin supérieur gauche : somme des tops en duplicate,
+                // sinon le score de chaque joueur, le joueur au trait marqué d'une flèche
+                if (duplicateMode) {
+                    snprintf(scoreText, sizeof(scoreText), "Total: %d / top %d", totalPoints, duplicate.topTotal);
+                } else {
+                    int len = 0;
+                    scoreText[0] = '\0';
+                    for (int p = 0; p < game.playerCount && len < (int)sizeof(scoreText); p++)
+                        len += snprintf(scoreText + len, sizeof(scoreText) - len, "%s%s%s: %d",
+                                        p > 0 ? "  " : "", (!game.over && p == game.current) ? "> " : "",
+                                        game.players[p].name, game.players[p].score);
+                }
+                drawText(res.renderer, &res.atlas, FONT_BOARD, scoreText, 10, 10);
             }
-        }
-        // Affichage du score total dans le coin supérieur gauche
-        {
-            char totalText[50];
-            snprintf(totalText, sizeof(totalText), "Total: %d", totalPoints);
-            SDL_Surface *totalSurface = TTF_RenderUTF8_Blended(res.boardFont, totalText, TEXT_COLOR);
-            if (totalSurface) {
-                SDL_Texture *totalTexture = SDL_CreateTextureFromSurface(res.renderer, totalSurface);
-                int totalW, totalH;
-                SDL_QueryTexture(totalTexture, NULL, NULL, &totalW, &totalH);
-                SDL_Rect totalRect = { 10, 10, totalW, totalH };
-                SDL_RenderCopy(res.renderer, totalTexture, NULL, &totalRect);
-                SDL_DestroyTexture(totalTexture);
-                SDL_FreeSurface(totalSurface);
+            if (dirty & DIRTY_RACK) {
+                SDL_Rect area = { 0, BOARD_HEIGHT, WINDOW_WIDTH, SCRABBLE_RACK_HEIGHT };
+                SDL_RenderSetClipRect(res.renderer, &area);
+                SDL_SetRenderDrawColor(res.renderer, BACKGROUND_COLOR.r, BACKGROUND_COLOR.g, BACKGROUND_COLOR.b, BACKGROUND_COLOR.a);
+                SDL_RenderFillRect(res.renderer, &area);
+                // Rack affiché : le tirage en duplicate, sinon celui du joueur humain (jamais celui d'un robot)
+                int shown = shownPlayer(&game);
+                const char *rack = duplicateMode ? duplicateRack : (shown >= 0 ? game.players[shown].rack : "");
+                drawRack(res.renderer, &renderCache, rack, rackAreaWidth, startXRack, buttonMargin, buttonWidth, buttonHeight);
+            }
+            if (dirty & DIRTY_INPUT) {
+                // Invite affichée hors saisie, selon le joueur au trait
+                char prompt[128];
+                const char *name = game.players[game.current].name;
+                if (duplicateMode)
+                    snprintf(prompt, sizeof(prompt), "%s", isBoardEmpty(board, boardSize) ?
+                             "Cliquez pour choisir une case (1er mot doit passer par le milieu)" :
+                             "Cliquez pour choisir une case");
+                else if (game.over)
+                    snprintf(prompt, sizeof(prompt), "Partie terminée");
+                else if (game.players[game.current].bot)
+                    snprintf(prompt, sizeof(prompt), "%s réfléchit...", name);
+                else if (gameFirstMove(&game))
+                    snprintf(prompt, sizeof(prompt), "%s : cliquez pour choisir une case (1er mot doit passer par le milieu)", name);
+                else
+                    snprintf(prompt, sizeof(prompt), "%s : cliquez pour choisir une case, P pour passer", name);
+                drawInputArea(res.renderer, &res.atlas, currentState, inputBuffer, prompt);
             }
+            SDL_RenderSetClipRect(res.renderer, NULL);
+            SDL_SetRenderTarget(res.renderer, NULL);
+            dirty = 0;
+            present = true;
+            TRACE_END("compose");
         }
-        // Redessin des lettres et de leurs valeurs sur le plateau
-        for (int y = 0; y < boardSize; y++) {
-            for (int x = 0; x < boardSize; x++) {
-                char letter = board[y][x];
-                if (letter != ' ') {
-                    char text[2] = { letter, '\0' };
-                    SDL_Surface *textSurface = TTF_RenderUTF8_Blended(res.boardFont, text, TEXT_COLOR);
-                    if (textSurface) {
-                        SDL_Texture *textTexture = SDL_CreateTextureFromSurface(res.renderer, textSurface);
-                        int textW, textH;
-                        SDL_QueryTexture(textTexture, NULL, NULL, &textW, &textH);
-                        int posX = BOARD_MARGIN + (int)(x * cellWidth + (cellWidth - textW) / 2);
-                        int posY = BOARD_MARGIN + (int)(y * cellHeight + (cellHeight - textH) / 2);
-                        SDL_Rect dstRect = { posX, posY, textW, textH };
-                        SDL_RenderCopy(res.renderer, textTexture, NULL, &dstRect);
-                        SDL_DestroyTexture(textTexture);
-                        SDL_FreeSurface(textSurface);
-                    }
-                    // Affichage de la valeur de la lettre sur la case
-                    char valueText[4];
-                    sprintf(valueText, "%d", getLetterScore(letter));
-                    SDL_Surface *valueSurface = TTF_RenderUTF8_Blended(res.valueFont, valueText, TEXT_COLOR);
-                    if (valueSurface) {
-                        SDL_Texture *valueTexture = SDL_CreateTextureFromSurface(res.renderer, valueSurface);
-                        int valueW, valueH;
-                        SDL_QueryTexture(valueTexture, NULL, NULL, &valueW, &valueH);
-                        int valuePosX = BOARD_MARGIN + (int)(x * cellWidth) + (int)cellWidth - valueW - 2;
-                        int valuePosY = BOARD_MARGIN + (int)(y * cellHeight) + (int)cellHeight - valueH - 2;
-                        SDL_Rect valueRect = { valuePosX, valuePosY, valueW, valueH };
-                        SDL_RenderCopy(res.renderer, valueTexture, NULL, &valueRect);
-                        SDL_DestroyTexture(valueTexture);
-                        SDL_FreeSurface(valueSurface);
-                    }
-                }
+        // Mise à jour de l'affichage à l'écran (synchronisée sur le rafraîchissement vertical)
+        if (present) {
+            TRACE_BEGIN("present");
+            SDL_RenderCopy(res.renderer, renderCache.frame, NULL, NULL);
+            if (showStats)
+                drawDebugOverlay(res.renderer, &renderCache, statsText);
+            SDL_RenderPresent(res.renderer);
+            present = false;
+            TRACE_END("present");
+        }
+    }
+    // Attente d'un robot encore en calcul (sa décision est abandonnée)
+    if (bot.running)
+        pthread_join(bot.thread, NULL);
+    
+    // Écriture de la partie jouée (binaire avec index, et texte GCG) : l'historique de la partie,
+    // ou en duplicate la suite des tops posés sur le plateau
+    GameRecord gameRecord;
+    int status = duplicateMode ? duplicateRecordGame(&duplicate, &gameRecord) : gameStateRecord(&game, &gameRecord);
+    if (status == 0) {
+        if (gameRecord.count > 0 && saveGameRecord(&gameRecord, GAME_RECORD_FILE) == 0) {
+            FILE *gcg = fopen(GAME_GCG_FILE, "w");
+            if (gcg) {
+                exportGCG(&gameRecord, gcg);
+                fclose(gcg);
             }
+            printf("Partie enregistrée : %d coups dans %s et %s\n", gameRecord.count,
+                   GAME_RECORD_FILE, GAME_GCG_FILE);
         }
-        // Mise à jour de l'affichage à l'écran
-        SDL_RenderPresent(res.renderer);
-        SDL_Delay(64); // Pause pour limiter la fréquence de rafraîchissement
+        freeGameRecord(&gameRecord);
     }
+    if (duplicateMode)
+        freeDuplicateGame(&duplicate);
     
     // Libération de toutes les ressources et nettoyage
-    cleanup(&res, dictionaryHash, board, boardSize);
+    freeRenderCache(&renderCache);
+    freeLeaveTable(leaveTable);
+    freeMoveList(&bot.moves);
+    freeMoveList(&moveList);
+    freeLexicon(lexicon);
+    cleanup(&res, dictionaryHash);
+    useRuleset(NULL);
+    freeRuleset(rules);
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,295 @@
+#include "movegen.h"
+#include "board.h"
+#include "stats.h"
+#include "trace.h"
+
+//
+// ---------------------- Génération de coups par ancres ----------------------
+//
+
+// Indice du joker dans les décomptes du rack (après les 26 lettres)
+#define BLANK 26
+
+// Contexte de génération pour une ligne (ou colonne) du plateau
+typedef struct {
+    const Lexicon *lexicon;
+    int size;
+    char dir;                           // 'h' : la ligne est une rangée, 'v' : une colonne
+    int fixed;                          // Indice de la rangée (h) ou de la colonne (v)
+    // Plateau copié par rangées [0] et par colonnes [1] : chaque ligne est contiguë
+    char grid[2][BOARD_MAX_SIZE][BOARD_MAX_SIZE];
+    const char *line;                   // Lettres de la ligne (' ' : case vide, minuscule : joker)
+    uint32_t crossMask[BOARD_MAX_SIZE]; // Lettres autorisées par le mot croisé de chaque case
+    int crossSum[BOARD_MAX_SIZE];       // Valeur des lettres du mot croisé (-1 : pas de mot croisé)
+    int letterMult[BOARD_MAX_SIZE];     // Multiplicateur de lettre de chaque case vide
+    int wordMult[BOARD_MAX_SIZE];       // Multiplicateur de mot de chaque case vide
+    char word[BOARD_MAX_SIZE];          // Lettres du coup en construction (minuscule : joker)
+    int letterValue[26];                // Valeur de chaque lettre (règles en vigueur)
+    int blankValue;                     // Valeur d'un joker
+    int rackSize;                       // Un coup posant rackSize lettres reçoit la prime du scrabble
+    int bingoBonus;
+    int rackCount[27];                  // Lettres encore disponibles sur le rack (BLANK : jokers)
+    int rackOrig[27];                   // Lettres du rack avant la génération
+    int rackPos[27][RULESET_MAX_RACK];  // Positions de chaque lettre dans le rack
+    uint32_t rackMask;                  // Lettres présentes au moins une fois sur le rack (sans joker)
+    int usedMask;                       // Positions du rack consommées par le coup en cours
+    int tilesUsed;                      // Nombre de lettres posées par le coup en cours
+    int fullMask;                       // Masque de toutes les positions du rack
+    const float *rackLeaves;            // Valeur du reliquat par masque conservé (peut être NULL)
+    MoveList *out;
+} GenContext;
+
+void initMoveList(MoveList *list) {
+    list->moves = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+void freeMoveList(MoveList *list) {
+    free(list->moves);
+    initMoveList(list);
+}
+
+// Ajoute une case à la liste (la capacité double si nécessaire)
+static Move *pushMove(MoveList *list) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 256;
+        Move *moves = realloc(list->moves, capacity * sizeof(Move));
+        STAT_INC(STAT_ALLOCS);
+        if (!moves) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            return NULL;
+        }
+        list->moves = moves;
+        list->capacity = capacity;
+    }
+    return &list->moves[list->count++];
+}
+
+// Indice (0..25) de la lettre d'une case occupée, joker posé (minuscule) compris
+static inline int tileLetter(char c) {
+    return (c & 0x1F) - 1;
+}
+
+// Valeur d'une lettre posée : un joker (minuscule) vaut la valeur du joker
+static inline int tileValue(const GenContext *g, char c) {
+    return (c >= 'a') ? g->blankValue : g->letterValue[c - 'A'];
+}
+
+// Consomme une lettre du rack, ou un joker (l = BLANK), à la première position encore libre
+static inline void takeLetter(GenContext *g, int l) {
+    int pos = g->rackPos[l][g->rackOrig[l] - g->rackCount[l]];
+    g->usedMask |= 1 << pos;
+    g->tilesUsed++;
+    if (--g->rackCount[l] == 0 && l != BLANK)
+        g->rackMask &= ~(1u << l);
+}
+
+// Rend au rack la dernière lettre consommée
+static inline void returnLetter(GenContext *g, int l) {
+    g->rackCount[l]++;
+    if (l != BLANK)
+        g->rackMask |= 1u << l;
+    g->tilesUsed--;
+    int pos = g->rackPos[l][g->rackOrig[l] - g->rackCount[l]];
+    g->usedMask &= ~(1 << pos);
+}
+
+// Enregistre le coup couvrant les cases [start, end) de la ligne courante
+static void recordMove(GenContext *g, int start, int end, int score) {
+    Move *move = pushMove(g->out);
+    if (!move)
+        return;
+    STAT_INC(STAT_MOVES);
+    int len = end - start;
+    memcpy(move->word, &g->word[start], len);
+    move->word[len] = '\0';
+    move->x = (g->dir == 'h') ? start : g->fixed;
+    move->y = (g->dir == 'h') ? g->fixed : start;
+    move->dir = g->dir;
+    move->tilesUsed = g->tilesUsed;
+    move->usedMask = g->usedMask;
+    move->score = score + (g->tilesUsed == g->rackSize ? g->bingoBonus : 0);
+    move->equity = (float)move->score;
+    if (g->rackLeaves)
+        move->equity += g->rackLeaves[g->fullMask & ~g->usedMask];
+}
+
+// Noyaux spécialisés pour le plateau standard : taille, bornes et masques de 16 bits fixés
+#define KERNEL_SIZE MOVEGEN_STANDARD_SIZE
+#define KERNEL_MASK uint16_t
+#define KERNEL(name) name##Standard
+#include "movegen_kernels.h"
+
+// Noyaux spécialisés pour le plateau du Super Scrabble (masques de 32 bits)
+#define KERNEL_SIZE MOVEGEN_SUPER_SIZE
+#define KERNEL_MASK uint32_t
+#define KERNEL(name) name##Super
+#include "movegen_kernels.h"
+
+// Noyaux génériques : taille lue dans le contexte, masques de 32 bits
+#define KERNEL_SIZE (g->size)
+#define KERNEL_MASK uint32_t
+#define KERNEL(name) name##Generic
+#include "movegen_kernels.h"
+
+// Noyaux génériques imposés à toutes les tailles ; taille nommée par moveGenKernelName
+static bool genericOnly = false;
+static int namedSize = MOVEGEN_STANDARD_SIZE;
+
+void selectMoveGenKernels(int boardSize, bool forceGeneric) {
+    genericOnly = forceGeneric;
+    namedSize = boardSize;
+}
+
+const char *moveGenKernelName(void) {
+    switch (genericOnly ? 0 : namedSize) {
+        case MOVEGEN_STANDARD_SIZE: return "15x15";
+        case MOVEGEN_SUPER_SIZE:    return "21x21";
+        default:                    return "générique";
+    }
+}
+
+/*
+ * Fonction : generateMovesWithRules
+ * ---------------------------------
+ * Génère tous les coups légaux pour un rack, avec leur score complet (mot principal,
+ * mots croisés, prime du scrabble) et leur équité (score + valeur du reliquat). Les valeurs
+ * des lettres, la prime et la taille du chevalet sont celles des règles données.
+ * Seules les cases ancres (vides et adjacentes à une lettre) sont explorées et les lettres
+ * sont filtrées par l'arbre lexical et les contraintes des mots croisés.
+ *
+ * Paramètres :
+ *   rules      : règles du jeu (valeurs des lettres, prime, taille du chevalet).
+ *   lexicon    : arbre lexical du dictionnaire.
+ *   board      : le plateau de jeu (une minuscule est un joker posé).
+ *   boardSize  : taille du plateau (au plus BOARD_MAX_SIZE).
+ *   bonusBoard : cases bonus (utilisées uniquement sur les cases vides).
+ *   rack       : lettres du rack (au plus RULESET_MAX_RACK, '?' pour un joker).
+ *   firstMove  : vrai si le premier mot doit passer par la case centrale.
+ *   rackLeaves : valeurs de reliquat préparées par leavePrepareRack (NULL : équité = score).
+ *   out        : liste de sortie (vidée avant la génération).
+ *
+ * Retour :
+ *   Le nombre de coups générés.
+ *
+ * Remarque :
+ *   - Un coup d'une seule lettre formant un mot dans les deux directions apparaît deux fois.
+ *   - Les lettres posées par un joker sont en minuscules dans le mot du coup.
+ */
+int generateMovesWithRules(const Ruleset *rules, const Lexicon *lexicon, char **board, int boardSize,
+                           BonusBoard bonusBoard, const char *rack, bool firstMove,
+                           const float *rackLeaves, MoveList *out) {
+    GenContext g;
+    g.lexicon = lexicon;
+    g.size = boardSize;
+    g.rackLeaves = rackLeaves;
+    g.out = out;
+    g.usedMask = 0;
+    g.tilesUsed = 0;
+    g.rackMask = 0;
+    memset(g.rackCount, 0, sizeof(g.rackCount));
+    for (int l = 0; l < 26; l++)
+        g.letterValue[l] = rules->tileValue['A' + l];
+    g.blankValue = rules->tileValue['?'];
+    g.rackSize = rules->rackSize;
+    g.bingoBonus = rules->bingoBonus;
+
+    int rackLen = 0;
+    for (; rackLen < RULESET_MAX_RACK && rack[rackLen] != '\0'; rackLen++) {
+        char c = toupper((unsigned char)rack[rackLen]);
+        if (c == '?') {
+            g.rackPos[BLANK][g.rackCount[BLANK]++] = rackLen;
+            continue;
+        }
+        if (c < 'A' || c > 'Z')
+            continue;
+        int l = c - 'A';
+        g.rackPos[l][g.rackCount[l]++] = rackLen;
+        g.rackMask |= 1u << l;
+    }
+    memcpy(g.rackOrig, g.rackCount, sizeof(g.rackCount));
+    g.fullMask = (1 << rackLen) - 1;
+
+    TRACE_BEGIN("generateMoves");
+    out->count = 0;
+    switch (genericOnly ? 0 : boardSize) {
+        case MOVEGEN_STANDARD_SIZE: generateBoardStandard(&g, board, bonusBoard, firstMove); break;
+        case MOVEGEN_SUPER_SIZE:    generateBoardSuper(&g, board, bonusBoard, firstMove); break;
+        default:                    generateBoardGeneric(&g, board, bonusBoard, firstMove); break;
+    }
+    TRACE_END("generateMoves");
+    return out->count;
+}
+
+// Génération avec les règles en vigueur (outils et parties du processus)
+int generateMoves(const Lexicon *lexicon, char **board, int boardSize, BonusBoard bonusBoard,
+                  const char *rack, bool firstMove, const float *rackLeaves, MoveList *out) {
+    return generateMovesWithRules(currentRules, lexicon, board, boardSize, bonusBoard, rack,
+                                  firstMove, rackLeaves, out);
+}
+
+int bestMoveIndex(const MoveList *list) {
+    STAT_TIMER_START(rankingStart);
+    int best = -1;
+    for (int i = 0; i < list->count; i++) {
+        const Move *m = &list->moves[i];
+        if (best < 0 || m->equity > list->moves[best].equity ||
+            (m->equity == list->moves[best].equity && m->score > list->moves[best].score))
+            best = i;
+    }
+    STAT_TIMER_STOP(PHASE_RANKING, rankingStart);
+    return best;
+}
+
+// Compare deux mots sans tenir compte de la casse (un joker s'écrit en minuscule)
+static bool sameLetters(const char *a, const char *b) {
+    for (; *a != '\0' && *b != '\0'; a++, b++)
+        if (toupper((unsigned char)*a) != toupper((unsigned char)*b))
+            return false;
+    return *a == *b;
+}
+
+const Move *findMove(const MoveList *list, const char *word, int x, int y, char dir) {
+    const Move *found = NULL;
+    for (int i = 0; i < list->count; i++) {
+        const Move *move = &list->moves[i];
+        if (move->x != x || move->y != y || move->dir != dir || !sameLetters(move->word, word))
+            continue;
+        if (!found || move->score > found->score)
+            found = move;
+    }
+    return found;
+}
+
+/*
+ * Fonction : applyMove
+ * --------------------
+ * Pose les lettres du coup sur les cases vides et retire du rack les positions consommées
+ * (le rack est compacté ; il reste à le compléter depuis le sac).
+ */
+void applyMove(char **board, const Move *move, char *rack) {
+    int len = strlen(move->word);
+    for (int i = 0; i < len; i++) {
+        int x = move->x, y = move->y;
+        if (move->dir == 'h')
+            x += i;
+        else
+            y += i;
+        if (board[y][x] == ' ')
+            board[y][x] = move->word[i];
+    }
+    int j = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        if (!(move->usedMask & (1 << i)))
+            rack[j++] = rack[i];
+    rack[j] = '\0';
+}
+
+bool isBoardEmpty(char **board, int boardSize) {
+    for (int y = 0; y < boardSize; y++)
+        for (int x = 0; x < boardSize; x++)
+            if (board[y][x] != ' ')
+                return false;
+    return true;
+}
@@ -0,0 +1,73 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "scrabble.h"
+#include "lexicon.h"
+#include "leave.h"
+#include "ruleset.h"
+
+// Tailles de plateau servies par des noyaux de génération spécialisés
+#define MOVEGEN_STANDARD_SIZE 15   // Plateau standard
+#define MOVEGEN_SUPER_SIZE    21   // Plateau du Super Scrabble
+
+// Les masques de ligne des noyaux génériques tiennent sur 32 bits
+_Static_assert(BOARD_MAX_SIZE < 32, "Les masques de ligne doivent tenir sur 32 bits");
+
+// Longueur maximale d'un mot posé (taille du plateau + '\0')
+#define MOVE_MAX_WORD (BOARD_MAX_SIZE + 1)
+
+// Coup complet : mot formé (lettres du plateau incluses), position, score et lettres consommées
+typedef struct {
+    char word[MOVE_MAX_WORD];
+    int x, y;
+    char dir;          // 'h' ou 'v'
+    int score;         // Score complet : mot principal, mots croisés et prime du scrabble
+    int tilesUsed;     // Nombre de lettres posées depuis le rack
+    int usedMask;      // Positions du rack consommées (bit i : rack[i])
+    float equity;      // score + valeur du reliquat
+} Move;
+
+// Liste de coups réutilisable (la mémoire est conservée d'un appel à l'autre)
+typedef struct {
+    Move *moves;
+    int count;
+    int capacity;
+} MoveList;
+
+void initMoveList(MoveList *list);
+void freeMoveList(MoveList *list);
+
+// Génère tous les coups légaux du rack (algorithme des ancres d'Appel et Jacobson) avec les
+// valeurs, la prime et le chevalet des règles en vigueur
+int generateMoves(const Lexicon *lexicon, char **board, int boardSize, BonusBoard bonusBoard,
+                  const char *rack, bool firstMove, const float *rackLeaves, MoveList *out);
+
+// Même génération avec des règles données (positions de l'interface publique, qui portent
+// les règles de leur moteur)
+int generateMovesWithRules(const Ruleset *rules, const Lexicon *lexicon, char **board, int boardSize,
+                           BonusBoard bonusBoard, const char *rack, bool firstMove,
+                           const float *rackLeaves, MoveList *out);
+
+// Choisit les noyaux de génération : un plateau de taille MOVEGEN_STANDARD_SIZE ou
+// MOVEGEN_SUPER_SIZE passe par ses noyaux spécialisés, sauf si forceGeneric (mesures et
+// validation, à régler avant tout thread), tout autre plateau par les noyaux génériques.
+// boardSize ne sert qu'au nom donné par moveGenKernelName ; appelée par useRuleset.
+void selectMoveGenKernels(int boardSize, bool forceGeneric);
+
+// Nom des noyaux servant le plateau choisi ("15x15", "21x21" ou "générique")
+const char *moveGenKernelName(void);
+
+// Indice du coup de meilleure équité (-1 si la liste est vide)
+int bestMoveIndex(const MoveList *list);
+
+// Coup de la liste correspondant au mot posé en (x, y) dans le sens dir, casse ignorée (meilleur
+// score si le mot peut être formé de plusieurs façons, avec ou sans joker) ; NULL s'il n'existe pas
+const Move *findMove(const MoveList *list, const char *word, int x, int y, char dir);
+
+// Pose le coup sur le plateau et retire du rack les lettres consommées
+void applyMove(char **board, const Move *move, char *rack);
+
+// Vrai si aucune lettre n'est encore posée
+bool isBoardEmpty(char **board, int boardSize);
+
+#endif  // MOVEGEN_H
@@ -0,0 +1,268 @@
+// Pas de garde d'inclusion : ce fichier est inclus une fois par variante, par movegen.c seul.
+//
+// Noyaux de la génération de coups (extraction des lignes, recherche des ancres, contraintes
+// des mots croisés, score incrémental), écrits une seule fois pour toutes les tailles de
+// plateau. Avant chaque inclusion, movegen.c définit :
+//   KERNEL_SIZE  : taille du plateau, constante (15, 21) ou lue dans le contexte (g->size) ;
+//   KERNEL_MASK  : type entier des masques de ligne (un bit par case) ;
+//   KERNEL(nom)  : nom de la fonction dans cette variante.
+// Avec une taille constante, le compilateur déroule les boucles sur les cases et fixe les
+// bornes ; les macros sont retirées à la fin du fichier.
+//
+
+/*
+ * Fonction : computeCrossCheck
+ * ----------------------------
+ * Calcule, pour la case vide i de la ligne courante (qui a au moins une lettre voisine dans la
+ * direction perpendiculaire), les lettres qui forment un mot croisé valide et la valeur des
+ * lettres de ce mot croisé. Les lettres voisines sont délimitées par le masque d'occupation
+ * de la ligne perpendiculaire.
+ */
+static void KERNEL(computeCrossCheck)(GenContext *g, int i, KERNEL_MASK crossOccupied) {
+    const char *cross = g->grid[g->dir == 'h'][i];   // Ligne perpendiculaire passant par la case
+    int pos = g->fixed;                              // Position de la case sur cette ligne
+    uint32_t emptyBefore = ~(uint32_t)crossOccupied & ((1u << pos) - 1);
+    int start = emptyBefore ? 32 - __builtin_clz(emptyBefore) : 0;
+    int end = pos + 1 + __builtin_ctz(~((uint32_t)crossOccupied >> (pos + 1)));
+
+    STAT_INC(STAT_CROSS_CHECKS);
+
+    // Descend dans l'arbre avec les lettres situées avant la case
+    int node = 0, sum = 0;
+    for (int p = start; p < pos; p++) {
+        sum += tileValue(g, cross[p]);
+        if (node >= 0)
+            node = lexiconChild(g->lexicon, node, tileLetter(cross[p]));
+    }
+    for (int p = pos + 1; p < end; p++)
+        sum += tileValue(g, cross[p]);
+    g->crossSum[i] = sum;
+    g->crossMask[i] = 0;
+    if (node < 0)
+        return;
+
+    // Teste chaque lettre possible suivie des lettres situées après la case
+    uint32_t children = g->lexicon->nodes[node].mask & LEXICON_LETTERS;
+    STAT_ADD(STAT_DICT_PROBES, __builtin_popcount(children));
+    while (children) {
+        int l = __builtin_ctz(children);
+        children &= children - 1;
+        int n = lexiconChild(g->lexicon, node, l);
+        for (int p = pos + 1; n >= 0 && p < end; p++)
+            n = lexiconChild(g->lexicon, n, tileLetter(cross[p]));
+        if (n >= 0 && (g->lexicon->nodes[n].mask & LEXICON_TERMINAL))
+            g->crossMask[i] |= 1u << l;
+    }
+}
+
+/*
+ * Fonction : extendRight
+ * ----------------------
+ * Prolonge le mot vers la droite à partir de la case sq, en suivant l'arbre lexical.
+ * Les scores (mot principal, multiplicateur de mot, mots croisés) sont accumulés en
+ * paramètres, de sorte qu'un coup est évalué au moment même où il est trouvé. Avec un joker
+ * sur le rack, chaque lettre possible est aussi essayée sous la forme d'un joker.
+ */
+static void KERNEL(extendRight)(GenContext *g, int node, int sq, int anchor, int start,
+                                int mainSum, int wordMul, int crossTotal) {
+    if (sq >= KERNEL_SIZE || g->line[sq] == ' ') {
+        // Un mot se termine ici : il doit avoir recouvert l'ancre et compter au moins 2 lettres
+        if (sq > anchor && sq - start >= 2 && (g->lexicon->nodes[node].mask & LEXICON_TERMINAL))
+            recordMove(g, start, sq, mainSum * wordMul + crossTotal);
+        if (sq >= KERNEL_SIZE)
+            return;
+
+        uint32_t playable = g->rackCount[BLANK] > 0 ? LEXICON_LETTERS : g->rackMask;
+        uint32_t candidates = g->lexicon->nodes[node].mask & g->crossMask[sq] & playable;
+        STAT_ADD(STAT_PRUNED, __builtin_popcount(g->lexicon->nodes[node].mask & LEXICON_LETTERS & ~candidates));
+        while (candidates) {
+            int l = __builtin_ctz(candidates);
+            candidates &= candidates - 1;
+            int child = lexiconChild(g->lexicon, node, l);
+            int crossWord = (g->crossSum[sq] >= 0) ? g->crossSum[sq] * g->wordMult[sq] : 0;
+
+            if (g->rackMask & (1u << l)) {
+                int value = g->letterValue[l] * g->letterMult[sq];
+                int cross = (g->crossSum[sq] >= 0) ? crossWord + value * g->wordMult[sq] : 0;
+                takeLetter(g, l);
+                g->word[sq] = 'A' + l;
+                KERNEL(extendRight)(g, child, sq + 1, anchor, start,
+                                    mainSum + value, wordMul * g->wordMult[sq], crossTotal + cross);
+                returnLetter(g, l);
+            }
+            if (g->rackCount[BLANK] > 0) {
+                int value = g->blankValue * g->letterMult[sq];
+                int cross = (g->crossSum[sq] >= 0) ? crossWord + value * g->wordMult[sq] : 0;
+                takeLetter(g, BLANK);
+                g->word[sq] = 'a' + l;
+                KERNEL(extendRight)(g, child, sq + 1, anchor, start,
+                                    mainSum + value, wordMul * g->wordMult[sq], crossTotal + cross);
+                returnLetter(g, BLANK);
+            }
+        }
+    } else {
+        // Case occupée : la lettre du plateau doit prolonger le préfixe
+        int child = lexiconChild(g->lexicon, node, tileLetter(g->line[sq]));
+        if (child >= 0) {
+            g->word[sq] = g->line[sq];
+            KERNEL(extendRight)(g, child, sq + 1, anchor, start, mainSum + tileValue(g, g->line[sq]),
+                                wordMul, crossTotal);
+        }
+    }
+}
+
+/*
+ * Fonction : leftPart
+ * -------------------
+ * Construit toutes les parties gauches (préfixes tirés du rack) posées sur les cases vides
+ * non-ancres situées juste avant l'ancre, puis prolonge chacune vers la droite.
+ * Ces cases n'ont aucun voisin, donc aucun mot croisé : seuls les bonus comptent.
+ */
+static void KERNEL(leftPart)(GenContext *g, int node, int limit, int anchor, char *prefix, int prefixLen) {
+    int start = anchor - prefixLen;
+    int mainSum = 0, wordMul = 1;
+    for (int i = 0; i < prefixLen; i++) {
+        g->word[start + i] = prefix[i];
+        mainSum += tileValue(g, prefix[i]) * g->letterMult[start + i];
+        wordMul *= g->wordMult[start + i];
+    }
+    KERNEL(extendRight)(g, node, anchor, anchor, start, mainSum, wordMul, 0);
+    if (limit == 0)
+        return;
+
+    uint32_t playable = g->rackCount[BLANK] > 0 ? LEXICON_LETTERS : g->rackMask;
+    uint32_t candidates = g->lexicon->nodes[node].mask & playable;
+    STAT_ADD(STAT_PRUNED, __builtin_popcount(g->lexicon->nodes[node].mask & LEXICON_LETTERS & ~candidates));
+    while (candidates) {
+        int l = __builtin_ctz(candidates);
+        candidates &= candidates - 1;
+        int child = lexiconChild(g->lexicon, node, l);
+        if (g->rackMask & (1u << l)) {
+            takeLetter(g, l);
+            prefix[prefixLen] = 'A' + l;
+            KERNEL(leftPart)(g, child, limit - 1, anchor, prefix, prefixLen + 1);
+            returnLetter(g, l);
+        }
+        if (g->rackCount[BLANK] > 0) {
+            takeLetter(g, BLANK);
+            prefix[prefixLen] = 'a' + l;
+            KERNEL(leftPart)(g, child, limit - 1, anchor, prefix, prefixLen + 1);
+            returnLetter(g, BLANK);
+        }
+    }
+}
+
+/*
+ * Fonction : generateLine
+ * -----------------------
+ * Génère les coups de la ligne courante (rangée ou colonne g->fixed).
+ *
+ * Paramètres :
+ *   g          : le contexte (g->dir et g->fixed désignent la ligne).
+ *   bonusBoard : cases bonus.
+ *   firstMove  : vrai si le premier mot doit passer par la case centrale.
+ *   lines      : masques d'occupation des lignes de même direction, décalés d'une ligne
+ *                (lines[k + 1] : ligne k ; lines[0] et lines[KERNEL_SIZE + 1] sont vides).
+ *   crossLines : masques d'occupation des lignes perpendiculaires, décalés de même.
+ */
+static void KERNEL(generateLine)(GenContext *g, BonusBoard bonusBoard, bool firstMove,
+                                 const KERNEL_MASK *lines, const KERNEL_MASK *crossLines) {
+    int center = KERNEL_SIZE / 2;
+    uint32_t full = (1u << KERNEL_SIZE) - 1;
+    STAT_TIMER_START(prefilterStart);
+
+    // Ancres : cases vides voisines d'une lettre (case centrale au premier coup)
+    uint32_t occupied = lines[g->fixed + 1];
+    uint32_t anchors;
+    if (firstMove)
+        anchors = (g->fixed == center) ? (1u << center) & ~occupied : 0;
+    else
+        anchors = ~occupied & full &
+                  (lines[g->fixed] | lines[g->fixed + 2] | occupied << 1 | occupied >> 1);
+    if (!anchors) {
+        STAT_TIMER_STOP(PHASE_PREFILTER, prefilterStart);
+        return;
+    }
+
+    // Lettres de la ligne, bonus et contraintes des mots croisés des cases vides : seules les
+    // cases voisines d'une lettre des lignes parallèles adjacentes portent un mot croisé
+    g->line = g->grid[g->dir == 'v'][g->fixed];
+    uint32_t constrained = ~occupied & full & (lines[g->fixed] | lines[g->fixed + 2]);
+    for (int i = 0; i < KERNEL_SIZE; i++) {
+        if (occupied & (1u << i))
+            continue;
+        int code = (g->dir == 'h') ? bonusBoard[g->fixed][i] : bonusBoard[i][g->fixed];
+        g->letterMult[i] = bonusLetterMultiplier[code];
+        g->wordMult[i] = bonusWordMultiplier[code];
+        if (constrained & (1u << i)) {
+            KERNEL(computeCrossCheck)(g, i, crossLines[i + 1]);
+        } else {
+            STAT_INC(STAT_CROSS_CHECKS);
+            STAT_INC(STAT_CROSS_FREE);
+            g->crossMask[i] = LEXICON_LETTERS;
+            g->crossSum[i] = -1;
+        }
+    }
+
+    STAT_TIMER_STOP(PHASE_PREFILTER, prefilterStart);
+
+    STAT_TIMER_START(generationStart);
+    char prefix[BOARD_MAX_SIZE];
+    for (uint32_t pending = anchors; pending; pending &= pending - 1) {
+        int a = __builtin_ctz(pending);
+        uint32_t before = (1u << a) - 1;
+        STAT_INC(STAT_ANCHORS);
+        if (a > 0 && (occupied & (1u << (a - 1)))) {
+            // Partie gauche imposée : les lettres déjà posées avant l'ancre
+            uint32_t emptyBefore = ~occupied & before;
+            int start = emptyBefore ? 32 - __builtin_clz(emptyBefore) : 0;
+            int node = 0, mainSum = 0;
+            for (int i = start; i < a && node >= 0; i++) {
+                g->word[i] = g->line[i];
+                mainSum += tileValue(g, g->line[i]);
+                node = lexiconChild(g->lexicon, node, tileLetter(g->line[i]));
+            }
+            if (node >= 0)
+                KERNEL(extendRight)(g, node, a, a, start, mainSum, 1, 0);
+        } else {
+            // Partie gauche libre : cases vides non-ancres avant l'ancre
+            uint32_t blocked = (occupied | anchors) & before;
+            int limit = a - (blocked ? 32 - __builtin_clz(blocked) : 0);
+            if (limit > g->rackSize - 1)
+                limit = g->rackSize - 1;
+            KERNEL(leftPart)(g, 0, limit, a, prefix, 0);
+        }
+    }
+    STAT_TIMER_STOP(PHASE_GENERATION, generationStart);
+}
+
+/*
+ * Fonction : generateBoard
+ * ------------------------
+ * Copie le plateau par rangées et par colonnes (chaque ligne devient contiguë), calcule les
+ * masques d'occupation des lignes puis génère les coups de chaque ligne des deux directions.
+ */
+static void KERNEL(generateBoard)(GenContext *g, char **board, BonusBoard bonusBoard, bool firstMove) {
+    KERNEL_MASK occupied[2][BOARD_MAX_SIZE + 2];   // [0] : rangées, [1] : colonnes (décalées d'une ligne)
+    memset(occupied, 0, sizeof(occupied));
+    for (int y = 0; y < KERNEL_SIZE; y++) {
+        for (int x = 0; x < KERNEL_SIZE; x++) {
+            char c = board[y][x];
+            g->grid[0][y][x] = c;
+            g->grid[1][x][y] = c;
+            if (c != ' ') {
+                occupied[0][y + 1] |= (KERNEL_MASK)(1u << x);
+                occupied[1][x + 1] |= (KERNEL_MASK)(1u << y);
+            }
+        }
+    }
+    for (int d = 0; d < 2; d++) {
+        g->dir = (d == 0) ? 'h' : 'v';
+        for (g->fixed = 0; g->fixed < KERNEL_SIZE; g->fixed++)
+            KERNEL(generateLine)(g, bonusBoard, firstMove, occupied[d], occupied[d ^ 1]);
+    }
+}
+
+#undef KERNEL_SIZE
+#undef KERNEL_MASK
+#undef KERNEL
@@ -0,0 +1,1258 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "board.h"            // canPlaceWord / validatePlacement : chemin de référence
+#include "dictionary.h"       // Chargement du dictionnaire
+#include "lexicon.h"          // Arbre lexical utilisé par le générateur
+#include "movegen.h"          // Génération de tous les coups légaux
+#include "bag.h"              // Sac de lettres reproductible
+#include "scrabble_engine.h"  // Interface publique du moteur
+#include "gamestate.h"        // Parties entre robots (suivi des lettres invisibles)
+#include "inference.h"        // Lettres invisibles et tirage des racks adverses
+#include "endgame.h"          // Finale et pré-finale, comparées au minimax exhaustif
+
+#include <math.h>
+#include <unistd.h>
+
+//
+// ---------------------- Oracle différentiel ---------------------------------
+//
+// Compare chaque implémentation rapide du moteur à la recherche exhaustive historique
+// (chaque mot du dictionnaire, normalisé comme pour l'arbre lexical, à chaque case, dans les
+// deux sens, filtré par canPlaceWord puis validatePlacement). Les positions sont tirées de
+// parties reproductibles (graine fixe). Pour chaque position, les ensembles complets de coups
+// et leurs scores doivent être identiques ; toute divergence est réduite automatiquement
+// (lettres du rack et du plateau retirées tant qu'elle persiste) et la position minimale est
+// affichée au format du corpus du banc d'essai. Le rapport donne aussi l'accélération de
+// chaque moteur sur l'oracle.
+//
+// Un coup est identifié par les lettres qu'il pose (case et lettre) : un coup d'une seule
+// lettre peut être décrit par un mot horizontal ou vertical, c'est le même coup.
+//
+// L'oracle tourne avec les règles en vigueur (standard, ou fichier donné par -R) : plateau,
+// bonus, valeurs et prime du scrabble. La recherche historique ne pose pas de joker : les
+// jokers tirés du sac sont écartés des racks des positions comparées à la référence.
+//
+// Les noyaux de génération spécialisés (15 x 15 et 21 x 21) sont en outre comparés aux noyaux
+// génériques sur des positions reproductibles dont les racks et le plateau portent des
+// jokers : les deux ensembles de coups, lettres des jokers comprises, doivent être identiques.
+//
+// Les lettres invisibles et le tirage des racks adverses sont vérifiés de la même façon
+// contre une référence exacte : le suivi reconstitué depuis l'historique de parties entre
+// robots doit donner le décompte du plateau, et la fréquence de chaque rack tiré doit suivre
+// la loi hypergéométrique multivariée (test du khi-deux).
+//
+// La finale et la pré-finale sont comparées à un minimax exhaustif sur un plateau de fin de
+// partie et de petits racks : même écart final, même probabilité de gain pour chaque coup.
+//
+
+#define ORACLE_MAX_API_MOVES 32768   // Coups demandés à l'interface publique (tous)
+#define ORACLE_MAX_REPORTED  8       // Coups divergents affichés par position
+#define ORACLE_TRACKER_GAMES 8       // Parties entre robots pour le suivi des lettres invisibles
+#define ORACLE_RACK_SAMPLES  400000  // Racks tirés par test du khi-deux
+#define ORACLE_MAX_LAW_CELLS 1000000 // Taille maximale de la loi exacte énumérée
+#define ORACLE_CHI2_Z        4.265   // Quantile normal du seuil du khi-deux (p = 1e-5)
+#define ORACLE_MAX_CANDIDATES 256    // Candidats de la pré-finale (tous les coups des petits racks)
+#define ORACLE_ENDGAME_BUDGET_MS 60000.0  // Budget des finales : la recherche doit aller au bout
+#define ORACLE_KERNEL_POSITIONS 200  // Positions de la comparaison des noyaux de génération
+
+// Coup canonique : lettres posées triées par case, score complet
+typedef struct {
+    uint16_t tiles[RULESET_MAX_RACK];   // case (y * taille + x) << 6 | lettre (0..25, joker 26..51)
+    int count;
+    int score;
+    char word[MOVE_MAX_WORD];      // Une description du coup, pour les messages
+    int x, y;
+    char dir;
+} OracleMove;
+
+typedef struct {
+    OracleMove *moves;
+    int count;
+    int capacity;
+} MoveSet;
+
+// Position de test : plateau, bonus restants et rack du joueur au trait
+typedef struct {
+    char **board;
+    BonusBoard bonusBoard;
+    char rack[RULESET_MAX_RACK + 1];
+    uint64_t seed;
+} OraclePosition;
+
+typedef struct OracleContext OracleContext;
+
+// Un moteur à valider : remplit out avec tous ses coups ; retourne 0, -1 en cas d'erreur
+typedef struct {
+    const char *name;
+    int (*generate)(OracleContext *ctx, const OraclePosition *pos, MoveSet *out);
+} OracleEngine;
+
+struct OracleContext {
+    DictionaryEntry *dictionary;
+    DictionaryEntry *reference;    // Mots de la référence, normalisés comme ceux de l'arbre lexical
+    Lexicon *lexicon;
+    ScrabbleEngine *engine;
+    ScrabblePosition *apiPosition;
+    ScrabbleMove *apiMoves;
+    MoveList moves;
+    MoveSet expected, actual;      // Position courante
+    MoveSet reducedExpected, reducedActual;  // Position en cours de réduction
+};
+
+static double nowSeconds(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+//
+// Ensembles de coups
+//
+
+static void clearMoveSet(MoveSet *set) {
+    set->count = 0;
+}
+
+static void freeMoveSet(MoveSet *set) {
+    free(set->moves);
+    set->moves = NULL;
+    set->count = set->capacity = 0;
+}
+
+// Ordre des lettres posées, puis des coups (tri et recherche)
+static int compareTiles(const void *a, const void *b) {
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+static int compareMoves(const void *a, const void *b) {
+    const OracleMove *m = a, *n = b;
+    if (m->count != n->count)
+        return m->count - n->count;
+    for (int i = 0; i < m->count; i++)
+        if (m->tiles[i] != n->tiles[i])
+            return (int)m->tiles[i] - (int)n->tiles[i];
+    return 0;
+}
+
+/*
+ * Fonction : addMove
+ * ------------------
+ * Ajoute un coup décrit par son mot principal sous forme canonique (lettres posées sur les
+ * cases vides du plateau, triées par case).
+ *
+ * Retour :
+ *   0, ou -1 en cas d'échec d'allocation.
+ */
+static int addMove(MoveSet *set, char **board, const char *word, int x, int y, char dir, int score) {
+    if (set->count == set->capacity) {
+        int capacity = set->capacity ? set->capacity * 2 : 1024;
+        OracleMove *moves = realloc(set->moves, capacity * sizeof(OracleMove));
+        if (!moves) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            return -1;
+        }
+        set->moves = moves;
+        set->capacity = capacity;
+    }
+    OracleMove *move = &set->moves[set->count++];
+    move->count = 0;
+    move->score = score;
+    move->x = x;
+    move->y = y;
+    move->dir = dir;
+    snprintf(move->word, sizeof(move->word), "%s", word);
+    int size = currentRules->boardSize;
+    for (int i = 0; word[i] != '\0' && move->count < RULESET_MAX_RACK; i++) {
+        int cx = (dir == 'h') ? x + i : x, cy = (dir == 'h') ? y : y + i;
+        if (board[cy][cx] != ' ')
+            continue;
+        int letter = islower((unsigned char)word[i]) ? 26 + word[i] - 'a' : word[i] - 'A';
+        move->tiles[move->count++] = (uint16_t)((cy * size + cx) << 6 | letter);
+    }
+    qsort(move->tiles, move->count, sizeof(uint16_t), compareTiles);
+    return 0;
+}
+
+// Trie l'ensemble et fusionne les descriptions multiples d'un même coup
+static void normalizeMoveSet(MoveSet *set) {
+    qsort(set->moves, set->count, sizeof(OracleMove), compareMoves);
+    int j = 0;
+    for (int i = 0; i < set->count; i++)
+        if (j == 0 || compareMoves(&set->moves[j - 1], &set->moves[i]) != 0)
+            set->moves[j++] = set->moves[i];
+    set->count = j;
+}
+
+//
+// Oracle : recherche exhaustive historique
+//
+
+// Score complet d'une pose, compté case par case : mot principal, mots croisés formés par
+// chaque lettre posée, bonus des cases couvertes et prime du scrabble pour tout le chevalet
+static int referenceScore(char **board, BonusBoard bonusBoard, const char *word, int x, int y, char dir) {
+    int size = currentRules->boardSize;
+    int dx = (dir == 'h') ? 1 : 0, dy = 1 - dx;
+    int mainScore = 0, mainMultiplier = 1, crossTotal = 0, placed = 0;
+    for (int i = 0; word[i] != '\0'; i++) {
+        int cx = x + dx * i, cy = y + dy * i;
+        char letter = toupper((unsigned char)word[i]);
+        if (board[cy][cx] != ' ') {
+            mainScore += getLetterScore(letter);
+            continue;
+        }
+        placed++;
+        int bonus = bonusBoard[cy][cx];
+        int letterMultiplier = bonusLetterMultiplier[bonus];
+        int wordMultiplier = bonusWordMultiplier[bonus];
+        mainScore += getLetterScore(letter) * letterMultiplier;
+        mainMultiplier *= wordMultiplier;
+
+        // Mot croisé : lettres voisines dans l'autre sens
+        int crossScore = 0, crossLength = 1;
+        for (int k = 1; cx - dy * k >= 0 && cy - dx * k >= 0 && board[cy - dx * k][cx - dy * k] != ' '; k++, crossLength++)
+            crossScore += getLetterScore(board[cy - dx * k][cx - dy * k]);
+        for (int k = 1; cx + dy * k < size && cy + dx * k < size && board[cy + dx * k][cx + dy * k] != ' '; k++, crossLength++)
+            crossScore += getLetterScore(board[cy + dx * k][cx + dy * k]);
+        if (crossLength > 1)
+            crossTotal += (crossScore + getLetterScore(letter) * letterMultiplier) * wordMultiplier;
+    }
+    return mainScore * mainMultiplier + crossTotal +
+           (placed == currentRules->rackSize ? currentRules->bingoBonus : 0);
+}
+
+/*
+ * Fonction : buildReferenceWords
+ * ------------------------------
+ * Mots de la recherche de référence, filtrés et normalisés exactement comme dans buildLexicon :
+ * passage en majuscules, mots vides ou contenant un caractère hors de A-Z écartés, doublons
+ * fusionnés. Les moteurs ne voient que ces mots : sans ce filtre, un dictionnaire en
+ * minuscules ou accentué ferait diverger la référence sur toutes les positions.
+ *
+ * Retour :
+ *   0 en cas de succès (*out reçoit la table), -1 en cas d'échec d'allocation.
+ */
+static int buildReferenceWords(DictionaryEntry *dictionary, DictionaryEntry **out) {
+    DictionaryEntry *reference = NULL;
+    DictionaryEntry *entry, *tmp;
+    HASH_ITER(hh, dictionary, entry, tmp) {
+        char word[sizeof(entry->word)];
+        int len = 0;
+        bool valid = entry->word[0] != '\0';
+        for (; valid && entry->word[len] != '\0'; len++) {
+            word[len] = toupper((unsigned char)entry->word[len]);
+            valid = word[len] >= 'A' && word[len] <= 'Z';
+        }
+        word[len] = '\0';
+        if (!valid || isValidWordHash(word, reference))
+            continue;
+        DictionaryEntry *copy = malloc(sizeof(DictionaryEntry));
+        if (!copy) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            freeDictionaryHash(reference);
+            return -1;
+        }
+        memcpy(copy->word, word, len + 1);
+        HASH_ADD_STR(reference, word, copy);
+    }
+    *out = reference;
+    return 0;
+}
+
+// Tous les coups légaux par la recherche exhaustive (chemin de findBestMove)
+static int oracleMoves(OracleContext *ctx, const OraclePosition *pos, MoveSet *out) {
+    int size = currentRules->boardSize;
+    bool firstMove = isBoardEmpty(pos->board, size);
+    DictionaryEntry *entry, *tmp;
+    HASH_ITER(hh, ctx->reference, entry, tmp) {
+        const char *word = entry->word;
+        if ((int)strlen(word) > size)
+            continue;
+        for (int y = 0; y < size; y++)
+            for (int x = 0; x < size; x++)
+                for (int d = 0; d < 2; d++) {
+                    char dir = (d == 0) ? 'h' : 'v';
+                    if (!canPlaceWord(word, x, y, dir, pos->board, size, pos->rack, firstMove) ||
+                        !validatePlacement(word, x, y, dir, pos->board, size, ctx->reference))
+                        continue;
+                    int score = referenceScore(pos->board, (int (*)[BOARD_MAX_SIZE])pos->bonusBoard, word, x, y, dir);
+                    if (addMove(out, pos->board, word, x, y, dir, score) != 0)
+                        return -1;
+                }
+    }
+    return 0;
+}
+
+//
+// Moteurs comparés
+//
+
+// Générateur interne (ancres et arbre lexical)
+static int moveGenMoves(OracleContext *ctx, const OraclePosition *pos, MoveSet *out) {
+    int size = currentRules->boardSize;
+    generateMoves(ctx->lexicon, pos->board, size, (int (*)[BOARD_MAX_SIZE])pos->bonusBoard, pos->rack,
+                  isBoardEmpty(pos->board, size), NULL, &ctx->moves);
+    for (int i = 0; i < ctx->moves.count; i++) {
+        const Move *move = &ctx->moves.moves[i];
+        if (addMove(out, pos->board, move->word, move->x, move->y, move->dir, move->score) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+// Interface publique (bibliothèque), avec tous les coups demandés
+static int publicApiMoves(OracleContext *ctx, const OraclePosition *pos, MoveSet *out) {
+    int size = currentRules->boardSize;
+    scrabblePositionClear(ctx->apiPosition);
+    for (int y = 0; y < size; y++) {
+        char row[BOARD_MAX_SIZE + 1];
+        memcpy(row, pos->board[y], size);
+        row[size] = '\0';
+        if (scrabblePositionSetRow(ctx->apiPosition, y, row) != 0)
+            return -1;
+    }
+    int count = scrabbleGenerateMoves(ctx->apiPosition, pos->rack, ctx->apiMoves, ORACLE_MAX_API_MOVES);
+    if (count == ORACLE_MAX_API_MOVES) {
+        fprintf(stderr, "Erreur : plus de %d coups, ensemble tronqué\n", ORACLE_MAX_API_MOVES);
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        const ScrabbleMove *move = &ctx->apiMoves[i];
+        if (addMove(out, pos->board, move->word, move->x, move->y, move->dir, move->score) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static const OracleEngine engines[] = {
+    { "movegen", moveGenMoves },
+    { "api", publicApiMoves },
+};
+#define ENGINE_COUNT ((int)(sizeof(engines) / sizeof(engines[0])))
+
+//
+// Comparaison
+//
+
+// Nombre de différences entre l'oracle et le moteur (coups manquants, en trop, score faux)
+static int countDivergences(const MoveSet *expected, const MoveSet *actual, bool report) {
+    int i = 0, j = 0, divergences = 0;
+    while (i < expected->count || j < actual->count) {
+        int order = (i == expected->count) ? 1 : (j == actual->count) ? -1
+                  : compareMoves(&expected->moves[i], &actual->moves[j]);
+        const OracleMove *move = (order <= 0) ? &expected->moves[i] : &actual->moves[j];
+        const char *kind = NULL;
+        if (order < 0)
+            kind = "manquant";
+        else if (order > 0)
+            kind = "en trop ";
+        else if (expected->moves[i].score != actual->moves[j].score)
+            kind = "score   ";
+        if (kind) {
+            if (report && divergences < ORACLE_MAX_REPORTED)
+                printf("    %s %-15s x=%-2d y=%-2d %c  oracle %4d  moteur %4d\n", kind, move->word,
+                       move->x, move->y, move->dir, order <= 0 ? expected->moves[i].score : -1,
+                       order >= 0 ? actual->moves[j].score : -1);
+            divergences++;
+        }
+        if (order <= 0)
+            i++;
+        if (order >= 0)
+            j++;
+    }
+    if (report && divergences > ORACLE_MAX_REPORTED)
+        printf("    ... %d divergences au total\n", divergences);
+    return divergences;
+}
+
+// Vrai si le moteur diverge de l'oracle sur la position (-1 en cas d'erreur)
+static int diverges(OracleContext *ctx, const OracleEngine *engine, const OraclePosition *pos) {
+    clearMoveSet(&ctx->reducedExpected);
+    clearMoveSet(&ctx->reducedActual);
+    if (oracleMoves(ctx, pos, &ctx->reducedExpected) != 0 ||
+        engine->generate(ctx, pos, &ctx->reducedActual) != 0)
+        return -1;
+    normalizeMoveSet(&ctx->reducedExpected);
+    normalizeMoveSet(&ctx->reducedActual);
+    return countDivergences(&ctx->reducedExpected, &ctx->reducedActual, false) > 0;
+}
+
+//
+// Positions
+//
+
+// Complète le rack ; sans jokers, ceux tirés du sac sont écartés, avec jokers, une lettre
+// sur trois tirages est remplacée par un joker (les règles standard n'en ont pas)
+static void fillRack(Bag *bag, char *rack, bool blanks) {
+    bagFillRack(bag, rack);
+    int len = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        if (blanks || rack[i] != '?')
+            rack[len++] = rack[i];
+    rack[len] = '\0';
+    if (blanks && len > 0 && !strchr(rack, '?') && nextRandom(&bag->rng) % 3 == 0)
+        rack[nextRandom(&bag->rng) % len] = '?';
+}
+
+/*
+ * Fonction : generatePosition
+ * ---------------------------
+ * Joue une partie reproductible à deux joueurs pendant un nombre de coups tiré au hasard
+ * (au plus maxPlies), en choisissant le meilleur coup trois fois sur quatre et un coup légal
+ * quelconque sinon, puis retient le plateau et le rack du joueur au trait.
+ *
+ * Paramètres :
+ *   ctx      : contexte (arbre lexical et liste de coups).
+ *   seed     : graine de la partie.
+ *   maxPlies : nombre maximal de coups joués avant la position.
+ *   blanks   : vrai pour jouer avec des jokers (voir fillRack), faux pour la référence.
+ *   pos      : position produite (plateau déjà alloué).
+ */
+static void generatePosition(OracleContext *ctx, uint64_t seed, int maxPlies, bool blanks,
+                             OraclePosition *pos) {
+    int size = currentRules->boardSize;
+    Bag bag;
+    bagInit(&bag, seed);
+    for (int y = 0; y < size; y++)
+        memset(pos->board[y], ' ', size);
+    initBonusBoard(pos->bonusBoard);
+    char racks[2][RULESET_MAX_RACK + 1] = { "", "" };
+    fillRack(&bag, racks[0], blanks);
+    fillRack(&bag, racks[1], blanks);
+    int plies = (maxPlies > 0) ? (int)(nextRandom(&bag.rng) % (maxPlies + 1)) : 0;
+    int player = 0;
+    for (int ply = 0; ply < plies && racks[player][0] != '\0'; ply++) {
+        generateMoves(ctx->lexicon, pos->board, size, pos->bonusBoard, racks[player],
+                      isBoardEmpty(pos->board, size), NULL, &ctx->moves);
+        if (ctx->moves.count == 0)
+            break;
+        int index = (nextRandom(&bag.rng) % 4 == 0) ? (int)(nextRandom(&bag.rng) % ctx->moves.count)
+                                                    : bestMoveIndex(&ctx->moves);
+        const Move *move = &ctx->moves.moves[index];
+        for (int i = 0; move->word[i] != '\0'; i++)
+            pos->bonusBoard[move->dir == 'h' ? move->y : move->y + i][move->dir == 'h' ? move->x + i : move->x] = 0;
+        applyMove(pos->board, move, racks[player]);
+        fillRack(&bag, racks[player], blanks);
+        player = 1 - player;
+    }
+    memset(pos->rack, 0, sizeof(pos->rack));
+    memcpy(pos->rack, racks[player], strlen(racks[player]));
+    pos->seed = seed;
+}
+
+// Position au format du corpus du banc d'essai (CATEGORIE PLATEAU RACK)
+static void printPosition(const char *label, const OraclePosition *pos) {
+    int size = currentRules->boardSize;
+    printf("%s ", label);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++)
+            putchar(pos->board[y][x] == ' ' ? '.' : pos->board[y][x]);
+        putchar(y < size - 1 ? '/' : ' ');
+    }
+    printf("%s\n", pos->rack);
+}
+
+// Vrai si tous les mots du plateau sont valides et toutes les lettres reliées à la case centrale
+static bool isLegalBoard(OracleContext *ctx, char **board) {
+    int size = currentRules->boardSize;
+    for (int d = 0; d < 2; d++)
+        for (int line = 0; line < size; line++) {
+            char word[BOARD_MAX_SIZE + 1];
+            int len = 0;
+            for (int i = 0; i <= size; i++) {
+                char c = (i < size) ? (d == 0 ? board[line][i] : board[i][line]) : ' ';
+                if (c != ' ') {
+                    word[len++] = c;
+                    continue;
+                }
+                word[len] = '\0';
+                if (len > 1 && !isValidWordHash(word, ctx->reference))
+                    return false;
+                len = 0;
+            }
+        }
+    int tiles = 0, reached = 0, stack[BOARD_MAX_SIZE * BOARD_MAX_SIZE], top = 0;
+    bool seen[BOARD_MAX_SIZE * BOARD_MAX_SIZE] = { false };
+    for (int i = 0; i < size * size; i++)
+        tiles += board[i / size][i % size] != ' ';
+    if (tiles == 0)
+        return true;
+    int center = size / 2;
+    if (board[center][center] == ' ')
+        return false;
+    stack[top++] = center * size + center;
+    seen[center * size + center] = true;
+    while (top > 0) {
+        int cell = stack[--top], x = cell % size, y = cell / size;
+        reached++;
+        const int neighbours[4][2] = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+        for (int n = 0; n < 4; n++) {
+            int nx = neighbours[n][0], ny = neighbours[n][1];
+            if (nx < 0 || ny < 0 || nx >= size || ny >= size || seen[ny * size + nx] || board[ny][nx] == ' ')
+                continue;
+            seen[ny * size + nx] = true;
+            stack[top++] = ny * size + nx;
+        }
+    }
+    return reached == tiles;
+}
+
+/*
+ * Fonction : minimizePosition
+ * ---------------------------
+ * Réduit une position divergente : retire une à une les lettres du rack puis celles du
+ * plateau (en rendant à la case son bonus d'origine) tant que le plateau reste légal et que
+ * la divergence persiste, jusqu'à ce qu'aucun retrait ne soit plus possible.
+ *
+ * Paramètres :
+ *   ctx    : contexte.
+ *   engine : le moteur qui diverge.
+ *   pos    : la position, modifiée sur place.
+ *
+ * Retour :
+ *   Le nombre d'appels à l'oracle effectués.
+ */
+static int minimizePosition(OracleContext *ctx, const OracleEngine *engine, OraclePosition *pos) {
+    int size = currentRules->boardSize;
+    int calls = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; pos->rack[i] != '\0'; ) {
+            char saved[RULESET_MAX_RACK + 1];
+            memcpy(saved, pos->rack, sizeof(saved));
+            memmove(&pos->rack[i], &pos->rack[i + 1], RULESET_MAX_RACK - i);
+            pos->rack[RULESET_MAX_RACK] = '\0';
+            calls++;
+            if (pos->rack[0] != '\0' && diverges(ctx, engine, pos) == 1) {
+                changed = true;
+                continue;
+            }
+            memcpy(pos->rack, saved, sizeof(saved));
+            i++;
+        }
+        for (int cell = 0; cell < size * size; cell++) {
+            int x = cell % size, y = cell / size;
+            char letter = pos->board[y][x];
+            if (letter == ' ')
+                continue;
+            pos->board[y][x] = ' ';
+            if (isLegalBoard(ctx, pos->board)) {
+                pos->bonusBoard[y][x] = currentRules->premium[y][x];
+                calls++;
+                if (diverges(ctx, engine, pos) == 1) {
+                    changed = true;
+                    continue;
+                }
+                pos->bonusBoard[y][x] = 0;
+            }
+            pos->board[y][x] = letter;
+        }
+        fprintf(stderr, "  réduction : %d appels à l'oracle\n", calls);
+    }
+    return calls;
+}
+
+//
+// Lettres invisibles et tirage des racks adverses
+//
+
+// Vrai si le suivi reconstitué depuis l'historique donne le décompte du plateau pour chaque joueur
+static bool trackerMatchesBoard(GameState *state) {
+    char *rows[BOARD_MAX_SIZE];
+    gameBoardRows(state, rows);
+    for (int p = 0; p < state->playerCount; p++) {
+        const char *rack = state->players[p].rack;
+        int unseen[LEAVE_ALPHABET];
+        int total = countUnseenTiles(rows, state->boardSize, rack, unseen);
+        UnseenTracker tracker;
+        unseenFromHistory(&tracker, state->history, state->historyCount, rack);
+        if (tracker.total != total || memcmp(tracker.counts, unseen, sizeof(unseen)) != 0)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Fonction : checkUnseenTracker
+ * -----------------------------
+ * Joue des parties entre robots (2 à 4 joueurs) et compare, après chaque tour, les lettres
+ * invisibles de chaque joueur reconstituées depuis l'historique au décompte du plateau.
+ * Retient au passage le suivi d'un joueur en début de pré-fin de partie (sac de 7 lettres au
+ * plus), utilisé ensuite par le test du khi-deux.
+ *
+ * Retour :
+ *   Le nombre de tours où le suivi diverge.
+ */
+static int checkUnseenTracker(OracleContext *ctx, uint64_t seed, UnseenTracker *preEndgame) {
+    static GameState state;
+    int turns = 0, failures = 0;
+    preEndgame->total = 0;
+    for (int g = 0; g < ORACLE_TRACKER_GAMES; g++) {
+        int players = GAME_MIN_PLAYERS + g % (GAME_MAX_PLAYERS - GAME_MIN_PLAYERS + 1);
+        if (initGameState(&state, players, players, seed + g) != 0)
+            return 1;
+        while (!state.over) {
+            GameAction action;
+            gameChooseAction(&state, ctx->lexicon, NULL, &ctx->moves, &action);
+            if (gameApplyAction(&state, &action) != 0)
+                break;
+            turns++;
+            if (!trackerMatchesBoard(&state)) {
+                printf("  suivi : divergence partie %d, tour %d\n", g, state.turn);
+                failures++;
+            }
+            if (preEndgame->total == 0 && players == 2 && !state.over &&
+                state.bag.total <= currentRules->rackSize)
+                unseenFromHistory(preEndgame, state.history, state.historyCount,
+                                  state.players[state.current].rack);
+        }
+    }
+    printf("suivi      %d divergences sur %d tours (%d parties)\n", failures, turns, ORACLE_TRACKER_GAMES);
+    return failures;
+}
+
+// Énumère les racks de taille left (indices en base mixte) avec leur probabilité
+// hypergéométrique multivariée : produit des C(c_i, x_i), divisé ensuite par C(N, k)
+static void enumerateRacks(const int *counts, const int *radix, int symbols, int depth, int left,
+                           int index, double logWeight, double *law) {
+    if (depth == symbols) {
+        if (left == 0)
+            law[index] = exp(logWeight);
+        return;
+    }
+    int c = counts[depth];
+    for (int x = 0; x <= c && x <= left; x++)
+        enumerateRacks(counts, radix, symbols, depth + 1, left - x, index + x * radix[depth],
+                       logWeight + lgamma(c + 1) - lgamma(x + 1) - lgamma(c - x + 1), law);
+}
+
+/*
+ * Fonction : checkRackSampler
+ * ---------------------------
+ * Tire ORACLE_RACK_SAMPLES racks de taille k dans un multiensemble (inferenceSampleRack sans
+ * pondération) et compare leurs fréquences à la loi hypergéométrique multivariée exacte par
+ * un test du khi-deux (cases attendues à moins de 5 tirages regroupées). Un rack contenant
+ * une lettre absente du multiensemble fait échouer le test immédiatement.
+ *
+ * Retour :
+ *   0 si le test passe, 1 sinon.
+ */
+static int checkRackSampler(const char *label, const int counts[LEAVE_ALPHABET], int k, uint64_t seed) {
+    int symbolOf[LEAVE_ALPHABET], present[LEAVE_ALPHABET], radix[LEAVE_ALPHABET];
+    int symbols = 0, total = 0;
+    long cells = 1;
+    for (int s = 0; s < LEAVE_ALPHABET; s++) {
+        symbolOf[s] = -1;
+        total += counts[s];
+        if (counts[s] == 0)
+            continue;
+        symbolOf[s] = symbols;
+        present[symbols] = counts[s];
+        radix[symbols++] = (int)cells;
+        cells *= (counts[s] < k ? counts[s] : k) + 1;   // Au plus min(c, k) exemplaires par rack
+        if (cells > ORACLE_MAX_LAW_CELLS) {
+            printf("khi-deux   %-12s ignoré (loi exacte trop grande)\n", label);
+            return 0;
+        }
+    }
+    double *law = calloc(cells, sizeof(double));
+    long *observed = calloc(cells, sizeof(long));
+    if (!law || !observed) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        free(law);
+        free(observed);
+        return 1;
+    }
+    double logTotal = lgamma(total + 1) - lgamma(k + 1) - lgamma(total - k + 1);
+    enumerateRacks(present, radix, symbols, 0, k, 0, -logTotal, law);
+
+    UnseenTracker tracker;
+    memcpy(tracker.counts, counts, sizeof(tracker.counts));
+    tracker.total = total;
+    static RackInference inference;
+    inferenceInit(&inference, &tracker, k);
+    uint64_t rng = seed;
+    int failure = 0;
+    for (int n = 0; n < ORACLE_RACK_SAMPLES && !failure; n++) {
+        char rack[8];
+        int drawn[LEAVE_ALPHABET] = { 0 };
+        int index = 0;
+        int length = inferenceSampleRack(&inference, &rng, rack);
+        for (int i = 0; i < length && !failure; i++) {
+            int s = leaveSymbol(rack[i]);
+            if (s < 0 || ++drawn[s] > counts[s]) {
+                printf("  khi-deux : rack %s impossible dans le multiensemble\n", rack);
+                failure = 1;
+            } else {
+                index += radix[symbolOf[s]];
+            }
+        }
+        if (length != k) {
+            printf("  khi-deux : rack de %d lettres au lieu de %d\n", length, k);
+            failure = 1;
+        }
+        if (!failure)
+            observed[index]++;
+    }
+
+    // Khi-deux : cases attendues à 5 tirages ou plus, les autres regroupées en une seule
+    double chi2 = 0.0, restExpected = 0.0, restObserved = 0.0;
+    int bins = 0, racks = 0;
+    for (long i = 0; i < cells; i++) {
+        if (law[i] <= 0.0) {
+            if (observed[i] > 0) {
+                printf("  khi-deux : rack de probabilité nulle tiré %ld fois\n", observed[i]);
+                failure = 1;
+            }
+            continue;
+        }
+        racks++;
+        double expected = law[i] * ORACLE_RACK_SAMPLES;
+        if (expected < 5.0) {
+            restExpected += expected;
+            restObserved += observed[i];
+            continue;
+        }
+        chi2 += (observed[i] - expected) * (observed[i] - expected) / expected;
+        bins++;
+    }
+    if (restExpected > 0.0) {
+        chi2 += (restObserved - restExpected) * (restObserved - restExpected) / restExpected;
+        bins++;
+    }
+    // Seuil du khi-deux à (bins - 1) degrés de liberté (approximation de Wilson-Hilferty)
+    int dof = bins > 1 ? bins - 1 : 1;
+    double h = 2.0 / (9.0 * dof);
+    double threshold = dof * pow(1.0 - h + ORACLE_CHI2_Z * sqrt(h), 3);
+    if (chi2 > threshold)
+        failure = 1;
+    printf("khi-deux   %-12s %d lettres, racks de %d : %d racks possibles, khi2 %.1f (ddl %d, seuil %.1f) %s\n",
+           label, total, k, racks, chi2, dof, threshold, failure ? "ÉCHEC" : "ok");
+    free(law);
+    free(observed);
+    return failure;
+}
+
+// Lettres invisibles et tirage des racks adverses ; retourne le nombre de vérifications en échec
+static int checkInference(OracleContext *ctx, uint64_t seed) {
+    UnseenTracker preEndgame;
+    int failures = checkUnseenTracker(ctx, seed, &preEndgame) > 0;
+    // Petit multiensemble avec un joker et de nombreuses lettres absentes
+    int small[LEAVE_ALPHABET] = { 0 };
+    small['A' - 'A'] = 2;
+    small['E' - 'A'] = 3;
+    small['I' - 'A'] = 1;
+    small['R' - 'A'] = 2;
+    small['S' - 'A'] = 1;
+    small['T' - 'A'] = 1;
+    small['W' - 'A'] = 1;
+    small[LEAVE_BLANK] = 1;
+    failures += checkRackSampler("fabriqué", small, 7, seed);
+    failures += checkRackSampler("fabriqué", small, 3, seed + 1);
+    if (preEndgame.total > 0) {
+        int k = preEndgame.total < currentRules->rackSize ? preEndgame.total : currentRules->rackSize;
+        failures += checkRackSampler("pré-finale", preEndgame.counts, k, seed + 2);
+    }
+    return failures;
+}
+
+//
+// Finale et pré-finale
+//
+
+// Valeur des lettres d'un rack
+static int rackValue(const char *rack) {
+    int sum = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        sum += getLetterScore(rack[i]);
+    return sum;
+}
+
+// Rack restant après le coup (positions de usedMask retirées)
+static void rackAfter(const char *rack, int usedMask, char *out) {
+    int j = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        if (!(usedMask & (1 << i)))
+            out[j++] = rack[i];
+    out[j] = '\0';
+}
+
+// Pose le coup sur les cases vides ; retourne le nombre de cases remplies (cells)
+static int placeMove(char **board, const Move *move, int *cells) {
+    int size = currentRules->boardSize;
+    int n = 0;
+    for (int i = 0; move->word[i] != '\0'; i++) {
+        int x = move->x + (move->dir == 'h' ? i : 0);
+        int y = move->y + (move->dir == 'h' ? 0 : i);
+        if (board[y][x] == ' ') {
+            board[y][x] = move->word[i];
+            cells[n++] = y * size + x;
+        }
+    }
+    return n;
+}
+
+static void clearCells(char **board, const int *cells, int n) {
+    int size = currentRules->boardSize;
+    for (int i = 0; i < n; i++)
+        board[cells[i] / size][cells[i] % size] = ' ';
+}
+
+/*
+ * Fonction : bruteEndgame
+ * -----------------------
+ * Finale de référence : minimax exhaustif, sans élagage ni table de transposition, sur tous
+ * les coups et la passe. Mêmes règles que la recherche du moteur : finir son rack rapporte
+ * deux fois la valeur du rack adverse, deux passes consécutives terminent la partie (chacun
+ * perd alors la valeur de son rack).
+ *
+ * Retour :
+ *   L'écart que le joueur au trait réalise d'ici la fin de la partie.
+ */
+static int bruteEndgame(OracleContext *ctx, char **board, BonusBoard bonusBoard, const char *toMove,
+                        const char *other, int passes) {
+    if (passes >= 2)
+        return rackValue(other) - rackValue(toMove);
+    int best = -bruteEndgame(ctx, board, bonusBoard, other, toMove, passes + 1);
+    MoveList list;
+    initMoveList(&list);
+    generateMoves(ctx->lexicon, board, currentRules->boardSize, bonusBoard, toMove, false, NULL, &list);
+    for (int i = 0; i < list.count; i++) {
+        const Move *move = &list.moves[i];
+        char after[8];
+        rackAfter(toMove, move->usedMask, after);
+        int value;
+        if (after[0] == '\0') {
+            value = move->score + 2 * rackValue(other);
+        } else {
+            int cells[RULESET_MAX_RACK];
+            int n = placeMove(board, move, cells);
+            value = move->score - bruteEndgame(ctx, board, bonusBoard, other, after, 0);
+            clearCells(board, cells, n);
+        }
+        if (value > best)
+            best = value;
+    }
+    freeMoveList(&list);
+    return best;
+}
+
+// Lettres de pool désignées par les bits de mask
+static void maskLetters(const char *pool, int mask, char *out) {
+    int n = 0;
+    for (int i = 0; pool[i] != '\0'; i++)
+        if (mask & (1 << i))
+            out[n++] = pool[i];
+    out[n] = '\0';
+}
+
+/*
+ * Fonction : brutePreEndgame
+ * --------------------------
+ * Référence de la pré-finale pour un coup candidat : chaque lettre invisible est prise
+ * individuellement (tous les sous-ensembles sont équiprobables), sans passer par les
+ * multiensembles pondérés du moteur. Si le coup vide le sac, chaque tirage mène à une finale
+ * exhaustive ; sinon l'adversaire choisit, parmi toutes ses réponses et la passe, celle qui
+ * minimise notre écart, une réponse qui vide le sac menant elle aussi à une finale exhaustive.
+ * Sans table des reliquats, une branche statique vaut l'écart courant.
+ */
+static void brutePreEndgame(OracleContext *ctx, char **board, BonusBoard bonusBoard, const char *rack,
+                            const char *pool, int bagCount, int spread, const Move *move,
+                            double *win, double *expected) {
+    int poolSize = strlen(pool);
+    int drawCount = move->tilesUsed < bagCount ? move->tilesUsed : bagCount;
+    int restCount = bagCount - drawCount;
+    double base = spread + move->score;
+    char leave[8];
+    rackAfter(rack, move->usedMask, leave);
+    int cells[RULESET_MAX_RACK];
+    int placed = placeMove(board, move, cells);
+    int branches = 0;
+    *win = 0.0;
+    *expected = 0.0;
+    for (int drawMask = 0; drawMask < (1 << poolSize); drawMask++) {
+        if (__builtin_popcount(drawMask) != drawCount)
+            continue;
+        for (int bagMask = 0; bagMask < (1 << poolSize); bagMask++) {
+            if ((bagMask & drawMask) || __builtin_popcount(bagMask) != restCount)
+                continue;
+            char mine[16], drawn[8], bag[8], opponent[8];
+            maskLetters(pool, drawMask, drawn);
+            maskLetters(pool, bagMask, bag);
+            maskLetters(pool, ((1 << poolSize) - 1) & ~drawMask & ~bagMask, opponent);
+            snprintf(mine, sizeof(mine), "%s%s", leave, drawn);
+            double value;
+            bool estimated = false;
+            if (restCount == 0) {
+                value = mine[0] == '\0' ? base + 2 * rackValue(opponent)
+                                        : base - bruteEndgame(ctx, board, bonusBoard, opponent, mine, 0);
+            } else {
+                value = base;
+                estimated = true;
+                MoveList replies;
+                initMoveList(&replies);
+                generateMoves(ctx->lexicon, board, currentRules->boardSize, bonusBoard, opponent, false,
+                              NULL, &replies);
+                for (int r = 0; r < replies.count; r++) {
+                    const Move *reply = &replies.moves[r];
+                    bool solved = reply->tilesUsed >= restCount;
+                    double v = base - reply->score;
+                    if (solved) {
+                        char after[16];
+                        int replyCells[RULESET_MAX_RACK];
+                        rackAfter(opponent, reply->usedMask, after);
+                        strcat(after, bag);
+                        int n = placeMove(board, reply, replyCells);
+                        v += bruteEndgame(ctx, board, bonusBoard, mine, after, 0);
+                        clearCells(board, replyCells, n);
+                    }
+                    if (v < value) {
+                        value = v;
+                        estimated = !solved;
+                    }
+                }
+                freeMoveList(&replies);
+            }
+            *win += estimated ? 1.0 / (1.0 + exp(-value / PREENDGAME_SPREAD_SCALE))
+                              : (value > 0) ? 1.0 : (value == 0) ? 0.5 : 0.0;
+            *expected += value;
+            branches++;
+        }
+    }
+    clearCells(board, cells, placed);
+    *win /= branches;
+    *expected /= branches;
+}
+
+// Compare une finale du moteur au minimax exhaustif ; retourne 1 en cas d'écart
+static int checkEndgame(OracleContext *ctx, EndgameSearch *search, char **board, BonusBoard bonusBoard,
+                        const char *toMove, const char *other) {
+    EndgameResult result;
+    solveEndgame(search, board, toMove, other, ORACLE_ENDGAME_BUDGET_MS, &result);
+    int expected = bruteEndgame(ctx, board, bonusBoard, toMove, other, 0);
+    int failure = !result.exact || result.value != expected;
+    printf("finale     %-7s contre %-7s écart %4d (référence %4d), profondeur %d, %llu nœuds %s\n",
+           toMove, other, result.value, expected, result.depth, (unsigned long long)result.nodes,
+           failure ? "ÉCHEC" : "ok");
+    return failure;
+}
+
+// Compare chaque candidat de la pré-finale à la référence exhaustive ; retourne 1 en cas d'écart
+static int checkPreEndgame(OracleContext *ctx, char **board, BonusBoard bonusBoard, const char *rack,
+                           const char *pool, int bagCount, int spread) {
+    int unseen[LEAVE_ALPHABET] = { 0 };
+    for (int i = 0; pool[i] != '\0'; i++)
+        unseen[leaveSymbol(pool[i])]++;
+    PreEndgameOptions options;
+    defaultPreEndgameOptions(&options);
+    options.candidates = ORACLE_MAX_CANDIDATES;
+    options.branchBudgetMs = ORACLE_ENDGAME_BUDGET_MS;
+    options.replies = 0;
+    PreEndgameCandidate candidates[ORACLE_MAX_CANDIDATES];
+    int count = solvePreEndgame(ctx->lexicon, board, currentRules->boardSize, bonusBoard, NULL, rack,
+                                unseen, bagCount, spread, &options, candidates, ORACLE_MAX_CANDIDATES);
+    if (count < 0)
+        return 1;
+    int failures = 0;
+    for (int c = 0; c < count; c++) {
+        const PreEndgameCandidate *candidate = &candidates[c];
+        double win, expected;
+        brutePreEndgame(ctx, board, bonusBoard, rack, pool, bagCount, spread, &candidate->move,
+                        &win, &expected);
+        bool exact = candidate->exactDraws + candidate->staticDraws == candidate->draws;
+        if (!exact || fabs(win - candidate->winProbability) > 1e-9 ||
+            fabs(expected - candidate->expectedSpread) > 1e-6) {
+            printf("  pré-finale : %s (%d, %d, %c) gain %.4f écart %.3f, référence %.4f et %.3f\n",
+                   candidate->move.word, candidate->move.x, candidate->move.y, candidate->move.dir,
+                   candidate->winProbability, candidate->expectedSpread, win, expected);
+            failures++;
+        }
+    }
+    printf("pré-finale rack %-7s invisibles %-7s sac %d : %d candidats, %d écarts %s\n",
+           rack, pool, bagCount, count, failures, failures ? "ÉCHEC" : "ok");
+    return failures > 0;
+}
+
+/*
+ * Fonction : checkEndgames
+ * ------------------------
+ * Joue une partie entre robots jusqu'à la pré-fin de partie et, sur ce plateau, compare la
+ * finale (solveEndgame) et la pré-finale (solvePreEndgame, toutes les réponses adverses) au
+ * minimax exhaustif, sur de petits racks tirés du rack du joueur et des lettres invisibles :
+ * l'écart et la probabilité de gain doivent être identiques.
+ *
+ * Retour :
+ *   Le nombre de vérifications en échec.
+ */
+static int checkEndgames(OracleContext *ctx, uint64_t seed) {
+    int size = currentRules->boardSize;
+    static GameState state;
+    if (initGameState(&state, 2, 2, seed) != 0)
+        return 1;
+    while (!state.over && state.bag.total > currentRules->rackSize) {
+        GameAction action;
+        gameChooseAction(&state, ctx->lexicon, NULL, &ctx->moves, &action);
+        if (gameApplyAction(&state, &action) != 0)
+            return 1;
+    }
+    char **board = initBoard(size);
+    TranspositionTable *tt = board ? createTranspositionTable(ENDGAME_TT_BITS) : NULL;
+    EndgameSearch search;
+    if (!tt || initEndgameSearch(&search, ctx->lexicon, size, state.bonusBoard, tt) != 0) {
+        freeTranspositionTable(tt);
+        freeBoard(board, size);
+        return 1;
+    }
+    for (int y = 0; y < size; y++)
+        memcpy(board[y], state.board[y], size);
+
+    // Petits racks sans joker (le minimax exhaustif reste rapide), puis un joker seul
+    const char *rack = state.players[state.current].rack;
+    int unseen[LEAVE_ALPHABET];
+    countUnseenTiles(board, size, rack, unseen);
+    char mine[8], pool[32];
+    int m = 0, p = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        if (rack[i] != '?')
+            mine[m++] = rack[i];
+    for (int s = 0; s < 26; s++)
+        for (int k = 0; k < unseen[s] && p < (int)sizeof(pool) - 1; k++)
+            pool[p++] = 'A' + s;
+    mine[m] = pool[p] = '\0';
+    int failures = 0;
+    if (m < 4 || p < 5) {
+        printf("finale     ignorée (rack %s, %d lettres invisibles)\n", rack, p);
+    } else {
+        char a[8], b[8];
+        snprintf(a, sizeof(a), "%.2s", mine);
+        snprintf(b, sizeof(b), "%.1s", pool);
+        failures += checkEndgame(ctx, &search, board, state.bonusBoard, a, b);
+        snprintf(a, sizeof(a), "%.1s", mine + 2);
+        snprintf(b, sizeof(b), "%.2s", pool + 1);
+        failures += checkEndgame(ctx, &search, board, state.bonusBoard, a, b);
+        snprintf(a, sizeof(a), "%.3s", mine + 1);
+        snprintf(b, sizeof(b), "%.2s", pool + 3);
+        failures += checkEndgame(ctx, &search, board, state.bonusBoard, a, b);
+        snprintf(a, sizeof(a), "%.3s", mine);
+        snprintf(b, sizeof(b), "%.3s", pool + 2);
+        failures += checkEndgame(ctx, &search, board, state.bonusBoard, a, b);
+        snprintf(b, sizeof(b), "%.1s", pool + 4);
+        failures += checkEndgame(ctx, &search, board, state.bonusBoard, "?", b);
+
+        int spread = state.players[state.current].score - state.players[1 - state.current].score;
+        snprintf(a, sizeof(a), "%.2s", mine);
+        snprintf(b, sizeof(b), "%.2s", pool);
+        failures += checkPreEndgame(ctx, board, state.bonusBoard, a, b, 1, spread);
+        snprintf(a, sizeof(a), "%.2s", mine + 2);
+        snprintf(b, sizeof(b), "%.3s", pool + 2);
+        failures += checkPreEndgame(ctx, board, state.bonusBoard, a, b, 2, spread);
+        snprintf(b, sizeof(b), "%.3s", pool + 1);
+        failures += checkPreEndgame(ctx, board, state.bonusBoard, a, b, 2, 0);
+    }
+    freeEndgameSearch(&search);
+    freeTranspositionTable(tt);
+    freeBoard(board, size);
+    return failures;
+}
+
+//
+// Noyaux de génération
+//
+
+/*
+ * Fonction : checkKernels
+ * -----------------------
+ * Compare, sur count positions reproductibles avec jokers (racks et plateau), les coups des
+ * noyaux spécialisés pour la taille du plateau à ceux des noyaux génériques : mêmes coups,
+ * mêmes lettres de joker, mêmes scores. Les noyaux spécialisés sont remis en vigueur à la fin.
+ *
+ * Retour :
+ *   Le nombre de positions où les deux générations divergent.
+ */
+static int checkKernels(OracleContext *ctx, uint64_t seed, int count, int maxPlies, OraclePosition *pos) {
+    int size = currentRules->boardSize;
+    selectMoveGenKernels(size, false);
+    const char *kernels = moveGenKernelName();
+    selectMoveGenKernels(size, true);
+    if (strcmp(kernels, moveGenKernelName()) == 0) {
+        printf("noyaux     ignorés (aucun noyau spécialisé pour le plateau %d x %d)\n", size, size);
+        return 0;
+    }
+    double elapsed[2] = { 0.0, 0.0 };
+    long moveCount = 0;
+    int failures = 0, withBlanks = 0;
+    for (int p = 0; p < count; p++) {
+        generatePosition(ctx, seed + p, maxPlies, true, pos);
+        bool blank = strchr(pos->rack, '?') != NULL;
+        for (int y = 0; y < size && !blank; y++)
+            for (int x = 0; x < size && !blank; x++)
+                blank = islower((unsigned char)pos->board[y][x]);
+        withBlanks += blank;
+        MoveSet *sets[2] = { &ctx->expected, &ctx->actual };
+        for (int k = 0; k < 2; k++) {
+            selectMoveGenKernels(size, k == 1);
+            clearMoveSet(sets[k]);
+            double start = nowSeconds();
+            if (moveGenMoves(ctx, pos, sets[k]) != 0) {
+                selectMoveGenKernels(size, false);
+                return failures + 1;
+            }
+            elapsed[k] += nowSeconds() - start;
+            normalizeMoveSet(sets[k]);
+        }
+        moveCount += ctx->expected.count;
+        int divergences = countDivergences(&ctx->expected, &ctx->actual, false);
+        if (divergences == 0)
+            continue;
+        failures++;
+        printf("  noyaux : position %llu, %d divergences (oracle : %s, moteur : générique)\n",
+               (unsigned long long)pos->seed, divergences, kernels);
+        printPosition("    repro", pos);
+        countDivergences(&ctx->expected, &ctx->actual, true);
+    }
+    selectMoveGenKernels(size, false);
+    printf("noyaux     %s contre générique : %d positions (%d avec jokers), %ld coups, "
+           "%d divergences, %.3f ms contre %.3f ms %s\n", kernels, count, withBlanks, moveCount,
+           failures, elapsed[0] * 1e3, elapsed[1] * 1e3, failures ? "ÉCHEC" : "ok");
+    return failures;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-R règles] [-n positions] [-p coups_max] [-s graine]\n"
+            "          [-k positions] [-m]\n"
+            "  -R : fichier de règles (plateau, bonus, lettres ; règles standard par défaut)\n"
+            "  -k : positions avec jokers de la comparaison des noyaux spécialisés aux noyaux\n"
+            "       génériques (défaut : %d, 0 pour l'ignorer)\n"
+            "  -m : ne pas réduire les positions divergentes\n",
+            prog, ORACLE_KERNEL_POSITIONS);
+}
+
+// Fonction principale de l'oracle différentiel
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *rulesFile = NULL;
+    int positionCount = 8;
+    int kernelPositions = ORACLE_KERNEL_POSITIONS;
+    int maxPlies = 24;
+    uint64_t seed = 1;
+    bool minimize = true;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:R:n:p:s:k:mh")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 'n': positionCount = atoi(optarg); break;
+            case 'p': maxPlies = atoi(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            case 'k': kernelPositions = atoi(optarg); break;
+            case 'm': minimize = false; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    // Mêmes règles pour les moteurs internes (règles du processus) et l'interface publique
+    // (règles du moteur)
+    Ruleset *rules = NULL;
+    if (rulesFile && !(rules = loadRuleset(rulesFile)))
+        return EXIT_FAILURE;
+    useRuleset(rules);
+    int size = currentRules->boardSize;
+
+    static OracleContext ctx;
+    ctx.dictionary = loadDictionaryHash(dictionaryFile);
+    if (!ctx.dictionary || !(ctx.lexicon = buildLexicon(ctx.dictionary)) ||
+        buildReferenceWords(ctx.dictionary, &ctx.reference) != 0)
+        return EXIT_FAILURE;
+    ctx.engine = scrabbleEngineLoad(dictionaryFile, NULL);
+    if (ctx.engine && rulesFile && scrabbleLoadRules(ctx.engine, rulesFile) != 0)
+        return EXIT_FAILURE;
+    ctx.apiPosition = ctx.engine ? scrabblePositionCreate(ctx.engine) : NULL;
+    ctx.apiMoves = malloc(ORACLE_MAX_API_MOVES * sizeof(ScrabbleMove));
+    OraclePosition pos;
+    pos.board = initBoard(size);
+    if (!ctx.apiPosition || !ctx.apiMoves || !pos.board)
+        return EXIT_FAILURE;
+    initMoveList(&ctx.moves);
+
+    double oracleTime = 0.0, engineTime[ENGINE_COUNT] = { 0.0 };
+    int failures[ENGINE_COUNT] = { 0 };
+    long oracleMoveCount = 0;
+    int status = EXIT_SUCCESS;
+
+    for (int p = 0; p < positionCount; p++) {
+        generatePosition(&ctx, seed + p, maxPlies, false, &pos);
+        clearMoveSet(&ctx.expected);
+        double start = nowSeconds();
+        if (oracleMoves(&ctx, &pos, &ctx.expected) != 0)
+            return EXIT_FAILURE;
+        double elapsed = nowSeconds() - start;
+        oracleTime += elapsed;
+        normalizeMoveSet(&ctx.expected);
+        oracleMoveCount += ctx.expected.count;
+        printf("position %llu : rack %-7s %5d coups  oracle %8.3f s",
+               (unsigned long long)pos.seed, pos.rack, ctx.expected.count, elapsed);
+
+        for (int e = 0; e < ENGINE_COUNT; e++) {
+            clearMoveSet(&ctx.actual);
+            start = nowSeconds();
+            if (engines[e].generate(&ctx, &pos, &ctx.actual) != 0)
+                return EXIT_FAILURE;
+            elapsed = nowSeconds() - start;
+            engineTime[e] += elapsed;
+            normalizeMoveSet(&ctx.actual);
+            int divergences = countDivergences(&ctx.expected, &ctx.actual, false);
+            printf("  %s %s %.3f ms", engines[e].name, divergences ? "DIVERGE" : "ok", elapsed * 1e3);
+            if (divergences == 0)
+                continue;
+            failures[e]++;
+            status = EXIT_FAILURE;
+            printf("\n  %s : %d divergences\n", engines[e].name, divergences);
+            countDivergences(&ctx.expected, &ctx.actual, true);
+            if (minimize) {
+                OraclePosition reduced = pos;
+                reduced.board = initBoard(size);
+                if (!reduced.board)
+                    return EXIT_FAILURE;
+                for (int y = 0; y < size; y++)
+                    memcpy(reduced.board[y], pos.board[y], size);
+                minimizePosition(&ctx, &engines[e], &reduced);
+                printf("  reproducteur minimal (%s) :\n", engines[e].name);
+                printPosition("    repro", &reduced);
+                if (diverges(&ctx, &engines[e], &reduced) == 1)
+                    countDivergences(&ctx.reducedExpected, &ctx.reducedActual, true);
+                freeBoard(reduced.board, size);
+            }
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    printf("\n%d positions, %ld coups, oracle %.3f s\n", positionCount, oracleMoveCount, oracleTime);
+    for (int e = 0; e < ENGINE_COUNT; e++)
+        printf("%-8s %3d divergences  %10.3f ms  accélération x%.0f\n", engines[e].name, failures[e],
+               engineTime[e] * 1e3, engineTime[e] > 0 ? oracleTime / engineTime[e] : 0.0);
+    printf("\n");
+    if (kernelPositions > 0 && checkKernels(&ctx, seed, kernelPositions, maxPlies, &pos) > 0)
+        status = EXIT_FAILURE;
+    if (checkInference(&ctx, seed) > 0)
+        status = EXIT_FAILURE;
+    if (checkEndgames(&ctx, seed) > 0)
+        status = EXIT_FAILURE;
+
+    freeBoard(pos.board, size);
+    freeMoveSet(&ctx.expected);
+    freeMoveSet(&ctx.actual);
+    freeMoveSet(&ctx.reducedExpected);
+    freeMoveSet(&ctx.reducedActual);
+    freeMoveList(&ctx.moves);
+    free(ctx.apiMoves);
+    scrabblePositionFree(ctx.apiPosition);
+    scrabbleEngineFree(ctx.engine);
+    freeLexicon(ctx.lexicon);
+    freeDictionaryHash(ctx.reference);
+    freeDictionaryHash(ctx.dictionary);
+    freeRuleset(rules);
+    return status;
+}
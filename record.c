@@ -0,0 +1,558 @@
+#include "record.h"
+
+//
+// ---------------------- Enregistrement des parties --------------------------
+//
+
+static const char RECORD_MAGIC[4] = { 'S', 'C', 'G', 'R' };
+static const char RECORD_INDEX_MAGIC[4] = { 'S', 'C', 'G', 'I' };
+
+// En-tête : magie, version, joueurs, taille, intervalle, noms
+#define RECORD_HEADER_SIZE (4 + 4 + 1 + 1 + 2 + RECORD_MAX_PLAYERS * RECORD_NAME_SIZE)
+// Pied : nombre de coups, nombre d'instantanés, position de l'index, magie
+#define RECORD_FOOTER_SIZE (4 + 4 + 8 + 4)
+#define RECORD_MAX_INTERVAL 256
+
+_Static_assert(sizeof(RecordMove) == 32, "RecordMove doit occuper 32 octets");
+
+/*
+ * Fonction : initGameRecord
+ * -------------------------
+ * Prépare une partie vide, sur un plateau initial vide, avec des noms par défaut
+ * (Joueur1, Joueur2...).
+ *
+ * Paramètres :
+ *   record      : la partie à initialiser.
+ *   playerCount : nombre de joueurs (1 à RECORD_MAX_PLAYERS).
+ *   boardSize   : taille du plateau (au plus RECORD_MAX_BOARD).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si les paramètres sont invalides.
+ */
+int initGameRecord(GameRecord *record, int playerCount, int boardSize) {
+    memset(record, 0, sizeof(GameRecord));
+    if (playerCount < 1 || playerCount > RECORD_MAX_PLAYERS || boardSize < 1 ||
+        boardSize > RECORD_MAX_BOARD) {
+        fprintf(stderr, "Erreur : partie de %d joueurs sur un plateau %dx%d non prise en charge.\n",
+                playerCount, boardSize, boardSize);
+        return -1;
+    }
+    record->playerCount = playerCount;
+    record->boardSize = boardSize;
+    for (int p = 0; p < playerCount; p++)
+        snprintf(record->names[p], RECORD_NAME_SIZE, "Joueur%d", p + 1);
+    memset(record->initial, ' ', sizeof(record->initial));
+    return 0;
+}
+
+void freeGameRecord(GameRecord *record) {
+    free(record->moves);
+    record->moves = NULL;
+    record->count = 0;
+    record->capacity = 0;
+}
+
+void recordSetInitialBoard(GameRecord *record, char **board) {
+    for (int y = 0; y < record->boardSize; y++)
+        memcpy(&record->initial[y * record->boardSize], board[y], record->boardSize);
+}
+
+// Copie au plus 7 lettres ; le reste du champ est mis à zéro (fichiers reproductibles)
+static void copyLetters(char dst[RECORD_RACK_SIZE], const char *src) {
+    memset(dst, 0, RECORD_RACK_SIZE);
+    for (int i = 0; src && i < RECORD_RACK_SIZE - 1 && src[i] != '\0'; i++)
+        dst[i] = src[i];
+}
+
+// Ajoute un coup vide à la partie (la capacité double si nécessaire)
+static RecordMove *pushRecordMove(GameRecord *record, int player, RecordMoveType type) {
+    if (player < 0 || player >= record->playerCount) {
+        fprintf(stderr, "Erreur : joueur %d inconnu.\n", player);
+        return NULL;
+    }
+    if (record->count == record->capacity) {
+        int capacity = record->capacity ? record->capacity * 2 : 64;
+        RecordMove *moves = realloc(record->moves, capacity * sizeof(RecordMove));
+        if (!moves) {
+            fprintf(stderr, "Erreur d'allocation mémoire.\n");
+            return NULL;
+        }
+        record->moves = moves;
+        record->capacity = capacity;
+    }
+    RecordMove *move = &record->moves[record->count++];
+    memset(move, 0, sizeof(RecordMove));
+    move->type = type;
+    move->player = player;
+    move->dir = 'h';
+    return move;
+}
+
+/*
+ * Fonction : recordPlay
+ * ---------------------
+ * Ajoute un coup posé. La case (x, y) peut être le début du mot ou la première lettre
+ * posée : au rejeu, les cases déjà occupées sont sautées.
+ *
+ * Paramètres :
+ *   record     : la partie.
+ *   player     : le joueur.
+ *   rackBefore : le rack avant le coup.
+ *   x, y, dir  : la position et la direction du coup.
+ *   tiles      : les lettres posées, dans l'ordre du mot (1 à 7).
+ *   score      : les points du coup.
+ *   drawn      : les lettres tirées ensuite (NULL ou "" si aucune).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si le coup est invalide ou en cas d'erreur d'allocation.
+ */
+int recordPlay(GameRecord *record, int player, const char *rackBefore, int x, int y, char dir,
+               const char *tiles, int score, const char *drawn) {
+    size_t count = strlen(tiles);
+    if (x < 0 || y < 0 || x >= record->boardSize || y >= record->boardSize ||
+        (dir != 'h' && dir != 'v') || count == 0 || count >= RECORD_RACK_SIZE) {
+        fprintf(stderr, "Erreur : coup invalide (%s en %d,%d %c).\n", tiles, x, y, dir);
+        return -1;
+    }
+    RecordMove *move = pushRecordMove(record, player, RECORD_PLAY);
+    if (!move)
+        return -1;
+    move->x = x;
+    move->y = y;
+    move->dir = dir;
+    move->score = score;
+    copyLetters(move->tiles, tiles);
+    copyLetters(move->rackBefore, rackBefore);
+    copyLetters(move->drawn, drawn);
+    return 0;
+}
+
+int recordExchange(GameRecord *record, int player, const char *rackBefore,
+                   const char *exchanged, const char *drawn) {
+    RecordMove *move = pushRecordMove(record, player, RECORD_EXCHANGE);
+    if (!move)
+        return -1;
+    copyLetters(move->tiles, exchanged);
+    copyLetters(move->rackBefore, rackBefore);
+    copyLetters(move->drawn, drawn);
+    return 0;
+}
+
+int recordPass(GameRecord *record, int player, const char *rack) {
+    RecordMove *move = pushRecordMove(record, player, RECORD_PASS);
+    if (!move)
+        return -1;
+    copyLetters(move->rackBefore, rack);
+    return 0;
+}
+
+/*
+ * Fonction : recordEndRack
+ * ------------------------
+ * Ajoute un ajustement de fin de partie : le joueur qui a fini reçoit la valeur du rack
+ * adverse (points > 0), un joueur à qui il reste des lettres perd leur valeur (points < 0).
+ *
+ * Paramètres :
+ *   rack   : les lettres comptées.
+ *   points : les points ajoutés ou retirés.
+ */
+int recordEndRack(GameRecord *record, int player, const char *rack, int points) {
+    RecordMove *move = pushRecordMove(record, player, RECORD_END_RACK);
+    if (!move)
+        return -1;
+    move->score = points;
+    copyLetters(move->tiles, rack);
+    if (points <= 0)
+        copyLetters(move->rackBefore, rack);
+    return 0;
+}
+
+int recordMoveTiles(char **board, const Move *move, char tiles[RECORD_RACK_SIZE]) {
+    int count = 0;
+    for (int i = 0; move->word[i] != '\0' && count < RECORD_RACK_SIZE - 1; i++) {
+        int x = move->x + (move->dir == 'h' ? i : 0);
+        int y = move->y + (move->dir == 'v' ? i : 0);
+        if (board[y][x] == ' ')
+            tiles[count++] = move->word[i];
+    }
+    tiles[count] = '\0';
+    return count;
+}
+
+// Lettre du rack correspondant à une lettre posée : un joker (minuscule) vient d'un '?'
+static char rackTile(char tile) {
+    return (tile >= 'a' && tile <= 'z') ? '?' : tile;
+}
+
+void recordDrawnTiles(const char *rackBefore, const char *used, const char *rackAfter,
+                      char drawn[RECORD_RACK_SIZE]) {
+    int counts[256] = { 0 };
+    for (int i = 0; rackBefore[i] != '\0'; i++)
+        counts[(unsigned char)rackBefore[i]]++;
+    for (int i = 0; used[i] != '\0'; i++)
+        counts[(unsigned char)rackTile(used[i])]--;
+    int n = 0;
+    for (int i = 0; rackAfter[i] != '\0' && n < RECORD_RACK_SIZE - 1; i++) {
+        if (counts[(unsigned char)rackAfter[i]] > 0)
+            counts[(unsigned char)rackAfter[i]]--;
+        else
+            drawn[n++] = rackAfter[i];
+    }
+    drawn[n] = '\0';
+}
+
+void recordRackAfter(const RecordMove *move, char rack[RECORD_RACK_SIZE]) {
+    char used[RECORD_RACK_SIZE] = "";
+    if (move->type == RECORD_PLAY || move->type == RECORD_EXCHANGE)
+        for (int i = 0; i < RECORD_RACK_SIZE - 1 && move->tiles[i] != '\0'; i++)
+            used[i] = rackTile(move->tiles[i]);
+    int n = 0;
+    for (int i = 0; i < RECORD_RACK_SIZE - 1 && move->rackBefore[i] != '\0'; i++) {
+        char *u = strchr(used, move->rackBefore[i]);
+        if (u)
+            *u = '#';   // Lettre jouée, consommée une seule fois
+        else
+            rack[n++] = move->rackBefore[i];
+    }
+    for (int i = 0; i < RECORD_RACK_SIZE - 1 && move->drawn[i] != '\0' && n < RECORD_RACK_SIZE - 1; i++)
+        rack[n++] = move->drawn[i];
+    rack[n] = '\0';
+}
+
+//
+// ---------------------- Rejeu -----------------------------------------------
+//
+
+void replayInit(const GameRecord *record, ReplayState *state) {
+    state->boardSize = record->boardSize;
+    state->moveIndex = 0;
+    memset(state->scores, 0, sizeof(state->scores));
+    memcpy(state->cells, record->initial, sizeof(state->cells));
+}
+
+/*
+ * Fonction : replayStep
+ * ---------------------
+ * Applique un coup : les lettres posées remplissent, dans l'ordre, les cases vides à partir
+ * de (x, y) dans la direction du coup, puis le score du joueur est mis à jour.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si le coup sort du plateau ou désigne un joueur inconnu.
+ */
+int replayStep(ReplayState *state, const RecordMove *move) {
+    if (move->player >= RECORD_MAX_PLAYERS)
+        return -1;
+    if (move->type == RECORD_PLAY) {
+        int size = state->boardSize;
+        int dx = (move->dir == 'h'), dy = !dx;
+        int x = move->x, y = move->y;
+        for (int i = 0; i < RECORD_RACK_SIZE - 1 && move->tiles[i] != '\0'; i++) {
+            while (x < size && y < size && state->cells[y * size + x] != ' ') {
+                x += dx;
+                y += dy;
+            }
+            if (x >= size || y >= size)
+                return -1;
+            state->cells[y * size + x] = move->tiles[i];
+            x += dx;
+            y += dy;
+        }
+    }
+    state->scores[move->player] += move->score;
+    state->moveIndex++;
+    return 0;
+}
+
+int replayTo(const GameRecord *record, int moveIndex, ReplayState *state) {
+    replayInit(record, state);
+    if (moveIndex < 0 || moveIndex > record->count)
+        return -1;
+    for (int i = 0; i < moveIndex; i++)
+        if (replayStep(state, &record->moves[i]) != 0)
+            return -1;
+    return 0;
+}
+
+//
+// ---------------------- Fichier binaire et index ----------------------------
+//
+
+// Écrit un instantané de l'index : scores puis cases du plateau
+static bool writeSnapshot(FILE *fp, const ReplayState *state) {
+    int32_t scores[RECORD_MAX_PLAYERS];
+    for (int p = 0; p < RECORD_MAX_PLAYERS; p++)
+        scores[p] = state->scores[p];
+    size_t cells = (size_t)state->boardSize * state->boardSize;
+    return fwrite(scores, sizeof(scores), 1, fp) == 1 &&
+           fwrite(state->cells, 1, cells, fp) == cells;
+}
+
+/*
+ * Fonction : saveGameRecord
+ * -------------------------
+ * Écrit la partie et son index : la partie est rejouée une fois pour produire un
+ * instantané tous les RECORD_SNAPSHOT_INTERVAL coups (le premier est le plateau initial).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 en cas d'erreur (coup incohérent ou écriture impossible).
+ */
+int saveGameRecord(const GameRecord *record, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
+        return -1;
+    }
+    uint32_t version = RECORD_VERSION;
+    uint8_t players = record->playerCount, size = record->boardSize;
+    uint16_t interval = RECORD_SNAPSHOT_INTERVAL;
+    bool ok = fwrite(RECORD_MAGIC, 1, sizeof(RECORD_MAGIC), fp) == sizeof(RECORD_MAGIC) &&
+              fwrite(&version, sizeof(version), 1, fp) == 1 &&
+              fwrite(&players, 1, 1, fp) == 1 && fwrite(&size, 1, 1, fp) == 1 &&
+              fwrite(&interval, sizeof(interval), 1, fp) == 1 &&
+              fwrite(record->names, sizeof(record->names), 1, fp) == 1 &&
+              fwrite(record->moves, sizeof(RecordMove), record->count, fp) == (size_t)record->count;
+
+    uint64_t indexOffset = ok ? (uint64_t)ftell(fp) : 0;
+    uint32_t moveCount = record->count, snapshotCount = 0;
+    ReplayState state;
+    replayInit(record, &state);
+    for (int i = 0; ok; i++) {
+        if (i % RECORD_SNAPSHOT_INTERVAL == 0) {
+            ok = writeSnapshot(fp, &state);
+            snapshotCount++;
+        }
+        if (i == record->count)
+            break;
+        if (ok && replayStep(&state, &record->moves[i]) != 0) {
+            fprintf(stderr, "Erreur : coup %d incohérent.\n", i + 1);
+            ok = false;
+        }
+    }
+    ok = ok && fwrite(&moveCount, sizeof(moveCount), 1, fp) == 1 &&
+         fwrite(&snapshotCount, sizeof(snapshotCount), 1, fp) == 1 &&
+         fwrite(&indexOffset, sizeof(indexOffset), 1, fp) == 1 &&
+         fwrite(RECORD_INDEX_MAGIC, 1, sizeof(RECORD_INDEX_MAGIC), fp) == sizeof(RECORD_INDEX_MAGIC);
+    if (fclose(fp) != 0)
+        ok = false;
+    if (!ok) {
+        fprintf(stderr, "Erreur d'écriture du fichier %s\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Fonction : openRecordReader
+ * ---------------------------
+ * Ouvre un fichier de partie et lit seulement son en-tête et son pied (position de l'index).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si le fichier est absent ou invalide.
+ */
+int openRecordReader(RecordReader *reader, const char *filename) {
+    memset(reader, 0, sizeof(RecordReader));
+    reader->fp = fopen(filename, "rb");
+    if (!reader->fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", filename);
+        return -1;
+    }
+    char magic[4], indexMagic[4];
+    uint32_t version = 0, moveCount = 0, snapshotCount = 0;
+    uint8_t players = 0, size = 0;
+    uint16_t interval = 0;
+    uint64_t indexOffset = 0;
+    bool ok = fread(magic, 1, sizeof(magic), reader->fp) == sizeof(magic) &&
+              memcmp(magic, RECORD_MAGIC, sizeof(magic)) == 0 &&
+              fread(&version, sizeof(version), 1, reader->fp) == 1 && version == RECORD_VERSION &&
+              fread(&players, 1, 1, reader->fp) == 1 && fread(&size, 1, 1, reader->fp) == 1 &&
+              fread(&interval, sizeof(interval), 1, reader->fp) == 1 &&
+              fread(reader->names, sizeof(reader->names), 1, reader->fp) == 1 &&
+              fseek(reader->fp, -RECORD_FOOTER_SIZE, SEEK_END) == 0 &&
+              fread(&moveCount, sizeof(moveCount), 1, reader->fp) == 1 &&
+              fread(&snapshotCount, sizeof(snapshotCount), 1, reader->fp) == 1 &&
+              fread(&indexOffset, sizeof(indexOffset), 1, reader->fp) == 1 &&
+              fread(indexMagic, 1, sizeof(indexMagic), reader->fp) == sizeof(indexMagic) &&
+              memcmp(indexMagic, RECORD_INDEX_MAGIC, sizeof(indexMagic)) == 0;
+    ok = ok && players >= 1 && players <= RECORD_MAX_PLAYERS && size >= 1 &&
+         size <= RECORD_MAX_BOARD && interval >= 1 && interval <= RECORD_MAX_INTERVAL &&
+         moveCount <= INT32_MAX / 2 && snapshotCount == moveCount / interval + 1 &&
+         indexOffset == RECORD_HEADER_SIZE + (uint64_t)moveCount * sizeof(RecordMove);
+    if (!ok) {
+        fprintf(stderr, "Fichier de partie invalide : %s\n", filename);
+        closeRecordReader(reader);
+        return -1;
+    }
+    for (int p = 0; p < RECORD_MAX_PLAYERS; p++)
+        reader->names[p][RECORD_NAME_SIZE - 1] = '\0';
+    reader->playerCount = players;
+    reader->boardSize = size;
+    reader->interval = interval;
+    reader->moveCount = moveCount;
+    reader->snapshotCount = snapshotCount;
+    reader->indexOffset = (long)indexOffset;
+    return 0;
+}
+
+/*
+ * Fonction : recordReaderSeek
+ * ---------------------------
+ * Reconstitue la position après moveIndex coups : lecture de l'instantané qui précède, puis
+ * rejeu d'au plus interval - 1 coups lus dans le fichier.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si moveIndex est hors de la partie ou si le fichier est invalide.
+ */
+int recordReaderSeek(RecordReader *reader, int moveIndex, ReplayState *state) {
+    if (moveIndex < 0 || moveIndex > reader->moveCount)
+        return -1;
+    int snapshot = moveIndex / reader->interval;
+    int size = reader->boardSize;
+    size_t cells = (size_t)size * size;
+    int32_t scores[RECORD_MAX_PLAYERS];
+    long offset = reader->indexOffset + snapshot * (long)(sizeof(scores) + cells);
+    if (fseek(reader->fp, offset, SEEK_SET) != 0 ||
+        fread(scores, sizeof(scores), 1, reader->fp) != 1 ||
+        fread(state->cells, 1, cells, reader->fp) != cells)
+        return -1;
+    state->boardSize = size;
+    state->moveIndex = snapshot * reader->interval;
+    for (int p = 0; p < RECORD_MAX_PLAYERS; p++)
+        state->scores[p] = scores[p];
+
+    if (state->moveIndex < moveIndex &&
+        fseek(reader->fp, RECORD_HEADER_SIZE + state->moveIndex * (long)sizeof(RecordMove), SEEK_SET) != 0)
+        return -1;
+    while (state->moveIndex < moveIndex) {
+        RecordMove move;
+        if (fread(&move, sizeof(move), 1, reader->fp) != 1 || replayStep(state, &move) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+void closeRecordReader(RecordReader *reader) {
+    if (reader->fp)
+        fclose(reader->fp);
+    reader->fp = NULL;
+}
+
+/*
+ * Fonction : loadGameRecord
+ * -------------------------
+ * Charge une partie complète (coups et plateau initial, lu dans le premier instantané).
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si le fichier est absent ou invalide.
+ */
+int loadGameRecord(GameRecord *record, const char *filename) {
+    RecordReader reader;
+    if (openRecordReader(&reader, filename) != 0)
+        return -1;
+    if (initGameRecord(record, reader.playerCount, reader.boardSize) != 0) {
+        closeRecordReader(&reader);
+        return -1;
+    }
+    memcpy(record->names, reader.names, sizeof(record->names));
+    ReplayState state;
+    bool ok = recordReaderSeek(&reader, 0, &state) == 0;
+    memcpy(record->initial, state.cells, sizeof(record->initial));
+    if (ok && reader.moveCount > 0) {
+        record->moves = malloc(reader.moveCount * sizeof(RecordMove));
+        ok = record->moves &&
+             fseek(reader.fp, RECORD_HEADER_SIZE, SEEK_SET) == 0 &&
+             fread(record->moves, sizeof(RecordMove), reader.moveCount, reader.fp) ==
+                 (size_t)reader.moveCount;
+        record->count = record->capacity = ok ? reader.moveCount : 0;
+        // Champs de lettres toujours terminés, même si le fichier est corrompu
+        for (int i = 0; i < record->count; i++) {
+            RecordMove *move = &record->moves[i];
+            move->tiles[RECORD_RACK_SIZE - 1] = '\0';
+            move->rackBefore[RECORD_RACK_SIZE - 1] = '\0';
+            move->drawn[RECORD_RACK_SIZE - 1] = '\0';
+            ok = ok && move->player < record->playerCount;
+        }
+    }
+    closeRecordReader(&reader);
+    if (!ok) {
+        fprintf(stderr, "Fichier de partie invalide : %s\n", filename);
+        freeGameRecord(record);
+        return -1;
+    }
+    return 0;
+}
+
+//
+// ---------------------- Export GCG ------------------------------------------
+//
+
+// Mot complet d'un coup rejoué ; les lettres déjà présentes avant le coup sont notées '.'
+static void playedWord(const ReplayState *before, const ReplayState *after, const RecordMove *move,
+                       char *coord, char *word) {
+    int size = after->boardSize;
+    int dx = (move->dir == 'h'), dy = !dx;
+    int x = move->x, y = move->y;
+    while (x - dx >= 0 && y - dy >= 0 && after->cells[(y - dy) * size + (x - dx)] != ' ') {
+        x -= dx;
+        y -= dy;
+    }
+    if (dx)
+        sprintf(coord, "%d%c", y + 1, 'A' + x);
+    else
+        sprintf(coord, "%c%d", 'A' + x, y + 1);
+    int n = 0;
+    for (; x < size && y < size && after->cells[y * size + x] != ' '; x += dx, y += dy)
+        word[n++] = (before->cells[y * size + x] != ' ') ? '.' : after->cells[y * size + x];
+    word[n] = '\0';
+}
+
+/*
+ * Fonction : exportGCG
+ * --------------------
+ * Écrit la partie au format texte GCG : un coup par ligne, avec le rack, la position
+ * (rangée puis colonne pour un coup horizontal, colonne puis rangée pour un coup vertical),
+ * le mot, les points et le total du joueur.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si un coup est incohérent.
+ */
+int exportGCG(const GameRecord *record, FILE *out) {
+    fprintf(out, "#character-encoding UTF-8\n");
+    for (int p = 0; p < record->playerCount; p++)
+        fprintf(out, "#player%d %s %s\n", p + 1, record->names[p], record->names[p]);
+
+    ReplayState state, before;
+    replayInit(record, &state);
+    for (int i = 0; i < record->count; i++) {
+        const RecordMove *move = &record->moves[i];
+        before = state;
+        if (replayStep(&state, move) != 0) {
+            fprintf(stderr, "Erreur : coup %d incohérent.\n", i + 1);
+            return -1;
+        }
+        const char *name = record->names[move->player];
+        int total = state.scores[move->player];
+        switch (move->type) {
+            case RECORD_PLAY: {
+                char coord[8], word[RECORD_MAX_BOARD + 1];
+                playedWord(&before, &state, move, coord, word);
+                fprintf(out, ">%s: %s %s %s %+d %d\n", name, move->rackBefore, coord, word,
+                        move->score, total);
+                break;
+            }
+            case RECORD_EXCHANGE:
+                fprintf(out, ">%s: %s -%s +0 %d\n", name, move->rackBefore, move->tiles, total);
+                break;
+            case RECORD_PASS:
+                fprintf(out, ">%s: %s - +0 %d\n", name, move->rackBefore, total);
+                break;
+            default:
+                if (move->score > 0)
+                    fprintf(out, ">%s: (%s) %+d %d\n", name, move->tiles, move->score, total);
+                else
+                    fprintf(out, ">%s: %s (%s) %+d %d\n", name, move->tiles, move->tiles,
+                            move->score, total);
+                break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#ifndef RECORD_H
+#define RECORD_H
+
+#include "scrabble.h"
+#include "movegen.h"
+
+//
+// Enregistrement des parties
+//
+// Une partie est une suite de coups de taille fixe (32 octets) : lettres posées, première
+// case, direction, score, rack avant le coup et lettres tirées ensuite. Le fichier binaire se
+// termine par un index : un instantané du plateau et des scores tous les
+// RECORD_SNAPSHOT_INTERVAL coups, ce qui permet d'atteindre le coup N en ne rejouant que
+// quelques coups depuis l'instantané le plus proche. L'export texte suit le format GCG.
+//
+// Disposition du fichier :
+//   en-tête   "SCGR", version, joueurs, taille du plateau, intervalle, noms des joueurs
+//   coups     RecordMove x nombre de coups
+//   index     par instantané : scores des joueurs puis cases du plateau (taille x taille)
+//   pied      nombre de coups, nombre d'instantanés, position de l'index, "SCGI"
+//
+
+#define RECORD_VERSION           1
+#define RECORD_MAX_PLAYERS       4
+#define RECORD_NAME_SIZE         16
+#define RECORD_MAX_BOARD         BOARD_MAX_SIZE
+#define RECORD_RACK_SIZE         8      // 7 lettres + '\0'
+#define RECORD_SNAPSHOT_INTERVAL 8
+
+typedef enum {
+    RECORD_PLAY,        // Lettres posées sur le plateau
+    RECORD_EXCHANGE,    // Lettres remises dans le sac
+    RECORD_PASS,        // Tour passé
+    RECORD_END_RACK     // Fin de partie : valeur d'un rack ajoutée (> 0) ou retirée (< 0)
+} RecordMoveType;
+
+// Coup enregistré, écrit tel quel dans le fichier (32 octets)
+typedef struct {
+    uint8_t type;                       // RecordMoveType
+    uint8_t player;                     // Indice du joueur (0..RECORD_MAX_PLAYERS-1)
+    uint8_t x, y;                       // Case de la première lettre posée
+    char dir;                           // 'h' ou 'v'
+    uint8_t reserved;
+    int16_t score;                      // Points du coup
+    char tiles[RECORD_RACK_SIZE];       // Lettres posées (ordre du mot), échangées ou comptées
+    char rackBefore[RECORD_RACK_SIZE];  // Rack avant le coup
+    char drawn[RECORD_RACK_SIZE];       // Lettres tirées après le coup
+} RecordMove;
+
+// Partie complète en mémoire
+typedef struct {
+    int playerCount;
+    int boardSize;
+    char names[RECORD_MAX_PLAYERS][RECORD_NAME_SIZE];
+    char initial[RECORD_MAX_BOARD * RECORD_MAX_BOARD];   // Plateau avant le premier coup
+    RecordMove *moves;
+    int count;
+    int capacity;
+} GameRecord;
+
+// Position reconstituée après un nombre donné de coups
+typedef struct {
+    int boardSize;
+    int moveIndex;                                  // Nombre de coups rejoués
+    int scores[RECORD_MAX_PLAYERS];
+    char cells[RECORD_MAX_BOARD * RECORD_MAX_BOARD];  // cells[y * boardSize + x], ' ' : vide
+} ReplayState;
+
+// Lecture d'un fichier sans le charger : en-tête et pied seulement, coups lus à la demande
+typedef struct {
+    FILE *fp;
+    int playerCount;
+    int boardSize;
+    int interval;
+    int moveCount;
+    int snapshotCount;
+    long indexOffset;
+    char names[RECORD_MAX_PLAYERS][RECORD_NAME_SIZE];
+} RecordReader;
+
+// Création (plateau initial vide) et libération d'une partie
+int initGameRecord(GameRecord *record, int playerCount, int boardSize);
+void freeGameRecord(GameRecord *record);
+
+// Plateau de départ d'une partie commencée sur une position existante
+void recordSetInitialBoard(GameRecord *record, char **board);
+
+// Ajout d'un coup ; retournent 0, ou -1 en cas d'erreur d'allocation ou de coup invalide
+int recordPlay(GameRecord *record, int player, const char *rackBefore, int x, int y, char dir,
+               const char *tiles, int score, const char *drawn);
+int recordExchange(GameRecord *record, int player, const char *rackBefore,
+                   const char *exchanged, const char *drawn);
+int recordPass(GameRecord *record, int player, const char *rack);
+int recordEndRack(GameRecord *record, int player, const char *rack, int points);
+
+// Lettres posées par un coup du générateur (cases vides du plateau avant le coup)
+int recordMoveTiles(char **board, const Move *move, char tiles[RECORD_RACK_SIZE]);
+
+// Lettres tirées : rack après le coup moins (rack avant le coup moins les lettres jouées) ;
+// une lettre jouée en minuscule (joker) compte comme un '?' du rack
+void recordDrawnTiles(const char *rackBefore, const char *used, const char *rackAfter,
+                      char drawn[RECORD_RACK_SIZE]);
+
+// Rack du joueur après un coup (rack avant, moins les lettres jouées, plus les lettres tirées)
+void recordRackAfter(const RecordMove *move, char rack[RECORD_RACK_SIZE]);
+
+// Rejeu : position initiale, puis un coup ; replayStep retourne -1 si le coup est incohérent
+void replayInit(const GameRecord *record, ReplayState *state);
+int replayStep(ReplayState *state, const RecordMove *move);
+int replayTo(const GameRecord *record, int moveIndex, ReplayState *state);
+
+// Fichier binaire avec index ; retournent 0, ou -1 en cas d'erreur
+int saveGameRecord(const GameRecord *record, const char *filename);
+int loadGameRecord(GameRecord *record, const char *filename);
+
+// Accès direct au coup N d'un fichier par l'instantané le plus proche
+int openRecordReader(RecordReader *reader, const char *filename);
+int recordReaderSeek(RecordReader *reader, int moveIndex, ReplayState *state);
+void closeRecordReader(RecordReader *reader);
+
+// Export texte au format GCG
+int exportGCG(const GameRecord *record, FILE *out);
+
+#endif  // RECORD_H
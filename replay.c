@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "record.h"           // Parties enregistrées, rejeu et export GCG
+
+#include <unistd.h>
+
+//
+// ---------------------- Relecture des parties enregistrées ------------------
+//
+// Outil sans interface graphique autour des fichiers .scg : résumé de chaque partie, export
+// GCG, position après le coup N (par l'index du fichier, sans rejouer toute la partie) et
+// mesure du rejeu complet en mémoire sur un lot de parties.
+//
+
+static double nowNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Affiche le plateau (une rangée par ligne, '.' pour une case vide) et les scores
+static void printState(const ReplayState *state, char names[][RECORD_NAME_SIZE], int playerCount) {
+    int size = state->boardSize;
+    printf("Après %d coups :\n", state->moveIndex);
+    for (int y = 0; y < size; y++) {
+        printf("  %2d ", y + 1);
+        for (int x = 0; x < size; x++) {
+            char c = state->cells[y * size + x];
+            putchar(c == ' ' ? '.' : c);
+        }
+        putchar('\n');
+    }
+    for (int p = 0; p < playerCount; p++)
+        printf("  %s : %d\n", names[p], state->scores[p]);
+}
+
+// Position après le coup N, lue par l'index du fichier
+static int showMove(const char *filename, int moveIndex) {
+    RecordReader reader;
+    if (openRecordReader(&reader, filename) != 0)
+        return -1;
+    ReplayState state;
+    int status = recordReaderSeek(&reader, moveIndex, &state);
+    if (status != 0)
+        fprintf(stderr, "%s : coup %d absent (la partie compte %d coups)\n", filename, moveIndex,
+                reader.moveCount);
+    else
+        printState(&state, reader.names, reader.playerCount);
+    closeRecordReader(&reader);
+    return status;
+}
+
+/*
+ * Fonction : benchReplay
+ * ----------------------
+ * Charge toutes les parties puis les rejoue entièrement en mémoire, reps fois chacune.
+ *
+ * Retour :
+ *   0 en cas de succès, -1 si une partie ne peut pas être chargée ou rejouée.
+ */
+static int benchReplay(char **files, int fileCount, int reps) {
+    GameRecord *records = calloc(fileCount, sizeof(GameRecord));
+    if (!records) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return -1;
+    }
+    int loaded = 0, status = 0;
+    long moves = 0;
+    for (; loaded < fileCount && status == 0; loaded++) {
+        status = loadGameRecord(&records[loaded], files[loaded]);
+        moves += records[loaded].count;
+    }
+    long checksum = 0;
+    double start = nowNs();
+    for (int r = 0; r < reps && status == 0; r++) {
+        for (int i = 0; i < fileCount && status == 0; i++) {
+            ReplayState state;
+            status = replayTo(&records[i], records[i].count, &state);
+            checksum += state.scores[0];
+        }
+    }
+    double elapsed = nowNs() - start;
+    if (status == 0)
+        printf("%d parties, %ld coups, %d répétitions : %.0f ns par partie, %.1f ns par coup "
+               "(contrôle %ld)\n", fileCount, moves, reps, elapsed / ((double)fileCount * reps),
+               moves > 0 ? elapsed / ((double)moves * reps) : 0.0, checksum);
+    for (int i = 0; i < loaded; i++)
+        freeGameRecord(&records[i]);
+    free(records);
+    return status;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-g] [-n coup] [-b répétitions] fichier.scg...\n"
+            "  -g : export GCG sur la sortie standard\n"
+            "  -n : plateau et scores après le coup N (accès direct par l'index)\n"
+            "  -b : rejoue toutes les parties en mémoire et mesure le temps par partie\n",
+            prog);
+}
+
+// Fonction principale de l'outil de relecture
+int main(int argc, char *argv[]) {
+    bool gcg = false;
+    int moveIndex = -1;
+    int reps = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "gn:b:h")) != -1) {
+        switch (opt) {
+            case 'g': gcg = true; break;
+            case 'n': moveIndex = atoi(optarg); break;
+            case 'b': reps = atoi(optarg); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (reps > 0)
+        return benchReplay(&argv[optind], argc - optind, reps) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    int status = EXIT_SUCCESS;
+    for (int f = optind; f < argc; f++) {
+        if (moveIndex >= 0) {
+            if (showMove(argv[f], moveIndex) != 0)
+                status = EXIT_FAILURE;
+            continue;
+        }
+        GameRecord record;
+        if (loadGameRecord(&record, argv[f]) != 0) {
+            status = EXIT_FAILURE;
+            continue;
+        }
+        if (gcg) {
+            if (exportGCG(&record, stdout) != 0)
+                status = EXIT_FAILURE;
+        } else {
+            ReplayState state;
+            if (replayTo(&record, record.count, &state) != 0) {
+                fprintf(stderr, "%s : partie incohérente\n", argv[f]);
+                status = EXIT_FAILURE;
+            } else {
+                printf("%s : %d coups", argv[f], record.count);
+                for (int p = 0; p < record.playerCount; p++)
+                    printf(", %s %d", record.names[p], state.scores[p]);
+                printf("\n");
+            }
+        }
+        freeGameRecord(&record);
+    }
+    return status;
+}
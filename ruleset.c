@@ -0,0 +1,221 @@
+#include "ruleset.h"
+#include "movegen.h"
+
+//
+// ---------------------- Règles du jeu ---------------------------------------
+//
+
+const int bonusLetterMultiplier[BONUS_CODES] = { 1, 1, 1, 3, 2, 1, 4 };
+const int bonusWordMultiplier[BONUS_CODES] = { 1, 3, 2, 1, 1, 4, 1 };
+
+// Règles standard : valeurs françaises, 98 lettres sans joker
+const Ruleset standardRuleset = {
+    .name = "standard",
+    .boardSize = 15,
+    .rackSize = 7,
+    .bingoBonus = 50,
+    // 1 : mot compte triple, 2 : mot compte double, 3 : lettre compte triple, 4 : lettre compte double
+    .premium = {
+        {1, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 1},
+        {0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 2, 0},
+        {0, 0, 2, 0, 0, 0, 4, 0, 4, 0, 0, 0, 2, 0, 0},
+        {4, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 4},
+        {0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0},
+        {0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0},
+        {0, 0, 4, 0, 0, 0, 4, 0, 4, 0, 0, 0, 4, 0, 0},
+        {1, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0, 4, 0, 0, 1},
+        {0, 0, 4, 0, 0, 0, 4, 0, 4, 0, 0, 0, 4, 0, 0},
+        {0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0},
+        {0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0},
+        {4, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 4},
+        {0, 0, 2, 0, 0, 0, 4, 0, 4, 0, 0, 0, 2, 0, 0},
+        {0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 2, 0},
+        {1, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 1}
+    },
+    .counts = {
+        9, 2, 2, 4, 12, 2, 3, 2, 9, 1, 1, 4, 2,   // A .. M
+        6, 8, 2, 1, 6, 4, 6, 4, 2, 2, 1, 2, 1,    // N .. Z
+        0                                         // Joker
+    },
+    .tileCount = 98,
+    .tileValue = {
+        ['A'] = 1, ['B'] = 3, ['C'] = 3, ['D'] = 2, ['E'] = 1, ['F'] = 4, ['G'] = 2,
+        ['H'] = 4, ['I'] = 1, ['J'] = 8, ['K'] = 10, ['L'] = 1, ['M'] = 2, ['N'] = 1,
+        ['O'] = 1, ['P'] = 3, ['Q'] = 8, ['R'] = 1, ['S'] = 1, ['T'] = 1, ['U'] = 1,
+        ['V'] = 4, ['W'] = 10, ['X'] = 10, ['Y'] = 10, ['Z'] = 10
+    }
+};
+
+const Ruleset *currentRules = &standardRuleset;
+
+void useRuleset(const Ruleset *rules) {
+    currentRules = rules ? rules : &standardRuleset;
+    selectMoveGenKernels(currentRules->boardSize, false);
+}
+
+void initBonusBoard(BonusBoard bonusBoard) {
+    memcpy(bonusBoard, currentRules->premium, sizeof(BonusBoard));
+}
+
+// Code de bonus d'un caractère de la disposition ; -1 s'il est inconnu
+static int bonusCode(char c) {
+    switch (c) {
+        case '.': return BONUS_NONE;
+        case 'Q': return BONUS_QUADRUPLE_WORD;
+        case 'T': return BONUS_TRIPLE_WORD;
+        case 'D': return BONUS_DOUBLE_WORD;
+        case 'q': return BONUS_QUADRUPLE_LETTER;
+        case 't': return BONUS_TRIPLE_LETTER;
+        case 'd': return BONUS_DOUBLE_LETTER;
+        default:  return -1;
+    }
+}
+
+// Retire le commentaire et les blancs de fin de ligne
+static void trimLine(char *line) {
+    char *comment = strchr(line, '#');
+    if (comment)
+        *comment = '\0';
+    size_t len = strlen(line);
+    while (len > 0 && isspace((unsigned char)line[len - 1]))
+        line[--len] = '\0';
+}
+
+// Lit la disposition des bonus (boardSize lignes non vides) ; retourne 0, ou -1 en cas d'erreur
+static int readPremium(FILE *fp, Ruleset *rules, int *lineNumber) {
+    char line[256];
+    int y = 0;
+    while (y < rules->boardSize && fgets(line, sizeof(line), fp)) {
+        (*lineNumber)++;
+        trimLine(line);
+        const char *cells = line;
+        while (isspace((unsigned char)*cells))
+            cells++;
+        if (*cells == '\0')
+            continue;
+        if ((int)strlen(cells) != rules->boardSize)
+            return -1;
+        for (int x = 0; x < rules->boardSize; x++) {
+            int code = bonusCode(cells[x]);
+            if (code < 0)
+                return -1;
+            rules->premium[y][x] = code;
+        }
+        y++;
+    }
+    return (y == rules->boardSize) ? 0 : -1;
+}
+
+/*
+ * Fonction : loadRuleset
+ * ----------------------
+ * Charge un fichier de règles (format décrit dans ruleset.h). La taille du chevalet et la
+ * prime du scrabble valent par défaut celles des règles standard, comme la disposition des
+ * bonus d'un plateau 15 x 15 ; un plateau d'une autre taille doit décrire la sienne.
+ *
+ * Paramètre :
+ *   path : le fichier de règles.
+ *
+ * Retour :
+ *   Les règles (à libérer avec freeRuleset), ou NULL en cas d'erreur (message sur stderr).
+ */
+Ruleset *loadRuleset(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier de règles %s\n", path);
+        return NULL;
+    }
+    Ruleset *rules = calloc(1, sizeof(Ruleset));
+    if (!rules) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les règles.\n");
+        fclose(fp);
+        return NULL;
+    }
+    snprintf(rules->name, sizeof(rules->name), "%s", path);
+    rules->boardSize = standardRuleset.boardSize;
+    rules->rackSize = standardRuleset.rackSize;
+    rules->bingoBonus = standardRuleset.bingoBonus;
+
+    char line[256];
+    int lineNumber = 0;
+    bool havePremium = false;
+    const char *error = NULL;
+    while (!error && fgets(line, sizeof(line), fp)) {
+        lineNumber++;
+        trimLine(line);
+        char key[16], name[RULESET_NAME_SIZE];
+        char letter;
+        int value, count;
+        if (sscanf(line, "%15s", key) != 1)
+            continue;
+        if (strcmp(key, "nom") == 0) {
+            if (sscanf(line, " %*s %31[^\n]", name) != 1)
+                error = "nom manquant";
+            else
+                snprintf(rules->name, sizeof(rules->name), "%s", name);
+        } else if (strcmp(key, "plateau") == 0) {
+            if (sscanf(line, " %*s %d", &value) != 1 || value < 1 || value > BOARD_MAX_SIZE)
+                error = "taille de plateau invalide";
+            else if (havePremium && value != rules->boardSize)
+                error = "plateau redéfini après la disposition des bonus";
+            else
+                rules->boardSize = value;
+        } else if (strcmp(key, "chevalet") == 0) {
+            if (sscanf(line, " %*s %d", &value) != 1 || value < 1 || value > RULESET_MAX_RACK)
+                error = "taille de chevalet invalide";
+            else
+                rules->rackSize = value;
+        } else if (strcmp(key, "scrabble") == 0) {
+            if (sscanf(line, " %*s %d", &value) != 1 || value < 0)
+                error = "prime de scrabble invalide";
+            else
+                rules->bingoBonus = value;
+        } else if (strcmp(key, "lettre") == 0) {
+            if (sscanf(line, " %*s %c %d %d", &letter, &value, &count) != 3 ||
+                !isupper((unsigned char)letter) || value < 0 || value > INT8_MAX || count < 0)
+                error = "lettre invalide";
+            else {
+                rules->tileValue[(unsigned char)letter] = (int8_t)value;
+                rules->counts[letter - 'A'] = count;
+            }
+        } else if (strcmp(key, "joker") == 0) {
+            if (sscanf(line, " %*s %d %d", &value, &count) != 2 || value < 0 || value > INT8_MAX ||
+                count < 0)
+                error = "joker invalide";
+            else {
+                rules->tileValue['?'] = (int8_t)value;
+                for (char c = 'a'; c <= 'z'; c++)
+                    rules->tileValue[(unsigned char)c] = (int8_t)value;
+                rules->counts[LEAVE_BLANK] = count;
+            }
+        } else if (strcmp(key, "bonus") == 0) {
+            if (readPremium(fp, rules, &lineNumber) != 0)
+                error = "disposition des bonus invalide";
+            havePremium = true;
+        } else {
+            error = "directive inconnue";
+        }
+    }
+    fclose(fp);
+
+    if (!error && !havePremium) {
+        if (rules->boardSize == standardRuleset.boardSize)
+            memcpy(rules->premium, standardRuleset.premium, sizeof(BonusBoard));
+        else
+            error = "disposition des bonus manquante";
+    }
+    for (int i = 0; i < LEAVE_ALPHABET; i++)
+        rules->tileCount += rules->counts[i];
+    if (!error && rules->tileCount == 0)
+        error = "aucune lettre dans le sac";
+    if (error) {
+        fprintf(stderr, "Erreur dans le fichier de règles %s, ligne %d : %s\n", path, lineNumber, error);
+        free(rules);
+        return NULL;
+    }
+    return rules;
+}
+
+void freeRuleset(Ruleset *rules) {
+    free(rules);
+}
@@ -0,0 +1,80 @@
+#ifndef RULESET_H
+#define RULESET_H
+
+#include "scrabble.h"
+#include "leave.h"
+
+//
+// Règles du jeu
+//
+// Taille du plateau et disposition des cases bonus, taille du chevalet, prime du scrabble,
+// alphabet, valeur et nombre d'exemplaires de chaque lettre. Les règles en vigueur sont
+// globales au processus : elles sont choisies au démarrage (useRuleset), avant toute partie
+// et tout thread, puis seulement lues. Les règles standard sont en vigueur par défaut.
+// L'interface publique n'en dépend pas : chaque ScrabbleEngine porte ses propres règles et
+// les passe au générateur (generateMovesWithRules).
+//
+// Fichier de règles : une directive par ligne, '#' commence un commentaire.
+//   nom NOM                 nom des règles
+//   plateau N               taille du plateau (N x N, au plus BOARD_MAX_SIZE)
+//   chevalet N              lettres du chevalet (au plus RULESET_MAX_RACK)
+//   scrabble N              prime pour un coup qui pose tout le chevalet
+//   lettre L VALEUR NOMBRE  lettre de l'alphabet (A..Z), sa valeur et ses exemplaires
+//   joker VALEUR NOMBRE     jokers ('?' sur le chevalet, minuscule une fois posés)
+//   bonus                   suivi de N lignes de N cases : '.' aucun bonus, 'Q' mot compte
+//                           quadruple, 'T' mot compte triple, 'D' mot compte double,
+//                           'q' lettre compte quadruple, 't' lettre compte triple,
+//                           'd' lettre compte double
+// Une lettre absente du fichier ne fait pas partie de l'alphabet (aucun exemplaire).
+//
+
+#define RULESET_MAX_RACK 7
+#define RULESET_NAME_SIZE 32
+
+// Codes des cases bonus
+enum {
+    BONUS_NONE,
+    BONUS_TRIPLE_WORD,
+    BONUS_DOUBLE_WORD,
+    BONUS_TRIPLE_LETTER,
+    BONUS_DOUBLE_LETTER,
+    BONUS_QUADRUPLE_WORD,
+    BONUS_QUADRUPLE_LETTER,
+    BONUS_CODES
+};
+
+// Multiplicateurs de lettre et de mot de chaque code de bonus
+extern const int bonusLetterMultiplier[BONUS_CODES];
+extern const int bonusWordMultiplier[BONUS_CODES];
+
+typedef struct {
+    char name[RULESET_NAME_SIZE];
+    int boardSize;
+    int rackSize;
+    int bingoBonus;                      // Prime d'un coup posant tout le chevalet
+    BonusBoard premium;                  // Disposition des cases bonus (boardSize x boardSize)
+    int counts[LEAVE_ALPHABET];          // Exemplaires de chaque symbole ('A'..'Z', joker)
+    int tileCount;                       // Nombre total de lettres du sac complet
+    // Valeur d'une lettre indexée par son caractère : majuscule (lettre), minuscule (joker
+    // posé, valeur du joker), '?' (joker sur le chevalet) ; 0 pour tout autre caractère
+    int8_t tileValue[256];
+} Ruleset;
+
+// Règles standard (plateau 15 x 15, 98 lettres sans joker)
+extern const Ruleset standardRuleset;
+
+// Règles en vigueur
+extern const Ruleset *currentRules;
+
+// Charge un fichier de règles ; NULL en cas d'erreur (message sur stderr)
+Ruleset *loadRuleset(const char *path);
+void freeRuleset(Ruleset *rules);
+
+// Met des règles en vigueur (avant de créer les parties et les threads) et choisit les noyaux
+// de génération adaptés à la taille du plateau
+void useRuleset(const Ruleset *rules);
+
+// Copie la disposition des bonus des règles en vigueur (cases bonus d'une nouvelle partie)
+void initBonusBoard(BonusBoard bonusBoard);
+
+#endif  // RULESET_H
@@ -1,15 +1,15 @@
 #ifndef SCRABBLE_H
 #define SCRABBLE_H
 
+// En-tête commun du moteur : aucune dépendance à SDL (l'interface graphique inclut
+// SDL dans graphics.h), afin que le moteur puisse être compilé en bibliothèque.
+
 // Définition de la version POSIX
 #define _POSIX_C_SOURCE 200809L
 
-// Inclusion des bibliothèques SDL et TTF
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
-
 // Bibliothèques standards
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,50 +20,36 @@
 // UT_hash (pour le dictionnaire)
 #include "uthash.h"
 
-// Définition des constantes
-#define WINDOW_WIDTH      800
-#define WINDOW_HEIGHT     900
-
-#define BOARD_HEIGHT      800                        // Hauteur de la zone du plateau
-#define SCRABBLE_RACK_HEIGHT       50
-#define INPUT_AREA_HEIGHT (WINDOW_HEIGHT - BOARD_HEIGHT - SCRABBLE_RACK_HEIGHT)
-#define BOARD_MARGIN      50
-
-// Énumération pour l'état de saisie
-typedef enum {
-    STATE_IDLE,
-    STATE_INPUT_TEXT,
-    STATE_INPUT_DIRECTION
-} InputState;
-
 // Structure pour le dictionnaire (UT_hash)
 typedef struct {
     char word[100];  // La taille peut être adaptée
     UT_hash_handle hh;
 } DictionaryEntry;
 
+// Table des valeurs de reliquat (définie dans leave.h)
+typedef struct LeaveTable LeaveTable;
+
+// Taille maximale du plateau (21 x 21 du Super Scrabble) : la taille de la partie est celle
+// des règles (ruleset.h)
+#define BOARD_MAX_SIZE 21
+
+// Cases bonus d'une partie, indexées [y][x] (codes de bonus de ruleset.h, 0 : aucun)
+typedef int BonusBoard[BOARD_MAX_SIZE][BOARD_MAX_SIZE];
+
 // Prototypes de fonctions globales
 // (Vous pouvez les regrouper par module dans leurs fichiers respectifs, mais les déclarer ici
 //  permet d’avoir un point de référence commun pour les autres modules.)
 int getLetterScore(char letter);
 char drawRandomLetter(void);
 bool canPlaceWord(const char *word, int startX, int startY, char dir,
-                  char **board, int boardSize, const char *rack, int totalPoints);
+                  char **board, int boardSize, const char *rack, bool firstMove);
 void placeWord(const char *word, int startX, int startY, char dir,
                char **board, char *rack);
 int recalcTotalScore(char **board, int boardSize);
 bool validatePlacement(const char *word, int startX, int startY, char dir,
                        char **board, int boardSize, DictionaryEntry *dictionary);
 void findBestMove(char **board, int boardSize, DictionaryEntry *dictionary,
-                  char *rack, int *totalPoints, int bonusBoard[15][15]);
-
-// Prototypes pour le rendu graphique
-void drawGrid(SDL_Renderer *renderer, int boardSize, int boardDrawWidth, int boardDrawHeight);
-void drawBoard(SDL_Renderer *renderer, TTF_Font *boardFont, TTF_Font *valueFont,
-               char **board, int boardSize, int boardDrawWidth, int boardDrawHeight, int gridThickness);
-void drawRack(SDL_Renderer *renderer, TTF_Font *rackFont, TTF_Font *valueFont,
-              char *rack, int rackAreaWidth, int startXRack, int buttonMargin, int buttonWidth, int buttonHeight,
-              TTF_Font *inputFont);
-void drawInputArea(SDL_Renderer *renderer, TTF_Font *inputFont, InputState currentState, char *inputBuffer, int totalPoints);
+                  char *rack, int *totalPoints, BonusBoard bonusBoard,
+                  const LeaveTable *leaves);
 
 #endif  // SCRABBLE_H
@@ -0,0 +1,102 @@
+#ifndef SCRABBLE_ENGINE_H
+#define SCRABBLE_ENGINE_H
+
+//
+// Interface publique du moteur (libscrabble_engine.a / libscrabble_engine.so)
+//
+// Cet en-tête ne dépend ni de SDL ni des en-têtes internes du moteur : les structures
+// sont opaques et tout l'état passe par deux objets de contexte explicites.
+//   - ScrabbleEngine   : dictionnaire, arbre lexical, table de reliquats et règles (plateau,
+//                        bonus, valeurs et distribution des lettres ; standard par défaut,
+//                        ou chargées par scrabbleLoadRules avant de créer les positions).
+//                        En lecture seule ensuite, partageable entre threads.
+//   - ScrabblePosition : plateau, cases bonus restantes et tampons de génération, avec les
+//                        règles de son moteur. Un par thread.
+// Deux moteurs peuvent suivre des règles différentes dans le même processus. Le moteur ne lit
+// aucune donnée globale modifiable, sauf le choix des noyaux de génération imposé par les
+// outils de mesure (selectMoveGenKernels, interne, réglé avant tout thread).
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SCRABBLE_BOARD_SIZE 15   // Plateau des règles standard (taille du moteur : scrabbleBoardSize)
+#define SCRABBLE_RACK_SIZE  7    // Chevalet le plus grand accepté
+#define SCRABBLE_MAX_BOARD_SIZE 21   // Plateau le plus grand accepté par un fichier de règles
+#define SCRABBLE_MAX_WORD   (SCRABBLE_MAX_BOARD_SIZE + 1)   // Mot le plus long + '\0'
+
+typedef struct ScrabbleEngine ScrabbleEngine;
+typedef struct ScrabblePosition ScrabblePosition;
+
+// Coup proposé par le moteur
+typedef struct {
+    char word[SCRABBLE_MAX_WORD];  // Mot principal, lettres du plateau incluses
+    int x, y;                      // Case de la première lettre
+    char dir;                      // 'h' ou 'v'
+    int score;                     // Score complet (mots croisés et bonus de 50 points compris)
+    int tilesUsed;                 // Nombre de lettres posées depuis le rack
+    float equity;                  // Score + valeur du reliquat (score seul sans table)
+} ScrabbleMove;
+
+// Chargement du moteur : dictionnaire obligatoire, table de reliquats facultative (NULL)
+ScrabbleEngine *scrabbleEngineLoad(const char *dictionaryPath, const char *leavesPath);
+void scrabbleEngineFree(ScrabbleEngine *engine);
+
+// Règles du moteur : fichier de règles (NULL : règles standard) ; retourne 0, ou -1 en cas
+// d'erreur ou si des positions du moteur existent encore (les règles restent alors inchangées)
+int scrabbleLoadRules(ScrabbleEngine *engine, const char *path);
+int scrabbleBoardSize(const ScrabbleEngine *engine);
+int scrabbleRackSize(const ScrabbleEngine *engine);
+
+// Règles indépendantes de la position
+bool scrabbleIsWord(const ScrabbleEngine *engine, const char *word);
+int scrabbleLetterScore(const ScrabbleEngine *engine, char letter);
+// Exemplaires de la lettre ('?' : joker) dans le sac complet
+int scrabbleLetterCount(const ScrabbleEngine *engine, char letter);
+
+// Positions : plateau vide (taille des règles du moteur) et toutes les cases bonus à la création
+ScrabblePosition *scrabblePositionCreate(const ScrabbleEngine *engine);
+void scrabblePositionFree(ScrabblePosition *position);
+void scrabblePositionClear(ScrabblePosition *position);
+
+// Remplit une ligne (scrabbleBoardSize(engine) caractères, '.' ou ' ' pour une case vide, minuscule
+// pour un joker) ; les bonus des cases occupées sont considérés comme consommés. Retourne 0,
+// ou -1 si la ligne est invalide.
+int scrabblePositionSetRow(ScrabblePosition *position, int y, const char *letters);
+char scrabblePositionGet(const ScrabblePosition *position, int x, int y);
+
+// Les maxOut meilleurs coups du rack ('?' : joker, posé en minuscule dans le mot), triés par
+// équité décroissante ; retourne leur nombre
+int scrabbleGenerateMoves(ScrabblePosition *position, const char *rack,
+                          ScrabbleMove *out, int maxOut);
+
+// Pose un coup (obtenu par scrabbleGenerateMoves) et consomme les bonus des cases couvertes ;
+// retourne le nombre de lettres posées, -1 si le coup est incompatible avec le plateau
+int scrabblePlayMove(ScrabblePosition *position, const ScrabbleMove *move);
+
+// Coup analysé en fin de partie
+typedef struct {
+    ScrabbleMove move;         // Coup conseillé (mot vide : passer)
+    double winProbability;     // Probabilité de gain (sac vide : 1, 0,5 ou 0)
+    double expectedSpread;     // Écart final attendu (score du joueur - score adverse)
+    bool exact;                // Toutes les variantes ont été résolues jusqu'à la fin de partie
+} ScrabbleEndgameMove;
+
+// Lettres invisibles (sac + rack adverse) d'après le plateau et le rack du joueur
+int scrabbleUnseenTiles(const ScrabblePosition *position, const char *rack);
+
+// Fin de partie du rack pour l'écart actuel spread (score du joueur - score adverse). Sac vide
+// (l'adversaire tient toutes les lettres invisibles) : finale résolue, un coup. De 1 à
+// SCRABBLE_RACK_SIZE lettres dans le sac : les meilleurs coups évalués sur tous les tirages,
+// triés par probabilité de gain. budgetMs borne chaque finale résolue. Retourne le nombre de
+// coups écrits, 0 si le sac est plus plein (ou l'adversaire sans lettre), -1 en cas d'erreur
+int scrabbleSolveEndgame(ScrabblePosition *position, const char *rack, int spread,
+                         double budgetMs, ScrabbleEndgameMove *out, int maxOut);
+
+// Compteurs du moteur (dictionnaire, ancres, coups, durées par phase) du thread appelant
+// depuis son appel précédent, sur une ligne (texte ou JSON) ; -1 si la bibliothèque est
+// compilée sans instrumentation (make STATS=1 pour l'activer)
+int scrabbleStatsReport(char *buffer, size_t size, bool json);
+
+#endif  // SCRABBLE_ENGINE_H
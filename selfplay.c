@@ -0,0 +1,530 @@
+#include "board.h"            // Plateau, distribution des lettres et valeurs
+#include "dictionary.h"       // Chargement du dictionnaire
+#include "lexicon.h"          // Arbre lexical utilisé par le générateur
+#include "movegen.h"          // Génération de tous les coups légaux
+#include "bag.h"              // Sac de lettres reproductible
+#include "leave.h"            // Table des valeurs de reliquat
+#include "record.h"           // Enregistrement des parties jouées
+#include "stats.h"            // Compteurs d'instrumentation (SCRABBLE_STATS)
+#include "trace.h"            // Traces chronologiques (SCRABBLE_TRACE)
+
+#include <pthread.h>
+#include <unistd.h>
+
+//
+// ---------------------- Auto-apprentissage des reliquats --------------------
+//
+// Outil sans interface graphique : des parties complètes sont jouées en parallèle par le
+// moteur. Pour chaque coup joué alors que le sac n'est pas vide, on retient le reliquat
+// conservé et l'écart de points réalisé par la suite jusqu'à la fin de la partie. La valeur
+// d'un reliquat est la moyenne de cet écart, centrée sur la moyenne de tous les coups.
+//
+
+#define CHECKPOINT_MAGIC   "SCLC"
+#define CHECKPOINT_VERSION 1
+#define MAX_GAME_MOVES     256
+#define LEAVE_PRIOR        20.0   // Pseudo-observations qui ramènent les reliquats rares vers 0
+
+// Accumulateurs d'apprentissage (un jeu par thread, fusionnés à la fin de chaque époque)
+typedef struct {
+    double *sum;        // Somme des écarts futurs par rang de reliquat
+    uint32_t *count;    // Nombre d'observations par rang de reliquat
+    uint64_t games;
+    uint64_t moves;
+} LeaveStats;
+
+// Observation d'un coup : reliquat conservé et écart juste après le coup
+typedef struct {
+    int rank;
+    int player;
+    int spreadAfter;
+} Observation;
+
+// Travail confié à un thread pour une époque
+typedef struct {
+    const Lexicon *lexicon;
+    const LeaveTable *policy;   // Table utilisée pour choisir les coups (NULL : score seul)
+    uint64_t seed;
+    uint64_t firstGame;         // Indice global de la première partie du thread
+    uint64_t gameCount;         // Nombre de parties à jouer
+    uint64_t stride;            // Écart entre deux parties du thread (nombre de threads)
+    const char *recordDir;      // Répertoire des parties enregistrées (NULL : aucun)
+    LeaveStats stats;
+} Worker;
+
+static void freeStats(LeaveStats *stats) {
+    free(stats->sum);
+    free(stats->count);
+}
+
+static int allocStats(LeaveStats *stats) {
+    stats->sum = calloc(LEAVE_TABLE_SIZE, sizeof(double));
+    stats->count = calloc(LEAVE_TABLE_SIZE, sizeof(uint32_t));
+    stats->games = 0;
+    stats->moves = 0;
+    if (!stats->sum || !stats->count) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        freeStats(stats);
+        stats->sum = NULL;
+        stats->count = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+// Valeur des lettres restant sur un rack (pénalité de fin de partie)
+static int rackValue(const char *rack) {
+    int total = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        total += getLetterScore(rack[i]);
+    return total;
+}
+
+// Rang du reliquat conservé après un coup (-1 s'il dépasse LEAVE_MAX_TILES lettres)
+static int keptLeaveRank(const char *rack, int usedMask) {
+    int kept[RULESET_MAX_RACK];
+    int count = 0;
+    for (int i = 0; rack[i] != '\0'; i++) {
+        if (usedMask & (1 << i))
+            continue;
+        int s = leaveSymbol(rack[i]);
+        int j = count++;
+        while (j > 0 && kept[j - 1] > s) {
+            kept[j] = kept[j - 1];
+            j--;
+        }
+        kept[j] = s;
+    }
+    return (count <= LEAVE_MAX_TILES) ? leaveRank(kept, count) : -1;
+}
+
+/*
+ * Fonction : playGame
+ * -------------------
+ * Joue une partie complète entre deux joueurs pilotés par le moteur et ajoute ses
+ * observations aux accumulateurs du thread.
+ *
+ * Paramètres :
+ *   w         : le travail du thread (lexique, table de jeu, accumulateurs).
+ *   gameIndex : indice global de la partie (détermine la graine du sac).
+ *   board     : plateau de travail du thread.
+ *   bonus     : cases bonus du thread.
+ *   list      : liste de coups réutilisée d'un tour à l'autre.
+ *   record    : partie à compléter coup par coup (NULL : partie non enregistrée).
+ */
+static void playGame(Worker *w, uint64_t gameIndex, char **board, BonusBoard bonus, MoveList *list,
+                     GameRecord *record) {
+    Observation obs[MAX_GAME_MOVES];
+    int obsCount = 0;
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+    char racks[2][RULESET_MAX_RACK + 1] = { "", "" };
+    int scores[2] = { 0, 0 };
+    int scoreless = 0;
+    bool firstMove = true;
+    Bag bag;
+
+    int size = currentRules->boardSize;
+    for (int y = 0; y < size; y++)
+        memset(board[y], ' ', size);
+    bagInit(&bag, w->seed ^ (gameIndex * 0x9E3779B97F4A7C15ULL));
+    bagFillRack(&bag, racks[0]);
+    bagFillRack(&bag, racks[1]);
+
+    for (int p = 0, turn = 0; turn < MAX_GAME_MOVES; p ^= 1, turn++) {
+        char *rack = racks[p];
+        char rackBefore[RULESET_MAX_RACK + 1];
+        strcpy(rackBefore, rack);
+        if (w->policy)
+            leavePrepareRack(w->policy, rack, rackLeaves);
+        generateMoves(w->lexicon, board, size, bonus, rack, firstMove,
+                      w->policy ? rackLeaves : NULL, list);
+        int best = bestMoveIndex(list);
+
+        if (best >= 0) {
+            const Move *move = &list->moves[best];
+            scores[p] += move->score;
+            w->stats.moves++;
+            if (bag.total > 0) {
+                int rank = keptLeaveRank(rack, move->usedMask);
+                if (rank >= 0 && obsCount < MAX_GAME_MOVES) {
+                    obs[obsCount].rank = rank;
+                    obs[obsCount].player = p;
+                    obs[obsCount].spreadAfter = scores[p] - scores[p ^ 1];
+                    obsCount++;
+                }
+            }
+            char tiles[RECORD_RACK_SIZE];
+            if (record)
+                recordMoveTiles(board, move, tiles);
+            applyMove(board, move, rack);
+            int kept = strlen(rack);
+            bagFillRack(&bag, rack);
+            if (record)
+                recordPlay(record, p, rackBefore, move->x, move->y, move->dir, tiles, move->score,
+                           rack + kept);
+            firstMove = false;
+            scoreless = (move->score > 0) ? 0 : scoreless + 1;
+
+            // Le joueur a vidé son rack : il gagne la valeur du rack adverse
+            if (rack[0] == '\0') {
+                int remaining = rackValue(racks[p ^ 1]);
+                scores[p] += remaining;
+                scores[p ^ 1] -= remaining;
+                if (record) {
+                    recordEndRack(record, p, racks[p ^ 1], remaining);
+                    recordEndRack(record, p ^ 1, racks[p ^ 1], -remaining);
+                }
+                break;
+            }
+        } else {
+            // Aucun coup : échange complet si le sac le permet, sinon passe
+            if (bag.total >= currentRules->rackSize) {
+                char old[RULESET_MAX_RACK + 1];
+                strcpy(old, rack);
+                rack[0] = '\0';
+                bagFillRack(&bag, rack);
+                for (int i = 0; old[i] != '\0'; i++)
+                    bagReturn(&bag, old[i]);
+                if (record)
+                    recordExchange(record, p, old, old, rack);
+            } else if (record) {
+                recordPass(record, p, rack);
+            }
+            scoreless++;
+        }
+
+        // Six tours consécutifs sans points : chacun perd la valeur de son rack
+        if (scoreless >= 6) {
+            scores[0] -= rackValue(racks[0]);
+            scores[1] -= rackValue(racks[1]);
+            if (record) {
+                recordEndRack(record, 0, racks[0], -rackValue(racks[0]));
+                recordEndRack(record, 1, racks[1], -rackValue(racks[1]));
+            }
+            break;
+        }
+    }
+
+    // Écart obtenu après chaque coup observé, du point de vue de son auteur
+    for (int i = 0; i < obsCount; i++) {
+        int finalSpread = scores[obs[i].player] - scores[obs[i].player ^ 1];
+        w->stats.sum[obs[i].rank] += finalSpread - obs[i].spreadAfter;
+        w->stats.count[obs[i].rank]++;
+    }
+    w->stats.games++;
+
+    if (record) {
+        char filename[512];
+        snprintf(filename, sizeof(filename), "%s/partie-%08llu.scg", w->recordDir,
+                 (unsigned long long)gameIndex);
+        saveGameRecord(record, filename);
+    }
+}
+
+// Point d'entrée d'un thread : joue ses parties sans aucune synchronisation
+static void *workerMain(void *arg) {
+    Worker *w = arg;
+    traceSetThreadName("selfplay");
+    int size = currentRules->boardSize;
+    char **board = initBoard(size);
+    BonusBoard bonus;
+    MoveList list;
+    if (!board)
+        return NULL;
+    initBonusBoard(bonus);
+    initMoveList(&list);
+    GameRecord record;
+    initGameRecord(&record, 2, size);
+
+    for (uint64_t i = 0; i < w->gameCount; i++) {
+        record.count = 0;
+        playGame(w, w->firstGame + i * w->stride, board, bonus, &list,
+                 w->recordDir ? &record : NULL);
+    }
+
+    freeGameRecord(&record);
+    freeMoveList(&list);
+    freeBoard(board, size);
+    statsFlush();   // Compteurs du thread ajoutés aux totaux globaux
+    return NULL;
+}
+
+/*
+ * Fonction : mergeStats
+ * ---------------------
+ * Ajoute les accumulateurs d'un thread aux accumulateurs globaux puis les remet à zéro.
+ * Appelée par le thread principal une fois tous les threads de l'époque terminés.
+ */
+static void mergeStats(LeaveStats *global, LeaveStats *local) {
+    for (int r = 0; r < LEAVE_TABLE_SIZE; r++) {
+        if (local->count[r] == 0)
+            continue;
+        global->sum[r] += local->sum[r];
+        global->count[r] += local->count[r];
+        local->sum[r] = 0.0;
+        local->count[r] = 0;
+    }
+    global->games += local->games;
+    global->moves += local->moves;
+    local->games = 0;
+    local->moves = 0;
+}
+
+/*
+ * Fonction : saveCheckpoint
+ * -------------------------
+ * Écrit les accumulateurs globaux dans un fichier temporaire puis le renomme,
+ * de sorte qu'une interruption ne laisse jamais de point de reprise partiel.
+ */
+static int saveCheckpoint(const char *filename, const LeaveStats *stats, uint64_t seed) {
+    char tmpName[512];
+    snprintf(tmpName, sizeof(tmpName), "%s.tmp", filename);
+    FILE *fp = fopen(tmpName, "wb");
+    if (!fp) {
+        fprintf(stderr, "Erreur d'ouverture du fichier %s\n", tmpName);
+        return -1;
+    }
+    uint32_t version = CHECKPOINT_VERSION, size = LEAVE_TABLE_SIZE;
+    bool ok = fwrite(CHECKPOINT_MAGIC, 1, 4, fp) == 4 &&
+              fwrite(&version, sizeof(version), 1, fp) == 1 &&
+              fwrite(&size, sizeof(size), 1, fp) == 1 &&
+              fwrite(&seed, sizeof(seed), 1, fp) == 1 &&
+              fwrite(&stats->games, sizeof(stats->games), 1, fp) == 1 &&
+              fwrite(&stats->moves, sizeof(stats->moves), 1, fp) == 1 &&
+              fwrite(stats->sum, sizeof(double), LEAVE_TABLE_SIZE, fp) == LEAVE_TABLE_SIZE &&
+              fwrite(stats->count, sizeof(uint32_t), LEAVE_TABLE_SIZE, fp) == LEAVE_TABLE_SIZE;
+    if (fclose(fp) != 0)
+        ok = false;
+    if (!ok || rename(tmpName, filename) != 0) {
+        fprintf(stderr, "Erreur d'écriture du point de reprise %s\n", filename);
+        remove(tmpName);
+        return -1;
+    }
+    return 0;
+}
+
+// Recharge un point de reprise ; retourne 1 s'il a été chargé, 0 s'il n'existe pas, -1 s'il est
+// invalide (stats n'est alors pas modifié : la lecture se fait dans des accumulateurs provisoires)
+static int loadCheckpoint(const char *filename, LeaveStats *stats, uint64_t seed) {
+    FILE *fp = fopen(filename, "rb");
+    if (!fp)
+        return 0;
+    LeaveStats loaded;
+    if (allocStats(&loaded) != 0) {
+        fclose(fp);
+        return -1;
+    }
+    char magic[4];
+    uint32_t version = 0, size = 0;
+    uint64_t savedSeed = 0;
+    bool ok = fread(magic, 1, 4, fp) == 4 && memcmp(magic, CHECKPOINT_MAGIC, 4) == 0 &&
+              fread(&version, sizeof(version), 1, fp) == 1 && version == CHECKPOINT_VERSION &&
+              fread(&size, sizeof(size), 1, fp) == 1 && size == LEAVE_TABLE_SIZE &&
+              fread(&savedSeed, sizeof(savedSeed), 1, fp) == 1 && savedSeed == seed &&
+              fread(&loaded.games, sizeof(loaded.games), 1, fp) == 1 &&
+              fread(&loaded.moves, sizeof(loaded.moves), 1, fp) == 1 &&
+              fread(loaded.sum, sizeof(double), LEAVE_TABLE_SIZE, fp) == LEAVE_TABLE_SIZE &&
+              fread(loaded.count, sizeof(uint32_t), LEAVE_TABLE_SIZE, fp) == LEAVE_TABLE_SIZE;
+    fclose(fp);
+    if (!ok) {
+        fprintf(stderr, "Erreur : point de reprise invalide ou graine différente : %s\n", filename);
+        freeStats(&loaded);
+        return -1;
+    }
+    freeStats(stats);
+    *stats = loaded;
+    return 1;
+}
+
+/*
+ * Fonction : buildLeaveTable
+ * --------------------------
+ * Convertit les accumulateurs en table de reliquats : écart futur moyen de chaque reliquat,
+ * centré sur la moyenne globale et amorti par LEAVE_PRIOR pour les reliquats peu observés.
+ */
+static void buildLeaveTable(const LeaveStats *stats, LeaveTable *table) {
+    double totalSum = 0.0, totalCount = 0.0;
+    for (int r = 0; r < LEAVE_TABLE_SIZE; r++) {
+        totalSum += stats->sum[r];
+        totalCount += stats->count[r];
+    }
+    double mean = (totalCount > 0) ? totalSum / totalCount : 0.0;
+    for (int r = 0; r < LEAVE_TABLE_SIZE; r++)
+        table->values[r] = (float)((stats->sum[r] - stats->count[r] * mean) / (stats->count[r] + LEAVE_PRIOR));
+}
+
+static double elapsedSeconds(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-R règles] [-n parties] [-j threads] [-o table.bin]\n"
+            "          [-p politique.bin] [-c reprise] [-k parties_par_reprise] [-s graine]\n"
+            "          [-g répertoire]\n"
+            "  -R : fichier de règles (plateau, bonus, lettres), règles standard par défaut\n"
+            "  -g : enregistre chaque partie dans répertoire/partie-NNNNNNNN.scg\n",
+            prog);
+}
+
+// Fonction principale de l'outil d'auto-apprentissage
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *outputFile = "leaves.bin";
+    const char *policyFile = NULL;
+    const char *checkpointFile = "selfplay.ckpt";
+    uint64_t totalGames = 100000;
+    uint64_t gamesPerCheckpoint = 10000;
+    uint64_t seed = 1;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *recordDir = NULL;
+    const char *rulesFile = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:R:n:j:o:p:c:k:s:g:h")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'R': rulesFile = optarg; break;
+            case 'n': totalGames = strtoull(optarg, NULL, 10); break;
+            case 'j': threads = strtol(optarg, NULL, 10); break;
+            case 'o': outputFile = optarg; break;
+            case 'p': policyFile = optarg; break;
+            case 'c': checkpointFile = optarg; break;
+            case 'k': gamesPerCheckpoint = strtoull(optarg, NULL, 10); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            case 'g': recordDir = optarg; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (threads < 1)
+        threads = 1;
+    if (gamesPerCheckpoint < (uint64_t)threads)
+        gamesPerCheckpoint = threads;
+    Ruleset *rules = NULL;
+    if (rulesFile && !(rules = loadRuleset(rulesFile)))
+        return EXIT_FAILURE;
+    useRuleset(rules);
+
+    // Le dictionnaire n'est utile que pour construire l'arbre lexical partagé
+    DictionaryEntry *dictionary = loadDictionaryHash(dictionaryFile);
+    if (!dictionary)
+        return EXIT_FAILURE;
+    Lexicon *lexicon = buildLexicon(dictionary);
+    freeDictionaryHash(dictionary);
+    if (!lexicon)
+        return EXIT_FAILURE;
+
+    LeaveTable *policy = NULL;
+    if (policyFile && !(policy = loadLeaveTable(policyFile))) {
+        freeLexicon(lexicon);
+        return EXIT_FAILURE;
+    }
+
+    // Les accumulateurs non alloués restent à NULL : le nettoyage final vaut pour tous les cas
+    int status = EXIT_FAILURE;
+    LeaveStats global = { 0 };
+    Worker *workers = calloc(threads, sizeof(Worker));
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    bool *started = calloc(threads, sizeof(bool));
+    if (!workers || !tids || !started) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        goto cleanup;
+    }
+    if (allocStats(&global) != 0)
+        goto cleanup;
+    for (long t = 0; t < threads; t++) {
+        if (allocStats(&workers[t].stats) != 0)
+            goto cleanup;
+        workers[t].lexicon = lexicon;
+        workers[t].policy = policy;
+        workers[t].seed = seed;
+        workers[t].recordDir = recordDir;
+    }
+
+    // Un point de reprise illisible ou d'une autre graine arrête l'outil : il serait sinon
+    // écrasé par le premier point de reprise de cette exécution
+    int resumed = loadCheckpoint(checkpointFile, &global, seed);
+    if (resumed < 0) {
+        fprintf(stderr, "Supprimez %s ou reprenez avec sa graine.\n", checkpointFile);
+        goto cleanup;
+    }
+    if (resumed > 0)
+        printf("Reprise : %llu parties, %llu coups déjà joués\n",
+               (unsigned long long)global.games, (unsigned long long)global.moves);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t startMoves = global.moves;
+
+    // Chaque époque : les threads jouent sans se synchroniser, puis le thread principal fusionne
+    while (global.games < totalGames) {
+        uint64_t epoch = totalGames - global.games;
+        if (epoch > gamesPerCheckpoint)
+            epoch = gamesPerCheckpoint;
+        for (long t = 0; t < threads; t++) {
+            workers[t].firstGame = global.games + t;
+            workers[t].stride = threads;
+            workers[t].gameCount = epoch / threads + ((uint64_t)t < epoch % threads ? 1 : 0);
+            int err = pthread_create(&tids[t], NULL, workerMain, &workers[t]);
+            started[t] = err == 0;
+            if (err != 0)
+                fprintf(stderr, "Erreur : thread %ld non créé (%s), ses parties sont jouées par le "
+                        "thread principal\n", t, strerror(err));
+        }
+        // Les parties d'un thread non créé sont jouées ici : l'époque reste complète et les
+        // graines des parties ne changent pas
+        for (long t = 0; t < threads; t++)
+            if (!started[t])
+                workerMain(&workers[t]);
+        for (long t = 0; t < threads; t++) {
+            if (started[t])
+                pthread_join(tids[t], NULL);
+            mergeStats(&global, &workers[t].stats);
+        }
+        // Sans point de reprise, une interruption perdrait tout le travail : on s'arrête
+        if (saveCheckpoint(checkpointFile, &global, seed) != 0) {
+            fprintf(stderr, "Arrêt après %llu parties : point de reprise impossible à écrire.\n",
+                    (unsigned long long)global.games);
+            goto cleanup;
+        }
+
+        double seconds = elapsedSeconds(&start);
+        printf("%llu/%llu parties, %llu coups, %.0f coups/heure\n",
+               (unsigned long long)global.games, (unsigned long long)totalGames,
+               (unsigned long long)global.moves,
+               seconds > 0 ? (global.moves - startMoves) * 3600.0 / seconds : 0.0);
+        if (STATS_ENABLED) {
+            EngineStats totals;
+            char line[512];
+            statsGlobal(&totals);
+            statsFormat(&totals, false, line, sizeof(line));
+            printf("[Stats] %s\n", line);
+        }
+        fflush(stdout);
+    }
+
+    // Table finale au format lu par le jeu
+    LeaveTable *table = createLeaveTable();
+    if (table) {
+        buildLeaveTable(&global, table);
+        if (saveLeaveTable(table, outputFile) == 0) {
+            printf("Table de reliquats écrite dans %s\n", outputFile);
+            status = EXIT_SUCCESS;
+        }
+        freeLeaveTable(table);
+    }
+
+cleanup:
+    for (long t = 0; workers && t < threads; t++)
+        freeStats(&workers[t].stats);
+    freeStats(&global);
+    free(workers);
+    free(tids);
+    free(started);
+    freeLeaveTable(policy);
+    freeLexicon(lexicon);
+    freeRuleset(rules);
+    return status;
+}
@@ -0,0 +1,1368 @@
+#include "board.h"            // Plateau, cases bonus et valeurs des lettres
+#include "dictionary.h"       // Chargement du dictionnaire
+#include "lexicon.h"          // Arbre lexical partagé par toutes les parties
+#include "movegen.h"          // Génération de tous les coups légaux
+#include "bag.h"              // Sac de lettres reproductible
+#include "leave.h"            // Table des valeurs de reliquat
+#include "trace.h"            // Traces chronologiques (SCRABBLE_TRACE)
+#include "server.h"           // Protocole : trames, opérations et statuts
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//
+// ---------------------- Serveur de parties ----------------------------------
+//
+// Un seul thread gère toutes les connexions (epoll, sockets non bloquantes) et possède
+// l'état de toutes les parties : les lectures, écritures et modifications de partie se font
+// sans verrou. Les calculs coûteux (validation d'un coup par le générateur, coup du moteur,
+// conseil) sont confiés à un groupe de threads. Chaque calcul emporte une copie du plateau
+// et du rack ; son résultat revient à la boucle par une file protégée par un verrou et un
+// eventfd, et n'est appliqué que si la partie n'a pas changé entre-temps (version).
+//
+// Les parties occupent des cases de taille fixe d'un réservoir alloué au démarrage, et les
+// calculs des cases d'un second réservoir : ni allocation par partie, ni par requête. Le
+// dictionnaire n'est chargé qu'une fois et partagé en lecture seule par tous les threads.
+//
+// Les réponses d'une connexion s'accumulent dans une file de blocs de taille fixe, recyclés
+// d'une connexion à l'autre ; à la fin de chaque tour de boucle, toute la file part en un
+// seul appel writev. Des requêtes envoyées à la suite sont ainsi lues, traitées et répondues
+// par lots, et une trame BATCH ne coûte qu'un en-tête pour toutes ses requêtes.
+//
+
+#define SERVER_DEFAULT_SOCKET      "scrabble.sock"
+#define SERVER_DEFAULT_GAMES       8192
+#define SERVER_MAX_GAMES           65536       // L'indice d'une case tient sur 16 bits
+#define SERVER_DEFAULT_CONNECTIONS 1024
+#define SERVER_MAX_JOBS            1024        // Calculs en attente ou en cours
+#define SERVER_MAX_BACKLOG         (1 << 20)   // Réponses non envoyées au-delà desquelles on cesse de lire
+#define SERVER_MAX_EVENTS          256
+#define SERVER_MAX_THREADS         256
+#define SERVER_OUT_BLOCK           16384       // Taille d'un bloc de sortie
+#define SERVER_MAX_FREE_BLOCKS     1024        // Blocs libres conservés pour être recyclés
+#define SERVER_MAX_IOV             64          // Blocs envoyés par appel à writev
+#define SERVER_MAX_BATCH           (SERVER_MAX_FRAME / 3)   // Requêtes d'une trame BATCH
+#define SERVER_PAYLOAD_MAX         (SERVER_CELLS + 32)      // Données d'une réponse immédiate
+#define SERVER_CELLS               (SERVER_BOARD_SIZE * SERVER_BOARD_SIZE)
+
+// Étiquettes epoll des deux descripteurs qui ne sont pas des connexions
+#define TAG_LISTEN UINT64_MAX
+#define TAG_WAKEUP (UINT64_MAX - 1)
+
+// Statut interne : la requête a été confiée aux threads, finishJob y répondra
+#define STATUS_PENDING 0xFF
+
+// Partie : case du réservoir, modifiée uniquement par la boucle d'événements
+typedef struct {
+    uint32_t id;                 // (génération << 16) | indice de la case ; 0 : case libre
+    uint32_t version;            // Incrémentée à chaque tour joué
+    int nextFree;                // Case libre suivante (-1 : fin de la liste)
+    int player;                  // Joueur au trait
+    int turn;
+    int scoreless;               // Tours consécutifs sans points
+    bool over;
+    int scores[2];
+    char racks[2][8];
+    char cells[SERVER_CELLS];    // cells[y * 15 + x], ' ' : case vide
+    Bag bag;
+} Game;
+
+// Calcul confié aux threads : copie de la position et résultat
+typedef struct Job {
+    struct Job *next;
+    uint8_t op;                  // SERVER_PLAY, SERVER_ENGINE_MOVE ou SERVER_HINT
+    uint32_t requestId;
+    int conn;
+    uint64_t connSerial;
+    uint32_t game;
+    uint32_t version;            // Version de la partie au lancement du calcul
+    bool firstMove;
+    int topK;
+    char rack[8];
+    char cells[SERVER_CELLS];
+    Move wanted;                 // SERVER_PLAY : coup proposé par le client
+    int count;                   // Coups trouvés
+    Move moves[SERVER_MAX_HINTS];
+} Job;
+
+// Bloc de la file de sortie d'une connexion
+typedef struct OutBlock {
+    struct OutBlock *next;
+    size_t len;                  // Octets écrits dans le bloc
+    size_t pos;                  // Octets déjà envoyés
+    unsigned char data[SERVER_OUT_BLOCK];
+} OutBlock;
+
+typedef struct {
+    int fd;                      // -1 : case libre
+    uint64_t serial;             // Distingue deux connexions successives sur la même case
+    uint32_t events;             // Événements epoll demandés
+    bool dirty;                  // Des réponses attendent d'être envoyées
+    size_t inLen;
+    unsigned char in[4 + SERVER_MAX_FRAME];
+    OutBlock *outHead, *outTail;
+    size_t backlog;              // Octets de réponse pas encore envoyés
+} Connection;
+
+// Requête d'une trame BATCH (les données pointent dans le tampon d'entrée)
+typedef struct {
+    uint8_t op;
+    uint8_t status;              // VALIDATE : statut calculé avant le parcours du dictionnaire
+    bool valid;
+    size_t len;
+    const unsigned char *data;
+} BatchItem;
+
+// Mot à valider d'un lot, normalisé, avec l'indice de sa requête
+typedef struct {
+    char word[SERVER_WORD_SIZE];
+    int item;
+} BatchWord;
+
+typedef struct {
+    const Lexicon *lexicon;
+    const LeaveTable *leaves;
+    int epfd, listenFd, wakeFd;
+
+    Game *games;
+    int maxGames;
+    int freeGame;                // Première case libre (-1 : réservoir plein)
+    int activeGames;
+    uint16_t generation;
+    uint64_t nextSeed;
+
+    Connection *conns;
+    int maxConns;
+    int *freeConns;              // Pile des cases de connexion libres
+    int freeConnCount;
+    int *dirty;                  // Connexions ayant des réponses à envoyer
+    int dirtyCount;
+    uint64_t nextSerial;
+    OutBlock *freeBlocks;
+    int freeBlockCount;
+
+    // Tampons de travail des trames BATCH (boucle d'événements seulement)
+    BatchItem *batchItems;
+    BatchWord *batchWords;
+    const char **batchKeys;
+    bool *batchFound;
+    unsigned char *batchOut;
+
+    Job *jobs;
+    Job *freeJobs;               // Réservoir des calculs (boucle d'événements seulement)
+
+    // File des calculs à faire et des calculs terminés, partagée avec les threads
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    Job *queueHead, *queueTail;
+    Job *done;
+    bool stopping;
+
+    uint64_t requests;
+    uint64_t computed;
+} Server;
+
+// Contexte d'un thread de calcul
+typedef struct {
+    Server *server;
+    char **board;
+    BonusBoard bonus;
+    MoveList list;
+    float rackLeaves[LEAVE_RACK_SUBSETS];
+} Worker;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int sig) {
+    (void)sig;
+    stopRequested = 1;
+}
+
+//
+// Encodage
+//
+
+// Entier non signé de size octets, en petit-boutiste
+static uint64_t getLittle(const unsigned char *p, int size) {
+    uint64_t value = 0;
+    for (int i = size - 1; i >= 0; i--)
+        value = (value << 8) | p[i];
+    return value;
+}
+
+static void putLittle(unsigned char *p, uint64_t value, int size) {
+    for (int i = 0; i < size; i++)
+        p[i] = (unsigned char)(value >> (8 * i));
+}
+
+// Coup sur SERVER_MOVE_SIZE octets (mot vide : échange ou passe)
+static size_t encodeMove(unsigned char *p, const Move *move) {
+    memset(p, 0, SERVER_WORD_SIZE);
+    memcpy(p, move->word, strnlen(move->word, SERVER_WORD_SIZE - 1));
+    p[16] = (unsigned char)move->x;
+    p[17] = (unsigned char)move->y;
+    p[18] = (unsigned char)move->dir;
+    p[19] = (unsigned char)move->tilesUsed;
+    putLittle(p + 20, (uint16_t)move->score, 2);
+    uint32_t bits;
+    memcpy(&bits, &move->equity, sizeof(bits));
+    putLittle(p + 22, bits, 4);
+    return SERVER_MOVE_SIZE;
+}
+
+//
+// Parties
+//
+
+// Valeur des lettres restant sur un rack (pénalité de fin de partie)
+static int rackValue(const char *rack) {
+    int total = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+        total += getLetterScore(rack[i]);
+    return total;
+}
+
+static Game *findGame(Server *s, uint32_t id) {
+    uint32_t index = id & 0xFFFF;
+    if (id == 0 || index >= (uint32_t)s->maxGames || s->games[index].id != id)
+        return NULL;
+    return &s->games[index];
+}
+
+// Prend une case libre et commence une partie (NULL si le réservoir est plein)
+static Game *newGame(Server *s, uint64_t seed) {
+    if (s->freeGame < 0)
+        return NULL;
+    int index = s->freeGame;
+    Game *g = &s->games[index];
+    s->freeGame = g->nextFree;
+    if (++s->generation == 0)
+        s->generation = 1;
+    g->id = ((uint32_t)s->generation << 16) | (uint32_t)index;
+    g->version = 0;
+    g->player = 0;
+    g->turn = 0;
+    g->scoreless = 0;
+    g->over = false;
+    g->scores[0] = g->scores[1] = 0;
+    g->racks[0][0] = g->racks[1][0] = '\0';
+    memset(g->cells, ' ', sizeof(g->cells));
+    bagInit(&g->bag, seed);
+    bagFillRack(&g->bag, g->racks[0]);
+    bagFillRack(&g->bag, g->racks[1]);
+    s->activeGames++;
+    return g;
+}
+
+static void closeGame(Server *s, Game *g) {
+    g->id = 0;
+    g->nextFree = s->freeGame;
+    s->freeGame = (int)(g - s->games);
+    s->activeGames--;
+}
+
+static bool boardEmpty(const Game *g) {
+    for (int i = 0; i < SERVER_CELLS; i++)
+        if (g->cells[i] != ' ')
+            return false;
+    return true;
+}
+
+// Passe la main ; six tours consécutifs sans points terminent la partie
+static void endTurn(Game *g, int points) {
+    g->scoreless = (points > 0) ? 0 : g->scoreless + 1;
+    if (!g->over && g->scoreless >= 6) {
+        g->scores[0] -= rackValue(g->racks[0]);
+        g->scores[1] -= rackValue(g->racks[1]);
+        g->over = true;
+    }
+    g->player ^= 1;
+    g->turn++;
+    g->version++;
+}
+
+// Joue un coup calculé sur une copie de la partie à la même version
+static void playMove(Game *g, const Move *move) {
+    char *rows[SERVER_BOARD_SIZE];
+    for (int y = 0; y < SERVER_BOARD_SIZE; y++)
+        rows[y] = &g->cells[y * SERVER_BOARD_SIZE];
+    int p = g->player;
+    char *rack = g->racks[p];
+    applyMove(rows, move, rack);
+    bagFillRack(&g->bag, rack);
+    g->scores[p] += move->score;
+
+    // Le joueur a vidé son rack : il gagne la valeur du rack adverse
+    if (rack[0] == '\0') {
+        int remaining = rackValue(g->racks[p ^ 1]);
+        g->scores[p] += remaining;
+        g->scores[p ^ 1] -= remaining;
+        g->over = true;
+    }
+    endTurn(g, move->score);
+}
+
+// Échange des lettres du joueur au trait ; retourne false si l'échange est impossible
+static bool exchangeTiles(Game *g, const char *tiles) {
+    char wanted[8], kept[8];
+    snprintf(wanted, sizeof(wanted), "%s", tiles);
+    strcpy(kept, g->racks[g->player]);
+    if (wanted[0] == '\0' || g->bag.total < currentRules->rackSize)
+        return false;
+    for (int i = 0; wanted[i] != '\0'; i++) {
+        wanted[i] = toupper((unsigned char)wanted[i]);
+        char *found = strchr(kept, wanted[i]);
+        if (!found)
+            return false;
+        memmove(found, found + 1, strlen(found));
+    }
+    char *rack = g->racks[g->player];
+    strcpy(rack, kept);
+    bagFillRack(&g->bag, rack);
+    for (int i = 0; wanted[i] != '\0'; i++)
+        bagReturn(&g->bag, wanted[i]);
+    endTurn(g, 0);
+    return true;
+}
+
+//
+// Connexions
+//
+
+static void releaseBlock(Server *s, OutBlock *b) {
+    if (s->freeBlockCount >= SERVER_MAX_FREE_BLOCKS) {
+        free(b);
+        return;
+    }
+    b->next = s->freeBlocks;
+    s->freeBlocks = b;
+    s->freeBlockCount++;
+}
+
+static void closeConnection(Server *s, int ci) {
+    Connection *c = &s->conns[ci];
+    epoll_ctl(s->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    c->fd = -1;
+    c->inLen = 0;
+    while (c->outHead) {
+        OutBlock *b = c->outHead;
+        c->outHead = b->next;
+        releaseBlock(s, b);
+    }
+    c->outTail = NULL;
+    c->backlog = 0;
+    s->freeConns[s->freeConnCount++] = ci;
+}
+
+// Lecture tant que les réponses en attente restent sous SERVER_MAX_BACKLOG et que le tampon
+// d'entrée a de la place (sinon EPOLLIN, déclenché par niveau, reviendrait sans fin), écriture
+// tant qu'il reste des réponses
+static void updateEvents(Server *s, int ci) {
+    Connection *c = &s->conns[ci];
+    bool readable = c->backlog < SERVER_MAX_BACKLOG && c->inLen < sizeof(c->in);
+    uint32_t events = (readable ? EPOLLIN : 0) | (c->backlog > 0 ? EPOLLOUT : 0);
+    if (events == c->events)
+        return;
+    struct epoll_event ev = { .events = events, .data.u64 = (uint64_t)ci };
+    if (epoll_ctl(s->epfd, EPOLL_CTL_MOD, c->fd, &ev) == 0)
+        c->events = events;
+}
+
+static void markDirty(Server *s, int ci) {
+    if (!s->conns[ci].dirty) {
+        s->conns[ci].dirty = true;
+        s->dirty[s->dirtyCount++] = ci;
+    }
+}
+
+// Ajoute des octets à la file de sortie ; retourne -1 si aucun bloc ne peut être alloué
+static int appendOutput(Server *s, Connection *c, const unsigned char *data, size_t len) {
+    while (len > 0) {
+        OutBlock *b = c->outTail;
+        if (!b || b->len == SERVER_OUT_BLOCK) {
+            if ((b = s->freeBlocks)) {
+                s->freeBlocks = b->next;
+                s->freeBlockCount--;
+            } else if (!(b = malloc(sizeof(OutBlock)))) {
+                fprintf(stderr, "Erreur d'allocation mémoire.\n");
+                return -1;
+            }
+            b->next = NULL;
+            b->len = b->pos = 0;
+            if (c->outTail)
+                c->outTail->next = b;
+            else
+                c->outHead = b;
+            c->outTail = b;
+        }
+        size_t n = SERVER_OUT_BLOCK - b->len;
+        if (n > len)
+            n = len;
+        memcpy(b->data + b->len, data, n);
+        b->len += n;
+        data += n;
+        len -= n;
+        c->backlog += n;
+    }
+    return 0;
+}
+
+// Ajoute une réponse à la file de sortie ; elle sera envoyée à la fin du tour de boucle
+static void sendResponse(Server *s, int ci, uint32_t requestId, uint8_t op, uint8_t status,
+                         const unsigned char *payload, size_t len) {
+    Connection *c = &s->conns[ci];
+    unsigned char header[SERVER_RESPONSE_HEADER];
+    putLittle(header, SERVER_RESPONSE_HEADER - 4 + len, 4);
+    putLittle(header + 4, requestId, 4);
+    header[8] = op;
+    header[9] = status;
+    if (appendOutput(s, c, header, sizeof(header)) != 0 || appendOutput(s, c, payload, len) != 0) {
+        closeConnection(s, ci);
+        return;
+    }
+    markDirty(s, ci);
+}
+
+static void processInput(Server *s, int ci);
+
+// Envoie la file de sortie, jusqu'à SERVER_MAX_IOV blocs par appel à writev ; si la sortie
+// repasse sous SERVER_MAX_BACKLOG, reprend les trames laissées en attente par la saturation
+static void flushConnection(Server *s, int ci) {
+    Connection *c = &s->conns[ci];
+    while (c->backlog > 0) {
+        struct iovec iov[SERVER_MAX_IOV];
+        int count = 0;
+        for (OutBlock *b = c->outHead; b && count < SERVER_MAX_IOV; b = b->next, count++) {
+            iov[count].iov_base = b->data + b->pos;
+            iov[count].iov_len = b->len - b->pos;
+        }
+        ssize_t n = writev(c->fd, iov, count);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (n <= 0) {
+            closeConnection(s, ci);
+            return;
+        }
+        c->backlog -= n;
+        while (n > 0) {
+            OutBlock *b = c->outHead;
+            size_t left = b->len - b->pos;
+            if ((size_t)n < left) {
+                b->pos += n;
+                break;
+            }
+            n -= left;
+            c->outHead = b->next;
+            releaseBlock(s, b);
+        }
+        if (!c->outHead)
+            c->outTail = NULL;
+    }
+    if (c->backlog < SERVER_MAX_BACKLOG && c->inLen > 0) {
+        processInput(s, ci);
+        if (c->fd < 0)
+            return;
+    }
+    updateEvents(s, ci);
+}
+
+//
+// Requêtes
+//
+
+// Confie un calcul aux threads ; retourne STATUS_PENDING, ou SERVER_BUSY si le réservoir
+// de calculs est épuisé
+static uint8_t submitJob(Server *s, int ci, uint32_t requestId, uint8_t op, const Game *g,
+                         int topK, const Move *wanted) {
+    Job *job = s->freeJobs;
+    if (!job)
+        return SERVER_BUSY;
+    s->freeJobs = job->next;
+    job->next = NULL;
+    job->op = op;
+    job->requestId = requestId;
+    job->conn = ci;
+    job->connSerial = s->conns[ci].serial;
+    job->game = g->id;
+    job->version = g->version;
+    job->firstMove = boardEmpty(g);
+    job->topK = topK;
+    strcpy(job->rack, g->racks[g->player]);
+    memcpy(job->cells, g->cells, sizeof(job->cells));
+    if (wanted)
+        job->wanted = *wanted;
+    job->count = 0;
+
+    pthread_mutex_lock(&s->lock);
+    if (s->queueTail)
+        s->queueTail->next = job;
+    else
+        s->queueHead = job;
+    s->queueTail = job;
+    pthread_cond_signal(&s->ready);
+    pthread_mutex_unlock(&s->lock);
+    return STATUS_PENDING;
+}
+
+// Coup proposé par le client : x, y, dir, mot (16 octets) ; false si les champs sont invalides
+static bool parseMove(const unsigned char *data, size_t n, Move *move) {
+    if (n < 3 + SERVER_WORD_SIZE || (data[2] != 'h' && data[2] != 'v') ||
+        data[0] >= SERVER_BOARD_SIZE || data[1] >= SERVER_BOARD_SIZE)
+        return false;
+    memset(move, 0, sizeof(*move));
+    move->x = data[0];
+    move->y = data[1];
+    move->dir = (char)data[2];
+    memcpy(move->word, data + 3, SERVER_WORD_SIZE - 1);
+    for (int i = 0; move->word[i] != '\0'; i++)
+        move->word[i] = toupper((unsigned char)move->word[i]);
+    return true;
+}
+
+/*
+ * Fonction : checkPlacement
+ * -------------------------
+ * Vérifie qu'un mot peut être posé par le joueur au trait, sans le jouer ni générer les
+ * coups : mot entier dans le plateau et non prolongé par des lettres posées, lettres du
+ * plateau respectées, au moins une lettre posée et toutes présentes dans le rack, mot relié
+ * aux lettres existantes (case centrale au premier coup), mot principal et mots croisés
+ * présents dans le lexique. Les jokers ne sont pas utilisés, comme dans le générateur.
+ *
+ * Paramètres :
+ *   s     : le serveur (lexique).
+ *   g     : la partie.
+ *   move  : le mot (lettres du plateau comprises), sa première case et sa direction.
+ *   score : reçoit le score du coup (mots croisés et bonus de 50 points compris).
+ *
+ * Retour :
+ *   true si la pose est légale, false sinon.
+ */
+static bool checkPlacement(const Server *s, const Game *g, const Move *move, int *score) {
+    int len = strlen(move->word);
+    int dx = (move->dir == 'h'), dy = !dx;
+    int endX = move->x + dx * (len - 1), endY = move->y + dy * (len - 1);
+    *score = 0;
+    if (len < 2 || endX >= SERVER_BOARD_SIZE || endY >= SERVER_BOARD_SIZE)
+        return false;
+    if ((move->x - dx >= 0 && move->y - dy >= 0 &&
+         g->cells[(move->y - dy) * SERVER_BOARD_SIZE + move->x - dx] != ' ') ||
+        (endX + dx < SERVER_BOARD_SIZE && endY + dy < SERVER_BOARD_SIZE &&
+         g->cells[(endY + dy) * SERVER_BOARD_SIZE + endX + dx] != ' '))
+        return false;
+
+    int counts[26] = { 0 };
+    for (const char *r = g->racks[g->player]; *r != '\0'; r++)
+        if (*r >= 'A' && *r <= 'Z')
+            counts[*r - 'A']++;
+
+    bool firstMove = boardEmpty(g), connected = false, center = false;
+    int placed = 0, mainSum = 0, mainMult = 1, crossTotal = 0;
+    for (int i = 0; i < len; i++) {
+        int x = move->x + dx * i, y = move->y + dy * i;
+        char c = move->word[i];
+        char cell = g->cells[y * SERVER_BOARD_SIZE + x];
+        if (c < 'A' || c > 'Z')
+            return false;
+        if (cell != ' ') {
+            if (cell != c)
+                return false;
+            mainSum += getLetterScore(c);
+            connected = true;
+            continue;
+        }
+        if (counts[c - 'A']-- == 0)
+            return false;
+        placed++;
+        if (x == SERVER_BOARD_SIZE / 2 && y == SERVER_BOARD_SIZE / 2)
+            center = true;
+        int bonus = currentRules->premium[y][x];
+        int letter = getLetterScore(c) * bonusLetterMultiplier[bonus];
+        int wordMult = bonusWordMultiplier[bonus];
+        mainSum += letter;
+        mainMult *= wordMult;
+
+        // Mot croisé passant par la lettre posée (direction perpendiculaire)
+        int cx = x, cy = y;
+        while (cx - dy >= 0 && cy - dx >= 0 && g->cells[(cy - dx) * SERVER_BOARD_SIZE + cx - dy] != ' ') {
+            cx -= dy;
+            cy -= dx;
+        }
+        char cross[SERVER_BOARD_SIZE + 1];
+        int crossLen = 0, crossSum = 0;
+        for (; cx < SERVER_BOARD_SIZE && cy < SERVER_BOARD_SIZE; cx += dy, cy += dx) {
+            char d = (cx == x && cy == y) ? c : g->cells[cy * SERVER_BOARD_SIZE + cx];
+            if (d == ' ')
+                break;
+            if (!(cx == x && cy == y))
+                crossSum += getLetterScore(d);
+            cross[crossLen++] = d;
+        }
+        if (crossLen > 1) {
+            cross[crossLen] = '\0';
+            if (!lexiconContains(s->lexicon, cross))
+                return false;
+            crossTotal += (crossSum + letter) * wordMult;
+            connected = true;
+        }
+    }
+    if (placed == 0 || (firstMove ? !center : !connected) || !lexiconContains(s->lexicon, move->word))
+        return false;
+    *score = mainSum * mainMult + crossTotal + (placed == currentRules->rackSize ? currentRules->bingoBonus : 0);
+    return true;
+}
+
+/*
+ * Fonction : runRequest
+ * ---------------------
+ * Exécute une requête. Les opérations immédiates écrivent leurs données de réponse dans
+ * payload ; le coup joué, le coup du moteur et le conseil sont confiés aux threads.
+ *
+ * Paramètres :
+ *   s         : le serveur.
+ *   ci        : la connexion qui attend la réponse, ou -1 pour une requête d'une trame BATCH
+ *               (les calculs y sont refusés).
+ *   requestId : l'identifiant de la requête.
+ *   op        : l'opération.
+ *   data, n   : les données de la requête.
+ *   payload   : reçoit les données de la réponse (au moins SERVER_PAYLOAD_MAX octets).
+ *   out       : reçoit la longueur des données de la réponse.
+ *
+ * Retour :
+ *   Le statut de la réponse, ou STATUS_PENDING si la requête a été confiée aux threads.
+ */
+static uint8_t runRequest(Server *s, int ci, uint32_t requestId, uint8_t op,
+                          const unsigned char *data, size_t n, unsigned char *payload, size_t *out) {
+    *out = 0;
+    if (op == SERVER_NEW_GAME) {
+        uint64_t seed = (n >= 8) ? getLittle(data, 8) : s->nextSeed++ * 0x9E3779B97F4A7C15ULL;
+        Game *g = newGame(s, seed);
+        if (!g)
+            return SERVER_FULL;
+        putLittle(payload, g->id, 4);
+        *out = 4;
+        return SERVER_OK;
+    }
+    if (op == SERVER_VALIDATE) {
+        char word[SERVER_WORD_SIZE];
+        if (n == 0 || n >= sizeof(word))
+            return SERVER_BAD_REQUEST;
+        memcpy(word, data, n);
+        word[n] = '\0';
+        payload[0] = strlen(word) == n && lexiconContains(s->lexicon, word);
+        *out = 1;
+        return SERVER_OK;
+    }
+    if (op < SERVER_NEW_GAME || op > SERVER_CHECK || n < 4)
+        return SERVER_BAD_REQUEST;
+
+    // Toutes les autres opérations commencent par l'identifiant de la partie
+    Game *g = findGame(s, (uint32_t)getLittle(data, 4));
+    if (!g)
+        return SERVER_UNKNOWN_GAME;
+    data += 4;
+    n -= 4;
+    bool mutating = (op == SERVER_PLAY || op == SERVER_EXCHANGE || op == SERVER_ENGINE_MOVE);
+    if (mutating && g->over)
+        return SERVER_GAME_OVER;
+
+    Move move;
+    switch (op) {
+        case SERVER_CLOSE_GAME:
+            closeGame(s, g);
+            return SERVER_OK;
+
+        case SERVER_PLAY:
+            if (!parseMove(data, n, &move))
+                return SERVER_BAD_REQUEST;
+            if (move.word[0] != '\0')
+                return (ci >= 0) ? submitJob(s, ci, requestId, op, g, 0, &move) : SERVER_BAD_REQUEST;
+            // Mot vide : le joueur passe
+            endTurn(g, 0);
+            *out = encodeMove(payload, &move);
+            payload[(*out)++] = g->over;
+            return SERVER_OK;
+
+        case SERVER_EXCHANGE: {
+            if (n < 8)
+                return SERVER_BAD_REQUEST;
+            char tiles[8];
+            memcpy(tiles, data, 7);
+            tiles[7] = '\0';
+            if (!exchangeTiles(g, tiles))
+                return SERVER_ILLEGAL;
+            payload[0] = g->over;
+            *out = 1;
+            return SERVER_OK;
+        }
+
+        case SERVER_ENGINE_MOVE:
+            return (ci >= 0) ? submitJob(s, ci, requestId, op, g, 1, NULL) : SERVER_BAD_REQUEST;
+
+        case SERVER_HINT:
+            if (ci < 0 || n < 1 || data[0] == 0 || data[0] > SERVER_MAX_HINTS)
+                return SERVER_BAD_REQUEST;
+            return submitJob(s, ci, requestId, op, g, data[0], NULL);
+
+        case SERVER_STATE: {
+            size_t k = 0;
+            payload[k++] = (unsigned char)g->player;
+            payload[k++] = g->over;
+            payload[k++] = (unsigned char)g->bag.total;
+            putLittle(payload + k, (uint16_t)g->turn, 2);
+            k += 2;
+            for (int p = 0; p < 2; p++, k += 4)
+                putLittle(payload + k, (uint32_t)g->scores[p], 4);
+            memset(payload + k, 0, 8);
+            memcpy(payload + k, g->racks[g->player], strlen(g->racks[g->player]));
+            k += 8;
+            memcpy(payload + k, g->cells, SERVER_CELLS);
+            *out = k + SERVER_CELLS;
+            return SERVER_OK;
+        }
+
+        case SERVER_CHECK: {
+            int score;
+            if (!parseMove(data, n, &move))
+                return SERVER_BAD_REQUEST;
+            payload[0] = checkPlacement(s, g, &move, &score);
+            putLittle(payload + 1, (uint16_t)score, 2);
+            *out = 3;
+            return SERVER_OK;
+        }
+    }
+    return SERVER_BAD_REQUEST;
+}
+
+static int compareBatchWords(const void *a, const void *b) {
+    return strcmp(((const BatchWord *)a)->word, ((const BatchWord *)b)->word);
+}
+
+/*
+ * Fonction : handleBatch
+ * ----------------------
+ * Traite une trame BATCH et répond par une seule trame. Les mots à valider du lot sont
+ * normalisés, triés puis vérifiés en un seul parcours de l'arbre lexical (les préfixes
+ * communs ne sont parcourus qu'une fois) ; les autres requêtes sont exécutées dans l'ordre
+ * du lot. Un lot mal délimité est refusé en entier.
+ */
+static void handleBatch(Server *s, int ci, uint32_t requestId, const unsigned char *data, size_t n) {
+    BatchItem *items = s->batchItems;
+    size_t count = (n >= 2) ? getLittle(data, 2) : 0;
+    size_t pos = 2;
+    if (n < 2 || count > SERVER_MAX_BATCH) {
+        sendResponse(s, ci, requestId, SERVER_BATCH, SERVER_BAD_REQUEST, NULL, 0);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        size_t len = (pos + 3 <= n) ? getLittle(data + pos, 2) : 0;
+        if (len < 1 || pos + 2 + len > n) {
+            sendResponse(s, ci, requestId, SERVER_BATCH, SERVER_BAD_REQUEST, NULL, 0);
+            return;
+        }
+        items[i].op = data[pos + 2];
+        items[i].data = data + pos + 3;
+        items[i].len = len - 1;
+        pos += 2 + len;
+    }
+    if (pos != n) {
+        sendResponse(s, ci, requestId, SERVER_BATCH, SERVER_BAD_REQUEST, NULL, 0);
+        return;
+    }
+    s->requests += count;
+
+    // Mots à valider : en majuscules, triés, puis un seul parcours du dictionnaire
+    int words = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].op != SERVER_VALIDATE)
+            continue;
+        items[i].valid = false;
+        if (items[i].len == 0 || items[i].len >= SERVER_WORD_SIZE) {
+            items[i].status = SERVER_BAD_REQUEST;
+            continue;
+        }
+        items[i].status = SERVER_OK;
+        BatchWord *w = &s->batchWords[words];
+        for (size_t k = 0; k < items[i].len; k++)
+            w->word[k] = toupper(items[i].data[k]);
+        w->word[items[i].len] = '\0';
+        if (strlen(w->word) != items[i].len)
+            continue;   // Octet nul dans le mot : invalide
+        w->item = (int)i;
+        words++;
+    }
+    qsort(s->batchWords, words, sizeof(BatchWord), compareBatchWords);
+    for (int w = 0; w < words; w++)
+        s->batchKeys[w] = s->batchWords[w].word;
+    lexiconContainsSorted(s->lexicon, s->batchKeys, words, s->batchFound);
+    for (int w = 0; w < words; w++)
+        items[s->batchWords[w].item].valid = s->batchFound[w];
+
+    // Réponse : nombre, puis longueur, statut et données de chaque requête
+    unsigned char *out = s->batchOut;
+    size_t total = 2;
+    putLittle(out, count, 2);
+    for (size_t i = 0; i < count; i++) {
+        unsigned char *item = out + total;
+        size_t len = 0;
+        uint8_t status;
+        if (items[i].op == SERVER_VALIDATE) {
+            status = items[i].status;
+            if (status == SERVER_OK)
+                item[3 + len++] = items[i].valid;
+        } else {
+            status = runRequest(s, -1, requestId, items[i].op, items[i].data, items[i].len,
+                                item + 3, &len);
+        }
+        putLittle(item, 1 + len, 2);
+        item[2] = status;
+        total += 3 + len;
+    }
+    sendResponse(s, ci, requestId, SERVER_BATCH, SERVER_OK, out, total);
+}
+
+/*
+ * Fonction : handleFrame
+ * ----------------------
+ * Traite une requête complète et y répond, sauf si elle a été confiée aux threads.
+ *
+ * Paramètres :
+ *   s     : le serveur.
+ *   ci    : la connexion qui a envoyé la requête.
+ *   frame : la trame, sans son préfixe de longueur.
+ *   len   : la longueur de la trame (au moins identifiant et opération).
+ */
+static void handleFrame(Server *s, int ci, const unsigned char *frame, size_t len) {
+    uint32_t requestId = (uint32_t)getLittle(frame, 4);
+    uint8_t op = frame[4];
+    if (op == SERVER_BATCH) {
+        handleBatch(s, ci, requestId, frame + 5, len - 5);
+        return;
+    }
+    unsigned char payload[SERVER_PAYLOAD_MAX];
+    size_t out;
+    s->requests++;
+    uint8_t status = runRequest(s, ci, requestId, op, frame + 5, len - 5, payload, &out);
+    if (status != STATUS_PENDING)
+        sendResponse(s, ci, requestId, op, status, payload, out);
+}
+
+// Traite toutes les trames complètes du tampon d'entrée, tant que la sortie n'est pas saturée
+static void processInput(Server *s, int ci) {
+    Connection *c = &s->conns[ci];
+    size_t pos = 0;
+    while (c->inLen - pos >= 4 && c->backlog < SERVER_MAX_BACKLOG) {
+        uint32_t len = (uint32_t)getLittle(c->in + pos, 4);
+        if (len < SERVER_REQUEST_HEADER - 4 || len > SERVER_MAX_FRAME) {
+            fprintf(stderr, "Connexion %d : trame invalide (%u octets), fermeture\n", ci, len);
+            closeConnection(s, ci);
+            return;
+        }
+        if (c->inLen - pos < 4 + (size_t)len)
+            break;
+        handleFrame(s, ci, c->in + pos + 4, len);
+        if (c->fd < 0)
+            return;
+        pos += 4 + len;
+    }
+    if (pos > 0) {
+        memmove(c->in, c->in + pos, c->inLen - pos);
+        c->inLen -= pos;
+    }
+}
+
+// Lit et traite les trames reçues ; un tampon plein (sortie saturée) suspend la lecture
+static void readConnection(Server *s, int ci) {
+    Connection *c = &s->conns[ci];
+    while (c->fd >= 0 && c->inLen < sizeof(c->in)) {
+        ssize_t n = read(c->fd, c->in + c->inLen, sizeof(c->in) - c->inLen);
+        if (n > 0) {
+            c->inLen += n;
+            processInput(s, ci);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            closeConnection(s, ci);   // Fin de connexion ou erreur
+        }
+    }
+    if (c->fd >= 0)
+        updateEvents(s, ci);
+}
+
+static void acceptConnections(Server *s) {
+    for (;;) {
+        int fd = accept(s->listenFd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                perror("accept");
+            return;
+        }
+        if (s->freeConnCount == 0) {
+            fprintf(stderr, "Trop de connexions (%d), connexion refusée\n", s->maxConns);
+            close(fd);
+            continue;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        int ci = s->freeConns[--s->freeConnCount];
+        Connection *c = &s->conns[ci];
+        c->fd = fd;
+        c->serial = s->nextSerial++;
+        c->events = EPOLLIN;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u64 = (uint64_t)ci };
+        if (epoll_ctl(s->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            perror("epoll_ctl");
+            closeConnection(s, ci);
+        }
+    }
+}
+
+//
+// Calculs
+//
+
+// Coup vertical d'une seule lettre qui double un coup horizontal (même lettre, même case)
+static bool isMirroredSingle(char **board, const Move *move) {
+    if (move->tilesUsed != 1 || move->dir != 'v')
+        return false;
+    int x = move->x;
+    for (int y = move->y; move->word[y - move->y] != '\0'; y++) {
+        if (board[y][x] != ' ')
+            continue;
+        return (x > 0 && board[y][x - 1] != ' ') ||
+               (x < SERVER_BOARD_SIZE - 1 && board[y][x + 1] != ' ');
+    }
+    return false;
+}
+
+// Ordre de classement : équité décroissante, puis score décroissant
+static bool rankedBefore(const Move *a, const Move *b) {
+    return a->equity > b->equity || (a->equity == b->equity && a->score > b->score);
+}
+
+// Génère les coups de la copie de position du calcul et garde ce que l'opération demande
+static void runJob(Worker *w, Job *job) {
+    const Server *s = w->server;
+    TRACE_BEGIN("serverJob");
+    for (int y = 0; y < SERVER_BOARD_SIZE; y++)
+        memcpy(w->board[y], &job->cells[y * SERVER_BOARD_SIZE], SERVER_BOARD_SIZE);
+    bool leaves = s->leaves && job->op != SERVER_PLAY;
+    if (leaves)
+        leavePrepareRack(s->leaves, job->rack, w->rackLeaves);
+    generateMoves(s->lexicon, w->board, SERVER_BOARD_SIZE, w->bonus, job->rack, job->firstMove,
+                  leaves ? w->rackLeaves : NULL, &w->list);
+
+    job->count = 0;
+    if (job->op == SERVER_PLAY) {
+        for (int i = 0; i < w->list.count; i++) {
+            const Move *move = &w->list.moves[i];
+            if (move->x == job->wanted.x && move->y == job->wanted.y &&
+                move->dir == job->wanted.dir && strcmp(move->word, job->wanted.word) == 0) {
+                job->moves[job->count++] = *move;
+                break;
+            }
+        }
+    } else if (job->op == SERVER_ENGINE_MOVE) {
+        int best = bestMoveIndex(&w->list);
+        if (best >= 0)
+            job->moves[job->count++] = w->list.moves[best];
+    } else {
+        // Les topK meilleurs coups, par insertion dans le tableau trié du calcul
+        for (int i = 0; i < w->list.count; i++) {
+            const Move *move = &w->list.moves[i];
+            if (job->count == job->topK && !rankedBefore(move, &job->moves[job->count - 1]))
+                continue;
+            if (isMirroredSingle(w->board, move))
+                continue;
+            int j = (job->count < job->topK) ? job->count++ : job->count - 1;
+            while (j > 0 && rankedBefore(move, &job->moves[j - 1])) {
+                job->moves[j] = job->moves[j - 1];
+                j--;
+            }
+            job->moves[j] = *move;
+        }
+    }
+    TRACE_END("serverJob");
+}
+
+static void *workerMain(void *arg) {
+    Worker *w = arg;
+    Server *s = w->server;
+    traceSetThreadName("server-worker");
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->queueHead && !s->stopping)
+            pthread_cond_wait(&s->ready, &s->lock);
+        if (!s->queueHead)
+            break;
+        Job *job = s->queueHead;
+        s->queueHead = job->next;
+        if (!s->queueHead)
+            s->queueTail = NULL;
+        pthread_mutex_unlock(&s->lock);
+
+        runJob(w, job);
+
+        // Le premier calcul terminé d'une série réveille la boucle d'événements
+        pthread_mutex_lock(&s->lock);
+        bool wake = (s->done == NULL);
+        job->next = s->done;
+        s->done = job;
+        if (wake) {
+            uint64_t one = 1;
+            if (write(s->wakeFd, &one, sizeof(one)) < 0)
+                perror("eventfd");
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+// Applique le résultat d'un calcul à sa partie et répond au client (boucle d'événements)
+static void finishJob(Server *s, Job *job) {
+    unsigned char payload[1 + SERVER_MAX_HINTS * SERVER_MOVE_SIZE];
+    size_t out = 0;
+    uint8_t status = SERVER_OK;
+    s->computed++;
+
+    if (job->op == SERVER_HINT) {
+        payload[out++] = (unsigned char)job->count;
+        for (int i = 0; i < job->count; i++)
+            out += encodeMove(payload + out, &job->moves[i]);
+    } else {
+        Game *g = findGame(s, job->game);
+        if (!g)
+            status = SERVER_UNKNOWN_GAME;
+        else if (g->version != job->version)
+            status = SERVER_CONFLICT;
+        else if (job->op == SERVER_PLAY && job->count == 0)
+            status = SERVER_ILLEGAL;
+        else {
+            Move none;
+            memset(&none, 0, sizeof(none));
+            const Move *move = (job->count > 0) ? &job->moves[0] : &none;
+            if (job->count > 0)
+                playMove(g, move);
+            else if (!exchangeTiles(g, g->racks[g->player]))
+                endTurn(g, 0);   // Aucun coup et sac presque vide : le moteur passe
+            out = encodeMove(payload, move);
+            payload[out++] = g->over;
+        }
+    }
+
+    Connection *c = &s->conns[job->conn];
+    if (c->fd >= 0 && c->serial == job->connSerial)
+        sendResponse(s, job->conn, job->requestId, job->op, status, payload, out);
+    job->next = s->freeJobs;
+    s->freeJobs = job;
+}
+
+static void drainCompletions(Server *s) {
+    uint64_t counter;
+    if (read(s->wakeFd, &counter, sizeof(counter)) < 0 && errno != EAGAIN)
+        perror("eventfd");
+    pthread_mutex_lock(&s->lock);
+    Job *done = s->done;
+    s->done = NULL;
+    pthread_mutex_unlock(&s->lock);
+
+    // La liste est empilée par les threads : on la retourne pour répondre dans l'ordre
+    Job *ordered = NULL;
+    while (done) {
+        Job *next = done->next;
+        done->next = ordered;
+        ordered = done;
+        done = next;
+    }
+    while (ordered) {
+        Job *next = ordered->next;
+        finishJob(s, ordered);
+        ordered = next;
+    }
+}
+
+//
+// Démarrage et boucle d'événements
+//
+
+static int openSocket(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Erreur : chemin de socket trop long : %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    unlink(path);   // Socket laissée par un serveur précédent
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "Erreur d'ouverture de la socket %s : %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+// Réservoirs de parties, de connexions et de calculs, alloués une fois pour toutes
+static int allocPools(Server *s) {
+    s->games = calloc(s->maxGames, sizeof(Game));
+    s->conns = calloc(s->maxConns, sizeof(Connection));
+    s->freeConns = calloc(s->maxConns, sizeof(int));
+    s->dirty = calloc(s->maxConns, sizeof(int));
+    s->jobs = calloc(SERVER_MAX_JOBS, sizeof(Job));
+    s->batchItems = calloc(SERVER_MAX_BATCH, sizeof(BatchItem));
+    s->batchWords = calloc(SERVER_MAX_BATCH, sizeof(BatchWord));
+    s->batchKeys = calloc(SERVER_MAX_BATCH, sizeof(const char *));
+    s->batchFound = calloc(SERVER_MAX_BATCH, sizeof(bool));
+    s->batchOut = malloc(2 + (size_t)SERVER_MAX_BATCH * (3 + SERVER_PAYLOAD_MAX));
+    if (!s->games || !s->conns || !s->freeConns || !s->dirty || !s->jobs || !s->batchItems ||
+        !s->batchWords || !s->batchKeys || !s->batchFound || !s->batchOut) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return -1;
+    }
+    for (int i = s->maxGames - 1; i >= 0; i--) {
+        s->games[i].nextFree = s->freeGame;
+        s->freeGame = i;
+    }
+    for (int i = s->maxConns - 1; i >= 0; i--) {
+        s->conns[i].fd = -1;
+        s->freeConns[s->freeConnCount++] = i;
+    }
+    for (int i = SERVER_MAX_JOBS - 1; i >= 0; i--) {
+        s->jobs[i].next = s->freeJobs;
+        s->freeJobs = &s->jobs[i];
+    }
+    return 0;
+}
+
+static void freePools(Server *s) {
+    for (int i = 0; s->conns && i < s->maxConns; i++)
+        if (s->conns[i].fd >= 0)
+            closeConnection(s, i);
+    while (s->freeBlocks) {
+        OutBlock *b = s->freeBlocks;
+        s->freeBlocks = b->next;
+        free(b);
+    }
+    free(s->games);
+    free(s->conns);
+    free(s->freeConns);
+    free(s->dirty);
+    free(s->jobs);
+    free(s->batchItems);
+    free(s->batchWords);
+    free(s->batchKeys);
+    free(s->batchFound);
+    free(s->batchOut);
+}
+
+/*
+ * Fonction : runServer
+ * --------------------
+ * Boucle d'événements : nouvelles connexions, requêtes, calculs terminés, puis envoi des
+ * réponses accumulées pendant le tour de boucle. S'arrête sur SIGINT ou SIGTERM.
+ */
+static void runServer(Server *s) {
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    while (!stopRequested) {
+        int n = epoll_wait(s->epfd, events, SERVER_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno != EINTR)
+                perror("epoll_wait");
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            uint64_t tag = events[i].data.u64;
+            if (tag == TAG_LISTEN) {
+                acceptConnections(s);
+                continue;
+            }
+            if (tag == TAG_WAKEUP) {
+                drainCompletions(s);
+                continue;
+            }
+            int ci = (int)tag;
+            Connection *c = &s->conns[ci];
+            if (c->fd < 0)
+                continue;
+            if (events[i].events & (EPOLLERR | EPOLLHUP) && !(events[i].events & EPOLLIN)) {
+                closeConnection(s, ci);
+                continue;
+            }
+            if (events[i].events & EPOLLOUT)
+                flushConnection(s, ci);
+            if (c->fd >= 0 && (events[i].events & EPOLLIN))
+                readConnection(s, ci);
+        }
+        // Un envoi peut relancer le traitement des trames en attente, qui remet la connexion
+        // dans la liste : on dépile jusqu'à ce qu'elle soit vide (chaque connexion y figure
+        // au plus une fois à la fois)
+        while (s->dirtyCount > 0) {
+            int ci = s->dirty[--s->dirtyCount];
+            s->conns[ci].dirty = false;
+            if (s->conns[ci].fd >= 0)
+                flushConnection(s, ci);
+        }
+    }
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage : %s [-d dictionnaire] [-l reliquats.bin] [-s socket] [-j threads]\n"
+            "          [-g parties] [-c connexions]\n"
+            "  -s : chemin de la socket Unix (défaut : %s)\n"
+            "  -g : nombre maximal de parties ouvertes (défaut : %d, au plus %d)\n"
+            "  -c : nombre maximal de connexions simultanées (défaut : %d)\n",
+            prog, SERVER_DEFAULT_SOCKET, SERVER_DEFAULT_GAMES, SERVER_MAX_GAMES,
+            SERVER_DEFAULT_CONNECTIONS);
+}
+
+// Fonction principale du serveur
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = "mots_filtres.txt";
+    const char *leavesFile = NULL;
+    const char *socketPath = SERVER_DEFAULT_SOCKET;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    Server server;
+    memset(&server, 0, sizeof(server));
+    server.maxGames = SERVER_DEFAULT_GAMES;
+    server.maxConns = SERVER_DEFAULT_CONNECTIONS;
+    server.freeGame = -1;
+    server.nextSeed = (uint64_t)time(NULL);
+
+    int opt;
+    while ((opt = getopt(argc, argv, "d:l:s:j:g:c:h")) != -1) {
+        switch (opt) {
+            case 'd': dictionaryFile = optarg; break;
+            case 'l': leavesFile = optarg; break;
+            case 's': socketPath = optarg; break;
+            case 'j': threads = strtol(optarg, NULL, 10); break;
+            case 'g': server.maxGames = atoi(optarg); break;
+            case 'c': server.maxConns = atoi(optarg); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > SERVER_MAX_THREADS)
+        threads = SERVER_MAX_THREADS;
+    if (server.maxGames < 1 || server.maxGames > SERVER_MAX_GAMES || server.maxConns < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Arbre lexical et table de reliquats : construits une fois, partagés en lecture seule
+    DictionaryEntry *dictionary = loadDictionaryHash(dictionaryFile);
+    if (!dictionary)
+        return EXIT_FAILURE;
+    Lexicon *lexicon = buildLexicon(dictionary);
+    freeDictionaryHash(dictionary);
+    if (!lexicon)
+        return EXIT_FAILURE;
+    LeaveTable *leaves = NULL;
+    if (leavesFile && !(leaves = loadLeaveTable(leavesFile)))
+        return EXIT_FAILURE;
+    server.lexicon = lexicon;
+    server.leaves = leaves;
+
+    if (allocPools(&server) != 0)
+        return EXIT_FAILURE;
+    Worker *workers = calloc(threads, sizeof(Worker));
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    bool ok = workers && tids;
+    for (long t = 0; ok && t < threads; t++) {
+        workers[t].server = &server;
+        initBonusBoard(workers[t].bonus);
+        initMoveList(&workers[t].list);
+        ok = (workers[t].board = initBoard(SERVER_BOARD_SIZE)) != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        return EXIT_FAILURE;
+    }
+
+    server.listenFd = openSocket(socketPath);
+    server.epfd = epoll_create1(0);
+    server.wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (server.listenFd < 0 || server.epfd < 0 || server.wakeFd < 0) {
+        if (server.epfd < 0 || server.wakeFd < 0)
+            perror("epoll");
+        return EXIT_FAILURE;
+    }
+    struct epoll_event ev = { .events = EPOLLIN, .data.u64 = TAG_LISTEN };
+    epoll_ctl(server.epfd, EPOLL_CTL_ADD, server.listenFd, &ev);
+    ev.data.u64 = TAG_WAKEUP;
+    epoll_ctl(server.epfd, EPOLL_CTL_ADD, server.wakeFd, &ev);
+
+    // Arrêt propre sur SIGINT / SIGTERM (epoll_wait est interrompu) ; SIGPIPE ignoré
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.ready, NULL);
+    long started = 0;
+    for (long t = 0; t < threads; t++)
+        if (pthread_create(&tids[t], NULL, workerMain, &workers[t]) == 0)
+            started++;
+    if (started == 0) {
+        fprintf(stderr, "Erreur : aucun thread de calcul n'a pu être créé\n");
+        return EXIT_FAILURE;
+    }
+    traceSetThreadName("server-loop");
+    printf("Serveur à l'écoute sur %s (%d parties, %d connexions au plus, %ld threads)\n",
+           socketPath, server.maxGames, server.maxConns, started);
+    fflush(stdout);
+
+    runServer(&server);
+
+    pthread_mutex_lock(&server.lock);
+    server.stopping = true;
+    pthread_cond_broadcast(&server.ready);
+    pthread_mutex_unlock(&server.lock);
+    for (long t = 0; t < started; t++)
+        pthread_join(tids[t], NULL);
+    printf("Arrêt : %llu requêtes, %llu calculs, %d parties ouvertes\n",
+           (unsigned long long)server.requests, (unsigned long long)server.computed,
+           server.activeGames);
+
+    close(server.listenFd);
+    close(server.wakeFd);
+    close(server.epfd);
+    unlink(socketPath);
+    pthread_mutex_destroy(&server.lock);
+    pthread_cond_destroy(&server.ready);
+    for (long t = 0; t < threads; t++) {
+        freeMoveList(&workers[t].list);
+        freeBoard(workers[t].board, SERVER_BOARD_SIZE);
+    }
+    free(workers);
+    free(tids);
+    freePools(&server);
+    freeLeaveTable(leaves);
+    freeLexicon(lexicon);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+
+//
+// Protocole du serveur de parties (scrabble-server)
+//
+// Le serveur écoute sur une socket Unix (SOCK_STREAM). Chaque requête et chaque réponse est
+// une trame préfixée par sa longueur ; tous les entiers sont en petit-boutiste.
+//
+//   requête   longueur (u32), identifiant (u32), opération (u8), données
+//   réponse   longueur (u32), identifiant (u32), opération (u8), statut (u8), données
+//
+// La longueur compte les octets qui la suivent ; celle d'une requête ne dépasse pas
+// SERVER_MAX_FRAME (la réponse à une trame BATCH peut être plus longue).
+// L'identifiant est choisi par le client et recopié dans la réponse : les requêtes calculées
+// par les threads du serveur (coup joué, coup du moteur, conseil) peuvent recevoir leur
+// réponse après des requêtes envoyées plus tard sur la même connexion.
+//
+// Un client peut envoyer ses requêtes à la suite sans attendre les réponses : toutes les
+// trames complètes reçues sont traitées ensemble et leurs réponses partent groupées (writev).
+// Une trame BATCH regroupe plusieurs requêtes immédiates en une seule trame et une seule
+// réponse ; les mots à valider d'un lot sont triés et vérifiés en un seul parcours du
+// dictionnaire.
+//
+// Données par opération (requête -> réponse en cas de succès) :
+//   NEW_GAME     [graine (u64)]                             -> partie (u32)
+//   CLOSE_GAME   partie (u32)                               -> rien
+//   PLAY         partie, x, y, dir ('h'/'v'), mot (16)      -> coup, fin de partie (u8)
+//                (mot vide : le joueur passe)
+//   EXCHANGE     partie, lettres (8, complétées par des 0)  -> fin de partie (u8)
+//   ENGINE_MOVE  partie                                     -> coup, fin de partie (u8)
+//                (mot vide : le moteur a échangé ou passé)
+//   VALIDATE     mot (le reste de la trame)                 -> valide (u8)
+//   CHECK        partie, x, y, dir, mot (16)                -> valide (u8), score (i16)
+//                (pose possible avec le rack du joueur au trait, sans la jouer)
+//   HINT         partie, nombre de coups (u8)               -> nombre (u8), coups
+//   STATE        partie                                     -> joueur au trait (u8),
+//                fin de partie (u8), lettres dans le sac (u8), tour (u16), scores (2 x i32),
+//                rack du joueur au trait (8), plateau (15 x 15, ' ' : case vide)
+//   BATCH        nombre (u16), puis par requête :           -> nombre (u16), puis par
+//                longueur (u16), opération (u8), données       réponse : longueur (u16),
+//                                                              statut (u8), données
+//                (requêtes immédiates seulement : NEW_GAME, CLOSE_GAME, EXCHANGE, VALIDATE,
+//                CHECK, STATE, et PLAY avec un mot vide ; les autres reçoivent BAD_REQUEST)
+//
+// Un coup est encodé sur SERVER_MOVE_SIZE octets : mot (16, lettres du plateau comprises),
+// x, y, direction, lettres posées (u8), score (i16) et équité (f32). C'est l'encodage de la
+// version 1 du format binaire de scrabble-analyze : le serveur ne joue que sur le plateau
+// 15 x 15 (SERVER_BOARD_SIZE), alors que la version 2 réserve SCRABBLE_MAX_WORD (22) octets
+// au mot pour les plateaux jusqu'à 21 x 21.
+//
+
+#define SERVER_PROTOCOL_VERSION 2
+#define SERVER_MAX_FRAME        16384   // Longueur maximale d'une trame (sans son préfixe)
+#define SERVER_REQUEST_HEADER   9       // Longueur, identifiant, opération
+#define SERVER_RESPONSE_HEADER  10      // Longueur, identifiant, opération, statut
+#define SERVER_WORD_SIZE        16
+#define SERVER_MOVE_SIZE        26
+#define SERVER_MAX_HINTS        64
+#define SERVER_BOARD_SIZE       15
+
+typedef enum {
+    SERVER_NEW_GAME = 1,
+    SERVER_CLOSE_GAME,
+    SERVER_PLAY,
+    SERVER_EXCHANGE,
+    SERVER_ENGINE_MOVE,
+    SERVER_VALIDATE,
+    SERVER_HINT,
+    SERVER_STATE,
+    SERVER_CHECK,
+    SERVER_BATCH
+} ServerOp;
+
+typedef enum {
+    SERVER_OK,
+    SERVER_BAD_REQUEST,     // Trame mal formée ou opération inconnue
+    SERVER_UNKNOWN_GAME,    // Partie inexistante ou fermée
+    SERVER_ILLEGAL,         // Coup absent des coups légaux, échange impossible
+    SERVER_GAME_OVER,       // La partie est terminée
+    SERVER_FULL,            // Plus aucune place libre pour une nouvelle partie
+    SERVER_BUSY,            // Trop de calculs en attente, la requête peut être renvoyée
+    SERVER_CONFLICT         // La partie a changé pendant le calcul du coup
+} ServerStatus;
+
+#endif  // SERVER_H
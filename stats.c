@@ -0,0 +1,101 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "stats.h"
+
+#include <stdatomic.h>
+
+static const char *counterNames[STAT_COUNTER_COUNT] = {
+    "dict_probes", "cross_checks", "cross_free", "anchors", "moves", "pruned", "allocs"
+};
+static const char *phaseNames[PHASE_COUNT] = {
+    "prefilter", "generation", "scoring", "ranking"
+};
+
+#ifdef SCRABBLE_STATS
+_Thread_local EngineStats threadStats;
+
+// Totaux de tous les threads, alimentés par statsFlush
+static _Atomic uint64_t globalCounters[STAT_COUNTER_COUNT];
+static _Atomic uint64_t globalPhaseNs[PHASE_COUNT];
+
+uint64_t statsNow(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+#endif
+
+void statsSnapshot(EngineStats *out) {
+#ifdef SCRABBLE_STATS
+    *out = threadStats;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+void statsDelta(const EngineStats *before, const EngineStats *after, EngineStats *delta) {
+    for (int i = 0; i < STAT_COUNTER_COUNT; i++)
+        delta->counters[i] = after->counters[i] - before->counters[i];
+    for (int i = 0; i < PHASE_COUNT; i++)
+        delta->phaseNs[i] = after->phaseNs[i] - before->phaseNs[i];
+}
+
+void statsFlush(void) {
+#ifdef SCRABBLE_STATS
+    for (int i = 0; i < STAT_COUNTER_COUNT; i++)
+        atomic_fetch_add_explicit(&globalCounters[i], threadStats.counters[i], memory_order_relaxed);
+    for (int i = 0; i < PHASE_COUNT; i++)
+        atomic_fetch_add_explicit(&globalPhaseNs[i], threadStats.phaseNs[i], memory_order_relaxed);
+    memset(&threadStats, 0, sizeof(threadStats));
+#endif
+}
+
+void statsGlobal(EngineStats *out) {
+#ifdef SCRABBLE_STATS
+    for (int i = 0; i < STAT_COUNTER_COUNT; i++)
+        out->counters[i] = atomic_load_explicit(&globalCounters[i], memory_order_relaxed);
+    for (int i = 0; i < PHASE_COUNT; i++)
+        out->phaseNs[i] = atomic_load_explicit(&globalPhaseNs[i], memory_order_relaxed);
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+/*
+ * Fonction : statsFormat
+ * ----------------------
+ * Écrit un bilan sur une ligne : "nom=valeur" séparés par des espaces (durées en µs), ou un
+ * objet JSON {"nom":valeur,...,"nom_ns":durée} sans retour à la ligne.
+ *
+ * Paramètres :
+ *   stats  : les compteurs à écrire.
+ *   json   : vrai pour le format JSON.
+ *   buffer : tampon de sortie.
+ *   size   : taille du tampon.
+ *
+ * Retour :
+ *   La longueur écrite (au plus size - 1).
+ */
+int statsFormat(const EngineStats *stats, bool json, char *buffer, size_t size) {
+    size_t len = 0;
+    if (size == 0)
+        return 0;
+    buffer[0] = '\0';
+    if (json && len < size)
+        len += snprintf(buffer + len, size - len, "{");
+    for (int i = 0; i < STAT_COUNTER_COUNT && len < size; i++)
+        len += snprintf(buffer + len, size - len, json ? "%s\"%s\":%llu" : "%s%s=%llu",
+                        i ? (json ? "," : " ") : "", counterNames[i],
+                        (unsigned long long)stats->counters[i]);
+    for (int i = 0; i < PHASE_COUNT && len < size; i++) {
+        if (json)
+            len += snprintf(buffer + len, size - len, ",\"%s_ns\":%llu", phaseNames[i],
+                            (unsigned long long)stats->phaseNs[i]);
+        else
+            len += snprintf(buffer + len, size - len, " %s=%.1fus", phaseNames[i],
+                            stats->phaseNs[i] / 1000.0);
+    }
+    if (json && len < size)
+        len += snprintf(buffer + len, size - len, "}");
+    return (int)(len < size ? len : size - 1);
+}
@@ -0,0 +1,71 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include "scrabble.h"
+
+//
+// Instrumentation du moteur (compilée seulement avec -DSCRABBLE_STATS, voir make STATS=1)
+//
+// Chaque thread compte dans son propre bloc (_Thread_local) : aucun verrou ni opération
+// atomique sur les chemins critiques. Un bilan par indice s'obtient par différence entre deux
+// instantanés du bloc du thread ; statsFlush reporte le bloc dans des totaux globaux par
+// additions atomiques, sans verrou. Sans SCRABBLE_STATS, les macros ne produisent aucun code
+// et les instantanés sont nuls.
+//
+
+typedef enum {
+    STAT_DICT_PROBES,      // Recherches dans le dictionnaire (hachage ou arbre lexical)
+    STAT_CROSS_CHECKS,     // Contraintes de mots croisés calculées
+    STAT_CROSS_FREE,       // ... dont résolues sans parcours de l'arbre (aucun voisin)
+    STAT_ANCHORS,          // Ancres explorées
+    STAT_MOVES,            // Coups produits
+    STAT_PRUNED,           // Sous-arbres écartés (lettre absente du rack ou du mot croisé)
+    STAT_ALLOCS,           // Allocations mémoire
+    STAT_COUNTER_COUNT
+} StatCounter;
+
+typedef enum {
+    PHASE_PREFILTER,       // Ancres et contraintes (générateur), filtre canPlaceWord (exhaustif)
+    PHASE_GENERATION,      // Parcours de l'arbre ou du dictionnaire
+    PHASE_SCORING,         // Score et équité des coups retenus
+    PHASE_RANKING,         // Classement et sélection des meilleurs coups
+    PHASE_COUNT
+} StatPhase;
+
+typedef struct {
+    uint64_t counters[STAT_COUNTER_COUNT];
+    uint64_t phaseNs[PHASE_COUNT];
+} EngineStats;
+
+#ifdef SCRABBLE_STATS
+#define STATS_ENABLED 1
+extern _Thread_local EngineStats threadStats;
+uint64_t statsNow(void);
+#define STAT_ADD(counter, n)          (threadStats.counters[counter] += (uint64_t)(n))
+#define STAT_INC(counter)             STAT_ADD(counter, 1)
+#define STAT_TIMER_START(var)         uint64_t var = statsNow()
+#define STAT_TIMER_STOP(phase, var)   (threadStats.phaseNs[phase] += statsNow() - (var))
+#else
+#define STATS_ENABLED 0
+#define STAT_ADD(counter, n)          ((void)0)
+#define STAT_INC(counter)             ((void)0)
+#define STAT_TIMER_START(var)         ((void)0)
+#define STAT_TIMER_STOP(phase, var)   ((void)0)
+#endif
+
+// Copie du bloc du thread appelant (zéros sans SCRABBLE_STATS)
+void statsSnapshot(EngineStats *out);
+
+// Activité entre deux instantanés du même thread
+void statsDelta(const EngineStats *before, const EngineStats *after, EngineStats *delta);
+
+// Reporte le bloc du thread dans les totaux globaux (sans verrou) puis le remet à zéro
+void statsFlush(void);
+
+// Totaux globaux reportés par statsFlush
+void statsGlobal(EngineStats *out);
+
+// Bilan sur une ligne, texte ou objet JSON ; retourne la longueur écrite (tronquée à size)
+int statsFormat(const EngineStats *stats, bool json, char *buffer, size_t size);
+
+#endif  // STATS_H
@@ -0,0 +1,176 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "trace.h"
+
+#include <stdatomic.h>
+#include <unistd.h>
+
+#ifdef SCRABBLE_TRACE
+
+#define TRACE_RING_SIZE 65536   // Événements conservés par thread (puissance de 2)
+
+typedef struct {
+    const char *name;
+    uint64_t ns;
+    char phase;                  // 'B' : début, 'E' : fin
+} TraceEvent;
+
+// Anneau d'un thread, jamais libéré : il reste lisible après la fin du thread
+typedef struct TraceBuffer {
+    struct TraceBuffer *next;
+    int tid;
+    const char *threadName;
+    _Atomic uint64_t head;       // Nombre total d'événements écrits
+    TraceEvent events[TRACE_RING_SIZE];
+} TraceBuffer;
+
+static _Atomic(TraceBuffer *) traceBuffers;   // Liste de tous les anneaux (ajout sans verrou)
+static atomic_int nextTid;
+static atomic_flag exitHandlerSet = ATOMIC_FLAG_INIT;
+static _Thread_local TraceBuffer *localBuffer;
+static _Thread_local bool localFailed;         // Allocation impossible : plus d'essai
+
+static uint64_t traceNow(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+static void writeAtExit(void) {
+    int count = traceWrite(NULL);
+    if (count >= 0) {
+        const char *path = getenv("SCRABBLE_TRACE");
+        fprintf(stderr, "Trace : %d événements écrits dans %s\n", count, path ? path : TRACE_DEFAULT_FILE);
+    }
+}
+
+// Alloue l'anneau du thread et l'ajoute en tête de la liste globale
+static TraceBuffer *registerThread(void) {
+    TraceBuffer *buffer = calloc(1, sizeof(TraceBuffer));
+    if (!buffer) {
+        fprintf(stderr, "Erreur d'allocation mémoire (trace).\n");
+        localFailed = true;
+        return NULL;
+    }
+    buffer->tid = atomic_fetch_add(&nextTid, 1) + 1;
+    TraceBuffer *head = atomic_load(&traceBuffers);
+    do {
+        buffer->next = head;
+    } while (!atomic_compare_exchange_weak(&traceBuffers, &head, buffer));
+    if (!atomic_flag_test_and_set(&exitHandlerSet))
+        atexit(writeAtExit);
+    localBuffer = buffer;
+    return buffer;
+}
+
+void traceEvent(const char *name, char phase) {
+    TraceBuffer *buffer = localBuffer;
+    if (!buffer && (localFailed || !(buffer = registerThread())))
+        return;
+    uint64_t head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    TraceEvent *event = &buffer->events[head & (TRACE_RING_SIZE - 1)];
+    event->name = name;
+    event->ns = traceNow();
+    event->phase = phase;
+    atomic_store_explicit(&buffer->head, head + 1, memory_order_release);
+}
+
+void traceSetThreadName(const char *name) {
+    TraceBuffer *buffer = localBuffer;
+    if (!buffer && (localFailed || !(buffer = registerThread())))
+        return;
+    buffer->threadName = name;
+}
+
+/*
+ * Fonction : writeBuffer
+ * ----------------------
+ * Écrit les événements encore présents dans un anneau. Un thread actif peut écraser les plus
+ * anciens pendant la copie : la position d'écriture est relue après la copie et tout
+ * événement qui a pu être réécrit entre-temps, ou qui est en cours de réécriture, est
+ * ignoré. Les fins sans début (début écrasé) sont aussi ignorées.
+ *
+ * Retour :
+ *   Le nombre d'événements écrits.
+ */
+static int writeBuffer(FILE *fp, TraceBuffer *buffer, TraceEvent *copy, int pid, bool *first) {
+    uint64_t end = atomic_load_explicit(&buffer->head, memory_order_acquire);
+    uint64_t copyStart = end > TRACE_RING_SIZE ? end - TRACE_RING_SIZE : 0;
+    for (uint64_t i = copyStart; i < end; i++)
+        copy[i - copyStart] = buffer->events[i & (TRACE_RING_SIZE - 1)];
+    // Le propriétaire peut être en train d'écrire l'événement after (pas encore publié), qui
+    // occupe la case de l'événement after - TRACE_RING_SIZE : celui-ci n'est plus sûr non plus
+    uint64_t after = atomic_load_explicit(&buffer->head, memory_order_acquire);
+    uint64_t valid = after + 1 > TRACE_RING_SIZE ? after + 1 - TRACE_RING_SIZE : 0;
+    uint64_t start = (valid > copyStart) ? (valid < end ? valid : end) : copyStart;
+
+    int written = 0, depth = 0;
+    if (buffer->threadName) {
+        fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                *first ? "" : ",\n", pid, buffer->tid, buffer->threadName);
+        *first = false;
+    }
+    for (uint64_t i = start; i < end; i++) {
+        const TraceEvent *event = &copy[i - copyStart];
+        if (event->phase == 'E' && depth == 0)
+            continue;
+        depth += (event->phase == 'B') ? 1 : -1;
+        fprintf(fp, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+                *first ? "" : ",\n", event->name, event->phase, event->ns / 1000.0, pid, buffer->tid);
+        *first = false;
+        written++;
+    }
+    return written;
+}
+
+/*
+ * Fonction : traceWrite
+ * ---------------------
+ * Écrit la trace de tous les threads au format JSON de Chrome ({"traceEvents":[...]}).
+ * Les anneaux ne sont pas vidés : un second appel réécrit les mêmes événements, plus les
+ * nouveaux.
+ *
+ * Paramètres :
+ *   path : fichier de sortie (NULL : variable SCRABBLE_TRACE ou fichier par défaut).
+ *
+ * Retour :
+ *   Le nombre d'événements écrits, ou -1 en cas d'erreur.
+ */
+int traceWrite(const char *path) {
+    if (!path)
+        path = getenv("SCRABBLE_TRACE");
+    if (!path)
+        path = TRACE_DEFAULT_FILE;
+    TraceEvent *copy = malloc(TRACE_RING_SIZE * sizeof(TraceEvent));
+    FILE *fp = copy ? fopen(path, "w") : NULL;
+    if (!fp) {
+        fprintf(stderr, "Erreur d'écriture de la trace %s\n", path);
+        free(copy);
+        return -1;
+    }
+    int pid = (int)getpid(), total = 0;
+    bool first = true;
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (TraceBuffer *buffer = atomic_load(&traceBuffers); buffer; buffer = buffer->next)
+        total += writeBuffer(fp, buffer, copy, pid, &first);
+    fprintf(fp, "\n]}\n");
+    free(copy);
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "Erreur d'écriture de la trace %s\n", path);
+        return -1;
+    }
+    return total;
+}
+
+#else
+
+void traceSetThreadName(const char *name) {
+    (void)name;
+}
+
+int traceWrite(const char *path) {
+    (void)path;
+    return -1;
+}
+
+#endif
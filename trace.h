@@ -0,0 +1,40 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "scrabble.h"
+
+//
+// Traces chronologiques au format Chrome / Perfetto (compilées seulement avec
+// -DSCRABBLE_TRACE, voir make TRACE=1)
+//
+// Chaque thread écrit ses événements de début et de fin dans son propre anneau de taille
+// fixe : ni verrou ni allocation après le premier événement, et les plus anciens événements
+// sont écrasés quand l'anneau est plein. Le fichier JSON (chrome://tracing, ui.perfetto.dev)
+// est écrit à la sortie du programme, ou à la demande par traceWrite, dans le fichier désigné
+// par la variable d'environnement SCRABBLE_TRACE (par défaut scrabble_trace.json). Sans
+// SCRABBLE_TRACE, les macros ne produisent aucun code.
+//
+// Les noms d'événements doivent être des chaînes littérales (seul le pointeur est conservé).
+//
+
+#define TRACE_DEFAULT_FILE "scrabble_trace.json"
+
+#ifdef SCRABBLE_TRACE
+#define TRACE_ENABLED 1
+void traceEvent(const char *name, char phase);
+#define TRACE_BEGIN(name)   traceEvent(name, 'B')
+#define TRACE_END(name)     traceEvent(name, 'E')
+#else
+#define TRACE_ENABLED 0
+#define TRACE_BEGIN(name)   ((void)0)
+#define TRACE_END(name)     ((void)0)
+#endif
+
+// Nom du thread appelant dans la trace (chaîne littérale ; sans effet sans SCRABBLE_TRACE)
+void traceSetThreadName(const char *name);
+
+// Écrit tous les anneaux dans un fichier JSON (NULL : fichier par défaut) ; retourne le
+// nombre d'événements écrits, ou -1 en cas d'erreur ou sans SCRABBLE_TRACE
+int traceWrite(const char *path);
+
+#endif  // TRACE_H
@@ -5,7 +5,8 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
-// Fonction d'initialisation de SDL, TTF, création de la fenêtre, du renderer et chargement des polices
+// Fonction d'initialisation de SDL, TTF, création de la fenêtre, du renderer, chargement des polices
+// et rastérisation de l'atlas de glyphes
 int initResources(Resources *res) {
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         fprintf(stderr, "Erreur SDL_Init: %s\n", SDL_GetError());
@@ -27,7 +28,8 @@ int initResources(Resources *res) {
         SDL_Quit();
         return -1;
     }
-    res->renderer = SDL_CreateRenderer(res->window, -1, SDL_RENDERER_ACCELERATED);
+    res->renderer = SDL_CreateRenderer(res->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE |
+                                                            SDL_RENDERER_PRESENTVSYNC);
     if (!res->renderer) {
         fprintf(stderr, "Erreur SDL_CreateRenderer: %s\n", SDL_GetError());
         SDL_DestroyWindow(res->window);
@@ -79,44 +81,25 @@ int initResources(Resources *res) {
         SDL_Quit();
         return -1;
     }
-    return 0;
-}
-
-// Alloue et initialise le plateau avec des espaces
-char **initBoard(int boardSize) {
-    char **board = malloc(boardSize * sizeof(char *));
-    if (!board) {
-        fprintf(stderr, "Erreur d'allocation mémoire pour le plateau.\n");
-        return NULL;
-    }
-    for (int i = 0; i < boardSize; i++) {
-        board[i] = malloc(boardSize * sizeof(char));
-        if (!board[i]) {
-            fprintf(stderr, "Erreur d'allocation mémoire.\n");
-            for (int j = 0; j < i; j++)
-                free(board[j]);
-            free(board);
-            return NULL;
-        }
-        memset(board[i], ' ', boardSize);
+    TTF_Font *fonts[FONT_COUNT] = { res->boardFont, res->rackFont, res->inputFont, res->valueFont };
+    if (createGlyphAtlas(res->renderer, fonts, &res->atlas) != 0) {
+        TTF_CloseFont(res->valueFont);
+        TTF_CloseFont(res->inputFont);
+        TTF_CloseFont(res->rackFont);
+        TTF_CloseFont(res->boardFont);
+        SDL_DestroyRenderer(res->renderer);
+        SDL_DestroyWindow(res->window);
+        TTF_Quit();
+        SDL_Quit();
+        return -1;
     }
-    return board;
-}
-
-void freeBoard(char **board, int boardSize) {
-    for (int i = 0; i < boardSize; i++)
-        free(board[i]);
-    free(board);
+    return 0;
 }
 
 // Libère toutes les ressources allouées
-void cleanup(Resources *res, DictionaryEntry *dictionaryHash, char **board, int boardSize) {
-    DictionaryEntry *current, *tmp;
-    HASH_ITER(hh, dictionaryHash, current, tmp) {
-        HASH_DEL(dictionaryHash, current);
-        free(current);
-    }
-    freeBoard(board, boardSize);
+void cleanup(Resources *res, DictionaryEntry *dictionaryHash) {
+    freeDictionaryHash(dictionaryHash);
+    freeGlyphAtlas(&res->atlas);
     TTF_CloseFont(res->valueFont);
     TTF_CloseFont(res->inputFont);
     TTF_CloseFont(res->rackFont);
@@ -3,6 +3,8 @@
 
 #include "scrabble.h"
 #include "dictionary.h"
+#include "board.h"
+#include "graphics.h"
 
 // Structure regroupant les ressources SDL et TTF
 typedef struct {
@@ -12,12 +14,11 @@ typedef struct {
     TTF_Font *rackFont;
     TTF_Font *inputFont;
     TTF_Font *valueFont;
+    GlyphAtlas atlas;      // Glyphes de toutes les polices, rastérisés une seule fois
 } Resources;
 
 // Prototypes
 int initResources(Resources *res);
-char **initBoard(int boardSize);
-void freeBoard(char **board, int boardSize);
-void cleanup(Resources *res, DictionaryEntry *dictionaryHash, char **board, int boardSize);
+void cleanup(Resources *res, DictionaryEntry *dictionaryHash);
 
 #endif // UTILS_H